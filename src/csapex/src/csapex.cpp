@@ -2,13 +2,18 @@
 #include "csapex.h"
 
 /// PROJECT
+#include <csapex/core/auto_save.h>
+#include <csapex/core/bottleneck_analyzer.h>
 #include <csapex/core/csapex_core.h>
+#include <csapex/core/execution_mode_analyzer.h>
 #include <csapex/core/settings/settings_impl.h>
 #include <csapex/io/server.h>
 #include <csapex/io/session_client.h>
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/msg/generic_vector_message.hpp>
 #include <csapex/param/parameter_factory.h>
+#include <csapex/scheduling/auto_partitioner.h>
+#include <csapex/scheduling/thread_placement.h>
 #include <csapex/utility/error_handling.h>
 #include <csapex/utility/exceptions.h>
 #include <csapex/utility/thread.h>
@@ -168,6 +173,24 @@ int Main::runHeadless()
     });
     core->startup();
 
+    if (settings.getTemporary<bool>("infer_execution_modes", false)) {
+        std::cout << core->inferExecutionModes() << std::endl;
+    }
+
+    int dump_interval = settings.getTemporary<int>("dump_bottlenecks", 0);
+    if (dump_interval > 0) {
+        BottleneckAnalyzerPtr analyzer = core->getBottleneckAnalyzer();
+        analyzer->setInterval(dump_interval);
+        analyzer->report_updated.connect([](const BottleneckReport& report) { std::cout << report << std::endl; });
+        analyzer->setEnabled(true);
+
+        ThreadPlacementPtr placement = core->getThreadPlacement();
+        placement->placement_changed.connect([](const PlacementReport& report) { std::cout << report << std::endl; });
+
+        AutoPartitionerPtr partitioner = core->getAutoPartitioner();
+        partitioner->partition_changed.connect([](const PartitionReport& report) { std::cout << report << std::endl; });
+    }
+
     core->startMainLoop();
 
     auto qt_res = runImpl();
@@ -197,6 +220,17 @@ int Main::run()
 
     core = std::make_shared<CsApexCore>(settings, handler);
 
+    if (settings.getTemporary("compile-graph", false)) {
+        try {
+            core->compile(config_to_load);
+        } catch (const std::exception& e) {
+            std::cerr << "cannot compile " << config_to_load << ": " << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << "compiled " << config_to_load << " to " << CsApexCore::getCompiledPath(config_to_load) << std::endl;
+        return 0;
+    }
+
     core->setServerFactory([this]() { return std::make_shared<TcpServer>(*core, true); });
 
     if (settings.getTemporary("start-server", false)) {
@@ -222,7 +256,7 @@ void Main::checkRecoveryFile(CsApexViewCore& view_core, CsApexWindow& w)
         if (recover_needed) {
             recover_needed = false;
             std::string temp_file_name = settings.get("config")->as<std::string>() + ".recover";
-            core->saveAs(temp_file_name, true);
+            core->getAutoSave()->save(temp_file_name);
             w.statusBar()->showMessage(tr("Recovery file saved."));
         }
     });
@@ -255,6 +289,9 @@ void Main::askForRecoveryConfig(const std::string& config_to_load)
 
 void Main::deleteRecoveryConfig()
 {
+    // a pending autosave must not recreate the file after it was deleted
+    core->getAutoSave()->flush();
+
     bool recovery = settings.getTemporary("config_recovery", false);
     if (!recovery) {
         bf3::path temp_file = settings.get("config")->as<std::string>() + ".recover";
@@ -282,7 +319,12 @@ int main(int argc, char** argv)
     po::options_description desc("Allowed options");
     desc.add_options()("help", "show help message")("debug", "enable debug output")("dump", "show variables")("paused", "start paused")("headless", "run without gui")(
         "threadless", "run without threading")("fatal_exceptions", "abort execution on exception")("disable_thread_grouping", "by default create one thread per node")("input", "config file to load")(
-        "start-server", "start tcp server")("port", po::value<int>()->default_value(42123), "tcp server port");
+        "start-server", "start tcp server")("port", po::value<int>()->default_value(42123), "tcp server port")("compile-graph", "compile the config file into a binary graph and exit")(
+        "trace-latency", "record per-token latencies along all paths of the graph")("fuse-chains", "execute chains of synchronous nodes in a single task")(
+        "auto-placement", "pin connected thread groups to the same cpu socket / cache domain")("infer-execution-modes", "headless: promote nodes on linear chains to pipelining after loading")("auto-partition", po::value<int>(),
+                                                                                                  "distribute the nodes over n thread groups by measured load")("dump-bottlenecks", po::value<int>(),
+                                                                                  "headless: print a bottleneck analysis every n milliseconds")(
+        "log-level", po::value<std::string>(), "discard node output below this level: debug, info, warning or error");
 
     po::positional_options_description p;
     p.add("input", 1);
@@ -294,7 +336,7 @@ int main(int argc, char** argv)
     bool fatal_exceptions = false;
     for (int i = 1; i < effective_argc; ++i) {
         std::string arg(argv[i]);
-        if (arg == "--headless") {
+        if (arg == "--headless" || arg == "--compile-graph") {
             headless = true;
         } else if (arg == "--fatal_exceptions") {
             fatal_exceptions = true;
@@ -398,6 +440,16 @@ int main(int argc, char** argv)
     settings.set("initially_paused", vm.count("paused") > 0);
     settings.set("start-server", vm.count("start-server") > 0);
     settings.set("port", vm["port"].as<int>());
+    settings.set("compile-graph", vm.count("compile-graph") > 0);
+    settings.set("trace_token_latency", vm.count("trace-latency") > 0);
+    settings.set("fuse_sync_chains", vm.count("fuse-chains") > 0);
+    settings.set("auto_thread_placement", vm.count("auto-placement") > 0);
+    settings.set("infer_execution_modes", vm.count("infer-execution-modes") > 0);
+    settings.set("auto_partition_groups", vm.count("auto-partition") > 0 ? vm["auto-partition"].as<int>() : 0);
+    settings.set("dump_bottlenecks", vm.count("dump-bottlenecks") > 0 ? vm["dump-bottlenecks"].as<int>() : 0);
+    if (vm.count("log-level")) {
+        settings.set("log_level", vm["log-level"].as<std::string>());
+    }
 
     // start the app
     Main m(std::move(app), settings, *handler);
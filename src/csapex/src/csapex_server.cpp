@@ -103,7 +103,8 @@ int main(int argc, char** argv)
     po::options_description desc("Allowed options");
     desc.add_options()("help", "show help message")("port", po::value<int>()->default_value(42123),
                                                     "tcp server port")("debug", "enable debug output")("dump", "show variables")("paused", "start paused")("headless", "run without gui")(
-        "threadless", "run without threading")("fatal_exceptions", "abort execution on exception")("disable_thread_grouping", "by default create one thread per node")("input", "config file to load");
+        "threadless", "run without threading")("fatal_exceptions", "abort execution on exception")("disable_thread_grouping", "by default create one thread per node")("input", "config file to load")(
+        "log-level", po::value<std::string>(), "discard node output below this level: debug, info, warning or error");
 
     po::positional_options_description p;
     p.add("input", 1);
@@ -204,6 +205,9 @@ int main(int argc, char** argv)
     settings.set("additional_args", additional_args);
     settings.set("initially_paused", vm.count("paused") > 0);
     settings.set("port", vm["port"].as<int>());
+    if (vm.count("log-level")) {
+        settings.set("log_level", vm["log-level"].as<std::string>());
+    }
 
     // start the app
     CsApexServer m(settings, *handler);
@@ -3,6 +3,7 @@
 
 /// COMPONENT
 #include "command_impl.hpp"
+#include <csapex/model/connection_description.h>
 #include <csapex/model/model_fwd.h>
 #include <csapex/msg/msg_fwd.h>
 #include <csapex/utility/uuid.h>
@@ -16,8 +17,9 @@ class CSAPEX_COMMAND_EXPORT AddConnection : public CommandImplementation<AddConn
     COMMAND_HEADER(AddConnection);
 
 public:
-    AddConnection(const AUUID& graph_uuid, const UUID& from_uuid, const UUID& to_uuid, bool active);
+    AddConnection(const AUUID& graph_uuid, const UUID& from_uuid, const UUID& to_uuid, bool active, ConnectionPolicy policy = ConnectionPolicy::HANDSHAKE);
 
+    SemanticVersion getVersion() const override;
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -35,6 +37,7 @@ protected:
 
 private:
     bool active;
+    ConnectionPolicy policy;
 };
 }  // namespace command
 }  // namespace csapex
@@ -60,6 +60,27 @@ public:
 
     virtual void accept(int level, std::function<void(int level, const Command&)> callback) const;
 
+    /**
+     * @return an estimate of the memory this command keeps alive to be undone or redone
+     */
+    virtual std::size_t getMemoryFootprint() const;
+
+    /**
+     * @brief spill moves large snapshots kept for undo and redo to files in directory, they are reloaded on demand
+     */
+    virtual void spill(const std::string& directory);
+
+    /**
+     * @brief reload reads spilled snapshots back into memory, throws if they cannot be read
+     */
+    virtual void reload();
+
+    /**
+     * @brief absorb merges a command that has been executed directly after this one into this command
+     * @return true, iff undoing this command now also undoes next
+     */
+    virtual bool absorb(const Command& next);
+
     virtual std::string getType() const = 0;
     virtual std::string getDescription() const = 0;
 
@@ -4,6 +4,7 @@
 /// COMPONENT
 #include "meta.h"
 #include <csapex/utility/uuid.h>
+#include <csapex/model/connection_description.h>
 
 namespace csapex
 {
@@ -16,6 +17,7 @@ class CSAPEX_COMMAND_EXPORT DeleteConnection : public Meta
 public:
     DeleteConnection(const AUUID& graph_uuid, const UUID& from, const UUID& to);
 
+    SemanticVersion getVersion() const override;
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -38,6 +40,7 @@ protected:
 protected:
     int connection_id;
     bool active_;
+    ConnectionPolicy policy_;
 
     UUID from_uuid;
     UUID to_uuid;
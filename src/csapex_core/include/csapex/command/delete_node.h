@@ -20,6 +20,10 @@ class CSAPEX_COMMAND_EXPORT DeleteNode : public Meta
 public:
     DeleteNode(const AUUID& graph_uuid, const UUID& uuid);
 
+    std::size_t getMemoryFootprint() const override;
+    void spill(const std::string& directory) override;
+    void reload() override;
+
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
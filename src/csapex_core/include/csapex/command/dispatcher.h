@@ -8,6 +8,7 @@
 
 /// SYSTEM
 #include <deque>
+#include <string>
 #include <csapex/utility/slim_signal.h>
 
 namespace csapex
@@ -44,10 +45,38 @@ public:
     void resetDirtyPoint();
     void clearSavepoints();
 
+    /**
+     * @brief setHistoryLimits bounds the undo history, the oldest commands are forgotten first.
+     * @param max_commands maximum number of commands that can be undone and redone, 0 for no limit
+     * @param max_bytes maximum estimated memory held by these commands, 0 for no limit
+     */
+    void setHistoryLimits(std::size_t max_commands, std::size_t max_bytes);
+
+    /**
+     * @brief setSpillDirectory enables moving snapshots of old commands to disk before they are forgotten
+     * @param directory where to spill to, empty to disable spilling
+     */
+    void setSpillDirectory(const std::string& directory);
+
+    std::size_t getHistoryMemory() const;
+
 private:
+    struct HistoryEntry
+    {
+        HistoryEntry(const Command::Ptr& command);
+
+        Command::Ptr command;
+        std::size_t bytes;
+    };
+
     void doExecute(Command::Ptr command);
     void setDirty(bool dirty);
 
+    void push(std::deque<HistoryEntry>& history, HistoryEntry entry);
+    void measure(HistoryEntry& entry);
+    void enforceHistoryLimits();
+    void dropOldest();
+
 protected:
     CommandDispatcher(const CommandDispatcher& copy);
     CommandDispatcher& operator=(const CommandDispatcher& assign);
@@ -57,9 +86,14 @@ private:
 
     std::vector<Command::Ptr> later;
 
-    std::deque<Command::Ptr> done;
-    std::deque<Command::Ptr> undone;
+    std::deque<HistoryEntry> done;
+    std::deque<HistoryEntry> undone;
     bool dirty_;
+
+    std::size_t max_commands_;
+    std::size_t max_bytes_;
+    std::size_t history_bytes_;
+    std::string spill_directory_;
 };
 
 }  // namespace csapex
@@ -27,6 +27,10 @@ public:
 
     virtual void init(GraphFacadeImplementation* root, CsApexCore& core) override;
 
+    std::size_t getMemoryFootprint() const override;
+    void spill(const std::string& directory) override;
+    void reload() override;
+
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
     void cloneData(const Meta& other) override;
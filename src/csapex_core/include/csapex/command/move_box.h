@@ -6,6 +6,9 @@
 #include <csapex/utility/uuid.h>
 #include <csapex/data/point.h>
 
+/// SYSTEM
+#include <chrono>
+
 namespace csapex
 {
 namespace command
@@ -17,6 +20,12 @@ class CSAPEX_COMMAND_EXPORT MoveBox : public CommandImplementation<MoveBox>
 public:
     MoveBox(const AUUID& graph_uuid, const UUID& node_uuid, Point from, Point to);
 
+    /**
+     * @brief absorb merges the steps of one continuous drag, i.e. moves of the same box that start where the last one ended
+     *        and follow it within a short time
+     */
+    bool absorb(const Command& next) override;
+
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -32,6 +41,8 @@ protected:
     Point to;
 
     UUID box_uuid;
+
+    std::chrono::steady_clock::time_point moved_at;
 };
 
 }  // namespace command
@@ -5,6 +5,9 @@
 #include "command_impl.hpp"
 #include <csapex/data/point.h>
 
+/// SYSTEM
+#include <chrono>
+
 namespace csapex
 {
 namespace command
@@ -18,6 +21,11 @@ public:
 
     virtual std::string getDescription() const override;
 
+    /**
+     * @brief absorb merges the steps of one continuous drag of the same fulcrum, see MoveBox::absorb
+     */
+    bool absorb(const Command& next) override;
+
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -31,6 +39,8 @@ private:
     int fulcrum_id;
     Point from;
     Point to;
+
+    std::chrono::steady_clock::time_point moved_at;
 };
 
 }  // namespace command
@@ -26,6 +26,10 @@ public:
 
     virtual std::string getDescription() const override;
 
+    std::size_t getMemoryFootprint() const override;
+    void spill(const std::string& directory) override;
+    void reload() override;
+
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
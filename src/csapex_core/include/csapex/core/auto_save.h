@@ -0,0 +1,119 @@
+#ifndef AUTO_SAVE_H
+#define AUTO_SAVE_H
+
+/// PROJECT
+#include <csapex/core/core_fwd.h>
+#include <csapex/core/graphio.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/utility/uuid.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+namespace csapex
+{
+/**
+ * @brief AutoSave writes snapshots of the configuration, e.g. recovery files, without stalling the graph.
+ *
+ * Taking a snapshot only copies the states of nodes whose NodeState revision changed since the
+ * previous snapshot, all other nodes are written as references. Serializing the copied states,
+ * filling in the referenced nodes from earlier snapshots and writing the file happens on a
+ * background thread. If several snapshots are pending, only the latest one is written.
+ */
+class CSAPEX_CORE_EXPORT AutoSave
+{
+public:
+    /**
+     * @brief A Source serializes the configuration, skipping nodes that the filter reports as unchanged
+     *        and using the state writer for all other nodes.
+     */
+    typedef std::function<YAML::Node(const GraphIO::NodeFilter&, const GraphIO::NodeStateWriter&)> Source;
+
+public:
+    AutoSave(const Source& source);
+    ~AutoSave();
+
+    /**
+     * @brief setHeader sets a line that is written in front of the document, e.g. a shebang
+     */
+    void setHeader(const std::string& header);
+
+    /**
+     * @brief save takes a snapshot of the current configuration and writes it to file in the background.
+     *        Must be called from the thread that owns the graph.
+     */
+    void save(const std::string& file);
+
+    /**
+     * @brief flush blocks until all snapshots have been written
+     */
+    void flush();
+
+    /**
+     * @brief invalidate forces the next snapshot to serialize every node
+     */
+    void invalidate();
+
+    std::size_t getSerializedNodeCount() const;
+    std::size_t getReusedNodeCount() const;
+
+private:
+    struct DeferredState
+    {
+        YAML::Node doc;
+        NodeStatePtr state;
+    };
+
+    struct Snapshot
+    {
+        std::string file;
+        std::string header;
+        YAML::Node document;
+        std::vector<DeferredState> states;
+    };
+
+    struct Revision
+    {
+        NodeState* state;
+        uint64_t revision;
+    };
+
+    bool isUnchanged(const NodeFacadeImplementation& node, std::unordered_map<AUUID, Revision, AUUID::Hasher>& seen);
+    void copyState(const NodeFacadeImplementation& node, YAML::Node& doc, std::vector<DeferredState>& states);
+
+    void writeLoop();
+    bool resolve(YAML::Node& graph, const std::string& prefix, std::map<std::string, YAML::Node>& seen);
+    void write(const Snapshot& snapshot);
+
+private:
+    Source source_;
+
+    // owned by the thread calling save
+    std::string header_;
+    std::unordered_map<AUUID, Revision, AUUID::Hasher> revisions_;
+    std::size_t serialized_;
+    std::size_t reused_;
+
+    // owned by the writer thread
+    std::map<std::string, YAML::Node> cache_;
+
+    std::thread writer_;
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<Snapshot> pending_;
+    bool writing_;
+    bool invalid_;
+    bool stop_;
+};
+
+}  // namespace csapex
+
+#endif  // AUTO_SAVE_H
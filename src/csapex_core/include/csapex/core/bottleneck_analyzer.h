@@ -0,0 +1,124 @@
+#ifndef BOTTLENECK_ANALYZER_H
+#define BOTTLENECK_ANALYZER_H
+
+/// PROJECT
+#include <csapex/model/model_fwd.h>
+#include <csapex/utility/uuid.h>
+#include <csapex/utility/slim_signal.hpp>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief NodeLoad describes how a single node spent the analyzed time window.
+ *        All ratios are fractions of the window length.
+ */
+struct CSAPEX_CORE_EXPORT NodeLoad
+{
+    NodeLoad();
+
+    AUUID node;
+    std::string label;
+    int depth;
+
+    long process_count;
+    double mean_process_time;
+
+    double utilization;
+    double waiting_on_input;
+    double blocked_on_output;
+};
+
+struct CSAPEX_CORE_EXPORT BottleneckReport
+{
+    BottleneckReport();
+
+    long window;
+
+    std::vector<NodeLoad> nodes;
+
+    /**
+     * critical_path is the source-to-sink chain with the largest sum of mean processing times
+     */
+    std::vector<AUUID> critical_path;
+    double critical_path_time;
+
+    /**
+     * bottleneck is the node with the highest utilization, it bounds the throughput of its component
+     */
+    AUUID bottleneck;
+};
+
+CSAPEX_CORE_EXPORT std::ostream& operator<<(std::ostream& out, const BottleneckReport& report);
+
+/**
+ * @brief The BottleneckAnalyzer periodically samples the processing time of all node workers
+ *        and the state durations of all connections to find out which node bounds the throughput.
+ *        A node waits on input while one of its input connections is empty, and it is blocked on
+ *        output while one of its output connections still holds a token that was not processed.
+ */
+class CSAPEX_CORE_EXPORT BottleneckAnalyzer
+{
+public:
+    BottleneckAnalyzer(GraphFacadeImplementationPtr root);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void setInterval(long interval_ms);
+    long getInterval() const;
+
+    /**
+     * @brief tick updates the report if the interval has elapsed, has to be called from the thread modifying the graph
+     */
+    void tick();
+
+    BottleneckReport update();
+    BottleneckReport getReport() const;
+
+public:
+    slim_signal::Signal<void(const BottleneckReport&)> report_updated;
+
+private:
+    struct NodeSample
+    {
+        long processing_time;
+        long process_count;
+    };
+
+    struct ConnectionSample
+    {
+        long empty;
+        long occupied;
+    };
+
+    void analyzeGraph(GraphFacadeImplementation& graph, long window, BottleneckReport& report, std::map<AUUID, NodeSample>& node_samples,
+                      std::map<int, ConnectionSample>& connection_samples);
+
+    std::vector<graph::VertexPtr> sortTopologically(GraphImplementation& graph) const;
+
+    ConnectionSample sampleConnection(const ConnectionPtr& connection, std::map<int, ConnectionSample>& connection_samples) const;
+
+private:
+    GraphFacadeImplementationPtr root_;
+
+    bool enabled_;
+    long interval_;
+    long last_update_;
+
+    std::map<AUUID, NodeSample> node_samples_;
+    std::map<int, ConnectionSample> connection_samples_;
+
+    mutable std::mutex report_mutex_;
+    BottleneckReport report_;
+};
+
+}  // namespace csapex
+
+#endif  // BOTTLENECK_ANALYZER_H
@@ -18,6 +18,9 @@ FWD(CorePlugin)
 FWD(Bootstrap)
 FWD(BootstrapPlugin)
 FWD(ExceptionHandler)
+FWD(BottleneckAnalyzer)
+FWD(ExecutionModeAnalyzer)
+FWD(AutoSave)
 
 class Settings;
 }  // namespace csapex
@@ -3,8 +3,10 @@
 
 /// COMPONENT
 #include <csapex/command/dispatcher.h>
+#include <csapex/core/core_fwd.h>
 #include <csapex/core/settings.h>
 #include <csapex_core/csapex_core_export.h>
+#include <csapex/model/model_fwd.h>
 #include <csapex/model/observer.h>
 #include <csapex/plugin/plugin_fwd.h>
 #include <csapex/model/notifier.h>
@@ -27,6 +29,7 @@ class ClassLoader;
 namespace csapex
 {
 class Profiler;
+struct ExecutionModeReport;
 
 class CSAPEX_CORE_EXPORT CsApexCore : public Observer, public Notifier, public Profilable
 {
@@ -54,6 +57,18 @@ public:
     void load(const std::string& file);
     void saveAs(const std::string& file, bool quiet = false);
 
+    /**
+     * @brief snapshot serializes the whole configuration into a YAML document.
+     *        Nodes for which is_unchanged returns true are written as references only,
+     *        the states of all other nodes are written by write_state if it is set, see GraphIO.
+     */
+    YAML::Node snapshot(const std::function<bool(const NodeFacadeImplementation&)>& is_unchanged = std::function<bool(const NodeFacadeImplementation&)>(),
+                        const std::function<void(const NodeFacadeImplementation&, YAML::Node&)>& write_state = std::function<void(const NodeFacadeImplementation&, YAML::Node&)>());
+
+    void compile(const std::string& file);
+    void saveCompiled(const std::string& file, const std::string& source_file);
+    static std::string getCompiledPath(const std::string& file);
+
     SnippetPtr serializeNodes(const AUUID& graph_id, const std::vector<UUID>& nodes) const;
 
     void reset();
@@ -74,6 +89,21 @@ public:
     CommandDispatcherPtr getCommandDispatcher() const;
 
     std::shared_ptr<Profiler> getProfiler() const;
+    BottleneckAnalyzerPtr getBottleneckAnalyzer() const;
+    ExecutionModeAnalyzerPtr getExecutionModeAnalyzer() const;
+    ThreadPlacementPtr getThreadPlacement() const;
+    AutoPartitionerPtr getAutoPartitioner() const;
+    AutoSavePtr getAutoSave() const;
+
+    /**
+     * @brief inferExecutionModes promotes all nodes that the ExecutionModeAnalyzer suggests with one undoable command
+     */
+    ExecutionModeReport inferExecutionModes();
+
+    /**
+     * @brief getTokenMemoryStatistics reports the memory of the tokens in flight, empty unless "account_token_memory" is set
+     */
+    TokenMemoryStatistics getTokenMemoryStatistics() const;
 
     bool isPaused() const;
     void setPause(bool pause);
@@ -119,6 +149,11 @@ private:
     CsApexCore(Settings& settings_, ExceptionHandler& handler, PluginLocatorPtr plugin_locator);
     CorePluginPtr makeCorePlugin(const std::string& name);
 
+    void loadConfig(const std::string& file, bool use_compiled);
+    void loadYaml(const std::string& file);
+    std::string loadCompiled(const std::string& file);
+    void applyLogLevel();
+
 private:
     bool is_root_;
 
@@ -143,6 +178,11 @@ private:
     std::shared_ptr<CommandDispatcher> dispatcher_;
 
     std::shared_ptr<Profiler> profiler_;
+    BottleneckAnalyzerPtr bottleneck_analyzer_;
+    ExecutionModeAnalyzerPtr execution_mode_analyzer_;
+    ThreadPlacementPtr thread_placement_;
+    AutoPartitionerPtr auto_partitioner_;
+    AutoSavePtr auto_save_;
 
     std::shared_ptr<PluginManager<CorePlugin>> core_plugin_manager;
     std::map<std::string, std::shared_ptr<CorePlugin>> core_plugins_;
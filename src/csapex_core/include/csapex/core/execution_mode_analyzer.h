@@ -0,0 +1,82 @@
+#ifndef EXECUTION_MODE_ANALYZER_H
+#define EXECUTION_MODE_ANALYZER_H
+
+/// PROJECT
+#include <csapex/command/command_fwd.h>
+#include <csapex/model/execution_mode.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/utility/uuid.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief ExecutionModeDecision describes the mode that is suggested for a single node and why.
+ */
+struct CSAPEX_CORE_EXPORT ExecutionModeDecision
+{
+    ExecutionModeDecision();
+
+    AUUID node;
+    std::string label;
+    int depth;
+
+    ExecutionMode current;
+    ExecutionMode suggested;
+    std::string reason;
+
+    bool isPromotion() const;
+};
+
+struct CSAPEX_CORE_EXPORT ExecutionModeReport
+{
+    std::vector<ExecutionModeDecision> nodes;
+
+    std::vector<ExecutionModeDecision> promotions() const;
+};
+
+CSAPEX_CORE_EXPORT std::ostream& operator<<(std::ostream& out, const ExecutionModeReport& report);
+
+/**
+ * @brief The ExecutionModeAnalyzer decides which nodes can run in PIPELINING mode without changing the results of the graph.
+ *        A pipelining node releases its inputs as soon as it has read them, so its predecessors can already produce the next
+ *        message while the node's outputs are still being processed downstream.
+ *        This is only safe for nodes on a plain chain: nodes that take part in joins or that lead to essential inputs keep
+ *        consuming messages in lockstep, and sources, sinks, subgraphs and nodes driven by events or asynchronous processing
+ *        gain nothing from releasing their inputs early.
+ *        Nodes are never demoted, modes that were chosen by hand are kept.
+ */
+class CSAPEX_CORE_EXPORT ExecutionModeAnalyzer
+{
+public:
+    ExecutionModeAnalyzer(GraphFacadeImplementationPtr root);
+
+    ExecutionModeReport analyze() const;
+
+    /**
+     * @brief makeCommand bundles all promotions of the report into one undoable command
+     * @return nullptr, if nothing would be promoted
+     */
+    CommandPtr makeCommand(const ExecutionModeReport& report) const;
+
+    /**
+     * @brief apply sets the suggested modes directly, without going through the command history
+     */
+    void apply(const ExecutionModeReport& report) const;
+
+private:
+    void analyzeGraph(GraphFacadeImplementation& graph_facade, ExecutionModeReport& report) const;
+    bool decide(const graph::Vertex& vertex, ExecutionModeDecision& decision) const;
+
+private:
+    GraphFacadeImplementationPtr root_;
+};
+
+}  // namespace csapex
+
+#endif  // EXECUTION_MODE_ANALYZER_H
@@ -13,6 +13,7 @@
 
 /// SYSTEM
 #include <yaml-cpp/yaml.h>
+#include <functional>
 #include <unordered_map>
 
 namespace csapex
@@ -22,9 +23,23 @@ class CSAPEX_CORE_EXPORT GraphIO : public Profilable
 public:
     GraphIO(GraphFacadeImplementation& graph, NodeFactoryImplementation* node_factory, bool throw_on_error = false);
 
+    /**
+     * @brief A NodeFilter returns true for nodes whose state has not changed since an earlier save.
+     *        Those nodes are only written as a reference {uuid, cached: true}.
+     */
+    typedef std::function<bool(const NodeFacadeImplementation&)> NodeFilter;
+
+    /**
+     * @brief A NodeStateWriter replaces NodeState::writeYaml for nodes that are serialized,
+     *        e.g. to copy the state and write it later on another thread.
+     */
+    typedef std::function<void(const NodeFacadeImplementation&, YAML::Node&)> NodeStateWriter;
+
 public:
     // options
     void setIgnoreForwardingConnections(bool ignore);
+    void setUnchangedNodeFilter(const NodeFilter& is_unchanged);
+    void setNodeStateWriter(const NodeStateWriter& write_state);
 
     // api
     void saveSettings(YAML::Node& yaml);
@@ -36,6 +51,13 @@ public:
     void loadGraph(const Snippet& doc);
     void loadGraphFrom(const YAML::Node& doc);
 
+    // compiled binary representation
+    void saveSettings(SerializationBuffer& data);
+    void loadSettings(const SerializationBuffer& data);
+
+    void saveGraphTo(SerializationBuffer& data);
+    void loadGraphFrom(const SerializationBuffer& data);
+
     Snippet saveSelectedGraph(const std::vector<UUID>& nodes);
 
     std::unordered_map<UUID, UUID, UUID::Hasher> loadIntoGraph(const Snippet& blueprint, const csapex::Point& position);
@@ -56,6 +78,13 @@ private:
     void saveFulcrums(YAML::Node& fulcrum, const ConnectionDescription& connection);
     void loadFulcrum(const YAML::Node& fulcrum);
 
+    void saveNodes(SerializationBuffer& data);
+    void loadNodes(const SerializationBuffer& data);
+    void loadNode(const SerializationBuffer& data);
+
+    void saveConnections(SerializationBuffer& data);
+    void loadConnections(const SerializationBuffer& data);
+
     void sendNotification(const std::string& notification);
 
 protected:
@@ -65,10 +94,15 @@ protected:
     void serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr node_handle);
     void deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr node_handle);
 
-    void loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type);
+    void serializeNode(SerializationBuffer& data, NodeFacadeImplementationConstPtr node_handle);
+    void deserializeNode(const SerializationBuffer& data, NodeFacadeImplementationPtr node_handle);
+
+    void loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type, ConnectionPolicy policy);
 
     UUID readNodeUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc);
+    UUID readNodeUUID(std::weak_ptr<UUIDProvider> parent, const std::string& id);
     UUID readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc);
+    UUID readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const std::string& id);
 
 private:
     GraphFacadeImplementation& graph_;
@@ -80,6 +114,9 @@ private:
 
     bool ignore_forwarding_connections_;
     bool throw_on_error_;
+
+    NodeFilter is_unchanged_;
+    NodeStateWriter write_state_;
 };
 
 }  // namespace csapex
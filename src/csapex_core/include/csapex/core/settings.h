@@ -18,10 +18,12 @@ class CSAPEX_CORE_EXPORT Settings
 public:
     static const std::string settings_file;
     static const std::string config_extension;
+    static const std::string config_extension_compiled;
     static const std::string template_extension;
     static const std::string message_extension;
     static const std::string message_extension_compressed;
     static const std::string message_extension_binary;
+    static const std::string message_log_extension;
     static const std::string default_config;
     static const std::string config_selector;
 
@@ -51,6 +53,12 @@ public:
     virtual void savePersistent() = 0;
     virtual void loadPersistent() = 0;
 
+    /**
+     * @brief flushPersistent blocks until all pending calls to savePersistent have reached the disk.
+     *        Implementations that save synchronously don't need to override this.
+     */
+    virtual void flushPersistent();
+
     virtual void saveTemporary(YAML::Node& node) = 0;
     virtual void loadTemporary(YAML::Node& node) = 0;
 
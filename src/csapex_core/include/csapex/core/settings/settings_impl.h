@@ -5,6 +5,13 @@
 #include <csapex/core/settings.h>
 #include <csapex/model/observer.h>
 
+/// SYSTEM
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <yaml-cpp/yaml.h>
+
 namespace csapex
 {
 class SettingsImplementation : public Settings, public Observer
@@ -13,7 +20,8 @@ public:
     static SettingsImplementation NoSettings;
 
 public:
-    SettingsImplementation(bool load_from_config = true);
+    SettingsImplementation(bool load_from_config = true, const std::string& file = settings_file);
+    ~SettingsImplementation();
 
     bool knows(const std::string& name) const override;
 
@@ -23,6 +31,7 @@ public:
 
     void savePersistent() override;
     void loadPersistent() override;
+    void flushPersistent() override;
 
     void saveTemporary(YAML::Node& node) override;
     void loadTemporary(YAML::Node& node) override;
@@ -34,7 +43,27 @@ private:
         bool persistent;
     };
 
+    YAML::Node snapshotPersistent() const;
+    void writeLoop();
+    void write(const YAML::Node& snapshot);
+
+private:
     std::map<std::string, Entry> settings_;
+
+    std::string file_;
+    std::atomic<bool> persistent_dirty_;
+
+    /**
+     * Persistent settings are written by a background thread. Each call to savePersistent
+     * hands over a snapshot, a snapshot that has not been written yet is replaced by newer ones.
+     */
+    std::thread writer_;
+    std::mutex writer_mutex_;
+    std::condition_variable writer_changed_;
+    YAML::Node pending_;
+    bool has_pending_;
+    bool writing_;
+    bool stop_writer_;
 };
 
 }  // namespace csapex
@@ -8,10 +8,12 @@
 #include <csapex/signal/signal_fwd.h>
 #include <csapex/utility/slim_signal.hpp>
 #include <csapex/model/token.h>
+#include <csapex/model/token_memory.h>
 #include <csapex_core/csapex_core_export.h>
 #include <csapex/model/connection_description.h>
 
 /// SYSTEM
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <deque>
@@ -20,7 +22,7 @@
 
 namespace csapex
 {
-class CSAPEX_CORE_EXPORT Connection
+class CSAPEX_CORE_EXPORT Connection : public std::enable_shared_from_this<Connection>
 {
     friend class GraphIO;
     friend class Graph;
@@ -68,6 +70,8 @@ public:
 
     ConnectionDescription getDescription() const;
 
+    virtual ConnectionPolicy getPolicy() const;
+
     bool contains(Connector* c) const;
 
     virtual void setToken(const TokenPtr& msg);
@@ -93,10 +97,29 @@ public:
 
     bool isPipelining() const;
 
+    /**
+     * @brief setDirectHandoff lets the connection share the payload of the sent tokens instead of copying it.
+     *        Only valid while the target is the single consumer of the source, i.e. within a fused chain.
+     */
+    void setDirectHandoff(bool direct);
+    bool isDirectHandoff() const;
+
     State getState() const;
     void setState(State s);
 
-    void reset();
+    /**
+     * @brief getSourceState is the state as seen by the output, which may only send when it is DONE.
+     *        For handshaking connections this is the same as getState().
+     */
+    virtual State getSourceState() const;
+
+    /**
+     * @brief getTimeInState accumulates the time this connection has spent in a state
+     * @return micro seconds, including the currently active state
+     */
+    long getTimeInState(State s) const;
+
+    virtual void reset();
 
 public:
     slim_signal::Signal<void()> deleted;
@@ -126,8 +149,20 @@ public:
     void deleteFulcrum(int fulcrum_id);
 
 protected:
+    void changeState(State s);
+
+    /**
+     * @brief prepareToken creates the copy of a token that is held by this connection, with direct handoff the payload is shared
+     */
+    TokenPtr prepareToken(const TokenPtr& token) const;
+
+    /**
+     * @brief updateMemoryLease accounts the token held by this connection, call it whenever message_ changes
+     */
+    void updateMemoryLease();
+
     void notifyMessageSet();
-    void notifyMessageProcessed();
+    virtual void notifyMessageProcessed();
 
 protected:
     OutputPtr from_;
@@ -138,10 +173,16 @@ protected:
 
     bool detached_;
 
+    std::atomic<bool> direct_handoff_;
+
     std::vector<FulcrumPtr> fulcrums_;
 
     State state_;
+    long state_since_;
+    long time_in_state_[3];
+
     TokenPtr message_;
+    TokenMemoryLease message_memory_;
 
     static int next_connection_id_;
 
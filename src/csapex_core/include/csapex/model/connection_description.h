@@ -10,6 +10,17 @@
 
 namespace csapex
 {
+/**
+ * @brief ConnectionPolicy selects how a connection hands tokens from its output to its input.
+ *        HANDSHAKE delivers every token and blocks the producer until the token is processed.
+ *        LATEST_VALUE never blocks the producer and replaces tokens that were not read yet by newer ones.
+ */
+enum class ConnectionPolicy
+{
+    HANDSHAKE = 0,
+    LATEST_VALUE = 1
+};
+
 struct CSAPEX_CORE_EXPORT ConnectionDescription : public Serializable
 {
 protected:
@@ -28,7 +39,10 @@ public:
 
     std::vector<Fulcrum> fulcrums;
 
-    ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, bool active, const std::vector<Fulcrum>& fulcrums);
+    ConnectionPolicy policy;
+
+    ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, bool active, const std::vector<Fulcrum>& fulcrums,
+                          ConnectionPolicy policy = ConnectionPolicy::HANDSHAKE);
 
     ConnectionDescription(const ConnectionDescription& other);
 
@@ -36,6 +50,7 @@ public:
 
     ConnectionDescription();
 
+    SemanticVersion getVersion() const override;
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
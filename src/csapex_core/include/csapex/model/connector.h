@@ -7,6 +7,7 @@
 #include <csapex/model/error_state.h>
 #include <csapex/model/connector_type.h>
 #include <csapex/model/connector_description.h>
+#include <csapex/msg/msg_fwd.h>
 #include <csapex_core/csapex_core_export.h>
 
 /// SYSTEM
@@ -48,6 +49,13 @@ public:
 
     virtual std::vector<UUID> getConnectedPorts() const = 0;
 
+    /**
+     * @brief addTap registers a lossy observer for the tokens sent by this connector
+     * @return false, iff this connector does not support taps
+     */
+    virtual bool addTap(const OutputTapPtr& tap);
+    virtual void removeTap(const OutputTapPtr& tap);
+
     // DEBUG INFORMATION
     virtual std::string makeStatusString() const = 0;
 
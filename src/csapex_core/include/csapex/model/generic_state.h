@@ -12,6 +12,7 @@
 #include <csapex/utility/slim_signal.h>
 
 /// SYSTEM
+#include <atomic>
 #include <set>
 #include <yaml-cpp/yaml.h>
 
@@ -69,11 +70,21 @@ public:
     void writeYaml(YAML::Node& out) const;
     void readYaml(const YAML::Node& node);
 
+    void writeBinary(SerializationBuffer& data) const;
+    void readBinary(const SerializationBuffer& data);
+
     void initializePersistentParameters();
 
+    /**
+     * @brief getRevision is incremented whenever the parameter set or the value of a parameter changes
+     */
+    uint64_t getRevision() const;
+
 private:
     void registerParameter(const csapex::param::ParameterPtr& param);
     void unregisterParameter(const csapex::param::ParameterPtr& param);
+    void observeParameters();
+    void touch();
 
 public:
     UUID parent_uuid_;
@@ -93,6 +104,11 @@ public:
     slim_signal::Signal<void(param::ParameterPtr)> parameter_added;
     slim_signal::Signal<void(param::Parameter*)> parameter_changed;
     slim_signal::Signal<void(param::ParameterPtr)> parameter_removed;
+
+private:
+    slim_signal::Signal<void(param::Parameter*)> parameter_touched_;
+    std::map<param::Parameter*, slim_signal::ScopedConnection> parameter_connections_;
+    std::atomic<uint64_t> revision_;
 };
 
 }  // namespace csapex
@@ -4,6 +4,9 @@
 /// COMPONENT
 #include <csapex/model/graph.h>
 
+/// SYSTEM
+#include <unordered_map>
+
 namespace csapex
 {
 class GraphImplementation : public Graph
@@ -80,17 +83,44 @@ public:
 
 private:
     void checkNodeState(NodeHandle* nh);
+    void checkNodeState(const graph::VertexPtr& vertex);
 
     void buildConnectedComponents();
     void calculateDepths();
+    void calculateDepths(const std::vector<graph::VertexPtr>& vertices);
+
+    std::set<graph::Vertex*> findVerticesThatNeedMessages(const std::vector<graph::VertexPtr>& vertices);
+    std::set<graph::Vertex*> findVerticesThatJoinStreams(const std::vector<graph::VertexPtr>& vertices);
+
+    // incremental analysis, used for single changes outside of transactions
+    void analyzeAddedVertex(const graph::VertexPtr& vertex);
+    void analyzeAddedEdge(const graph::VertexPtr& from, const graph::VertexPtr& to, const ConnectionPtr& connection);
+    void analyzeConnection(const Connection* connection);
+    void analyzeComponent(int component);
+
+    int mergeComponents(const graph::VertexPtr& a, const graph::VertexPtr& b);
+    void splitComponent(const graph::VertexPtr& a, const graph::VertexPtr& b);
 
-    std::set<graph::Vertex*> findVerticesThatNeedMessages();
-    std::set<graph::Vertex*> findVerticesThatJoinStreams();
+    void repairDepths(const graph::VertexPtr& vertex);
+    int calculateDepthFromParents(const graph::VertexPtr& vertex) const;
+    void propagateEssential(const graph::VertexPtr& vertex);
+    bool isLeadingToJoin(const graph::VertexPtr& vertex) const;
+
+    // chain fusion, see NodeRunner::setFusedPredecessor
+    void updateChainFusion(const graph::VertexPtr& vertex);
+    void updateChainFusionAround(const graph::VertexPtr& vertex);
+    bool isFusible(const graph::VertexPtr& vertex) const;
+
+    graph::VertexPtr findVertexForConnectorNoThrow(const UUID& connector_uuid) const noexcept;
 
 protected:
     std::vector<graph::VertexPtr> vertices_;
+    std::unordered_map<UUID, graph::VertexPtr, UUID::Hasher> vertex_index_;
     std::vector<ConnectionPtr> edges_;
 
+    std::map<int, std::vector<graph::VertexPtr>> components_;
+    int next_component_;
+
     std::map<Connection*, std::vector<slim_signal::ScopedConnection>> connection_observations_;
 
     std::set<graph::VertexPtr> sources_;
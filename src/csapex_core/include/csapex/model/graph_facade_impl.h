@@ -60,7 +60,7 @@ public:
     virtual bool isPaused() const override;
     virtual void pauseRequest(bool pause) override;
 
-    ConnectionPtr connect(OutputPtr output, InputPtr input);
+    ConnectionPtr connect(OutputPtr output, InputPtr input, ConnectionPolicy policy = ConnectionPolicy::HANDSHAKE);
 
     ConnectionPtr connect(const UUID& output_id, const UUID& input_id);
 
@@ -31,6 +31,7 @@ FWD(ConnectableOwner)
 FWD(Graph)
 FWD(GraphImplementation)
 FWD(SubgraphNode)
+FWD(SubgraphBridge)
 FWD(GraphFacade)
 FWD(GraphFacadeImplementation)
 FWD(TokenData)
@@ -43,6 +44,8 @@ FWD(NodeModifier)
 FWD(Clonable)
 FWD(Tag)
 FWD(NodeCharacteristics)
+FWD(TokenLatencyStatistics)
+FWD(TokenMemoryStatistics)
 FWD(ConnectorDescription)
 FWD(Connector)
 FWD(Connection)
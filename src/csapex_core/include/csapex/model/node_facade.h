@@ -81,6 +81,8 @@ public:
     virtual bool isProfiling() const = 0;
     virtual void setProfiling(bool profiling) = 0;
 
+    virtual TokenLatencyStatistics getTokenLatencyStatistics() const = 0;
+
     virtual ExecutionState getExecutionState() const = 0;
 
     virtual std::string getLabel() const = 0;
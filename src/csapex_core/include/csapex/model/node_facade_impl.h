@@ -67,6 +67,8 @@ public:
     bool isProfiling() const override;
     void setProfiling(bool profiling) override;
 
+    TokenLatencyStatistics getTokenLatencyStatistics() const override;
+
     ExecutionState getExecutionState() const override;
 
     std::string getLabel() const override;
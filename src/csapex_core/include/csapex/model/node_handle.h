@@ -16,6 +16,7 @@
 #include <csapex/serialization/serialization_fwd.h>
 
 /// SYSTEM
+#include <atomic>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -24,6 +25,28 @@ namespace csapex
 {
 class CSAPEX_CORE_EXPORT NodeHandle : public NodeModifier, public ConnectableOwner, public std::enable_shared_from_this<NodeHandle>
 {
+public:
+    /**
+     * @brief ParameterPort links a connectable parameter to its input and output.
+     *        The pending flags are raised whenever the parameter changes, so unchanged
+     *        values are neither converted to messages again nor read back from the input.
+     */
+    struct ParameterPort
+    {
+        csapex::param::Parameter* parameter;
+        Input* input;
+        Output* output;
+
+        std::atomic<bool> publish_pending;
+        std::atomic<bool> apply_pending;
+
+        TokenDataConstPtr published;
+        TokenDataConstPtr applied;
+
+        slim_signal::ScopedConnection observer;
+    };
+    typedef std::shared_ptr<ParameterPort> ParameterPortPtr;
+
 public:
     NodeHandle(const std::string& type, const UUID& uuid, NodePtr node, UUIDProviderPtr uuid_provider, InputTransitionPtr transition_in, OutputTransitionPtr transition_out);
     virtual ~NodeHandle();
@@ -110,6 +133,8 @@ public:
     std::unordered_map<UUID, csapex::param::Parameter*, UUID::Hasher>& inputToParamMap();
     std::unordered_map<UUID, csapex::param::Parameter*, UUID::Hasher>& outputToParamMap();
 
+    const std::vector<ParameterPortPtr>& getParameterPorts() const;
+
     bool isIsolated() const;
 
     bool isSource() const override;
@@ -179,7 +204,7 @@ private:
     template <typename T>
     void makeParameterConnectableTyped(csapex::param::ParameterPtr);
 
-    void updateParameterValue(Connectable* source);
+    bool updateParameterValue(Input* source, csapex::param::Parameter* p);
 
 protected:
     mutable std::recursive_mutex sync;
@@ -209,6 +234,8 @@ protected:
     std::unordered_map<UUID, csapex::param::Parameter*, UUID::Hasher> input_2_param_;
     std::unordered_map<UUID, csapex::param::Parameter*, UUID::Hasher> output_2_param_;
 
+    std::vector<ParameterPortPtr> parameter_ports_;
+
 private:
     UUIDProviderWeakPtr uuid_provider_;
 
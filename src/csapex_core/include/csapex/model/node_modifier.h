@@ -241,6 +241,13 @@ public:
 
     void setVariadic(bool variadic);
 
+    /**
+     * @brief setBatchProcessing declares that process() consumes whole batches via msg::getBatch.
+     *        Otherwise incoming batches are unrolled and process() is called once per element.
+     */
+    void setBatchProcessing(bool batch_processing);
+    bool isBatchProcessing() const;
+
     /**
      * Raw construction, handle with care!
      */
@@ -260,6 +267,7 @@ protected:
 
 protected:
     bool variadic_;
+    bool batch_processing_;
 
 private:
     mutable NodeWorker* node_worker_;
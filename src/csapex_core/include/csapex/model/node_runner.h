@@ -48,6 +48,23 @@ public:
 
     void setNodeWorker(NodeWorkerPtr worker);
 
+    /**
+     * @brief setFusedPredecessor declares that this runner is the only consumer of <predecessor>.
+     *        While chain fusion is enabled, this runner is executed directly after its predecessor
+     *        in the same task instead of being queued in the scheduler again.
+     * @param predecessor the runner to follow, an empty pointer disables fusion for this runner
+     */
+    void setFusedPredecessor(NodeRunnerWeakPtr predecessor);
+    NodeRunnerPtr getFusedPredecessor() const;
+
+    /**
+     * @brief getFusedExecutionCount counts how often this runner has been executed as part of its predecessor's task
+     */
+    long getFusedExecutionCount() const;
+
+    static void setChainFusionEnabled(bool enabled);
+    static bool isChainFusionEnabled();
+
 private:
     void connectNodeWorker();
 
@@ -55,6 +72,8 @@ private:
     void scheduleProcess();
     void checkParameters();
     void execute();
+    void executeChain();
+    bool continueFusedChain();
 
 private:
     NodeWorkerPtr worker_;
@@ -82,6 +101,10 @@ private:
     slim_signal::ScopedConnection wait_for_step_connection_;
 
     bool suppress_exceptions_;
+
+    NodeRunnerWeakPtr fused_predecessor_;
+    std::atomic<bool> fused_pending_;
+    std::atomic<long> fused_executions_;
 };
 
 }  // namespace csapex
@@ -11,6 +11,7 @@
 #include <csapex/serialization/serializable.h>
 
 /// SYSTEM
+#include <atomic>
 #include <boost/any.hpp>
 #include <yaml-cpp/yaml.h>
 
@@ -36,6 +37,9 @@ public:
     void writeYaml(YAML::Node& out) const;
     void readYaml(const YAML::Node& node);
 
+    void writeBinary(SerializationBuffer& data) const;
+    void readBinary(const SerializationBuffer& data);
+
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -104,6 +108,12 @@ public:
     GenericStatePtr getParameterState() const;
     void setParameterState(const GenericStatePtr& value);
 
+    /**
+     * @brief getRevision changes whenever any part of the state changes, including the parameters.
+     *        Comparing revisions is cheaper than comparing serialized states.
+     */
+    uint64_t getRevision() const;
+
     bool hasDictionaryEntry(const std::string& key) const;
     void deleteDictionaryEntry(const std::string& key);
 
@@ -153,6 +163,8 @@ private:
 
     ExecutionMode exec_mode_;
     ExecutionType exec_type_;
+
+    std::atomic<uint64_t> revision_;
 };
 
 }  // namespace csapex
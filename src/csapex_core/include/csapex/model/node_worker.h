@@ -17,6 +17,7 @@
 #include <csapex/model/execution_state.h>
 #include <csapex/model/activity_modifier.h>
 #include <csapex/model/parameterizable.h>
+#include <csapex/model/token_latency_statistics.h>
 
 /// SYSTEM
 #include <map>
@@ -61,6 +62,16 @@ public:
     void setProfiling(bool profiling);
     bool isProfiling() const;
 
+    TokenLatencyStatistics getTokenLatencyStatistics() const;
+
+    /**
+     * @brief getProcessingTime accumulates the time spent in process calls
+     * @return micro seconds
+     */
+    long getProcessingTime() const;
+    long getProcessCount() const;
+    void resetTokenLatencyStatistics();
+
     bool isEnabled() const;
     bool isIdle() const;
     bool isProcessing() const;
@@ -105,7 +116,6 @@ private:
 
     void publishParameters();
     void publishParameter(csapex::param::Parameter* p);
-    void publishParameterOn(const csapex::param::Parameter& p, Output* out);
 
     void finishTimer(TimerPtr t);
 
@@ -135,11 +145,17 @@ private:
     connection_types::MarkerMessageConstPtr getFirstMarkerMessage();
     bool processMarker(const connection_types::MarkerMessageConstPtr& marker);
 
+    bool hasIncomingBatch() const;
+    void processBatchElementwise(Node& node);
+    void forwardBatchMarkers(Node& node);
+
     void rememberExecutionMode();
 
     void startProfilerInterval(ActivityType type);
     void stopActiveProfilerInterval();
 
+    void traceMessages(long process_end);
+
 protected:
     mutable std::recursive_mutex sync;
 
@@ -168,6 +184,14 @@ private:
     // TimerPtr profiling_timer_;
     std::shared_ptr<ProfilerImplementation> profiler_;
 
+    long process_start_;
+    std::atomic<long> processing_time_;
+    std::atomic<long> process_count_;
+
+    long trace_dequeued_;
+    mutable std::mutex latency_mutex_;
+    TokenLatencyStatistics latency_statistics_;
+
     long guard_;
 };
 
@@ -0,0 +1,74 @@
+#ifndef SUBGRAPH_BRIDGE_H
+#define SUBGRAPH_BRIDGE_H
+
+/// PROJECT
+#include <csapex/model/model_fwd.h>
+#include <csapex/utility/singleton.hpp>
+#include <csapex/utility/uuid.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace csapex
+{
+/**
+ * @brief SubgraphMessages maps the labels of a subgraph's ports to the messages on them.
+ *        Ports are matched by label, so that a subgraph can be executed by a differently constructed copy of itself.
+ */
+using SubgraphMessages = std::map<std::string, TokenDataConstPtr>;
+
+/**
+ * @brief A SubgraphBridge executes a subgraph somewhere else, e.g. in another process.
+ *        A SubgraphNode with a bridge does not run its nested graph, it hands the messages on its inputs to the bridge
+ *        and publishes the messages that the bridge reports back.
+ */
+class CSAPEX_CORE_EXPORT SubgraphBridge
+{
+public:
+    using Callback = std::function<void(const SubgraphMessages&)>;
+    using ErrorCallback = std::function<void(const std::string&)>;
+
+public:
+    virtual ~SubgraphBridge() = default;
+
+    /**
+     * @brief process starts one pass of the bridged subgraph
+     * @param inputs the messages for the subgraph's inputs
+     * @param done is called with the messages of the subgraph's outputs, possibly from another thread
+     * @param failed is called with a description of the error, if the pass cannot be completed.
+     *        Exactly one of the two callbacks is called, exactly once.
+     */
+    virtual void process(const SubgraphMessages& inputs, Callback done, ErrorCallback failed) = 0;
+};
+
+/**
+ * @brief SubgraphBridgeFactory creates the bridges for subgraphs that are marked as remote in their parameters.
+ *        The core cannot reach other servers by itself, the remote library registers the constructor.
+ */
+class CSAPEX_CORE_EXPORT SubgraphBridgeFactory : public Singleton<SubgraphBridgeFactory>
+{
+public:
+    using Constructor = std::function<SubgraphBridgePtr(const std::string& host, int port, const AUUID& remote_subgraph)>;
+
+public:
+    void setConstructor(Constructor constructor);
+    bool canMakeBridges() const;
+
+    /**
+     * @brief makeBridge connects to the subgraph <remote_subgraph> of the server at <host>:<port>
+     * @throws std::runtime_error if no constructor is registered or the server cannot be reached
+     */
+    SubgraphBridgePtr makeBridge(const std::string& host, int port, const AUUID& remote_subgraph) const;
+
+private:
+    mutable std::recursive_mutex constructor_mutex_;
+    Constructor constructor_;
+};
+
+}  // namespace csapex
+
+#endif  // SUBGRAPH_BRIDGE_H
@@ -3,10 +3,12 @@
 
 /// COMPONENT
 #include <csapex/model/node.h>
+#include <csapex/model/subgraph_bridge.h>
 #include <csapex/model/variadic_io.h>
 #include <csapex/utility/uuid.h>
 
 /// SYSTEM
+#include <atomic>
 #include <unordered_map>
 #include <set>
 
@@ -116,6 +118,27 @@ public:
 
     bool isIterating() const;
 
+    /**
+     * @brief setBridge marks this subgraph as executed elsewhere, its messages are passed to the bridge instead of the nested graph
+     * @param bridge nullptr to execute the nested graph again
+     */
+    void setBridge(SubgraphBridgePtr bridge);
+    SubgraphBridgePtr getBridge() const;
+    bool isBridged() const;
+
+    /**
+     * @brief setDrivenExternally keeps the scheduler from processing this subgraph, while it is used via processExternally
+     */
+    void setDrivenExternally(bool driven_externally);
+    bool isDrivenExternally() const;
+
+    /**
+     * @brief processExternally runs one pass of the nested graph for messages that do not arrive via the external inputs,
+     *        i.e. this is the counterpart of a SubgraphBridge. Iterating containers is not supported here.
+     * @param done is called with the messages of the external outputs, once the nested graph has processed the inputs
+     */
+    void processExternally(const SubgraphMessages& inputs, SubgraphBridge::Callback done);
+
 private:
     UUID addForwardingInput(const UUID& internal_uuid, const TokenDataConstPtr& type, const std::string& label, bool optional);
     UUID addForwardingOutput(const UUID& internal_uuid, const TokenDataConstPtr& type, const std::string& label);
@@ -134,6 +157,10 @@ private:
 
     void startNextIteration();
 
+    void processBridged(const SubgraphBridgePtr& bridge, csapex::NodeModifier& node_modifier, Continuation continuation);
+    void updateRemoteBridge();
+    void sendRelayMessages();
+
 public:
     slim_signal::Signal<void(ConnectorPtr)> forwarding_connector_added;
     slim_signal::Signal<void(ConnectorPtr)> forwarding_connector_removed;
@@ -178,6 +205,11 @@ protected:
     EventPtr deactivation_event_;
 
     long guard_;
+
+    mutable std::recursive_mutex bridge_mutex_;
+    SubgraphBridgePtr bridge_;
+    SubgraphBridgePtr remote_bridge_;
+    std::atomic<bool> is_driven_externally_;
 };
 
 }  // namespace csapex
@@ -19,7 +19,7 @@
 #include <csapex/model/activity_type.h>
 #include <csapex/model/execution_state.h>
 #include <csapex/model/activity_modifier.h>
-#include <csapex/utility/subprocess.h>
+#include <csapex/model/subprocess_pool.h>
 
 /// SYSTEM
 #include <map>
@@ -37,6 +37,8 @@ class Interval;
 
 class CSAPEX_CORE_EXPORT SubprocessNodeWorker : public NodeWorker
 {
+    friend class SubprocessHost;
+
 private:
     using Lock = boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>;
 
@@ -58,7 +60,10 @@ protected:
     void handleChangedParametersImpl(const Parameterizable::ChangedParameterList& changed_params) override;
 
 private:
-    void runSubprocessLoop();
+    SubprocessNodeWorker(NodeHandlePtr node_handle, std::shared_ptr<SubprocessHost> host);
+
+    void prepareSubprocess();
+    void handleSubprocessMessage(const SubprocessChannel::Message& msg);
 
     void handleParameterUpdate(const SubprocessChannel::Message& msg);
 
@@ -70,9 +75,7 @@ private:
     void transmitParameter(const param::ParameterPtr& p);
 
 private:
-    pid_t pid_;
-
-    std::unique_ptr<Subprocess> subprocess_;
+    std::shared_ptr<SubprocessHost> host_;
 
     std::vector<param::Parameter*> changed_parameters_;
 
@@ -0,0 +1,177 @@
+#ifndef SUBPROCESS_POOL_H
+#define SUBPROCESS_POOL_H
+
+/// PROJECT
+#include <csapex/factory/factory_fwd.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/utility/singleton.hpp>
+#include <csapex/utility/subprocess.h>
+#include <csapex/utility/utility_fwd.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+namespace csapex
+{
+class SubprocessNodeWorker;
+
+/**
+ * @brief IsolationGranularity decides which isolated nodes share a worker process
+ */
+enum class IsolationGranularity
+{
+    NODE,   // every node runs in its own process
+    GRAPH,  // all nodes of a graph share a process
+    SHARED  // nodes are distributed over a fixed number of processes
+};
+
+/**
+ * @brief SubprocessHost is a worker process that runs several isolated nodes.
+ *        All nodes share the channels of one Subprocess, messages are prefixed with the UUID of their node.
+ *        A single relay thread reads the results of the child and hands them to the waiting node.
+ *
+ *        The child is a fork of this process and starts with copies of the nodes that were hosted at that time.
+ *        It is forked lazily by the first request and restarted in the same way after it crashed.
+ *        Nodes that are added later are constructed in the running child from their type and state before their first request,
+ *        which requires a node factory. Without one the child has to be forked again once it is idle.
+ *        Messages that are not requests are dropped for nodes the child does not know yet, it receives their current state anyway.
+ */
+class CSAPEX_CORE_EXPORT SubprocessHost : public std::enable_shared_from_this<SubprocessHost>
+{
+public:
+    struct Envelope
+    {
+        SubprocessChannel::MessageType type;
+        std::string payload;
+    };
+
+public:
+    SubprocessHost(const std::string& name_space, NodeFactoryImplementationPtr node_factory = nullptr);
+    ~SubprocessHost();
+
+    void add(SubprocessNodeWorker* worker);
+    void remove(SubprocessNodeWorker* worker);
+    std::size_t getNodeCount() const;
+
+    /**
+     * @brief send writes a message to the counterpart of the worker, requests start the child if necessary
+     */
+    void send(SubprocessNodeWorker* worker, SubprocessChannel::MessageType type, const uint8_t* data, std::size_t length);
+    void send(SubprocessNodeWorker* worker, SubprocessChannel::MessageType type, const std::string& data);
+
+    /**
+     * @brief receive blocks until the child has sent a message to the worker or has crashed
+     */
+    Envelope receive(SubprocessNodeWorker* worker);
+
+    bool isChild() const;
+    bool isRunning() const;
+    int getRestartCount() const;
+    pid_t getChildPid() const;
+
+    void flush();
+
+    /**
+     * @brief readChildStdOut returns the output of the child that has not been read before
+     */
+    std::string readChildStdOut();
+    std::string readChildStdErr();
+
+private:
+    struct Client
+    {
+        SubprocessNodeWorker* worker;
+        std::deque<Envelope> inbox;
+        bool waiting;
+    };
+
+    bool isBusy() const;
+
+    /**
+     * @brief ensureRunning starts the child if necessary, returns true if the worker has to be introduced to the running child
+     */
+    bool ensureRunning(std::unique_lock<std::recursive_mutex>& lock, SubprocessNodeWorker* worker);
+    void start();
+    void stop(std::unique_lock<std::recursive_mutex>& lock);
+
+    void runChild();
+    void adopt(const std::string& client, const std::string& payload);
+    void relay(std::shared_ptr<Subprocess> subprocess);
+
+private:
+    std::string name_space_;
+    NodeFactoryImplementationPtr node_factory_;
+
+    mutable std::recursive_mutex mutex_;
+    std::condition_variable_any changed_;
+
+    std::map<std::string, Client> clients_;
+    std::set<SubprocessNodeWorker*> forked_workers_;
+
+    // only used by the child: the nodes that were constructed after the fork
+    std::vector<NodeFacadeImplementationPtr> adopted_nodes_;
+    UUIDProviderPtr adopted_uuid_provider_;
+
+    std::shared_ptr<Subprocess> subprocess_;
+    pid_t child_pid_;
+    std::thread relay_thread_;
+    bool running_;
+    bool starting_;
+    bool is_child_;
+    int restarts_;
+
+    std::size_t cout_offset_;
+    std::size_t cerr_offset_;
+};
+
+/**
+ * @brief SubprocessPool assigns isolated nodes to worker processes according to the configured granularity
+ */
+class CSAPEX_CORE_EXPORT SubprocessPool : public Singleton<SubprocessPool>
+{
+    friend class Singleton<SubprocessPool>;
+
+public:
+    static IsolationGranularity parseGranularity(const std::string& name);
+
+    void setGranularity(IsolationGranularity granularity);
+    IsolationGranularity getGranularity() const;
+
+    /**
+     * @brief setWorkerCount limits the number of processes that are used with IsolationGranularity::SHARED
+     */
+    void setWorkerCount(std::size_t count);
+    std::size_t getWorkerCount() const;
+
+    /**
+     * @brief setNodeFactory allows new processes to construct nodes that are added after they were started
+     */
+    void setNodeFactory(NodeFactoryImplementationPtr node_factory);
+
+    std::shared_ptr<SubprocessHost> acquire(const NodeHandle& node_handle);
+
+private:
+    SubprocessPool();
+
+private:
+    mutable std::mutex mutex_;
+    IsolationGranularity granularity_;
+    std::size_t worker_count_;
+    std::weak_ptr<NodeFactoryImplementation> node_factory_;
+
+    std::map<std::string, std::weak_ptr<SubprocessHost>> hosts_;
+};
+
+}  // namespace csapex
+
+#endif  // SUBPROCESS_POOL_H
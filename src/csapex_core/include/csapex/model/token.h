@@ -8,6 +8,7 @@
 #include <csapex/msg/token_traits.h>
 #include <csapex_core/csapex_core_export.h>
 #include <csapex/model/activity_modifier.h>
+#include <csapex/model/token_provenance.h>
 
 namespace csapex
 {
@@ -31,8 +32,20 @@ public:
     int getSequenceNumber() const;
     void setSequenceNumber(int seq_no_) const;
 
+    /**
+     * @brief getProvenance returns the latency trace of this token
+     * @return nullptr, unless latency tracing is enabled (see TokenProvenance::setTracingEnabled)
+     */
+    TokenProvenanceConstPtr getProvenance() const;
+    void setProvenance(const TokenProvenanceConstPtr& provenance);
+
     virtual void cloneData(const Token& other);
 
+    /**
+     * @brief makeShallowCopy copies the token, but shares the payload instead of cloning it
+     */
+    Ptr makeShallowCopy() const;
+
     static Ptr makeEmpty();
 
 private:
@@ -44,6 +57,8 @@ private:
     ActivityModifier activity_modifier_;
 
     mutable int seq_no_;
+
+    TokenProvenanceConstPtr provenance_;
 };
 
 }  // namespace csapex
@@ -19,6 +19,21 @@ public:
     typedef std::shared_ptr<TokenData> Ptr;
     typedef std::shared_ptr<const TokenData> ConstPtr;
 
+    /**
+     * Kind tags of the special message types, assigned once by their constructors.
+     * They allow classifying tokens on hot paths without RTTI.
+     */
+    enum Kind : uint8_t
+    {
+        KIND_DATA = 0,
+        KIND_MARKER = 1 << 0,
+        KIND_NO_MESSAGE = 1 << 1,
+        KIND_END_OF_SEQUENCE = 1 << 2,
+        KIND_END_OF_PROGRAM = 1 << 3,
+        KIND_ANY = 1 << 4,
+        KIND_BATCH = 1 << 5
+    };
+
 public:
     TokenData(const std::string& type_name);
     TokenData(const std::string& type_name, const std::string& descriptive_name);
@@ -28,6 +43,44 @@ public:
 
     virtual bool isValid() const;
 
+    /**
+     * @brief getByteSize approximates the memory owned by this token, it is used for memory accounting (see TokenMemoryTracker).
+     *        Message types owning large buffers should override this, the default only counts the base object.
+     */
+    virtual std::size_t getByteSize() const;
+
+    inline uint8_t getKind() const
+    {
+        return kind_;
+    }
+    inline bool isMarker() const
+    {
+        return kind_ & KIND_MARKER;
+    }
+    inline bool isNoMessage() const
+    {
+        return kind_ & KIND_NO_MESSAGE;
+    }
+    /**
+     * @brief isEndOfSequence is also true for EndOfProgram markers
+     */
+    inline bool isEndOfSequence() const
+    {
+        return kind_ & KIND_END_OF_SEQUENCE;
+    }
+    inline bool isEndOfProgram() const
+    {
+        return kind_ & KIND_END_OF_PROGRAM;
+    }
+    inline bool isAny() const
+    {
+        return kind_ & KIND_ANY;
+    }
+    inline bool isBatch() const
+    {
+        return kind_ & KIND_BATCH;
+    }
+
     virtual bool isContainer() const;
     virtual Ptr nestedType() const;
     virtual ConstPtr nestedValue(std::size_t i) const;
@@ -50,10 +103,13 @@ public:
 protected:
     TokenData();
     void setDescriptiveName(const std::string& descriptiveName);
+    void addKind(Kind kind);
 
 private:
     std::string type_name_;
     std::string descriptive_name_;
+
+    uint8_t kind_;
 };
 
 }  // namespace csapex
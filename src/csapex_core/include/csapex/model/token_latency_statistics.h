@@ -0,0 +1,75 @@
+#ifndef TOKEN_LATENCY_STATISTICS_H
+#define TOKEN_LATENCY_STATISTICS_H
+
+/// PROJECT
+#include <csapex/serialization/serializable.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <map>
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+class TokenProvenance;
+
+/**
+ * @brief TokenLatencyStatistics aggregates the end-to-end latency of traced tokens per path.
+ *        A path is the sequence of nodes a token has passed from its origin to the recording node.
+ *        Latencies are collected in logarithmic histograms, bucket i counts latencies in [2^i, 2^(i+1)) us.
+ */
+class CSAPEX_CORE_EXPORT TokenLatencyStatistics : public Serializable
+{
+protected:
+    CLONABLE_IMPLEMENTATION(TokenLatencyStatistics);
+
+public:
+    static const std::size_t BUCKETS = 40;
+
+    struct Path
+    {
+        Path();
+
+        std::vector<std::string> nodes;
+
+        uint64_t count;
+        int64_t latency_sum;
+        int64_t latency_max;
+        int64_t queued_sum;
+        int64_t processing_sum;
+
+        std::vector<uint64_t> histogram;
+
+        double getMeanLatency() const;
+        double getMeanQueuedTime() const;
+        double getMeanProcessingTime() const;
+
+        /**
+         * @brief getPercentile approximates the latency percentile from the histogram.
+         * @param p in [0, 1]
+         * @return the upper bound of the bucket containing the percentile in micro seconds
+         */
+        int64_t getPercentile(double p) const;
+    };
+
+public:
+    TokenLatencyStatistics();
+
+    void record(const TokenProvenance& provenance);
+    void clear();
+
+    bool empty() const;
+
+    const std::map<std::string, Path>& getPaths() const;
+
+    void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+private:
+    std::map<std::string, Path> paths_;
+};
+
+}  // namespace csapex
+
+#endif  // TOKEN_LATENCY_STATISTICS_H
@@ -0,0 +1,157 @@
+#ifndef TOKEN_MEMORY_H
+#define TOKEN_MEMORY_H
+
+/// PROJECT
+#include <csapex/model/model_fwd.h>
+#include <csapex/serialization/serializable.h>
+#include <csapex/utility/singleton.hpp>
+#include <csapex/utility/uuid.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace csapex
+{
+/**
+ * @brief TokenMemoryStatistics is a snapshot of the token payloads that are currently held by outputs and connections.
+ *        The total and the types count every payload object once, outputs, nodes and connections count every payload they hold.
+ *        Connections store a copy of each token they transport, so a message sent over n connections is n + 1 payloads.
+ */
+class CSAPEX_CORE_EXPORT TokenMemoryStatistics : public Serializable
+{
+protected:
+    CLONABLE_IMPLEMENTATION(TokenMemoryStatistics);
+
+public:
+    struct Usage
+    {
+        Usage();
+
+        uint64_t count;
+        uint64_t bytes;
+    };
+
+    typedef std::map<std::string, Usage> UsageMap;
+
+public:
+    TokenMemoryStatistics();
+
+    bool empty() const;
+
+    const Usage& getTotal() const;
+
+    const UsageMap& getTypes() const;
+    const UsageMap& getOutputs() const;
+    const UsageMap& getNodes() const;
+    const UsageMap& getConnections() const;
+
+    /**
+     * @return the payloads held by the outputs of the node, empty if the node holds none
+     */
+    Usage getNodeUsage(const UUID& node) const;
+
+    void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+private:
+    friend class TokenMemoryTracker;
+
+    Usage total_;
+
+    UsageMap types_;
+    UsageMap outputs_;
+    UsageMap nodes_;
+    UsageMap connections_;
+};
+
+/**
+ * @brief TokenMemoryTracker aggregates the memory of live token payloads while accounting is enabled.
+ *        Accounting is opt-in, holders of tokens take a TokenMemoryLease that does nothing while it is disabled.
+ */
+class CSAPEX_CORE_EXPORT TokenMemoryTracker : public Singleton<TokenMemoryTracker>
+{
+    friend class Singleton<TokenMemoryTracker>;
+    friend class TokenMemoryLease;
+
+public:
+    static bool isAccountingEnabled();
+    static void setAccountingEnabled(bool enabled);
+
+    TokenMemoryStatistics getStatistics() const;
+    TokenMemoryStatistics::Usage getNodeUsage(const UUID& node) const;
+
+private:
+    TokenMemoryTracker();
+
+    std::size_t acquire(const TokenDataConstPtr& data);
+    void release(const TokenDataConstPtr& data);
+
+    void add(TokenMemoryStatistics::UsageMap& map, const std::string& key, std::size_t bytes);
+    void remove(TokenMemoryStatistics::UsageMap& map, const std::string& key, std::size_t bytes);
+
+    void addOutput(const std::string& output, const std::string& node, std::size_t bytes);
+    void removeOutput(const std::string& output, const std::string& node, std::size_t bytes);
+    void addConnection(const std::string& connection, std::size_t bytes);
+    void removeConnection(const std::string& connection, std::size_t bytes);
+
+private:
+    struct Payload
+    {
+        std::size_t leases;
+        std::size_t bytes;
+        std::string type;
+    };
+
+    mutable std::mutex mutex_;
+
+    std::unordered_map<const TokenData*, Payload> payloads_;
+    TokenMemoryStatistics statistics_;
+};
+
+/**
+ * @brief TokenMemoryLease accounts the payload of one token for the place holding it.
+ *        The holder updates the lease whenever it stores or drops a token, the lease keeps the payload alive until then.
+ */
+class CSAPEX_CORE_EXPORT TokenMemoryLease
+{
+public:
+    TokenMemoryLease();
+    ~TokenMemoryLease();
+
+    TokenMemoryLease(const TokenMemoryLease&) = delete;
+    TokenMemoryLease& operator=(const TokenMemoryLease&) = delete;
+
+    void holdForOutput(const UUID& output, const TokenPtr& token);
+    void holdForConnection(const std::string& connection, const TokenPtr& token);
+
+    void release();
+
+    bool isHeld() const;
+
+private:
+    bool holds(const TokenPtr& token) const;
+    bool acquire(const TokenPtr& token);
+
+private:
+    enum class Holder
+    {
+        NONE,
+        OUTPUT,
+        CONNECTION
+    };
+
+    Holder holder_;
+    std::string site_;
+    std::string node_;
+
+    TokenDataConstPtr data_;
+    std::size_t bytes_;
+};
+
+}  // namespace csapex
+
+#endif  // TOKEN_MEMORY_H
@@ -0,0 +1,59 @@
+#ifndef TOKEN_PROVENANCE_H
+#define TOKEN_PROVENANCE_H
+
+/// PROJECT
+#include <csapex/utility/uuid.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <memory>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief TokenHop records the time stamps of a token passing through a single node.
+ *        All stamps are steady clock micro seconds, 0 means "not recorded".
+ */
+struct TokenHop
+{
+    TokenHop();
+    explicit TokenHop(const UUID& node);
+
+    UUID node;
+
+    long enqueued;
+    long dequeued;
+    long process_start;
+    long process_end;
+};
+
+/**
+ * @brief TokenProvenance is the optional trace attached to a token while latency tracing is enabled.
+ *        It lists all hops from the originating node up to the receiver of the token.
+ *        Provenances are shared between clones of a token and must not be modified once attached,
+ *        appending a hop creates a copy (see Connection::setToken).
+ */
+class CSAPEX_CORE_EXPORT TokenProvenance
+{
+public:
+    static bool isTracingEnabled();
+    static void setTracingEnabled(bool enabled);
+
+    static long now();
+
+public:
+    long getOrigin() const;
+    long getQueuedTime() const;
+    long getProcessingTime() const;
+
+public:
+    std::vector<TokenHop> hops;
+};
+
+typedef std::shared_ptr<TokenProvenance> TokenProvenancePtr;
+typedef std::shared_ptr<TokenProvenance const> TokenProvenanceConstPtr;
+
+}  // namespace csapex
+
+#endif  // TOKEN_PROVENANCE_H
@@ -0,0 +1,233 @@
+#ifndef BATCH_MESSAGE_H
+#define BATCH_MESSAGE_H
+
+/// COMPONENT
+#include <csapex/msg/message.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/io.h>
+#include <csapex/utility/assert.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <vector>
+
+namespace csapex
+{
+namespace connection_types
+{
+/**
+ * @brief BatchMessage bundles several messages of the same type into a single token,
+ *        so that the per token overhead of connections and transitions is paid once per batch.
+ *        Only nodes that opt in via NodeModifier::setBatchProcessing ever see a batch,
+ *        all other nodes are called once per element by their NodeWorker.
+ *        Markers keep their position in the stream as elements of the batch.
+ */
+struct CSAPEX_CORE_EXPORT BatchMessage : public Message
+{
+protected:
+    CLONABLE_IMPLEMENTATION(BatchMessage);
+
+public:
+    typedef std::shared_ptr<BatchMessage> Ptr;
+    typedef std::shared_ptr<BatchMessage const> ConstPtr;
+
+public:
+    BatchMessage();
+
+    std::size_t size() const;
+    bool empty() const;
+
+    bool containsMarkers() const;
+
+    void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+    void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+public:
+    std::vector<TokenDataConstPtr> elements;
+};
+
+template <>
+struct type<BatchMessage>
+{
+    static std::string name()
+    {
+        return "Batch";
+    }
+};
+
+}  // namespace connection_types
+
+namespace msg
+{
+namespace impl
+{
+template <typename T, typename Enable = void>
+struct BatchElement
+{
+    static bool matches(const TokenData& data)
+    {
+        return dynamic_cast<const T*>(&data) != nullptr;
+    }
+    static const T& get(const TokenData& data)
+    {
+        return static_cast<const T&>(data);
+    }
+};
+
+template <typename T>
+struct BatchElement<T, typename std::enable_if<connection_types::should_use_value_message<T>::value>::type>
+{
+    static bool matches(const TokenData& data)
+    {
+        return dynamic_cast<const connection_types::GenericValueMessage<T>*>(&data) != nullptr;
+    }
+    static const T& get(const TokenData& data)
+    {
+        return static_cast<const connection_types::GenericValueMessage<T>&>(data).value;
+    }
+};
+}  // namespace impl
+
+/**
+ * @brief BatchView is a read only range over the elements received on an input.
+ *        A single message is viewed as a batch of size one, markers are not part of the view.
+ */
+template <typename T>
+class BatchView
+{
+public:
+    typedef std::vector<TokenDataConstPtr> Elements;
+
+    class const_iterator
+    {
+    public:
+        explicit const_iterator(Elements::const_iterator it) : it_(it)
+        {
+        }
+
+        const T& operator*() const
+        {
+            return impl::BatchElement<T>::get(**it_);
+        }
+        const_iterator& operator++()
+        {
+            ++it_;
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const
+        {
+            return it_ == other.it_;
+        }
+        bool operator!=(const const_iterator& other) const
+        {
+            return it_ != other.it_;
+        }
+
+    private:
+        Elements::const_iterator it_;
+    };
+
+public:
+    BatchView() : elements_(std::make_shared<Elements>())
+    {
+    }
+    explicit BatchView(const std::shared_ptr<const Elements>& elements) : elements_(elements)
+    {
+    }
+
+    std::size_t size() const
+    {
+        return elements_->size();
+    }
+    bool empty() const
+    {
+        return elements_->empty();
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        return impl::BatchElement<T>::get(*(*elements_)[i]);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(elements_->begin());
+    }
+    const_iterator end() const
+    {
+        return const_iterator(elements_->end());
+    }
+
+private:
+    std::shared_ptr<const Elements> elements_;
+};
+
+template <typename T>
+BatchView<T> getBatch(Input* input)
+{
+    if (!hasMessage(input)) {
+        return BatchView<T>();
+    }
+
+    TokenDataConstPtr data = getMessage(input);
+    if (data->isBatch()) {
+        auto batch = std::static_pointer_cast<connection_types::BatchMessage const>(data);
+        if (batch->containsMarkers()) {
+            auto messages = std::make_shared<typename BatchView<T>::Elements>();
+            for (const TokenDataConstPtr& element : batch->elements) {
+                if (!element->isMarker()) {
+                    messages->push_back(element);
+                }
+            }
+            apex_assert_hard_msg(messages->empty() || impl::BatchElement<T>::matches(*messages->front()), "the received batch has an unexpected element type");
+            return BatchView<T>(messages);
+        }
+        apex_assert_hard_msg(batch->empty() || impl::BatchElement<T>::matches(*batch->elements.front()), "the received batch has an unexpected element type");
+        return BatchView<T>(std::shared_ptr<const typename BatchView<T>::Elements>(batch, &batch->elements));
+    }
+
+    apex_assert_hard_msg(impl::BatchElement<T>::matches(*data), "the received message has an unexpected type");
+    return BatchView<T>(std::make_shared<typename BatchView<T>::Elements>(1, data));
+}
+
+template <typename T, typename = typename std::enable_if<connection_types::should_use_value_message<T>::value>::type>
+void publishBatch(Output* output, const std::vector<T>& values, std::string frame_id = "/")
+{
+    if (values.empty()) {
+        return;
+    }
+    auto batch = std::make_shared<connection_types::BatchMessage>();
+    batch->elements.reserve(values.size());
+    for (const T& value : values) {
+        batch->elements.push_back(std::make_shared<connection_types::GenericValueMessage<T>>(value, frame_id));
+    }
+    publish(output, batch);
+}
+
+template <typename M, typename = typename std::enable_if<std::is_base_of<TokenData, M>::value>::type>
+void publishBatch(Output* output, const std::vector<std::shared_ptr<M>>& messages)
+{
+    if (messages.empty()) {
+        return;
+    }
+    auto batch = std::make_shared<connection_types::BatchMessage>();
+    batch->elements.assign(messages.begin(), messages.end());
+    publish(output, batch);
+}
+
+}  // namespace msg
+}  // namespace csapex
+
+/// YAML
+namespace YAML
+{
+template <>
+struct CSAPEX_CORE_EXPORT convert<csapex::connection_types::BatchMessage>
+{
+    static Node encode(const csapex::connection_types::BatchMessage& rhs);
+    static bool decode(const Node& node, csapex::connection_types::BatchMessage& rhs);
+};
+
+}  // namespace YAML
+
+#endif  // BATCH_MESSAGE_H
@@ -0,0 +1,24 @@
+#ifndef CONNECTION_FACTORY_H
+#define CONNECTION_FACTORY_H
+
+/// PROJECT
+#include <csapex/model/connection_description.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/msg/msg_fwd.h>
+#include <csapex_core/csapex_core_export.h>
+
+namespace csapex
+{
+namespace connection_factory
+{
+/**
+ * @brief connect creates the connection class that implements the given policy
+ * @return nullptr, if the connectors cannot be connected
+ */
+CSAPEX_CORE_EXPORT ConnectionPtr connect(OutputPtr from, InputPtr to, ConnectionPolicy policy);
+CSAPEX_CORE_EXPORT ConnectionPtr connect(OutputPtr from, InputPtr to, int id, ConnectionPolicy policy);
+}  // namespace connection_factory
+
+}  // namespace csapex
+
+#endif  // CONNECTION_FACTORY_H
@@ -7,6 +7,7 @@
 #include <csapex/serialization/message_serializer.h>
 #include <csapex/msg/io.h>
 #include <csapex/utility/string.hpp>
+#include <csapex/utility/byte_size.hpp>
 
 // TODO remove
 #include <iostream>
@@ -65,6 +66,11 @@ public:
         return value;
     }
 
+    std::size_t getByteSize() const override
+    {
+        return sizeof(*this) + heapSizeOf(value) + frame_id.capacity();
+    }
+
     constexpr bool isArithmetic() const override
     {
         return std::is_arithmetic<Type>::value;
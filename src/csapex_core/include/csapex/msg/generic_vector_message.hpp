@@ -9,8 +9,10 @@
 #include <csapex/msg/generic_value_message.hpp>
 #include <csapex/msg/generic_pointer_message.hpp>
 #include <csapex/serialization/yaml.h>
+#include <csapex/serialization/io/bulk_io.h>
 #include <csapex/serialization/io/std_io.h>
 #include <csapex/utility/assert.h>
+#include <csapex/utility/semantic_version.h>
 
 /// SYSTEM
 #include <string>
@@ -134,6 +136,17 @@ private:
             node["values"] = *value;
         }
 
+        void serialize(SerializationBuffer& data, SemanticVersion& version) const override
+        {
+            EntryInterface::serialize(data, version);
+            serializePayload(data, version);
+        }
+        void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override
+        {
+            EntryInterface::deserialize(data, version);
+            deserializePayload(data, version);
+        }
+
         void decode(const YAML::Node& node) override
         {
             YAML::Emitter emitter;
@@ -290,6 +303,32 @@ private:
             return csapex::makeEmpty<typename std::remove_const<MsgType>::type>();
         }
 
+    private:
+        // version 1.0.0: vectors of trivially copyable elements are written as one block, older versions carry no payload
+        template <typename P = Payload>
+        void serializePayload(SerializationBuffer& data, SemanticVersion& version, typename std::enable_if<bulk_serialization_traits<P>::value>::type* = 0) const
+        {
+            version = SemanticVersion(1, 0, 0);
+            writeBulk(data, *value);
+        }
+        template <typename P = Payload>
+        void serializePayload(SerializationBuffer& /*data*/, SemanticVersion& /*version*/, typename std::enable_if<!bulk_serialization_traits<P>::value>::type* = 0) const
+        {
+        }
+
+        template <typename P = Payload>
+        void deserializePayload(const SerializationBuffer& data, const SemanticVersion& version, typename std::enable_if<bulk_serialization_traits<P>::value>::type* = 0)
+        {
+            value.reset(new std::vector<Payload>);
+            if (version.major_v >= 1) {
+                readBulk(data, *value);
+            }
+        }
+        template <typename P = Payload>
+        void deserializePayload(const SerializationBuffer& /*data*/, const SemanticVersion& /*version*/, typename std::enable_if<!bulk_serialization_traits<P>::value>::type* = 0)
+        {
+        }
+
     public:
         std::shared_ptr<std::vector<Payload>> value;
     };
@@ -467,11 +506,11 @@ public:
         static EntryInterface::Ptr make(const std::string& type)
         {
             const std::string ns = "csapex::connection_types::";
-            std::string ns_type = type;
-            if (type.find(ns) == std::string::npos) {
-                ns_type = ns + type;
+            auto pos = instance().map_.find(type);
+            if (pos == instance().map_.end() && type.find(ns) == std::string::npos) {
+                // message types might be stored without namespace
+                pos = instance().map_.find(ns + type);
             }
-            auto pos = instance().map_.find(ns_type);
             if (pos == instance().map_.end()) {
                 throw std::runtime_error(std::string("cannot make vector of type ") + type);
             }
@@ -34,6 +34,12 @@ public:
     virtual void setToken(TokenPtr message);
     virtual TokenPtr getToken() const;
 
+    /**
+     * @brief replaceToken exchanges the current token without counting it as a received message
+     *        and without notifying observers, e.g. to present the elements of a batch one at a time
+     */
+    void replaceToken(TokenPtr message);
+
     OutputPtr getSource() const;
 
     virtual void removeAllConnectionsNotUndoable() override;
@@ -31,6 +31,7 @@ public:
 
     void forwardMessages();
     bool areMessagesForwarded() const;
+    bool hasForwardedBatch() const;
     bool areMessagesProcessed() const;
     bool areMessagesComplete() const;
 
@@ -55,6 +56,7 @@ private:
 
     bool forwarded_;
     bool processed_;
+    bool has_batch_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,58 @@
+#ifndef LATEST_VALUE_CONNECTION_H
+#define LATEST_VALUE_CONNECTION_H
+
+/// PROJECT
+#include <csapex/model/connection.h>
+
+/// SYSTEM
+#include <atomic>
+#include <deque>
+
+namespace csapex
+{
+/**
+ * @brief LatestValueConnection never blocks its output, a producer can always send the next token.
+ *        A value that was not read by the input yet is replaced by a newer one, so the input always
+ *        receives the freshest data. Markers are never dropped and keep their order relative to the values,
+ *        which keeps the sequence numbers seen by the input increasing.
+ */
+class CSAPEX_CORE_EXPORT LatestValueConnection : public Connection
+{
+public:
+    static ConnectionPtr connect(OutputPtr from, InputPtr to);
+    static ConnectionPtr connect(OutputPtr from, InputPtr to, int id);
+
+public:
+    ~LatestValueConnection();
+
+    void setToken(const TokenPtr& msg) override;
+
+    ConnectionPolicy getPolicy() const override;
+    State getSourceState() const override;
+
+    void reset() override;
+
+    /**
+     * @brief getDroppedCount counts the tokens that were replaced before the input could read them
+     */
+    long getDroppedCount() const;
+
+protected:
+    LatestValueConnection(OutputPtr from, InputPtr to);
+    LatestValueConnection(OutputPtr from, InputPtr to, int id);
+
+    void notifyMessageProcessed() override;
+
+private:
+    void deliverPending();
+
+private:
+    std::deque<TokenPtr> pending_;
+    bool delivering_;
+
+    std::atomic<long> dropped_;
+};
+
+}  // namespace csapex
+
+#endif  // LATEST_VALUE_CONNECTION_H
@@ -0,0 +1,58 @@
+#ifndef MESSAGE_LOG_PROVIDER_H
+#define MESSAGE_LOG_PROVIDER_H
+
+/// COMPONENT
+#include <csapex/msg/message_provider.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <chrono>
+
+namespace csapex
+{
+class MessageLogReader;
+
+/**
+ * @brief MessageLogProvider plays back a message log, either at the rate it was recorded at
+ *        or as fast as the graph can consume the messages. The position parameter seeks.
+ * @see MessageLogWriter, MessageRecorder
+ */
+class CSAPEX_CORE_EXPORT MessageLogProvider : public MessageProvider
+{
+public:
+    static std::shared_ptr<MessageProvider> make();
+
+public:
+    MessageLogProvider();
+    ~MessageLogProvider();
+
+    void load(const std::string& file) override;
+    void parameterChanged() override;
+
+    virtual bool hasNext() override;
+    virtual connection_types::Message::Ptr next(std::size_t slot) override;
+
+    virtual void restart() override;
+
+    virtual std::vector<std::string> getExtensions() const override;
+
+    virtual GenericStatePtr getState() const override;
+    virtual void setParameterState(GenericStatePtr memento) override;
+
+    void seek(std::size_t index);
+    std::size_t getPosition() const;
+    std::size_t count() const;
+
+private:
+    std::unique_ptr<MessageLogReader> reader_;
+
+    std::size_t position_;
+    int requested_position_;
+
+    std::chrono::steady_clock::time_point playback_start_;
+    int64_t stamp_start_;
+};
+
+}  // namespace csapex
+
+#endif  // MESSAGE_LOG_PROVIDER_H
@@ -7,6 +7,7 @@
 #include <csapex/msg/io.h>
 #include <csapex/serialization/serialization_buffer.h>
 #include <csapex/serialization/io/csapex_io.h>
+#include <csapex/utility/byte_size.hpp>
 
 /// SYSTEM
 #include <type_traits>
@@ -153,6 +154,11 @@ public:
         return ValueContainer::acceptsConnectionFrom(other_side);
     }
 
+    std::size_t getByteSize() const override
+    {
+        return sizeof(Instance) + heapSizeOf(ValueContainer::value) + frame_id.capacity();
+    }
+
     void serialize(SerializationBuffer& data, SemanticVersion& version) const override
     {
         // TODO: ValueContainer should provide a version here!
@@ -22,6 +22,7 @@ FWD(OutputTransition)
 FWD(MessageProvider)
 FWD(MessageRenderer)
 FWD(MessageAllocator)
+FWD(OutputTap)
 
 namespace connection_types
 {
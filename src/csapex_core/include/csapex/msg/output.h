@@ -69,6 +69,10 @@ public:
 
     std::vector<ConnectionPtr> getConnections() const;
 
+    bool addTap(const OutputTapPtr& tap) override;
+    void removeTap(const OutputTapPtr& tap) override;
+    bool hasTaps() const;
+
     virtual bool hasMessage() = 0;
     virtual bool hasMarkerMessage() = 0;
 
@@ -83,10 +87,17 @@ public:
 protected:
     virtual void addStatusInformation(std::stringstream& status_stream) const override;
 
+    void offerToTaps(const TokenPtr& token);
+
 protected:
     OutputTransition* transition_;
 
     State state_;
+
+private:
+    mutable std::mutex taps_mutex_;
+    std::vector<OutputTapWeakPtr> taps_;
+    std::atomic<bool> has_taps_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,72 @@
+#ifndef OUTPUT_TAP_H
+#define OUTPUT_TAP_H
+
+/// COMPONENT
+#include <csapex/model/model_fwd.h>
+#include <csapex/msg/msg_fwd.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace csapex
+{
+/**
+ * @brief OutputTap observes the tokens published by an output without taking part in the
+ *        connection protocol. The producer never waits for a tap: tokens are handed over
+ *        without copying, at most max_frequency times per second, and only the latest token
+ *        is kept while the callback is still busy with an earlier one. Everything else is dropped.
+ *
+ *        The callback is invoked on a thread owned by the tap.
+ *        Destroying the tap detaches it from the output, this must not happen from within the callback.
+ */
+class CSAPEX_CORE_EXPORT OutputTap
+{
+public:
+    typedef std::function<void(const TokenConstPtr&)> Callback;
+
+    OutputTap(Callback callback, double max_frequency = 30.0);
+    ~OutputTap();
+
+    OutputTap(const OutputTap&) = delete;
+    OutputTap& operator=(const OutputTap&) = delete;
+
+    /**
+     * @brief offer passes a published token to the tap, never blocks
+     * @return true, iff the token was accepted for delivery
+     */
+    bool offer(const TokenConstPtr& token);
+
+    void setMaximumFrequency(double max_frequency);
+    double getMaximumFrequency() const;
+
+    long getDeliveredCount() const;
+    long getDroppedCount() const;
+
+private:
+    void deliveryLoop();
+
+private:
+    Callback callback_;
+
+    std::atomic<long> min_period_;
+    long last_accepted_;
+
+    std::atomic<long> delivered_;
+    std::atomic<long> dropped_;
+
+    std::mutex mutex_;
+    std::condition_variable pending_changed_;
+    TokenConstPtr pending_;
+    bool running_;
+
+    std::thread delivery_thread_;
+};
+
+}  // namespace csapex
+
+#endif  // OUTPUT_TAP_H
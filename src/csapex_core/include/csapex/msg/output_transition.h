@@ -43,6 +43,9 @@ public:
 public:
     slim_signal::Signal<void()> messages_processed;
 
+protected:
+    Connection::State getConnectionState(const ConnectionPtr& connection) const override;
+
 private:
     void fillConnections();
 
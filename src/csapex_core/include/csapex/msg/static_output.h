@@ -3,6 +3,7 @@
 
 /// COMPONENT
 #include <csapex/msg/output.h>
+#include <csapex/model/token_memory.h>
 
 namespace csapex
 {
@@ -26,11 +27,17 @@ public:
 
     TokenPtr getAddedToken() override;
 
+private:
+    void updateMemoryLeases();
+
 private:
     TokenPtr message_to_send_;
 
     mutable std::recursive_mutex message_mutex_;
     TokenPtr committed_message_;
+
+    TokenMemoryLease message_to_send_memory_;
+    TokenMemoryLease committed_message_memory_;
 };
 }  // namespace csapex
 
@@ -50,6 +50,8 @@ protected:
     virtual void connectionAdded(Connection* connection);
     virtual void connectionRemoved(Connection* connection);
 
+    virtual Connection::State getConnectionState(const ConnectionPtr& connection) const;
+
     void trackConnection(Connection* connection, const slim_signal::Connection& c);
 
 protected:
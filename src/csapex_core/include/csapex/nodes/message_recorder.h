@@ -0,0 +1,49 @@
+#ifndef MESSAGE_RECORDER_H
+#define MESSAGE_RECORDER_H
+
+/// PROJECT
+#include <csapex/model/node.h>
+
+/// SYSTEM
+#include <memory>
+#include <mutex>
+
+namespace csapex
+{
+class MessageLogWriter;
+
+/**
+ * @brief MessageRecorder appends every received message to a message log,
+ *        which can be played back with the MessageLogProvider.
+ */
+class CSAPEX_CORE_EXPORT MessageRecorder : public Node
+{
+public:
+    MessageRecorder();
+    ~MessageRecorder();
+
+    void setup(csapex::NodeModifier& node_modifier) override;
+    void setupParameters(Parameterizable& parameters) override;
+    void process(csapex::NodeModifier& node_modifier, csapex::Parameterizable& parameters) override;
+    void tearDown() override;
+
+    std::size_t getRecordedCount() const;
+
+private:
+    void close();
+
+private:
+    Input* in_;
+
+    std::string path_;
+    bool recording_;
+
+    mutable std::recursive_mutex writer_mutex_;
+    std::unique_ptr<MessageLogWriter> writer_;
+    int64_t stamp_offset_;
+    std::size_t recorded_;
+};
+
+}  // namespace csapex
+
+#endif  // MESSAGE_RECORDER_H
@@ -48,6 +48,14 @@ public:
     void setActive(bool active);
     bool isActive() const;
 
+    /**
+     * @brief setValue attaches a measurement that is not a duration, e.g. the memory a node holds after processing
+     */
+    void setValue(const std::string& name, double value);
+    const std::map<std::string, double>& getValues() const;
+
+    virtual SemanticVersion getVersion() const override;
+
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -67,6 +75,8 @@ private:
 
     bool active_;
     bool stopped_;
+
+    std::map<std::string, double> values_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,120 @@
+#ifndef AUTO_PARTITIONER_H
+#define AUTO_PARTITIONER_H
+
+/// PROJECT
+#include <csapex/command/command_fwd.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex/utility/slim_signal.hpp>
+#include <csapex/utility/uuid.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+struct CSAPEX_CORE_EXPORT PartitionReport
+{
+    PartitionReport();
+
+    /**
+     * load of each partition as a fraction of the analyzed time window,
+     * or in number of nodes if no processing time has been measured yet
+     */
+    std::vector<double> group_load;
+    std::vector<std::size_t> group_size;
+
+    std::size_t cut_edges;
+    std::size_t total_edges;
+    std::size_t moved_nodes;
+
+    /**
+     * imbalance is the load of the busiest partition divided by the mean load
+     */
+    double imbalance;
+};
+
+CSAPEX_CORE_EXPORT std::ostream& operator<<(std::ostream& out, const PartitionReport& report);
+
+/**
+ * @brief The AutoPartitioner distributes the nodes of a graph over a bounded number of thread groups.
+ *        Nodes are assigned one by one in topological order to the group that holds most of their
+ *        neighbors, weighted by how much capacity the group has left (linear deterministic greedy),
+ *        so that the measured processing load is balanced and few connections cross groups.
+ *        Only nodes in the default group, in private threads or in groups created by the partitioner
+ *        are moved, groups that were set up by hand are left alone.
+ *        The number of groups is stored in the ThreadPool, so that it is saved with the configuration.
+ *        With a command dispatcher, the moves are executed as one command that can be undone.
+ */
+class CSAPEX_CORE_EXPORT AutoPartitioner
+{
+public:
+    static const std::string GROUP_PREFIX;
+
+public:
+    AutoPartitioner(ThreadPool& thread_pool, GraphFacadeImplementationPtr root, CommandDispatcherPtr dispatcher = nullptr);
+
+    void setInterval(long interval_ms);
+    long getInterval() const;
+
+    /**
+     * @brief setImbalanceThreshold sets the imbalance above which the partition is recomputed
+     */
+    void setImbalanceThreshold(double threshold);
+    double getImbalanceThreshold() const;
+
+    /**
+     * @brief tick rebalances if partitioning is enabled in the thread pool and the interval has elapsed,
+     *        has to be called from the thread modifying the graph
+     */
+    void tick();
+
+    /**
+     * @brief partition assigns all movable nodes to the configured number of groups
+     */
+    PartitionReport partition();
+
+    PartitionReport getReport() const;
+
+public:
+    slim_signal::Signal<void(const PartitionReport&)> partition_changed;
+
+private:
+    struct Item
+    {
+        NodeRunnerPtr runner;
+        AUUID graph;
+        UUID node;
+        int depth;
+        double load;
+        int current;
+        std::vector<std::size_t> neighbors;
+    };
+
+    void collect(GraphFacadeImplementation& graph_facade, long window, std::vector<Item>& items, std::map<AUUID, long>& samples);
+    std::vector<ThreadGroup*> ensureGroups(int count);
+    bool isMovable(ThreadGroup* group) const;
+
+    PartitionReport evaluate(const std::vector<Item>& items, const std::vector<int>& assignment, std::size_t groups) const;
+
+private:
+    ThreadPool& thread_pool_;
+    GraphFacadeImplementationPtr root_;
+    CommandDispatcherPtr dispatcher_;
+
+    long interval_;
+    long last_update_;
+    double imbalance_threshold_;
+
+    std::map<AUUID, long> processing_time_;
+
+    PartitionReport report_;
+};
+
+}  // namespace csapex
+
+#endif  // AUTO_PARTITIONER_H
@@ -20,6 +20,8 @@ FWD(ThreadPool)
 FWD(ThreadGroup)
 FWD(Task)
 FWD(TimedQueue)
+FWD(ThreadPlacement)
+FWD(AutoPartitioner)
 }  // namespace csapex
 
 #undef FWD
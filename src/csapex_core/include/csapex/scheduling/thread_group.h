@@ -17,6 +17,7 @@
 #include <condition_variable>
 #include <deque>
 #include <set>
+#include <unordered_map>
 
 namespace YAML
 {
@@ -90,6 +91,17 @@ public:
     slim_signal::Signal<void(TaskGeneratorPtr)> generator_added;
     slim_signal::Signal<void(TaskGeneratorPtr)> generator_removed;
 
+private:
+    struct greater
+    {
+        bool operator()(const TaskPtr& a, const TaskPtr& b)
+        {
+            return a->getPriority() > b->getPriority();
+        }
+    };
+
+    typedef std::multiset<TaskPtr, greater> TaskQueue;
+
 private:
     void setup();
     void schedulingLoop();
@@ -98,6 +110,7 @@ private:
     bool waitForTasks();
     void handlePause();
     bool executeNextTask();
+    TaskPtr dequeue(TaskQueue::iterator it);
 
     void executeTask(const TaskPtr& task);
 
@@ -126,15 +139,9 @@ private:
     std::condition_variable_any pause_changed_;
 
     std::recursive_mutex tasks_mtx_;
-    struct greater
-    {
-        bool operator()(const TaskPtr& a, const TaskPtr& b)
-        {
-            return a->getPriority() > b->getPriority();
-        }
-    };
-
-    std::multiset<TaskPtr, greater> tasks_;
+    TaskQueue tasks_;
+    // the queued tasks of every generator, so that scheduling and removing do not have to search the whole queue
+    std::unordered_map<TaskGenerator*, std::vector<TaskQueue::iterator>> queued_tasks_;
 
     std::recursive_mutex state_mtx_;
     std::atomic<bool> running_;
@@ -0,0 +1,119 @@
+#ifndef THREAD_PLACEMENT_H
+#define THREAD_PLACEMENT_H
+
+/// PROJECT
+#include <csapex/model/model_fwd.h>
+#include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex/utility/cpu_topology.h>
+#include <csapex/utility/slim_signal.hpp>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <vector>
+
+namespace csapex
+{
+struct CSAPEX_CORE_EXPORT GroupPlacement
+{
+    GroupPlacement();
+
+    int group;
+    std::string name;
+
+    /**
+     * domain and numa_node are -1, if the group is not restricted to a single domain
+     */
+    int domain;
+    int numa_node;
+};
+
+/**
+ * @brief PlacementReport estimates how many bytes per second are exchanged between
+ *        thread groups and how much of that traffic crosses cache or NUMA boundaries.
+ */
+struct CSAPEX_CORE_EXPORT PlacementReport
+{
+    PlacementReport();
+
+    std::vector<GroupPlacement> groups;
+
+    double total_traffic;
+    double cross_domain_traffic;
+    double cross_numa_traffic;
+};
+
+CSAPEX_CORE_EXPORT std::ostream& operator<<(std::ostream& out, const PlacementReport& report);
+
+/**
+ * @brief ThreadPlacement pins the thread groups of a ThreadPool to the cpu domains of the machine.
+ *        Thread groups are clustered greedily by the traffic between them, estimated from the
+ *        message sizes and the rates of the connections between their nodes, so that connected
+ *        groups end up on the same socket or L3 cache domain.
+ */
+class CSAPEX_CORE_EXPORT ThreadPlacement
+{
+public:
+    ThreadPlacement(ThreadPool& thread_pool, GraphFacadeImplementationPtr root, const CpuTopology& topology = CpuTopology::fromSystem());
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void setInterval(long interval_ms);
+    long getInterval() const;
+
+    /**
+     * @brief tick places the thread groups if the interval has elapsed, has to be called from the thread modifying the graph
+     */
+    void tick();
+
+    /**
+     * @brief estimate reports the traffic for the current cpu affinities without changing them
+     */
+    PlacementReport estimate();
+
+    /**
+     * @brief place computes a new placement and applies it to the cpu affinities of all groups
+     */
+    PlacementReport place();
+
+    PlacementReport getReport() const;
+
+    const CpuTopology& getTopology() const;
+
+public:
+    slim_signal::Signal<void(const PlacementReport&)> placement_changed;
+
+private:
+    // private thread groups all share the same id, so groups are identified by their address
+    typedef std::map<std::pair<ThreadGroup*, ThreadGroup*>, double> TrafficMap;
+    typedef std::map<ThreadGroup*, int> DomainMap;
+
+    void collectTraffic(GraphFacadeImplementation& graph_facade, TrafficMap& traffic, std::set<ThreadGroup*>& groups);
+    double estimateMessageSize(const ConnectionPtr& connection);
+
+    int findDomain(ThreadGroup* group) const;
+    PlacementReport evaluate(const TrafficMap& traffic, const std::set<ThreadGroup*>& groups, const DomainMap& domains) const;
+
+private:
+    ThreadPool& thread_pool_;
+    GraphFacadeImplementationPtr root_;
+    CpuTopology topology_;
+
+    bool enabled_;
+    long interval_;
+    long last_update_;
+
+    std::map<int, double> message_sizes_;
+    DomainMap assignment_;
+
+    mutable std::mutex report_mutex_;
+    PlacementReport report_;
+};
+
+}  // namespace csapex
+
+#endif  // THREAD_PLACEMENT_H
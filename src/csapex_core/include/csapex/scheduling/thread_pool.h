@@ -66,6 +66,18 @@ public:
     void setPrivateThreadGroupCpuAffinity(const std::vector<bool>& affinity);
     std::vector<bool> getPrivateThreadGroupCpuAffinity() const;
 
+    /**
+     * @brief setIndividualCpuAffinity pins a single group, private groups are decoupled from the shared private affinity
+     */
+    void setIndividualCpuAffinity(ThreadGroup* group, const std::vector<bool>& affinity);
+
+    /**
+     * @brief setAutoPartitionGroupCount enables automatic partitioning into <count> groups, 0 disables it
+     * @see AutoPartitioner
+     */
+    void setAutoPartitionGroupCount(int count);
+    int getAutoPartitionGroupCount() const;
+
     void setSuppressExceptions(bool suppress_exceptions) override;
 
     void useProfiler(std::shared_ptr<Profiler> profiler) override;
@@ -113,6 +125,8 @@ private:
     std::map<ThreadGroup*, std::vector<slim_signal::ScopedConnection>> private_group_connections_;
 
     bool suppress_exceptions_;
+
+    int auto_partition_groups_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,119 @@
+#ifndef BULK_IO_H
+#define BULK_IO_H
+
+/// COMPONENT
+#include <csapex/serialization/serialization_buffer.h>
+
+/// PROJECT
+#include <csapex/data/point.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief bulk_serialization_traits decides whether a vector of T can be written as one contiguous block.
+ *        Arithmetic types are supported out of the box. Trivially copyable structs consisting of a
+ *        single scalar type can opt in by specializing the trait with value = true and scalar = that type.
+ */
+template <typename T, typename Enable = void>
+struct bulk_serialization_traits
+{
+    static constexpr bool value = false;
+};
+
+template <typename T>
+struct bulk_serialization_traits<T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type>
+{
+    static constexpr bool value = true;
+    typedef T scalar;
+};
+
+template <>
+struct bulk_serialization_traits<Point>
+{
+    static constexpr bool value = true;
+    typedef float scalar;
+};
+
+namespace bulk
+{
+inline constexpr bool isLittleEndianHost()
+{
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return false;
+#else
+    return true;
+#endif
+}
+
+template <std::size_t ScalarSize>
+void swapScalars(uint8_t* bytes, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, bytes += ScalarSize) {
+        std::reverse(bytes, bytes + ScalarSize);
+    }
+}
+}  // namespace bulk
+
+/**
+ * @brief writeBulk writes the element count as uint64 followed by all elements as little endian scalars.
+ *        On little endian hosts this is a single copy.
+ */
+template <typename T>
+void writeBulk(SerializationBuffer& data, const std::vector<T>& values)
+{
+    typedef typename bulk_serialization_traits<T>::scalar Scalar;
+    static_assert(std::is_trivially_copyable<T>::value, "bulk serialization requires trivially copyable types");
+    static_assert(sizeof(T) % sizeof(Scalar) == 0, "bulk serializable types must consist of scalars only");
+
+    data << static_cast<uint64_t>(values.size());
+    if (values.empty()) {
+        return;
+    }
+
+    std::size_t bytes = values.size() * sizeof(T);
+    std::size_t offset = data.size();
+    data.resize(offset + bytes);
+    std::memcpy(&data[offset], values.data(), bytes);
+
+    if (!bulk::isLittleEndianHost()) {
+        bulk::swapScalars<sizeof(Scalar)>(&data[offset], bytes / sizeof(Scalar));
+    }
+}
+
+template <typename T>
+void readBulk(const SerializationBuffer& data, std::vector<T>& values)
+{
+    typedef typename bulk_serialization_traits<T>::scalar Scalar;
+    static_assert(std::is_trivially_copyable<T>::value, "bulk serialization requires trivially copyable types");
+
+    uint64_t count;
+    data >> count;
+
+    if (count > (data.size() - data.getPos()) / sizeof(T)) {
+        throw std::runtime_error("bulk data exceeds the serialized buffer");
+    }
+
+    values.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    std::size_t bytes = count * sizeof(T);
+    uint8_t* target = reinterpret_cast<uint8_t*>(values.data());
+    data.readRaw(target, bytes);
+
+    if (!bulk::isLittleEndianHost()) {
+        bulk::swapScalars<sizeof(Scalar)>(target, bytes / sizeof(Scalar));
+    }
+}
+
+}  // namespace csapex
+
+#endif  // BULK_IO_H
@@ -0,0 +1,115 @@
+#ifndef MESSAGE_LOG_H
+#define MESSAGE_LOG_H
+
+/// PROJECT
+#include <csapex/model/token_data.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace boost
+{
+namespace iostreams
+{
+class mapped_file_source;
+}
+}  // namespace boost
+
+namespace csapex
+{
+/**
+ * A message log is an append-only file of binary serialized messages.
+ * It starts with a magic string and a versioned header, followed by one record per message.
+ * Every record is a finalized SerializationBuffer containing the recording time stamp and the message.
+ *
+ * Next to the log, an index file ("<log>.idx") holds the offset and time stamp of every record,
+ * so that a log can be opened and seeked without reading it. Records written after the last
+ * index entry (e.g. after a crash) are recovered by scanning, a truncated last record is ignored.
+ * A writer that continues an existing log cuts such a record off before appending.
+ */
+class CSAPEX_CORE_EXPORT MessageLogWriter
+{
+public:
+    MessageLogWriter(const std::string& path);
+    ~MessageLogWriter();
+
+    MessageLogWriter(const MessageLogWriter&) = delete;
+    MessageLogWriter& operator=(const MessageLogWriter&) = delete;
+
+    /**
+     * @brief write appends a message
+     * @param stamp recording time in micro seconds, used for playback at the original rate
+     */
+    void write(const TokenData& message, int64_t stamp);
+    void flush();
+
+    std::size_t count() const;
+    std::string getPath() const;
+
+    /**
+     * @brief getLastStamp returns the stamp of the last record in the log, including the ones written before it was opened
+     * @return std::numeric_limits<int64_t>::min() if the log has no records
+     */
+    int64_t getLastStamp() const;
+
+private:
+    void recover();
+
+private:
+    std::string path_;
+
+    std::FILE* data_;
+    std::FILE* index_;
+    uint64_t offset_;
+    std::size_t count_;
+    int64_t last_stamp_;
+
+    mutable std::mutex mutex_;
+};
+
+class CSAPEX_CORE_EXPORT MessageLogReader
+{
+    friend class MessageLogWriter;
+
+public:
+    MessageLogReader(const std::string& path);
+    ~MessageLogReader();
+
+    MessageLogReader(const MessageLogReader&) = delete;
+    MessageLogReader& operator=(const MessageLogReader&) = delete;
+
+    std::size_t count() const;
+
+    int64_t getStamp(std::size_t index) const;
+    TokenData::Ptr read(std::size_t index) const;
+
+    /**
+     * @brief find returns the index of the first message recorded at or after <stamp>
+     */
+    std::size_t find(int64_t stamp) const;
+
+private:
+    struct Entry
+    {
+        uint64_t offset;
+        int64_t stamp;
+    };
+
+    void loadIndex(const std::string& path);
+    void scan(uint64_t offset);
+    uint32_t recordLength(uint64_t offset) const;
+
+private:
+    std::unique_ptr<boost::iostreams::mapped_file_source> file_;
+    std::vector<Entry> entries_;
+    uint64_t body_offset_;
+};
+
+}  // namespace csapex
+
+#endif  // MESSAGE_LOG_H
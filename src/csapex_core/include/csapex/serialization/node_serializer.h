@@ -40,6 +40,8 @@ public:
 
     void shutdown() override;
 
+    bool hasSerializer(const csapex::Node& node) const;
+
     void serialize(const csapex::Node& node, YAML::Node& doc);
     void deserialize(csapex::Node& node, const YAML::Node& doc);
 
@@ -86,8 +86,8 @@ public:
         std::size_t nbytes = sizeof(T);
         T res = 0;
         for (std::size_t byte = 0; byte < nbytes; ++byte) {
-            uint8_t part = static_cast<T>(at(pos++));
-            res |= (part << (byte * 8));
+            uint8_t part = at(pos++);
+            res |= static_cast<T>(part) << (byte * 8);
         }
         i = res;
         return *this;
@@ -135,6 +135,10 @@ public:
     SerializationBuffer& operator<<(const YAML::Node& node);
     const SerializationBuffer& operator>>(YAML::Node& node) const;
 
+    // YAML documents of arbitrary size, an empty document is stored as a single length field
+    void writeYaml(const YAML::Node& node);
+    void readYaml(YAML::Node& node) const;
+
 private:
     static void init();
 
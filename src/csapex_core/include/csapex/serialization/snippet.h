@@ -46,6 +46,24 @@ public:
 
     void toYAML(YAML::Node& out) const;
 
+    /**
+     * @return an estimate of the memory held by the document, a spilled snippet holds none
+     */
+    std::size_t getByteSize() const;
+
+    /**
+     * @brief spill moves the document to a binary file in directory, it is reloaded as soon as it is accessed again.
+     *        The file is removed once the last copy of the snippet is destroyed.
+     * @return true, iff the document has been written
+     */
+    bool spill(const std::string& directory);
+    bool isSpilled() const;
+
+    /**
+     * @brief reload reads a spilled document back into memory, throws if the file cannot be read
+     */
+    void reload() const;
+
     virtual uint8_t getPacketType() const;
 
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
@@ -53,8 +71,12 @@ public:
 
     static std::shared_ptr<Snippet> makeEmpty();
 
+private:
+    const YAML::Node& getYAML() const;
+
 private:
     mutable std::shared_ptr<YAML::Node> yaml_;
+    mutable std::shared_ptr<const std::string> spill_file_;
 
     std::string name_;
     std::string description_;
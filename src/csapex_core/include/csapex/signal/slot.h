@@ -84,7 +84,8 @@ protected:
     long guard_;
 
 private:
-    std::deque<Connection*> available_connections_;
+    // connections can be destroyed while their message is queued, expired entries are skipped
+    std::deque<ConnectionWeakPtr> available_connections_;
 
     std::recursive_mutex available_connections_mutex_;
 };
@@ -9,7 +9,8 @@
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/graph_facade.h>
 #include <csapex/utility/assert.h>
-#include <csapex/msg/direct_connection.h>
+#include <csapex/model/connection.h>
+#include <csapex/msg/connection_factory.h>
 #include <csapex/command/command_serializer.h>
 #include <csapex/serialization/io/std_io.h>
 #include <csapex/serialization/io/csapex_io.h>
@@ -19,8 +20,8 @@ using namespace csapex::command;
 
 CSAPEX_REGISTER_COMMAND_SERIALIZER(AddConnection)
 
-AddConnection::AddConnection(const AUUID& parent_uuid, const UUID& from_uuid, const UUID& to_uuid, bool active)
-  : CommandImplementation(parent_uuid), from_uuid(from_uuid), to_uuid(to_uuid), active(active)
+AddConnection::AddConnection(const AUUID& parent_uuid, const UUID& from_uuid, const UUID& to_uuid, bool active, ConnectionPolicy policy)
+  : CommandImplementation(parent_uuid), from_uuid(from_uuid), to_uuid(to_uuid), active(active), policy(policy)
 {
 }
 
@@ -59,12 +60,18 @@ bool AddConnection::doExecute()
     apex_assert_hard(t);
     apex_assert_hard((f->isOutput() && t->isInput()));
 
-    ConnectionPtr c = DirectConnection::connect(f, t);
+    ConnectionPtr c = connection_factory::connect(f, t, policy);
     c->setActive(active);
 
     return graph->addConnection(c);
 }
 
+SemanticVersion AddConnection::getVersion() const
+{
+    // 0.1.0 adds the connection policy
+    return SemanticVersion(0, 1, 0);
+}
+
 void AddConnection::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
     Command::serialize(data, version);
@@ -72,6 +79,7 @@ void AddConnection::serialize(SerializationBuffer& data, SemanticVersion& versio
     data << from_uuid;
     data << to_uuid;
     data << active;
+    data << policy;
 }
 
 void AddConnection::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
@@ -81,4 +89,8 @@ void AddConnection::deserialize(const SerializationBuffer& data, const SemanticV
     data >> from_uuid;
     data >> to_uuid;
     data >> active;
+    policy = ConnectionPolicy::HANDSHAKE;
+    if (version >= SemanticVersion(0, 1, 0)) {
+        data >> policy;
+    }
 }
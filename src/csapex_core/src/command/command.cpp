@@ -105,6 +105,24 @@ void Command::accept(int level, std::function<void(int level, const Command&)> c
     callback(level, *this);
 }
 
+std::size_t Command::getMemoryFootprint() const
+{
+    return sizeof(Command);
+}
+
+void Command::spill(const std::string& /*directory*/)
+{
+}
+
+void Command::reload()
+{
+}
+
+bool Command::absorb(const Command& /*next*/)
+{
+    return false;
+}
+
 GraphFacadeImplementation* Command::getRoot()
 {
     GraphFacadeImplementation* gfl = dynamic_cast<GraphFacadeImplementation*>(root_graph_facade_);
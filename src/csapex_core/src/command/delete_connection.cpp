@@ -11,7 +11,8 @@
 #include <csapex/msg/output.h>
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/node.h>
-#include <csapex/msg/direct_connection.h>
+#include <csapex/model/connection.h>
+#include <csapex/msg/connection_factory.h>
 #include <csapex/command/command_serializer.h>
 #include <csapex/serialization/io/std_io.h>
 #include <csapex/serialization/io/csapex_io.h>
@@ -21,7 +22,7 @@ using namespace csapex::command;
 
 CSAPEX_REGISTER_COMMAND_SERIALIZER(DeleteConnection)
 
-DeleteConnection::DeleteConnection(const AUUID& parent_uuid, const UUID& from, const UUID& to) : Meta(parent_uuid, "delete connection and fulcrums"), active_(false), from_uuid(from), to_uuid(to)
+DeleteConnection::DeleteConnection(const AUUID& parent_uuid, const UUID& from, const UUID& to) : Meta(parent_uuid, "delete connection and fulcrums"), active_(false), policy_(ConnectionPolicy::HANDSHAKE), from_uuid(from), to_uuid(to)
 {
 }
 
@@ -39,6 +40,7 @@ bool DeleteConnection::doExecute()
     apex_assert_hard(connection);
 
     active_ = connection->isActive();
+    policy_ = connection->getPolicy();
 
     connection_id = connection->id();
 
@@ -64,7 +66,7 @@ bool DeleteConnection::doUndo()
     OutputPtr output = std::dynamic_pointer_cast<Output>(from);
     InputPtr input = std::dynamic_pointer_cast<Input>(to);
 
-    ConnectionPtr c = DirectConnection::connect(output, input, connection_id);
+    ConnectionPtr c = connection_factory::connect(output, input, connection_id, policy_);
     c->setActive(active_);
     graph->addConnection(c);
 
@@ -76,12 +78,19 @@ bool DeleteConnection::doRedo()
     return doExecute();
 }
 
+SemanticVersion DeleteConnection::getVersion() const
+{
+    // 0.1.0 adds the connection policy
+    return SemanticVersion(0, 1, 0);
+}
+
 void DeleteConnection::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
     Meta::serialize(data, version);
 
     data << connection_id;
     data << active_;
+    data << policy_;
 
     data << from_uuid;
     data << to_uuid;
@@ -93,6 +102,10 @@ void DeleteConnection::deserialize(const SerializationBuffer& data, const Semant
 
     data >> connection_id;
     data >> active_;
+    policy_ = ConnectionPolicy::HANDSHAKE;
+    if (version >= SemanticVersion(0, 1, 0)) {
+        data >> policy_;
+    }
 
     data >> from_uuid;
     data >> to_uuid;
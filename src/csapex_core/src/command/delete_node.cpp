@@ -31,6 +31,23 @@ DeleteNode::DeleteNode(const AUUID& parent_uuid, const UUID& uuid) : Meta(parent
 {
 }
 
+std::size_t DeleteNode::getMemoryFootprint() const
+{
+    return Meta::getMemoryFootprint() + saved_graph.getByteSize();
+}
+
+void DeleteNode::spill(const std::string& directory)
+{
+    Meta::spill(directory);
+    saved_graph.spill(directory);
+}
+
+void DeleteNode::reload()
+{
+    Meta::reload();
+    saved_graph.reload();
+}
+
 std::string DeleteNode::getDescription() const
 {
     return std::string("deleted node ") + uuid.getFullName();
@@ -13,7 +13,11 @@
 
 using namespace csapex;
 
-CommandDispatcher::CommandDispatcher(CsApexCore& core) : core_(core), dirty_(false)
+CommandDispatcher::HistoryEntry::HistoryEntry(const Command::Ptr& command) : command(command), bytes(0)
+{
+}
+
+CommandDispatcher::CommandDispatcher(CsApexCore& core) : core_(core), dirty_(false), max_commands_(0), max_bytes_(0), history_bytes_(0)
 {
 }
 
@@ -22,6 +26,7 @@ void CommandDispatcher::reset()
     later.clear();
     done.clear();
     undone.clear();
+    history_bytes_ = 0;
     dirty_ = false;
 }
 
@@ -66,11 +71,24 @@ void CommandDispatcher::doExecute(Command::Ptr command)
     bool success = Command::Access::executeCommand(command);
 
     if (command->isUndoable()) {
-        done.push_back(command);
-
         while (!undone.empty()) {
+            history_bytes_ -= undone.back().bytes;
             undone.pop_back();
         }
+
+        // consecutive edits of the same thing, e.g. a box moved step by step, are undone at once
+        bool absorbed = false;
+        if (success && !done.empty() && !done.back().command->isBeforeSavepoint() && !command->isAfterSavepoint()) {
+            absorbed = done.back().command->absorb(*command);
+        }
+
+        if (absorbed) {
+            measure(done.back());
+        } else {
+            push(done, HistoryEntry(command));
+        }
+
+        enforceHistoryLimits();
     }
 
     if (success) {
@@ -93,10 +111,10 @@ void CommandDispatcher::resetDirtyPoint()
     clearSavepoints();
 
     if (!done.empty()) {
-        done.back()->setBeforeSavepoint(true);
+        done.back().command->setBeforeSavepoint(true);
     }
     if (!undone.empty()) {
-        undone.back()->setAfterSavepoint(true);
+        undone.back().command->setAfterSavepoint(true);
     }
 
     dirty_changed(dirty_);
@@ -104,13 +122,13 @@ void CommandDispatcher::resetDirtyPoint()
 
 void CommandDispatcher::clearSavepoints()
 {
-    for (Command::Ptr cmd : done) {
-        cmd->setAfterSavepoint(false);
-        cmd->setBeforeSavepoint(false);
+    for (const HistoryEntry& entry : done) {
+        entry.command->setAfterSavepoint(false);
+        entry.command->setBeforeSavepoint(false);
     }
-    for (Command::Ptr cmd : undone) {
-        cmd->setAfterSavepoint(false);
-        cmd->setBeforeSavepoint(false);
+    for (const HistoryEntry& entry : undone) {
+        entry.command->setAfterSavepoint(false);
+        entry.command->setBeforeSavepoint(false);
     }
     dirty_changed(dirty_);
 }
@@ -152,15 +170,20 @@ void CommandDispatcher::undo()
         return;
     }
 
-    Command::Ptr last = done.back();
+    // spilled snapshots are read before anything changes, a command that cannot be restored stays in the history
+    done.back().command->reload();
+
+    HistoryEntry last = done.back();
     done.pop_back();
 
-    bool ret = Command::Access::undoCommand(last);
+    bool ret = Command::Access::undoCommand(last.command);
     apex_assert_hard(ret);
 
-    setDirty(!last->isAfterSavepoint());
+    setDirty(!last.command->isAfterSavepoint());
 
     undone.push_back(last);
+    measure(undone.back());
+    enforceHistoryLimits();
 
     state_changed();
 }
@@ -171,14 +194,18 @@ void CommandDispatcher::redo()
         return;
     }
 
-    Command::Ptr last = undone.back();
+    undone.back().command->reload();
+
+    HistoryEntry last = undone.back();
     undone.pop_back();
 
-    Command::Access::redoCommand(last);
+    Command::Access::redoCommand(last.command);
 
     done.push_back(last);
+    measure(done.back());
+    enforceHistoryLimits();
 
-    setDirty(!last->isBeforeSavepoint());
+    setDirty(!last.command->isBeforeSavepoint());
 
     state_changed();
 }
@@ -186,7 +213,7 @@ void CommandDispatcher::redo()
 CommandConstPtr CommandDispatcher::getNextUndoCommand() const
 {
     if (canUndo()) {
-        return done.back();
+        return done.back().command;
     } else {
         return nullptr;
     }
@@ -195,7 +222,7 @@ CommandConstPtr CommandDispatcher::getNextUndoCommand() const
 CommandConstPtr CommandDispatcher::getNextRedoCommand() const
 {
     if (canRedo()) {
-        return undone.back();
+        return undone.back().command;
     } else {
         return nullptr;
     }
@@ -203,14 +230,84 @@ CommandConstPtr CommandDispatcher::getNextRedoCommand() const
 
 void CommandDispatcher::visitUndoCommands(std::function<void(int level, const Command&)> callback) const
 {
-    for (const Command::Ptr& c : done) {
-        c->accept(0, callback);
+    for (const HistoryEntry& entry : done) {
+        entry.command->accept(0, callback);
     }
 }
 
 void CommandDispatcher::visitRedoCommands(std::function<void(int level, const Command&)> callback) const
 {
-    for (const Command::Ptr& c : undone) {
-        c->accept(0, callback);
+    for (const HistoryEntry& entry : undone) {
+        entry.command->accept(0, callback);
     }
 }
+
+void CommandDispatcher::setHistoryLimits(std::size_t max_commands, std::size_t max_bytes)
+{
+    max_commands_ = max_commands;
+    max_bytes_ = max_bytes;
+
+    enforceHistoryLimits();
+}
+
+void CommandDispatcher::setSpillDirectory(const std::string& directory)
+{
+    spill_directory_ = directory;
+}
+
+std::size_t CommandDispatcher::getHistoryMemory() const
+{
+    return history_bytes_;
+}
+
+void CommandDispatcher::push(std::deque<HistoryEntry>& history, HistoryEntry entry)
+{
+    history.push_back(entry);
+    measure(history.back());
+}
+
+void CommandDispatcher::measure(HistoryEntry& entry)
+{
+    history_bytes_ -= entry.bytes;
+    entry.bytes = entry.command->getMemoryFootprint();
+    history_bytes_ += entry.bytes;
+}
+
+void CommandDispatcher::enforceHistoryLimits()
+{
+    if (max_commands_ > 0) {
+        while (done.size() + undone.size() > max_commands_) {
+            dropOldest();
+        }
+    }
+
+    if (max_bytes_ == 0 || history_bytes_ <= max_bytes_) {
+        return;
+    }
+
+    if (!spill_directory_.empty()) {
+        // the commands next to the current state stay in memory, they are the ones most likely to be undone or redone
+        for (std::size_t i = 0; i + 1 < done.size() && history_bytes_ > max_bytes_; ++i) {
+            done[i].command->spill(spill_directory_);
+            measure(done[i]);
+        }
+        for (std::size_t i = 0; i + 1 < undone.size() && history_bytes_ > max_bytes_; ++i) {
+            undone[i].command->spill(spill_directory_);
+            measure(undone[i]);
+        }
+    }
+
+    // the last command can always be undone, even if it alone exceeds the budget
+    while (history_bytes_ > max_bytes_ && done.size() + undone.size() > 1) {
+        dropOldest();
+    }
+}
+
+void CommandDispatcher::dropOldest()
+{
+    std::deque<HistoryEntry>& history = done.empty() ? undone : done;
+    apex_assert_hard(!history.empty());
+
+    history_bytes_ -= history.front().bytes;
+    history.pop_front();
+}
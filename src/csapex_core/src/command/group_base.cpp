@@ -125,6 +125,9 @@ void GroupBase::pasteSelection(AUUID sub_graph_auuid)
     add(paste);
 
     old_uuid_to_new = paste->getMapping();
+
+    // the paste command owns the snapshot from now on, so that it can be spilled from the undo history
+    serialized_snippet_ = Snippet();
 }
 
 void GroupBase::clear()
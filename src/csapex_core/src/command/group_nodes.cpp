@@ -120,13 +120,13 @@ void GroupNodes::mapMessageGoingIn(AUUID parent_auuid, AUUID sub_graph_auuid)
             cache[ci.to] = in_map;
 
             // forwarding connection
-            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, in_map.internal, nested_connector_uuid, ci.active);
+            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, in_map.internal, nested_connector_uuid, ci.active, ci.policy);
             executeCommand(add_internal_connection);
             add(add_internal_connection);
         }
 
         // crossing connection
-        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, ci.from, in_map.external, ci.active);
+        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, ci.from, in_map.external, ci.active, ci.policy);
         executeCommand(add_external_connection);
         add(add_external_connection);
     }
@@ -152,13 +152,13 @@ void GroupNodes::mapMessageGoingOut(AUUID parent_auuid, AUUID sub_graph_auuid)
             cache[ci.from] = out_map;
 
             // forwarding connection
-            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, nested_connector_uuid, out_map.internal, ci.active);
+            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, nested_connector_uuid, out_map.internal, ci.active, ci.policy);
             executeCommand(add_internal_connection);
             add(add_internal_connection);
         }
 
         // crossing connection
-        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, out_map.external, ci.to, ci.active);
+        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, out_map.external, ci.to, ci.active, ci.policy);
         executeCommand(add_external_connection);
         add(add_external_connection);
     }
@@ -184,13 +184,13 @@ void GroupNodes::mapSignalGoingIn(AUUID parent_auuid, AUUID sub_graph_auuid)
             cache[ci.to] = in_map;
 
             // forwarding connection
-            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, in_map.internal, nested_connector_uuid, ci.active);
+            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, in_map.internal, nested_connector_uuid, ci.active, ci.policy);
             executeCommand(add_internal_connection);
             add(add_internal_connection);
         }
 
         // crossing connection
-        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, ci.from, in_map.external, ci.active);
+        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, ci.from, in_map.external, ci.active, ci.policy);
         executeCommand(add_external_connection);
         add(add_external_connection);
     }
@@ -216,13 +216,13 @@ void GroupNodes::mapSignalGoingOut(AUUID parent_auuid, AUUID sub_graph_auuid)
             cache[ci.from] = out_map;
 
             // forwarding connection
-            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, nested_connector_uuid, out_map.internal, ci.active);
+            CommandPtr add_internal_connection = std::make_shared<command::AddConnection>(sub_graph_auuid, nested_connector_uuid, out_map.internal, ci.active, ci.policy);
             executeCommand(add_internal_connection);
             add(add_internal_connection);
         }
 
         // crossing connection
-        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, out_map.external, ci.to, ci.active);
+        CommandPtr add_external_connection = std::make_shared<command::AddConnection>(parent_auuid, out_map.external, ci.to, ci.active, ci.policy);
         executeCommand(add_external_connection);
         add(add_external_connection);
     }
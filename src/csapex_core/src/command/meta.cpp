@@ -37,6 +37,29 @@ void Meta::accept(int level, std::function<void(int level, const Command&)> call
     }
 }
 
+std::size_t Meta::getMemoryFootprint() const
+{
+    std::size_t bytes = Command::getMemoryFootprint();
+    for (const Command::Ptr& cmd : nested) {
+        bytes += cmd->getMemoryFootprint();
+    }
+    return bytes;
+}
+
+void Meta::spill(const std::string& directory)
+{
+    for (const Command::Ptr& cmd : nested) {
+        cmd->spill(directory);
+    }
+}
+
+void Meta::reload()
+{
+    for (const Command::Ptr& cmd : nested) {
+        cmd->reload();
+    }
+}
+
 std::string Meta::getDescription() const
 {
     return type;
@@ -17,10 +17,32 @@ using namespace csapex::command;
 
 CSAPEX_REGISTER_COMMAND_SERIALIZER(MoveBox)
 
-MoveBox::MoveBox(const AUUID& graph_uuid, const UUID& node_uuid, Point from, Point to) : CommandImplementation(graph_uuid), from(from), to(to), box_uuid(node_uuid)
+namespace
+{
+// moves that follow each other more slowly belong to separate drags
+const std::chrono::milliseconds DRAG_STEP_INTERVAL(500);
+}  // namespace
+
+MoveBox::MoveBox(const AUUID& graph_uuid, const UUID& node_uuid, Point from, Point to)
+  : CommandImplementation(graph_uuid), from(from), to(to), box_uuid(node_uuid), moved_at(std::chrono::steady_clock::now())
 {
 }
 
+bool MoveBox::absorb(const Command& next)
+{
+    const MoveBox* move = dynamic_cast<const MoveBox*>(&next);
+    if (!move || move->graph_uuid != graph_uuid || move->box_uuid != box_uuid) {
+        return false;
+    }
+    if (move->from != to || move->moved_at - moved_at > DRAG_STEP_INTERVAL) {
+        return false;
+    }
+
+    to = move->to;
+    moved_at = move->moved_at;
+    return true;
+}
+
 std::string MoveBox::getDescription() const
 {
     std::stringstream ss;
@@ -74,4 +96,6 @@ void MoveBox::deserialize(const SerializationBuffer& data, const SemanticVersion
     data >> from.x >> from.y;
     data >> to.x >> to.y;
     data >> box_uuid;
+
+    moved_at = std::chrono::steady_clock::now();
 }
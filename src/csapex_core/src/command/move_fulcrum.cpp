@@ -17,8 +17,14 @@ using namespace csapex::command;
 
 CSAPEX_REGISTER_COMMAND_SERIALIZER(MoveFulcrum)
 
+namespace
+{
+// moves that follow each other more slowly belong to separate drags
+const std::chrono::milliseconds DRAG_STEP_INTERVAL(500);
+}  // namespace
+
 MoveFulcrum::MoveFulcrum(const AUUID& parent_uuid, int connection_id, int fulcrum_id, const Point& from, const Point& to)
-  : CommandImplementation(parent_uuid), connection_id(connection_id), fulcrum_id(fulcrum_id), from(from), to(to)
+  : CommandImplementation(parent_uuid), connection_id(connection_id), fulcrum_id(fulcrum_id), from(from), to(to), moved_at(std::chrono::steady_clock::now())
 {
 }
 
@@ -29,6 +35,21 @@ std::string MoveFulcrum::getDescription() const
     return ss.str();
 }
 
+bool MoveFulcrum::absorb(const Command& next)
+{
+    const MoveFulcrum* move = dynamic_cast<const MoveFulcrum*>(&next);
+    if (!move || move->graph_uuid != graph_uuid || move->connection_id != connection_id || move->fulcrum_id != fulcrum_id) {
+        return false;
+    }
+    if (move->from != to || move->moved_at - moved_at > DRAG_STEP_INTERVAL) {
+        return false;
+    }
+
+    to = move->to;
+    moved_at = move->moved_at;
+    return true;
+}
+
 bool MoveFulcrum::doExecute()
 {
     return true;
@@ -64,4 +85,6 @@ void MoveFulcrum::deserialize(const SerializationBuffer& data, const SemanticVer
     data >> fulcrum_id;
     data >> from.x >> from.y;
     data >> to.x >> to.y;
+
+    moved_at = std::chrono::steady_clock::now();
 }
@@ -24,6 +24,38 @@ std::string PasteGraph::getDescription() const
     return std::string("paste into a graph");
 }
 
+std::size_t PasteGraph::getMemoryFootprint() const
+{
+    std::size_t bytes = Command::getMemoryFootprint();
+    if (blueprint_) {
+        bytes += blueprint_->getByteSize();
+    }
+    if (delete_command_) {
+        bytes += delete_command_->getMemoryFootprint();
+    }
+    return bytes;
+}
+
+void PasteGraph::spill(const std::string& directory)
+{
+    if (blueprint_) {
+        blueprint_->spill(directory);
+    }
+    if (delete_command_) {
+        delete_command_->spill(directory);
+    }
+}
+
+void PasteGraph::reload()
+{
+    if (blueprint_) {
+        blueprint_->reload();
+    }
+    if (delete_command_) {
+        delete_command_->reload();
+    }
+}
+
 bool PasteGraph::doExecute()
 {
     GraphFacadeImplementation* graph_facade = graph_uuid.empty() ? getRoot() : getGraphFacade();
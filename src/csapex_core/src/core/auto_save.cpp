@@ -0,0 +1,252 @@
+/// HEADER
+#include <csapex/core/auto_save.h>
+
+/// PROJECT
+#include <csapex/model/node.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_state.h>
+#include <csapex/serialization/node_serializer.h>
+
+/// SYSTEM
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iostream>
+
+using namespace csapex;
+
+AutoSave::AutoSave(const Source& source) : source_(source), serialized_(0), reused_(0), writing_(false), invalid_(false), stop_(false)
+{
+}
+
+AutoSave::~AutoSave()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    changed_.notify_all();
+
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+void AutoSave::setHeader(const std::string& header)
+{
+    header_ = header;
+}
+
+void AutoSave::save(const std::string& file)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (invalid_) {
+            invalid_ = false;
+            revisions_.clear();
+        }
+    }
+
+    serialized_ = 0;
+    reused_ = 0;
+
+    std::unordered_map<AUUID, Revision, AUUID::Hasher> seen;
+
+    Snapshot snapshot;
+    snapshot.file = file;
+    snapshot.header = header_;
+    snapshot.document = source_([this, &seen](const NodeFacadeImplementation& node) { return isUnchanged(node, seen); },
+                                [this, &snapshot](const NodeFacadeImplementation& node, YAML::Node& doc) { copyState(node, doc, snapshot.states); });
+
+    // nodes that were not seen have been removed
+    revisions_.swap(seen);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pending_.push_back(snapshot);
+
+        if (!writer_.joinable()) {
+            writer_ = std::thread(&AutoSave::writeLoop, this);
+        }
+    }
+    changed_.notify_all();
+}
+
+void AutoSave::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this]() { return pending_.empty() && !writing_; });
+}
+
+void AutoSave::invalidate()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    invalid_ = true;
+}
+
+std::size_t AutoSave::getSerializedNodeCount() const
+{
+    return serialized_;
+}
+
+std::size_t AutoSave::getReusedNodeCount() const
+{
+    return reused_;
+}
+
+bool AutoSave::isUnchanged(const NodeFacadeImplementation& node, std::unordered_map<AUUID, Revision, AUUID::Hasher>& seen)
+{
+    NodePtr n = node.getNode();
+    if (n && NodeSerializer::instance().hasSerializer(*n)) {
+        // custom serializers can write any internal state, we cannot know whether it changed
+        ++serialized_;
+        return false;
+    }
+
+    NodeStatePtr state = node.getNodeState();
+    Revision current{ state.get(), state->getRevision() };
+    seen[node.getAUUID()] = current;
+
+    auto pos = revisions_.find(node.getAUUID());
+    bool unchanged = pos != revisions_.end() && pos->second.state == current.state && pos->second.revision == current.revision;
+    if (unchanged) {
+        ++reused_;
+    } else {
+        ++serialized_;
+    }
+    return unchanged;
+}
+
+void AutoSave::copyState(const NodeFacadeImplementation& node, YAML::Node& doc, std::vector<DeferredState>& states)
+{
+    NodePtr n = node.getNode();
+    if (n && NodeSerializer::instance().hasSerializer(*n)) {
+        // the hook of the node runs right after this, so the state is written right away as well
+        node.getNodeState()->writeYaml(doc);
+        return;
+    }
+
+    // the copy does not know its node, which might be gone by the time the copy is written
+    doc["type"] = node.getType();
+    doc["uuid"] = node.getUUID().getFullName();
+
+    NodeStatePtr copy = std::make_shared<NodeState>();
+    *copy = *node.getNodeState();
+    states.push_back(DeferredState{ doc, copy });
+}
+
+void AutoSave::writeLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this]() { return !pending_.empty() || stop_; });
+        if (pending_.empty()) {
+            // only stop once everything is written
+            return;
+        }
+
+        std::deque<Snapshot> snapshots;
+        snapshots.swap(pending_);
+        writing_ = true;
+
+        lock.unlock();
+
+        // every snapshot has to be resolved in order, each one can refer to nodes of its predecessor
+        bool complete = true;
+        std::map<std::string, const Snapshot*> latest;
+        for (Snapshot& snapshot : snapshots) {
+            for (DeferredState& deferred : snapshot.states) {
+                deferred.state->writeYaml(deferred.doc);
+            }
+            snapshot.states.clear();
+
+            std::map<std::string, YAML::Node> seen;
+            complete = resolve(snapshot.document, "", seen);
+            cache_.swap(seen);
+
+            if (complete) {
+                latest[snapshot.file] = &snapshot;
+            } else {
+                latest.erase(snapshot.file);
+            }
+        }
+
+        for (const auto& pair : latest) {
+            write(*pair.second);
+        }
+
+        lock.lock();
+
+        if (!complete) {
+            invalid_ = true;
+        }
+        writing_ = false;
+        changed_.notify_all();
+    }
+}
+
+bool AutoSave::resolve(YAML::Node& graph, const std::string& prefix, std::map<std::string, YAML::Node>& seen)
+{
+    YAML::Node nodes = graph["nodes"];
+    if (!nodes.IsSequence()) {
+        return true;
+    }
+
+    bool complete = true;
+
+    YAML::Node resolved(YAML::NodeType::Sequence);
+    for (std::size_t i = 0, n = nodes.size(); i < n; ++i) {
+        YAML::Node node = nodes[i];
+        std::string key = prefix + node["uuid"].as<std::string>();
+
+        if (node["cached"].IsDefined()) {
+            auto pos = cache_.find(key);
+            if (pos == cache_.end()) {
+                std::cerr << "autosave: node " << key << " is missing from the cache" << std::endl;
+                complete = false;
+                continue;
+            }
+            seen.insert(*pos);
+            resolved.push_back(pos->second);
+
+        } else {
+            if (node["subgraph"].IsDefined()) {
+                YAML::Node subgraph = node["subgraph"];
+                complete &= resolve(subgraph, key + "/", seen);
+            }
+            seen.insert(std::make_pair(key, node));
+            resolved.push_back(node);
+        }
+    }
+
+    graph["nodes"] = resolved;
+
+    return complete;
+}
+
+void AutoSave::write(const Snapshot& snapshot)
+{
+    YAML::Emitter yaml;
+    yaml << snapshot.document;
+
+    // write to a temporary file first, a crash must never leave a truncated file behind
+    std::string tmp_file = snapshot.file + ".tmp";
+    try {
+        {
+            std::ofstream ofs(tmp_file.c_str());
+            if (!snapshot.header.empty()) {
+                ofs << snapshot.header << '\n';
+            }
+            ofs << yaml.c_str();
+            ofs.flush();
+            if (!ofs) {
+                throw std::runtime_error("cannot write " + tmp_file);
+            }
+        }
+        boost::filesystem::rename(tmp_file, snapshot.file);
+
+    } catch (const std::exception& e) {
+        std::cerr << "autosave failed: " << e.what() << std::endl;
+        boost::system::error_code ec;
+        boost::filesystem::remove(tmp_file, ec);
+    }
+}
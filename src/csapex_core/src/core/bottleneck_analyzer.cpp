@@ -0,0 +1,284 @@
+/// HEADER
+#include <csapex/core/bottleneck_analyzer.h>
+
+/// PROJECT
+#include <csapex/model/connection.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph/vertex.h>
+#include <csapex/model/node_characteristics.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_worker.h>
+#include <csapex/model/token_provenance.h>
+#include <csapex/msg/input.h>
+#include <csapex/msg/output.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <iomanip>
+#include <unordered_map>
+
+using namespace csapex;
+
+namespace
+{
+long now()
+{
+    return TokenProvenance::now();
+}
+
+double ratio(long part, long window)
+{
+    if (window <= 0) {
+        return 0.0;
+    }
+    return std::min(1.0, std::max(0.0, part / static_cast<double>(window)));
+}
+}  // namespace
+
+NodeLoad::NodeLoad() : depth(-1), process_count(0), mean_process_time(0.0), utilization(0.0), waiting_on_input(0.0), blocked_on_output(0.0)
+{
+}
+
+BottleneckReport::BottleneckReport() : window(0), critical_path_time(0.0)
+{
+}
+
+std::ostream& csapex::operator<<(std::ostream& out, const BottleneckReport& report)
+{
+    out << "window: " << report.window / 1000.0 << " ms\n";
+    out << std::left << std::setw(40) << "node" << std::right << std::setw(8) << "depth" << std::setw(10) << "count" << std::setw(12) << "mean [ms]" << std::setw(8) << "util" << std::setw(8)
+        << "input" << std::setw(8) << "output" << '\n';
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2);
+    for (const NodeLoad& load : report.nodes) {
+        out << std::left << std::setw(40) << load.label << std::right << std::setw(8) << load.depth << std::setw(10) << load.process_count << std::setw(12) << load.mean_process_time / 1000.0
+            << std::setw(8) << load.utilization << std::setw(8) << load.waiting_on_input << std::setw(8) << load.blocked_on_output << '\n';
+    }
+    out.flags(flags);
+
+    out << "critical path (" << report.critical_path_time / 1000.0 << " ms):";
+    for (const AUUID& node : report.critical_path) {
+        out << ' ' << node;
+    }
+    out << '\n';
+    out << "bottleneck: " << report.bottleneck << '\n';
+    return out;
+}
+
+BottleneckAnalyzer::BottleneckAnalyzer(GraphFacadeImplementationPtr root) : root_(root), enabled_(false), interval_(1000), last_update_(now())
+{
+}
+
+void BottleneckAnalyzer::setEnabled(bool enabled)
+{
+    if (enabled && !enabled_) {
+        // start with a fresh baseline
+        update();
+    }
+    enabled_ = enabled;
+}
+
+bool BottleneckAnalyzer::isEnabled() const
+{
+    return enabled_;
+}
+
+void BottleneckAnalyzer::setInterval(long interval_ms)
+{
+    interval_ = interval_ms;
+}
+
+long BottleneckAnalyzer::getInterval() const
+{
+    return interval_;
+}
+
+void BottleneckAnalyzer::tick()
+{
+    if (enabled_ && now() - last_update_ >= interval_ * 1000) {
+        report_updated(update());
+    }
+}
+
+BottleneckReport BottleneckAnalyzer::update()
+{
+    long stamp = now();
+
+    BottleneckReport report;
+    report.window = stamp - last_update_;
+
+    std::map<AUUID, NodeSample> node_samples;
+    std::map<int, ConnectionSample> connection_samples;
+    analyzeGraph(*root_, report.window, report, node_samples, connection_samples);
+
+    double max_utilization = -1.0;
+    for (const NodeLoad& load : report.nodes) {
+        if (load.utilization > max_utilization) {
+            max_utilization = load.utilization;
+            report.bottleneck = load.node;
+        }
+    }
+
+    node_samples_ = std::move(node_samples);
+    connection_samples_ = std::move(connection_samples);
+    last_update_ = stamp;
+
+    std::unique_lock<std::mutex> lock(report_mutex_);
+    report_ = report;
+    return report;
+}
+
+BottleneckReport BottleneckAnalyzer::getReport() const
+{
+    std::unique_lock<std::mutex> lock(report_mutex_);
+    return report_;
+}
+
+BottleneckAnalyzer::ConnectionSample BottleneckAnalyzer::sampleConnection(const ConnectionPtr& connection, std::map<int, ConnectionSample>& connection_samples) const
+{
+    ConnectionSample sample;
+    sample.empty = connection->getTimeInState(Connection::State::NOT_INITIALIZED);
+    sample.occupied = connection->getTimeInState(Connection::State::UNREAD) + connection->getTimeInState(Connection::State::READ);
+    connection_samples[connection->id()] = sample;
+
+    auto pos = connection_samples_.find(connection->id());
+    if (pos != connection_samples_.end()) {
+        sample.empty -= pos->second.empty;
+        sample.occupied -= pos->second.occupied;
+    }
+    return sample;
+}
+
+std::vector<graph::VertexPtr> BottleneckAnalyzer::sortTopologically(GraphImplementation& graph) const
+{
+    // the depth of a vertex is its shortest distance to a source, a shortcut edge can place
+    // a vertex before one of its parents. Kahn's algorithm over the parent counts instead.
+    std::vector<graph::VertexPtr> vertices(graph.begin(), graph.end());
+    std::unordered_map<graph::Vertex*, int> missing_parents;
+    for (const graph::VertexPtr& vertex : vertices) {
+        missing_parents[vertex.get()] = 0;
+    }
+    for (const graph::VertexPtr& vertex : vertices) {
+        for (const graph::VertexPtr& child : vertex->getChildren()) {
+            auto pos = missing_parents.find(child.get());
+            if (pos != missing_parents.end()) {
+                ++pos->second;
+            }
+        }
+    }
+
+    std::vector<graph::VertexPtr> sorted;
+    sorted.reserve(vertices.size());
+    for (const graph::VertexPtr& vertex : vertices) {
+        if (missing_parents[vertex.get()] == 0) {
+            sorted.push_back(vertex);
+        }
+    }
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        for (const graph::VertexPtr& child : sorted[i]->getChildren()) {
+            auto pos = missing_parents.find(child.get());
+            if (pos != missing_parents.end() && --pos->second == 0) {
+                sorted.push_back(child);
+            }
+        }
+    }
+
+    // vertices on a cycle are never released, they are reported last without a path
+    for (const graph::VertexPtr& vertex : vertices) {
+        if (missing_parents[vertex.get()] > 0) {
+            sorted.push_back(vertex);
+        }
+    }
+    return sorted;
+}
+
+void BottleneckAnalyzer::analyzeGraph(GraphFacadeImplementation& graph_facade, long window, BottleneckReport& report, std::map<AUUID, NodeSample>& node_samples,
+                                      std::map<int, ConnectionSample>& connection_samples)
+{
+    GraphImplementationPtr graph = graph_facade.getLocalGraph();
+
+    std::vector<graph::VertexPtr> vertices = sortTopologically(*graph);
+
+    // longest path by mean processing time, every vertex is visited after all of its parents
+    std::unordered_map<graph::Vertex*, std::pair<double, graph::Vertex*>> path_time;
+    graph::Vertex* path_end = nullptr;
+    double path_end_time = -1.0;
+
+    for (const graph::VertexPtr& vertex : vertices) {
+        NodeFacadeImplementationPtr nf = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+        if (!nf) {
+            continue;
+        }
+
+        NodeLoad load;
+        load.node = nf->getAUUID();
+        load.label = nf->getLabel();
+        load.depth = vertex->getNodeCharacteristics().depth;
+
+        if (NodeWorkerPtr worker = nf->getNodeWorker().lock()) {
+            NodeSample sample{ worker->getProcessingTime(), worker->getProcessCount() };
+            node_samples[load.node] = sample;
+
+            auto pos = node_samples_.find(load.node);
+            if (pos != node_samples_.end()) {
+                sample.processing_time -= pos->second.processing_time;
+                sample.process_count -= pos->second.process_count;
+            }
+
+            load.process_count = sample.process_count;
+            load.mean_process_time = sample.process_count > 0 ? sample.processing_time / static_cast<double>(sample.process_count) : 0.0;
+            load.utilization = ratio(sample.processing_time, window);
+        }
+
+        NodeHandlePtr nh = nf->getNodeHandle();
+        long waiting = 0;
+        for (const InputPtr& input : nh->getExternalInputs()) {
+            for (const ConnectionPtr& connection : input->getConnections()) {
+                waiting = std::max(waiting, sampleConnection(connection, connection_samples).empty);
+            }
+        }
+        long blocked = 0;
+        for (const OutputPtr& output : nh->getExternalOutputs()) {
+            for (const ConnectionPtr& connection : output->getConnections()) {
+                blocked = std::max(blocked, sampleConnection(connection, connection_samples).occupied);
+            }
+        }
+        load.waiting_on_input = ratio(waiting, window);
+        load.blocked_on_output = ratio(blocked, window);
+
+        std::pair<double, graph::Vertex*> best(0.0, nullptr);
+        for (const graph::VertexPtr& parent : vertex->getParents()) {
+            auto pos = path_time.find(parent.get());
+            if (pos != path_time.end() && (!best.second || pos->second.first > best.first)) {
+                best = std::make_pair(pos->second.first, parent.get());
+            }
+        }
+        best.first += load.mean_process_time;
+        path_time[vertex.get()] = best;
+
+        if (vertex->getChildren().empty() && best.first > path_end_time) {
+            path_end_time = best.first;
+            path_end = vertex.get();
+        }
+
+        report.nodes.push_back(load);
+
+        if (nf->isGraph()) {
+            if (GraphFacadeImplementationPtr subgraph = graph_facade.getLocalSubGraph(nf->getUUID())) {
+                analyzeGraph(*subgraph, window, report, node_samples, connection_samples);
+            }
+        }
+    }
+
+    if (path_end && path_end_time > report.critical_path_time) {
+        report.critical_path.clear();
+        for (graph::Vertex* v = path_end; v; v = path_time[v].second) {
+            report.critical_path.push_back(v->getAUUID());
+        }
+        std::reverse(report.critical_path.begin(), report.critical_path.end());
+        report.critical_path_time = path_end_time;
+    }
+}
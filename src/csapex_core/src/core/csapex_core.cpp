@@ -2,7 +2,10 @@
 #include <csapex/core/csapex_core.h>
 
 /// COMPONENT
+#include <csapex/core/auto_save.h>
 #include <csapex/core/bootstrap.h>
+#include <csapex/core/bottleneck_analyzer.h>
+#include <csapex/core/execution_mode_analyzer.h>
 #include <csapex/core/core_plugin.h>
 #include <csapex/core/exception_handler.h>
 #include <csapex/core/graphio.h>
@@ -17,27 +20,111 @@
 #include <csapex/model/node_runner.h>
 #include <csapex/model/node_state.h>
 #include <csapex/model/subgraph_node.h>
+#include <csapex/model/subprocess_pool.h>
+#include <csapex/model/token_memory.h>
+#include <csapex/model/token_provenance.h>
 #include <csapex/msg/any_message.h>
 #include <csapex/plugin/plugin_locator.h>
 #include <csapex/plugin/plugin_manager.hpp>
 #include <csapex/profiling/profiler_impl.h>
+#include <csapex/scheduling/auto_partitioner.h>
+#include <csapex/scheduling/thread_placement.h>
 #include <csapex/scheduling/thread_pool.h>
 #include <csapex/serialization/snippet.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
 #include <csapex/utility/assert.h>
 #include <csapex/utility/error_handling.h>
 #include <csapex/utility/stream_interceptor.h>
+#include <csapex/utility/stream_relay.h>
 #include <csapex/utility/thread.h>
 #include <csapex/utility/uuid_provider.h>
 #include <csapex/io/server.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <fstream>
+#include <boost/iostreams/device/mapped_file.hpp>
 #ifdef WIN32
 #include <direct.h>
 #endif
 
 using namespace csapex;
 
+namespace
+{
+/**
+ * A compiled graph consists of the magic string, a header buffer describing the source file
+ * and a body buffer containing the settings and the graph in binary form.
+ */
+const std::string COMPILED_GRAPH_MAGIC = "APEXGRPH";
+const SemanticVersion COMPILED_GRAPH_VERSION(1, 0, 0);
+
+struct CompiledGraphHeader
+{
+    SemanticVersion version;
+    std::string source_file;
+    uint64_t source_size;
+    int64_t source_time;
+};
+
+bool readCompiledGraphHeader(const boost::iostreams::mapped_file_source& file, CompiledGraphHeader& header, std::size_t& body_offset)
+{
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(file.data());
+    const std::size_t magic_length = COMPILED_GRAPH_MAGIC.size();
+
+    if (file.size() < magic_length + SerializationBuffer::HEADER_LENGTH || !std::equal(COMPILED_GRAPH_MAGIC.begin(), COMPILED_GRAPH_MAGIC.end(), file.data())) {
+        return false;
+    }
+
+    uint32_t header_length = 0;
+    for (std::size_t byte = 0; byte < SerializationBuffer::HEADER_LENGTH; ++byte) {
+        header_length |= raw[magic_length + byte] << (byte * 8);
+    }
+    if (magic_length + header_length > file.size()) {
+        return false;
+    }
+
+    SerializationBuffer data(raw + magic_length, header_length);
+    data >> header.version;
+    if (header.version != COMPILED_GRAPH_VERSION) {
+        return false;
+    }
+    data >> header.source_file;
+    data >> header.source_size;
+    data >> header.source_time;
+
+    body_offset = magic_length + header_length;
+    return true;
+}
+
+bool isCompiledGraph(const std::string& file)
+{
+    std::ifstream in(file, std::ios::binary);
+    std::string magic(COMPILED_GRAPH_MAGIC.size(), '\0');
+    in.read(&magic.at(0), magic.size());
+    return in && magic == COMPILED_GRAPH_MAGIC;
+}
+
+bool isCompiledGraphFresh(const std::string& compiled_file, const std::string& source_file)
+{
+    if (!bf3::exists(compiled_file) || !isCompiledGraph(compiled_file)) {
+        return false;
+    }
+
+    boost::iostreams::mapped_file_source mapped(compiled_file);
+    CompiledGraphHeader header;
+    std::size_t body_offset;
+    if (!readCompiledGraphHeader(mapped, header, body_offset)) {
+        return false;
+    }
+
+    return header.source_size == bf3::file_size(source_file) && header.source_time == static_cast<int64_t>(bf3::last_write_time(source_file));
+}
+
+}  // namespace
+
 CsApexCore::CsApexCore(Settings& settings, ExceptionHandler& handler, csapex::PluginLocatorPtr plugin_locator)
   : bootstrap_(std::make_shared<Bootstrap>())
   , settings_(settings)
@@ -57,6 +144,22 @@ CsApexCore::CsApexCore(Settings& settings, ExceptionHandler& handler, csapex::Pl
     thread_pool_ = std::make_shared<ThreadPool>(exception_handler_, !settings_.get<bool>("threadless", false), settings_.get<bool>("thread_grouping", true));
     thread_pool_->setPause(settings_.get<bool>("initially_paused", false));
 
+    TokenProvenance::setTracingEnabled(settings_.get<bool>("trace_token_latency", false));
+    TokenMemoryTracker::setAccountingEnabled(settings_.get<bool>("account_token_memory", false));
+    NodeRunner::setChainFusionEnabled(settings_.get<bool>("fuse_sync_chains", false));
+    SubprocessPool::instance().setGranularity(SubprocessPool::parseGranularity(settings_.get<std::string>("isolation_granularity", "node")));
+    SubprocessPool::instance().setWorkerCount(settings_.get<int>("isolation_workers", static_cast<int>(SubprocessPool::instance().getWorkerCount())));
+
+    int undo_history_length = settings_.get<int>("undo_history_length", 0);
+    int undo_history_memory_mb = settings_.get<int>("undo_history_memory_mb", 0);
+    if (undo_history_length < 0 || undo_history_memory_mb < 0) {
+        std::cerr << "negative undo history limits are ignored, 0 disables a limit" << std::endl;
+    }
+    dispatcher_->setHistoryLimits(std::max(0, undo_history_length), static_cast<std::size_t>(std::max(0, undo_history_memory_mb)) << 20);
+    dispatcher_->setSpillDirectory(settings_.get<std::string>("undo_history_spill_directory", ""));
+
+    applyLogLevel();
+
     observe(thread_pool_->paused, paused);
 
     observe(thread_pool_->stepping_enabled, stepping_enabled);
@@ -237,6 +340,7 @@ void CsApexCore::init()
         }
 
         observe(node_factory_->new_node_type, new_node_type);
+        SubprocessPool::instance().setNodeFactory(node_factory_);
         observe(node_factory_->node_constructed, [this](NodeFacadePtr n) { n->getNodeState()->setMaximumFrequency(settings_.getPersistent("default_frequency", 60)); });
 
         status_changed("make graph");
@@ -254,6 +358,19 @@ void CsApexCore::init()
         root_ = std::make_shared<GraphFacadeImplementation>(*thread_pool_, graph_local, graph, root_facade_);
         root_->notification.connect(notification);
 
+        bottleneck_analyzer_ = std::make_shared<BottleneckAnalyzer>(root_);
+        execution_mode_analyzer_ = std::make_shared<ExecutionModeAnalyzer>(root_);
+
+        thread_placement_ = std::make_shared<ThreadPlacement>(*thread_pool_, root_);
+        thread_placement_->setEnabled(settings_.get<bool>("auto_thread_placement", false));
+
+        auto_partitioner_ = std::make_shared<AutoPartitioner>(*thread_pool_, root_, dispatcher_);
+        thread_pool_->setAutoPartitionGroupCount(settings_.get<int>("auto_partition_groups", 0));
+
+        auto_save_ = std::make_shared<AutoSave>(
+            [this](const GraphIO::NodeFilter& is_unchanged, const GraphIO::NodeStateWriter& write_state) { return snapshot(is_unchanged, write_state); });
+        auto_save_->setHeader("#!" + settings_.get<std::string>("path_to_bin", ""));
+
         if (is_root_) {
             root_->getSubgraphNode()->createInternalSlot(makeEmpty<connection_types::AnyMessage>(), root_->getLocalGraph()->makeUUID("slot_save"), "save",
                                                          [this](const TokenPtr&) { saveAs(getSettings().get<std::string>("config")); });
@@ -313,7 +430,7 @@ void CsApexCore::startup()
             load(cfg);
 
         } else {
-            load(settings_.get<std::string>("config_recovery_file"));
+            loadConfig(settings_.get<std::string>("config_recovery_file"), false);
             settings_.set("config", cfg);
         }
 
@@ -338,6 +455,9 @@ void CsApexCore::startMainLoop()
 
         while (running_) {
             getCommandDispatcher()->executeLater();
+            bottleneck_analyzer_->tick();
+            auto_partitioner_->tick();
+            thread_placement_->tick();
 
             running_changed_.wait_for(lock, std::chrono::milliseconds(10));
         }
@@ -449,6 +569,45 @@ ThreadPoolPtr CsApexCore::getThreadPool() const
     return thread_pool_;
 }
 
+BottleneckAnalyzerPtr CsApexCore::getBottleneckAnalyzer() const
+{
+    return bottleneck_analyzer_;
+}
+
+ExecutionModeAnalyzerPtr CsApexCore::getExecutionModeAnalyzer() const
+{
+    return execution_mode_analyzer_;
+}
+
+ExecutionModeReport CsApexCore::inferExecutionModes()
+{
+    ExecutionModeReport report = execution_mode_analyzer_->analyze();
+    if (CommandPtr cmd = execution_mode_analyzer_->makeCommand(report)) {
+        getCommandDispatcher()->execute(cmd);
+    }
+    return report;
+}
+
+ThreadPlacementPtr CsApexCore::getThreadPlacement() const
+{
+    return thread_placement_;
+}
+
+AutoPartitionerPtr CsApexCore::getAutoPartitioner() const
+{
+    return auto_partitioner_;
+}
+
+AutoSavePtr CsApexCore::getAutoSave() const
+{
+    return auto_save_;
+}
+
+TokenMemoryStatistics CsApexCore::getTokenMemoryStatistics() const
+{
+    return TokenMemoryTracker::instance().getStatistics();
+}
+
 PluginLocatorPtr CsApexCore::getPluginLocator() const
 {
     return plugin_locator_;
@@ -471,10 +630,22 @@ std::shared_ptr<Profiler> CsApexCore::getProfiler() const
 
 void CsApexCore::settingsChanged()
 {
+    applyLogLevel();
+
     settings_.savePersistent();
     config_changed();
 }
 
+void CsApexCore::applyLogLevel()
+{
+    std::string level = settings_.get<std::string>("log_level", "debug");
+    try {
+        StreamRelay::setMinimumLevel(StreamRelay::parseLevel(level));
+    } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << ", use debug, info, warning or error" << std::endl;
+    }
+}
+
 void CsApexCore::saveAs(const std::string& file, bool quiet)
 {
     TimerPtr timer = getProfiler()->getTimer("save graph");
@@ -493,10 +664,47 @@ void CsApexCore::saveAs(const std::string& file, bool quiet)
         }
     }
 
+    YAML::Node node_map = snapshot();
+
+    YAML::Emitter yaml;
+
+    {
+        auto interlude = timer->step("emit yaml");
+        yaml << node_map;
+    }
+
+    //    std::cerr << yaml.c_str() << std::endl;
+    {
+        auto interlude = timer->step("write yaml");
+        std::ofstream ofs(file.c_str());
+        ofs << "#!" << settings_.get<std::string>("path_to_bin") << '\n';
+        ofs << yaml.c_str();
+    }
+
+    timer->finish();
+
+    if (!quiet) {
+        if (settings_.getPersistent("use_graph_cache", true)) {
+            try {
+                saveCompiled(getCompiledPath(file), file);
+            } catch (const std::exception& e) {
+                std::cerr << "cannot update the compiled graph for " << file << ": " << e.what() << std::endl;
+            }
+        }
+
+        saved();
+    }
+}
+
+YAML::Node CsApexCore::snapshot(const std::function<bool(const NodeFacadeImplementation&)>& is_unchanged,
+                                const std::function<void(const NodeFacadeImplementation&, YAML::Node&)>& write_state)
+{
     YAML::Node node_map(YAML::NodeType::Map);
 
     GraphIO graphio(*root_, node_factory_.get());
     graphio.useProfiler(getProfiler());
+    graphio.setUnchangedNodeFilter(is_unchanged);
+    graphio.setNodeStateWriter(write_state);
     slim_signal::ScopedConnection connection = graphio.saveViewRequest.connect(save_detail_request);
 
     settings_.saveTemporary(node_map);
@@ -505,26 +713,74 @@ void CsApexCore::saveAs(const std::string& file, bool quiet)
     graphio.saveSettings(node_map);
     graphio.saveGraphTo(node_map);
 
-    YAML::Emitter yaml;
+    return node_map;
+}
 
+void CsApexCore::compile(const std::string& file)
+{
+    loadConfig(file, false);
+    saveCompiled(getCompiledPath(file), file);
+}
+
+void CsApexCore::saveCompiled(const std::string& file, const std::string& source_file)
+{
+    TimerPtr timer = getProfiler()->getTimer("save compiled graph");
+    timer->restart();
+
+    SerializationBuffer header;
+    header << COMPILED_GRAPH_VERSION;
+    header << source_file;
+    header << static_cast<uint64_t>(bf3::file_size(source_file));
+    header << static_cast<int64_t>(bf3::last_write_time(source_file));
+    header.finalize();
+
+    SerializationBuffer data;
     {
-        auto interlude = timer->step("emit yaml");
-        yaml << node_map;
+        auto interlude = timer->step("serialize settings");
+
+        YAML::Node config(YAML::NodeType::Map);
+        settings_.saveTemporary(config);
+        thread_pool_->saveSettings(config);
+        data.writeYaml(config);
     }
 
-    //    std::cerr << yaml.c_str() << std::endl;
+    GraphIO graphio(*root_, node_factory_.get());
+    graphio.useProfiler(getProfiler());
+    slim_signal::ScopedConnection connection = graphio.saveViewRequest.connect(save_detail_request);
+
+    graphio.saveSettings(data);
+    graphio.saveGraphTo(data);
+    data.finalize();
+
     {
-        auto interlude = timer->step("write yaml");
-        std::ofstream ofs(file.c_str());
-        ofs << "#!" << settings_.get<std::string>("path_to_bin") << '\n';
-        ofs << yaml.c_str();
+        auto interlude = timer->step("write binary");
+
+        // write to a temporary file first, a crash must never leave a truncated graph behind
+        std::string tmp_file = file + ".tmp";
+        {
+            std::ofstream out(tmp_file, std::ios::binary);
+            if (!out) {
+                throw std::runtime_error("cannot open file " + tmp_file + " for writing");
+            }
+            out.write(COMPILED_GRAPH_MAGIC.data(), COMPILED_GRAPH_MAGIC.size());
+            out.write(reinterpret_cast<const char*>(header.data()), header.size());
+            out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        }
+        bf3::rename(tmp_file, file);
     }
 
     timer->finish();
+}
 
-    if (!quiet) {
-        saved();
+std::string CsApexCore::getCompiledPath(const std::string& file)
+{
+    bf3::path path(file);
+    if (path.extension() == Settings::config_extension) {
+        path.replace_extension(Settings::config_extension_compiled);
+    } else {
+        path += Settings::config_extension_compiled;
     }
+    return path.string();
 }
 
 SnippetPtr CsApexCore::serializeNodes(const AUUID& graph_id, const std::vector<UUID>& nodes) const
@@ -535,6 +791,11 @@ SnippetPtr CsApexCore::serializeNodes(const AUUID& graph_id, const std::vector<U
 }
 
 void CsApexCore::load(const std::string& file)
+{
+    loadConfig(file, settings_.getPersistent("use_graph_cache", true));
+}
+
+void CsApexCore::loadConfig(const std::string& file, bool use_compiled)
 {
     settings_.set("config", file);
 
@@ -550,25 +811,41 @@ void CsApexCore::load(const std::string& file)
 
     apex_assert_hard(root_->getLocalGraph()->countNodes() == 0);
 
-    GraphIO graphio(*root_, node_factory_.get());
-    slim_signal::ScopedConnection connection = graphio.loadViewRequest.connect(load_detail_request);
-
-    graphio.useProfiler(profiler_);
-
     if (bf3::exists(file)) {
-        YAML::Node node_map = YAML::LoadFile(file.c_str());
+        if (isCompiledGraph(file)) {
+            std::string source_file = loadCompiled(file);
+            settings_.set("config", source_file);
+
+        } else {
+            std::string compiled_file = getCompiledPath(file);
+
+            bool loaded_compiled = false;
+            if (use_compiled && isCompiledGraphFresh(compiled_file, file)) {
+                try {
+                    loadCompiled(compiled_file);
+                    loaded_compiled = true;
+
+                } catch (const std::exception& e) {
+                    std::cerr << "cannot load the compiled graph " << compiled_file << ", falling back to " << file << ": " << e.what() << std::endl;
+                    root_->clear();
+                }
+            }
 
-        // first load settings
-        settings_.loadTemporary(node_map);
-        // make sure the config setting is correct
-        settings_.set("config", file);
+            if (!loaded_compiled) {
+                loadYaml(file);
 
-        // then load the graph
-        graphio.loadSettings(node_map);
-        graphio.loadGraphFrom(node_map);
+                if (use_compiled) {
+                    try {
+                        saveCompiled(compiled_file, file);
+                    } catch (const std::exception& e) {
+                        std::cerr << "cannot write the compiled graph " << compiled_file << ": " << e.what() << std::endl;
+                    }
+                }
+            }
 
-        // finally load thread affinities, _after_ the nodes are loaded
-        thread_pool_->loadSettings(node_map);
+            // make sure the config setting is correct
+            settings_.set("config", file);
+        }
     }
 
     load_needs_reset_ = true;
@@ -583,6 +860,68 @@ void CsApexCore::load(const std::string& file)
     }
 }
 
+void CsApexCore::loadYaml(const std::string& file)
+{
+    GraphIO graphio(*root_, node_factory_.get());
+    slim_signal::ScopedConnection connection = graphio.loadViewRequest.connect(load_detail_request);
+
+    graphio.useProfiler(profiler_);
+
+    YAML::Node node_map = YAML::LoadFile(file.c_str());
+
+    // first load settings
+    settings_.loadTemporary(node_map);
+
+    // then load the graph
+    graphio.loadSettings(node_map);
+    graphio.loadGraphFrom(node_map);
+
+    // finally load thread affinities, _after_ the nodes are loaded
+    thread_pool_->loadSettings(node_map);
+}
+
+std::string CsApexCore::loadCompiled(const std::string& file)
+{
+    TimerPtr timer = getProfiler()->getTimer("load compiled graph");
+    timer->restart();
+
+    boost::iostreams::mapped_file_source mapped(file);
+
+    CompiledGraphHeader header;
+    std::size_t body_offset;
+    if (!readCompiledGraphHeader(mapped, header, body_offset)) {
+        throw std::runtime_error(file + " is not a compiled graph of a supported version");
+    }
+
+    SerializationBuffer data(reinterpret_cast<const uint8_t*>(mapped.data()) + body_offset, mapped.size() - body_offset);
+
+    YAML::Node config;
+    {
+        auto interlude = timer->step("load settings");
+        data.readYaml(config);
+        if (!config.IsNull()) {
+            settings_.loadTemporary(config);
+        }
+    }
+
+    GraphIO graphio(*root_, node_factory_.get());
+    slim_signal::ScopedConnection connection = graphio.loadViewRequest.connect(load_detail_request);
+
+    graphio.useProfiler(profiler_);
+
+    graphio.loadSettings(data);
+    graphio.loadGraphFrom(data);
+
+    // thread affinities have to be loaded _after_ the nodes are loaded
+    if (!config.IsNull()) {
+        thread_pool_->loadSettings(config);
+    }
+
+    timer->finish();
+
+    return header.source_file;
+}
+
 int CsApexCore::getReturnCode() const
 {
     return return_code_;
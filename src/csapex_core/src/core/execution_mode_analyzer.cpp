@@ -0,0 +1,206 @@
+/// HEADER
+#include <csapex/core/execution_mode_analyzer.h>
+
+/// PROJECT
+#include <csapex/command/meta.h>
+#include <csapex/command/set_execution_mode.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph/vertex.h>
+#include <csapex/model/node.h>
+#include <csapex/model/node_characteristics.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_state.h>
+#include <csapex/signal/event.h>
+#include <csapex/signal/slot.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <iomanip>
+
+using namespace csapex;
+
+namespace
+{
+const char* toString(ExecutionMode mode)
+{
+    switch (mode) {
+        case ExecutionMode::PIPELINING:
+            return "PIPELINING";
+        case ExecutionMode::SEQUENTIAL:
+            return "SEQUENTIAL";
+    }
+    return "";
+}
+
+template <typename Connectables>
+bool anyConnected(const Connectables& connectables)
+{
+    for (const auto& connectable : connectables) {
+        if (connectable->isConnected()) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+ExecutionModeDecision::ExecutionModeDecision() : depth(-1), current(ExecutionMode::SEQUENTIAL), suggested(ExecutionMode::SEQUENTIAL)
+{
+}
+
+bool ExecutionModeDecision::isPromotion() const
+{
+    return current != suggested;
+}
+
+std::vector<ExecutionModeDecision> ExecutionModeReport::promotions() const
+{
+    std::vector<ExecutionModeDecision> result;
+    for (const ExecutionModeDecision& decision : nodes) {
+        if (decision.isPromotion()) {
+            result.push_back(decision);
+        }
+    }
+    return result;
+}
+
+std::ostream& csapex::operator<<(std::ostream& out, const ExecutionModeReport& report)
+{
+    out << std::left << std::setw(40) << "node" << std::right << std::setw(8) << "depth" << "  " << std::left << std::setw(12) << "current" << std::setw(12) << "suggested"
+        << "reason" << '\n';
+
+    std::size_t promoted = 0;
+    for (const ExecutionModeDecision& decision : report.nodes) {
+        out << std::left << std::setw(40) << decision.label << std::right << std::setw(8) << decision.depth << (decision.isPromotion() ? " *" : "  ") << std::left << std::setw(12)
+            << toString(decision.current) << std::setw(12) << toString(decision.suggested) << decision.reason << '\n';
+        if (decision.isPromotion()) {
+            ++promoted;
+        }
+    }
+    out << std::right;
+
+    out << promoted << " of " << report.nodes.size() << " nodes can be promoted to PIPELINING\n";
+    return out;
+}
+
+ExecutionModeAnalyzer::ExecutionModeAnalyzer(GraphFacadeImplementationPtr root) : root_(root)
+{
+}
+
+ExecutionModeReport ExecutionModeAnalyzer::analyze() const
+{
+    ExecutionModeReport report;
+    analyzeGraph(*root_, report);
+    return report;
+}
+
+CommandPtr ExecutionModeAnalyzer::makeCommand(const ExecutionModeReport& report) const
+{
+    std::vector<ExecutionModeDecision> promotions = report.promotions();
+    if (promotions.empty()) {
+        return nullptr;
+    }
+
+    // node uuids are absolute, so they are all resolved relative to the root graph
+    AUUID root_uuid = root_->getAbsoluteUUID();
+    std::shared_ptr<command::Meta> cmd = std::make_shared<command::Meta>(root_uuid, "infer execution modes");
+    for (const ExecutionModeDecision& decision : promotions) {
+        cmd->add(std::make_shared<command::SetExecutionMode>(root_uuid, decision.node, decision.suggested));
+    }
+    return cmd;
+}
+
+void ExecutionModeAnalyzer::apply(const ExecutionModeReport& report) const
+{
+    GraphImplementationPtr graph = root_->getLocalGraph();
+    for (const ExecutionModeDecision& decision : report.promotions()) {
+        if (NodeHandle* nh = graph->findNodeHandleNoThrow(decision.node)) {
+            nh->getNodeState()->setExecutionMode(decision.suggested);
+        }
+    }
+}
+
+void ExecutionModeAnalyzer::analyzeGraph(GraphFacadeImplementation& graph_facade, ExecutionModeReport& report) const
+{
+    GraphImplementationPtr graph = graph_facade.getLocalGraph();
+
+    std::vector<graph::VertexPtr> vertices(graph->begin(), graph->end());
+    std::sort(vertices.begin(), vertices.end(), [](const graph::VertexPtr& a, const graph::VertexPtr& b) { return a->getNodeCharacteristics().depth < b->getNodeCharacteristics().depth; });
+
+    for (const graph::VertexPtr& vertex : vertices) {
+        NodeFacadeImplementationPtr nf = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+        if (!nf) {
+            continue;
+        }
+
+        ExecutionModeDecision decision;
+        decision.node = nf->getAUUID();
+        decision.label = nf->getLabel();
+        decision.depth = vertex->getNodeCharacteristics().depth;
+        decision.current = nf->getNodeHandle()->getNodeState()->getExecutionMode();
+        decision.suggested = decision.current;
+
+        if (decide(*vertex, decision)) {
+            decision.suggested = ExecutionMode::PIPELINING;
+        }
+
+        report.nodes.push_back(decision);
+
+        if (nf->isGraph()) {
+            if (GraphFacadeImplementationPtr subgraph = graph_facade.getLocalSubGraph(nf->getUUID())) {
+                analyzeGraph(*subgraph, report);
+            }
+        }
+    }
+}
+
+bool ExecutionModeAnalyzer::decide(const graph::Vertex& vertex, ExecutionModeDecision& decision) const
+{
+    NodeFacadeImplementationPtr nf = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex.getNodeFacade());
+    NodeHandlePtr nh = nf->getNodeHandle();
+    const NodeCharacteristics& characteristics = vertex.getNodeCharacteristics();
+
+    if (decision.current == ExecutionMode::PIPELINING) {
+        decision.reason = "already pipelining";
+        return false;
+    }
+    if (nf->isGraph()) {
+        decision.reason = "subgraph, its outputs are produced by the nested nodes";
+        return false;
+    }
+    if (nh->isSource()) {
+        decision.reason = "source, has no inputs to release";
+        return false;
+    }
+    if (nh->isSink()) {
+        decision.reason = "sink, releases its inputs right after processing anyway";
+        return false;
+    }
+    if (characteristics.is_joining_vertex || characteristics.is_joining_vertex_counterpart) {
+        decision.reason = "joins branches that have to stay in lockstep";
+        return false;
+    }
+    if (characteristics.is_combined_by_joining_vertex || characteristics.is_leading_to_joining_vertex) {
+        decision.reason = "on a branch that is joined later";
+        return false;
+    }
+    if (characteristics.is_leading_to_essential_vertex) {
+        decision.reason = "leads to an essential input";
+        return false;
+    }
+    if (anyConnected(nh->getExternalSlots()) || anyConnected(nh->getExternalEvents())) {
+        decision.reason = "is driven by events";
+        return false;
+    }
+    if (NodePtr node = nh->getNode().lock()) {
+        if (node->isAsynchronous()) {
+            decision.reason = "processes asynchronously";
+            return false;
+        }
+    }
+
+    decision.reason = "on a linear chain, upstream can continue while outputs are pending";
+    return true;
+}
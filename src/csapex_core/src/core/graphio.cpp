@@ -6,7 +6,8 @@
 #include <csapex/model/node_handle.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/factory/node_factory_impl.h>
-#include <csapex/msg/direct_connection.h>
+#include <csapex/model/connection.h>
+#include <csapex/msg/connection_factory.h>
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/subgraph_node.h>
@@ -22,14 +23,19 @@
 #include <csapex/utility/yaml_node_builder.h>
 #include <csapex/serialization/node_serializer.h>
 #include <csapex/serialization/snippet.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
 #include <csapex/utility/yaml_io.hpp>
 #include <csapex/utility/exceptions.h>
 #include <csapex/profiling/profiler.h>
 #include <csapex/profiling/timer.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <iostream>
+#include <limits>
 #include <fstream>
 #include <yaml-cpp/yaml.h>
 #include <sys/types.h>
@@ -53,6 +59,16 @@ void GraphIO::setIgnoreForwardingConnections(bool ignore)
     ignore_forwarding_connections_ = ignore;
 }
 
+void GraphIO::setUnchangedNodeFilter(const NodeFilter& is_unchanged)
+{
+    is_unchanged_ = is_unchanged;
+}
+
+void GraphIO::setNodeStateWriter(const NodeStateWriter& write_state)
+{
+    write_state_ = write_state;
+}
+
 void GraphIO::saveSettings(YAML::Node& doc)
 {
     doc["uuid_map"] = graph_.getLocalGraph()->getUUIDMap();
@@ -123,6 +139,63 @@ void GraphIO::loadGraphFrom(const YAML::Node& doc)
     timer->finish();
 }
 
+void GraphIO::saveSettings(SerializationBuffer& data)
+{
+    data << graph_.getLocalGraph()->getUUIDMap();
+}
+
+void GraphIO::loadSettings(const SerializationBuffer& data)
+{
+    std::map<std::string, int> uuid_map;
+    data >> uuid_map;
+    graph_.getLocalGraph()->uuids_ = uuid_map;
+}
+
+void GraphIO::saveGraphTo(SerializationBuffer& data)
+{
+    TimerPtr timer = getProfiler()->getTimer("save graph");
+    timer->restart();
+
+    saveNodes(data);
+    saveConnections(data);
+
+    {
+        auto interlude = timer->step("save view");
+        YAML::Node view;
+        saveViewRequest(graph_, view);
+        data.writeYaml(view);
+    }
+
+    timer->finish();
+}
+
+void GraphIO::loadGraphFrom(const SerializationBuffer& data)
+{
+    TimerPtr timer = getProfiler()->getTimer("load graph");
+    timer->restart();
+
+    graph_.getLocalGraph()->beginTransaction();
+    {
+        auto interlude = timer->step("load nodes");
+        loadNodes(data);
+    }
+
+    {
+        auto interlude = timer->step("load connections");
+        loadConnections(data);
+    }
+    graph_.getLocalGraph()->finalizeTransaction();
+
+    {
+        auto interlude = timer->step("load view");
+        YAML::Node view;
+        data.readYaml(view);
+        loadViewRequest(graph_, view);
+    }
+
+    timer->finish();
+}
+
 Snippet GraphIO::saveSelectedGraph(const std::vector<UUID>& uuids)
 {
     YAML::Node yaml = YAML::Node(YAML::NodeType::Map);
@@ -243,7 +316,12 @@ void GraphIO::loadNodes(const YAML::Node& doc)
 
 UUID GraphIO::readNodeUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc)
 {
-    UUID uuid = UUIDProvider::makeUUID_forced(parent, doc.as<std::string>());
+    return readNodeUUID(parent, doc.as<std::string>());
+}
+
+UUID GraphIO::readNodeUUID(std::weak_ptr<UUIDProvider> parent, const std::string& id)
+{
+    UUID uuid = UUIDProvider::makeUUID_forced(parent, id);
 
     if (!old_node_uuid_to_new_.empty()) {
         auto pos = old_node_uuid_to_new_.find(uuid);
@@ -257,7 +335,12 @@ UUID GraphIO::readNodeUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node&
 
 UUID GraphIO::readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc)
 {
-    std::string id = doc.as<std::string>();
+    return readConnectorUUID(parent, doc.as<std::string>());
+}
+
+UUID GraphIO::readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const std::string& connector_id)
+{
+    std::string id = connector_id;
 
     // backward compatibility (trigger instead of event)
     {
@@ -302,6 +385,177 @@ void GraphIO::loadNode(const YAML::Node& doc)
     }
 }
 
+void GraphIO::saveNodes(SerializationBuffer& data)
+{
+    std::vector<NodeFacadeImplementationPtr> nodes = graph_.getLocalGraph()->getAllLocalNodeFacades();
+
+    data << static_cast<uint32_t>(nodes.size());
+    for (const NodeFacadeImplementationPtr& node : nodes) {
+        // every node is stored as a length-prefixed record, so that unknown node types can be skipped
+        std::size_t start = data.size();
+        data << static_cast<uint32_t>(0);
+
+        try {
+            serializeNode(data, node);
+        } catch (const std::exception& e) {
+            sendNotificationStreamGraphio("cannot save state for node " << node->getUUID() << ": " << e.what());
+            throw e;
+        }
+
+        uint32_t length = data.size() - start;
+        for (std::size_t byte = 0; byte < sizeof(uint32_t); ++byte) {
+            data.at(start + byte) = (length >> (byte * 8)) & 0xFF;
+        }
+    }
+}
+
+void GraphIO::loadNodes(const SerializationBuffer& data)
+{
+    uint32_t nodes;
+    data >> nodes;
+    for (uint32_t i = 0; i < nodes; ++i) {
+        uint32_t start = data.getPos();
+        uint32_t length;
+        data >> length;
+
+        try {
+            loadNode(data);
+        } catch (const std::exception& e) {
+            sendNotificationStreamGraphio("cannot load node: " << e.what());
+        }
+
+        data.seek(start + length);
+    }
+}
+
+void GraphIO::loadNode(const SerializationBuffer& data)
+{
+    std::string uuid_str;
+    data >> uuid_str;
+    std::string type;
+    data >> type;
+
+    TimerPtr timer = getProfiler()->getTimer("load graph");
+    auto interlude = timer->step(uuid_str);
+
+    UUID uuid = readNodeUUID(graph_.getLocalGraph()->shared_from_this(), uuid_str);
+
+    NodeFacadeImplementationPtr node_facade = node_factory_->makeNode(type, uuid, graph_.getLocalGraph());
+    if (!node_facade) {
+        return;
+    }
+
+    try {
+        deserializeNode(data, node_facade);
+
+    } catch (const std::exception& e) {
+        sendNotificationStreamGraphio("cannot load state for box " << uuid << ": " << type2name(typeid(e)) << ", what=" << e.what());
+    }
+}
+
+namespace
+{
+// connection lists of older versions start directly with their size
+const uint32_t VERSIONED_CONNECTIONS = std::numeric_limits<uint32_t>::max();
+// 0.1.0 adds the connection policy
+const SemanticVersion CONNECTIONS_VERSION(0, 1, 0);
+}  // namespace
+
+void GraphIO::saveConnections(SerializationBuffer& data)
+{
+    auto interlude = getProfiler()->getTimer("save graph")->step("save connections");
+
+    std::vector<ConnectionDescription> connections;
+    for (const ConnectionDescription& connection : graph_.enumerateAllConnections()) {
+        if (ignore_forwarding_connections_) {
+            if (connection.from.type() == "relayout" || connection.to.type() == "relayin" || connection.from.type() == "relayevent" || connection.to.type() == "relayslot") {
+                continue;
+            }
+        }
+        connections.push_back(connection);
+    }
+
+    data << VERSIONED_CONNECTIONS;
+    data << CONNECTIONS_VERSION;
+    data << static_cast<uint32_t>(connections.size());
+    for (const ConnectionDescription& connection : connections) {
+        data << connection.from.getFullName();
+        data << connection.to.getFullName();
+        data << connection.active;
+        data << connection.policy;
+
+        data << static_cast<uint32_t>(connection.fulcrums.size());
+        for (const Fulcrum& f : connection.fulcrums) {
+            data << f.type();
+            data << f.pos().x << f.pos().y;
+            data << f.handleIn().x << f.handleIn().y;
+            data << f.handleOut().x << f.handleOut().y;
+        }
+    }
+}
+
+void GraphIO::loadConnections(const SerializationBuffer& data)
+{
+    SemanticVersion version;
+    uint32_t connections;
+    data >> connections;
+    if (connections == VERSIONED_CONNECTIONS) {
+        data >> version;
+        data >> connections;
+    }
+
+    for (uint32_t i = 0; i < connections; ++i) {
+        std::string from_str, to_str;
+        bool active;
+        ConnectionPolicy policy = ConnectionPolicy::HANDSHAKE;
+        data >> from_str >> to_str >> active;
+        if (version >= SemanticVersion(0, 1, 0)) {
+            // connections of older versions always perform a handshake
+            data >> policy;
+        }
+
+        uint32_t fulcrum_count;
+        data >> fulcrum_count;
+        std::vector<Fulcrum> fulcrums;
+        for (uint32_t j = 0; j < fulcrum_count; ++j) {
+            int type;
+            Point pos, in, out;
+            data >> type;
+            data >> pos.x >> pos.y;
+            data >> in.x >> in.y;
+            data >> out.x >> out.y;
+            fulcrums.emplace_back(0, pos, type, in, out);
+        }
+
+        try {
+            UUID from_uuid = readConnectorUUID(graph_.getLocalGraph()->shared_from_this(), from_str);
+            UUID to_uuid = readConnectorUUID(graph_.getLocalGraph()->shared_from_this(), to_str);
+
+            ConnectorPtr from = graph_.findConnectorNoThrow(from_uuid);
+            if (!from) {
+                sendNotificationStreamGraphio("cannot load connection from '" << from_uuid << "' to '" << to_uuid << "', '" << from_uuid << "' doesn't exist.");
+                continue;
+            }
+
+            loadConnection(from, to_uuid, active ? "active" : "default", policy);
+
+            if (!fulcrums.empty()) {
+                ConnectionPtr connection = graph_.getLocalGraph()->getConnection(from->getUUID(), to_uuid);
+                if (!connection) {
+                    continue;
+                }
+                for (std::size_t j = 0; j < fulcrums.size(); ++j) {
+                    const Fulcrum& f = fulcrums[j];
+                    connection->addFulcrum(j, f.pos(), f.type(), f.handleIn(), f.handleOut());
+                }
+            }
+
+        } catch (const std::exception& e) {
+            sendNotificationStreamGraphio("cannot load connection: " << e.what());
+        }
+    }
+}
+
 void GraphIO::saveConnections(YAML::Node& yaml)
 {
     auto interlude = getProfiler()->getTimer("save graph")->step("save connections");
@@ -310,7 +564,13 @@ void GraphIO::saveConnections(YAML::Node& yaml)
 
 void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDescription>& connections)
 {
-    std::unordered_map<UUID, std::vector<std::pair<UUID, std::string>>, UUID::Hasher> connection_map;
+    struct Target
+    {
+        UUID uuid;
+        std::string type;
+        ConnectionPolicy policy;
+    };
+    std::unordered_map<UUID, std::vector<Target>, UUID::Hasher> connection_map;
 
     for (const ConnectionDescription& connection : connections) {
         if (ignore_forwarding_connections_) {
@@ -321,7 +581,7 @@ void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDesc
 
         std::string type = connection.active ? "active" : "default";
 
-        connection_map[connection.from].push_back(std::make_pair(connection.to, type));
+        connection_map[connection.from].push_back(Target{ connection.to, type, connection.policy });
 
         if (!connection.fulcrums.empty()) {
             YAML::Node fulcrum;
@@ -334,9 +594,15 @@ void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDesc
     for (const auto& pair : connection_map) {
         YAML::Node entry(YAML::NodeType::Map);
         entry["uuid"] = pair.first.getFullName();
-        for (const auto& info : pair.second) {
-            entry["targets"].push_back(info.first.getFullName());
-            entry["types"].push_back(info.second);
+
+        bool handshake_only = std::all_of(pair.second.begin(), pair.second.end(), [](const Target& target) { return target.policy == ConnectionPolicy::HANDSHAKE; });
+        for (const Target& target : pair.second) {
+            entry["targets"].push_back(target.uuid.getFullName());
+            entry["types"].push_back(target.type);
+            if (!handshake_only) {
+                // only written when needed, so that files stay readable by older versions
+                entry["policies"].push_back(target.policy == ConnectionPolicy::LATEST_VALUE ? "latest_value" : "handshake");
+            }
         }
         yaml["connections"].push_back(entry);
     }
@@ -387,6 +653,9 @@ void GraphIO::loadConnection(const YAML::Node& connection)
     const YAML::Node& types = connection["types"];
     apex_assert_hard(!types.IsDefined() || (types.Type() == YAML::NodeType::Sequence && targets.size() == types.size()));
 
+    const YAML::Node& policies = connection["policies"];
+    apex_assert_hard(!policies.IsDefined() || (policies.Type() == YAML::NodeType::Sequence && targets.size() == policies.size()));
+
     for (unsigned j = 0; j < targets.size(); ++j) {
         UUID to_uuid = readConnectorUUID(graph_.getLocalGraph()->shared_from_this(), targets[j]);
 
@@ -397,9 +666,14 @@ void GraphIO::loadConnection(const YAML::Node& connection)
             connection_type = types[j].as<std::string>();
         }
 
+        ConnectionPolicy policy = ConnectionPolicy::HANDSHAKE;
+        if (policies.IsDefined() && policies[j].as<std::string>() == "latest_value") {
+            policy = ConnectionPolicy::LATEST_VALUE;
+        }
+
         ConnectorPtr from = graph_.findConnectorNoThrow(from_uuid);
         if (from) {
-            loadConnection(from, to_uuid, connection_type);
+            loadConnection(from, to_uuid, connection_type, policy);
         } else {
             sendNotificationStreamGraphio("cannot load connection from '" << from_uuid << "' to '" << to_uuid << "', '" << from_uuid << "' doesn't exist.");
         }
@@ -492,7 +766,7 @@ void GraphIO::loadFulcrum(const YAML::Node& fulcrum)
     }
 }
 
-void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type)
+void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type, ConnectionPolicy policy)
 {
     try {
         NodeHandle* target = graph_.getLocalGraph()->findNodeHandleForConnector(to_uuid);
@@ -506,8 +780,7 @@ void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::
         OutputPtr out = std::dynamic_pointer_cast<Output>(from);
 
         if (out && in) {
-            // TODO: make connection factory
-            ConnectionPtr c = DirectConnection::connect(out, in);
+            ConnectionPtr c = connection_factory::connect(out, in, policy);
             if (connection_type == "active") {
                 c->setActive(true);
             }
@@ -525,7 +798,17 @@ void GraphIO::serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr no
 {
     auto interlude = getProfiler()->getTimer("save graph")->step("serialize node");
 
-    node_facade->getNodeState()->writeYaml(doc);
+    if (is_unchanged_ && !node_facade->isGraph() && is_unchanged_(*node_facade)) {
+        doc["uuid"] = node_facade->getUUID().getFullName();
+        doc["cached"] = true;
+        return;
+    }
+
+    if (write_state_) {
+        write_state_(*node_facade, doc);
+    } else {
+        node_facade->getNodeState()->writeYaml(doc);
+    }
 
     auto node = node_facade->getNode();
     if (node) {
@@ -537,6 +820,8 @@ void GraphIO::serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr no
             if (subgraph) {
                 YAML::Node subgraph_yaml;
                 GraphIO sub_graph_io(*subgraph, node_factory_);
+                sub_graph_io.setUnchangedNodeFilter(is_unchanged_);
+                sub_graph_io.setNodeStateWriter(write_state_);
                 slim_signal::ScopedConnection connection = sub_graph_io.saveViewRequest.connect(saveViewRequest);
 
                 sub_graph_io.saveGraphTo(subgraph_yaml);
@@ -580,6 +865,76 @@ void GraphIO::deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr
     }
 }
 
+void GraphIO::serializeNode(SerializationBuffer& data, NodeFacadeImplementationConstPtr node_facade)
+{
+    auto interlude = getProfiler()->getTimer("save graph")->step("serialize node");
+
+    data << node_facade->getUUID().getFullName();
+    data << node_facade->getType();
+
+    node_facade->getNodeState()->writeBinary(data);
+
+    // hooks for nodes to serialize are still yaml based, most nodes don't have any
+    YAML::Node node_specific;
+    GraphFacadeImplementationPtr subgraph;
+
+    auto node = node_facade->getNode();
+    if (node) {
+        NodeSerializer::instance().serialize(*node, node_specific);
+
+        if (node_facade->isGraph()) {
+            subgraph = graph_.getLocalSubGraph(node_facade->getUUID());
+        }
+    }
+
+    data.writeYaml(node_specific);
+
+    data << (subgraph != nullptr);
+    if (subgraph) {
+        GraphIO sub_graph_io(*subgraph, node_factory_);
+        slim_signal::ScopedConnection connection = sub_graph_io.saveViewRequest.connect(saveViewRequest);
+
+        sub_graph_io.saveGraphTo(data);
+    }
+}
+
+void GraphIO::deserializeNode(const SerializationBuffer& data, NodeFacadeImplementationPtr node_facade)
+{
+    NodeState::Ptr s = node_facade->getNodeState();
+    s->readBinary(data);
+    s->getParameterState()->initializePersistentParameters();
+
+    if (position_offset_x_ != 0.0 || position_offset_y_ != 0.0) {
+        Point pos = s->getPos();
+        s->setPos(Point(pos.x + position_offset_x_, pos.y + position_offset_y_));
+    }
+
+    YAML::Node node_specific;
+    data.readYaml(node_specific);
+
+    // hook for nodes to deserialize
+    auto node = node_facade->getNode();
+    apex_assert_hard(node);
+
+    NodeSerializer::instance().deserialize(*node, node_specific);
+
+    graph_.getLocalGraph()->addNode(node_facade);
+
+    node_facade->handleChangedParameters();
+
+    bool has_subgraph;
+    data >> has_subgraph;
+    if (has_subgraph && node_facade->isGraph()) {
+        GraphFacadeImplementationPtr subgraph = graph_.getLocalSubGraph(node_facade->getUUID());
+        if (subgraph) {
+            GraphIO sub_graph_io(*subgraph, node_factory_, throw_on_error_);
+            slim_signal::ScopedConnection connection = sub_graph_io.loadViewRequest.connect(loadViewRequest);
+
+            sub_graph_io.loadGraphFrom(data);
+        }
+    }
+}
+
 void GraphIO::sendNotification(const std::string& notification)
 {
     if (throw_on_error_) {
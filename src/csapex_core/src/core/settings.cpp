@@ -29,10 +29,12 @@ using namespace csapex;
 
 const std::string Settings::settings_file = defaultConfigPath() + "cfg/persistent_settings";
 const std::string Settings::config_extension = ".apex";
+const std::string Settings::config_extension_compiled = ".apexc";
 const std::string Settings::template_extension = ".apexs";
 const std::string Settings::message_extension = ".apexm";
 const std::string Settings::message_extension_compressed = ".apexm.gz";
 const std::string Settings::message_extension_binary = ".apexb";
+const std::string Settings::message_log_extension = ".apexlog";
 const std::string Settings::default_config = Settings::defaultConfigFile();
 const std::string Settings::config_selector = "Configs(*" + Settings::config_extension + ");;LegacyConfigs(*.vecfg)";
 
@@ -85,6 +87,10 @@ void Settings::addTemporary(csapex::param::Parameter::Ptr p)
     add(p, false);
 }
 
+void Settings::flushPersistent()
+{
+}
+
 bool Settings::isDirty() const
 {
     return dirty_;
@@ -32,29 +32,99 @@ using namespace csapex;
 
 SettingsImplementation SettingsImplementation::NoSettings(false);
 
-SettingsImplementation::SettingsImplementation(bool load_from_config)
+SettingsImplementation::SettingsImplementation(bool load_from_config, const std::string& file)
+  : file_(file), persistent_dirty_(false), has_pending_(false), writing_(false), stop_writer_(false)
 {
     if (load_from_config) {
         loadPersistent();
     }
 }
 
+SettingsImplementation::~SettingsImplementation()
+{
+    {
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+        stop_writer_ = true;
+    }
+    writer_changed_.notify_all();
+
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
 void SettingsImplementation::savePersistent()
 {
-    YAML::Emitter yaml;
-    yaml << YAML::BeginSeq;
+    if (!persistent_dirty_.exchange(false)) {
+        return;
+    }
+
+    YAML::Node snapshot = snapshotPersistent();
+
+    {
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+        // nodes are references, assigning would overwrite the snapshot that is currently being written
+        pending_.reset(snapshot);
+        has_pending_ = true;
+
+        if (!writer_.joinable()) {
+            writer_ = std::thread(&SettingsImplementation::writeLoop, this);
+        }
+    }
+    writer_changed_.notify_all();
+}
+
+void SettingsImplementation::flushPersistent()
+{
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    writer_changed_.wait(lock, [this]() { return !has_pending_ && !writing_; });
+}
+
+YAML::Node SettingsImplementation::snapshotPersistent() const
+{
+    YAML::Node snapshot(YAML::NodeType::Sequence);
 
     for (auto it = settings_.begin(); it != settings_.end(); ++it) {
-        Entry& entry = it->second;
+        const Entry& entry = it->second;
         if (entry.persistent) {
-            csapex::param::Parameter::Ptr p = entry.parameter;
             YAML::Node n;
-            p->serialize_yaml(n);
-            yaml << n;
+            entry.parameter->serialize_yaml(n);
+            snapshot.push_back(n);
         }
     }
 
-    yaml << YAML::EndSeq;
+    return snapshot;
+}
+
+void SettingsImplementation::writeLoop()
+{
+    std::unique_lock<std::mutex> lock(writer_mutex_);
+    while (true) {
+        writer_changed_.wait(lock, [this]() { return has_pending_ || stop_writer_; });
+        if (!has_pending_) {
+            // only stop once everything is written
+            return;
+        }
+
+        YAML::Node snapshot;
+        snapshot.reset(pending_);
+        pending_.reset();
+        has_pending_ = false;
+        writing_ = true;
+
+        lock.unlock();
+        write(snapshot);
+        lock.lock();
+
+        writing_ = false;
+        writer_changed_.notify_all();
+    }
+}
+
+void SettingsImplementation::write(const YAML::Node& snapshot)
+{
+    YAML::Emitter yaml;
+    yaml << snapshot;
 
 #if WIN32
     uint32_t pid = GetCurrentProcessId();
@@ -62,24 +132,36 @@ void SettingsImplementation::savePersistent()
     uint32_t pid = getpid();
 #endif
 
-    bf3::path tmp_file = settings_file + "." + std::to_string(pid) + ".tmp";
-    bf3::create_directories(tmp_file.parent_path());
-
-    std::ofstream ofs(tmp_file.c_str());
-    ofs << yaml.c_str();
+    // write to a temporary file first, so that a crash never leaves a half written file behind
+    bf3::path tmp_file = file_ + "." + std::to_string(pid) + ".tmp";
+    try {
+        bf3::create_directories(tmp_file.parent_path());
+
+        {
+            std::ofstream ofs(tmp_file.c_str());
+            ofs << yaml.c_str();
+            ofs.flush();
+            if (!ofs) {
+                throw std::runtime_error("cannot write " + tmp_file.string());
+            }
+        }
 
-    bf3::rename(tmp_file, settings_file);
+        bf3::rename(tmp_file, file_);
 
-    bf3::remove(tmp_file);
+    } catch (const std::exception& e) {
+        std::cerr << "cannot save the settings: " << e.what() << std::endl;
+        boost::system::error_code ec;
+        bf3::remove(tmp_file, ec);
+    }
 }
 
 void SettingsImplementation::loadPersistent()
 {
-    if (!bf3::exists(settings_file)) {
+    if (!bf3::exists(file_)) {
         return;
     }
 
-    YAML::Node doc = YAML::LoadFile(settings_file.c_str());
+    YAML::Node doc = YAML::LoadFile(file_.c_str());
 
     if (doc.Type() != YAML::NodeType::Sequence) {
         std::cerr << "cannot read the settings" << std::endl;
@@ -94,6 +176,8 @@ void SettingsImplementation::loadPersistent()
         entry.parameter = p;
         entry.persistent = true;
     }
+
+    persistent_dirty_ = false;
 }
 
 void SettingsImplementation::saveTemporary(YAML::Node& node)
@@ -151,7 +235,17 @@ void SettingsImplementation::add(csapex::param::Parameter::Ptr p, bool persisten
     entry.parameter = p;
     entry.persistent = persistent;
 
-    observe(p->parameter_changed, [this](param::Parameter* p) { settingsChanged(p->name()); });
+    if (persistent) {
+        persistent_dirty_ = true;
+    }
+
+    observe(p->parameter_changed, [this](param::Parameter* p) {
+        auto it = settings_.find(p->name());
+        if (it != settings_.end() && it->second.persistent) {
+            persistent_dirty_ = true;
+        }
+        settingsChanged(p->name());
+    });
 
     settingsChanged(p->name());
 }
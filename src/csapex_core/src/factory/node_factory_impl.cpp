@@ -14,6 +14,7 @@
 #include <csapex/utility/uuid.h>
 #include <csapex/plugin/plugin_manager.hpp>
 #include <csapex/model/subgraph_node.h>
+#include <csapex/nodes/message_recorder.h>
 #include <csapex/nodes/sticky_note.h>
 #include <csapex/param/string_list_parameter.h>
 #include <csapex/model/graph/graph_impl.h>
@@ -47,6 +48,10 @@ NodeFactoryImplementation::NodeFactoryImplementation(Settings& settings, PluginL
     note->setDescription("A sticky note to keep information.");
     registerNodeType(note, true);
 
+    NodeConstructorPtr recorder = std::make_shared<NodeConstructor>("csapex::MessageRecorder", [] { return std::make_shared<MessageRecorder>(); });
+    recorder->setDescription("Records all received messages into a message log for playback.");
+    registerNodeType(recorder, true);
+
     node_manager_->manifest_loaded.connect(manifest_loaded);
 }
 
@@ -5,6 +5,7 @@
 #include <csapex/plugin/plugin_manager.hpp>
 #include <csapex/core/settings.h>
 #include <csapex/msg/apex_message_provider.h>
+#include <csapex/msg/message_log_provider.h>
 
 /// SYSTEM
 #include <boost/filesystem.hpp>
@@ -42,6 +43,8 @@ void MessageProviderManager::loadPlugins()
     registerMessageProvider(Settings::message_extension, std::bind(&ApexMessageProvider::make));
     registerMessageProvider(Settings::message_extension_compressed, std::bind(&ApexMessageProvider::make));
     registerMessageProvider(Settings::message_extension_binary, std::bind(&ApexMessageProvider::make));
+    registerMessageProvider(Settings::message_log_extension, std::bind(&MessageLogProvider::make));
+    supported_types_ += std::string("*") + Settings::message_log_extension + " ";
 
     for (const auto& pair : manager_->getConstructors()) {
         try {
@@ -164,8 +164,8 @@ void Connectable::setType(TokenData::ConstPtr type)
     std::unique_lock<std::recursive_mutex> lock(sync_mutex);
     bool compatible = type_ && type && type_->canConnectTo(type.get()) && type->canConnectTo(type_.get());
 
-    bool is_any = std::dynamic_pointer_cast<connection_types::AnyMessage const>(type_) != nullptr;
-    bool will_be_any = std::dynamic_pointer_cast<connection_types::AnyMessage const>(type) != nullptr;
+    bool is_any = type_ && type_->isAny();
+    bool will_be_any = type && type->isAny();
 
     if (!compatible || (is_any != will_be_any)) {
         type_ = type;
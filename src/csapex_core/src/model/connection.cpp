@@ -15,20 +15,30 @@
 #include <csapex/utility/debug.h>
 #include <csapex/model/node_handle.h>
 #include <csapex/model/node_state.h>
+#include <csapex/model/token.h>
 
 /// SYSTEM
+#include <chrono>
 #include <cmath>
 #include <iostream>
 
 using namespace csapex;
 
+namespace
+{
+long now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
 int Connection::next_connection_id_ = 0;
 
 Connection::Connection(OutputPtr from, InputPtr to) : Connection(from, to, next_connection_id_++)
 {
 }
 
-Connection::Connection(OutputPtr from, InputPtr to, int id) : from_(from), to_(to), id_(id), active_(false), detached_(false), state_(State::NOT_INITIALIZED)
+Connection::Connection(OutputPtr from, InputPtr to, int id) : from_(from), to_(to), id_(id), active_(false), detached_(false), direct_handoff_(false), state_(State::NOT_INITIALIZED), state_since_(now()), time_in_state_{ 0, 0, 0 }
 {
     from->enabled_changed.connect(source_enable_changed);
     to->enabled_changed.connect(sink_enabled_changed);
@@ -115,8 +125,9 @@ bool Connection::isDetached() const
 void Connection::reset()
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
-    state_ = Connection::State::NOT_INITIALIZED;
+    changeState(Connection::State::NOT_INITIALIZED);
     message_.reset();
+    updateMemoryLease();
 }
 
 TokenPtr Connection::getToken() const
@@ -160,24 +171,52 @@ void Connection::setTokenProcessed()
 void Connection::setToken(const TokenPtr& token)
 {
     {
-        TokenPtr msg = token->cloneAs<Token>();
+        TokenPtr msg = prepareToken(token);
 
         std::unique_lock<std::recursive_mutex> lock(sync);
-        apex_assert_hard(msg != nullptr);
         apex_assert_hard(state_ == State::NOT_INITIALIZED);
 
-        if (!isActive() && msg->hasActivityModifier()) {
-            // remove active flag if the connection is inactive
-            msg->setActivityModifier(ActivityModifier::NONE);
-        }
-
         message_ = msg;
+        updateMemoryLease();
         setState(State::UNREAD);
     }
 
     notifyMessageSet();
 }
 
+void Connection::updateMemoryLease()
+{
+    if (!TokenMemoryTracker::isAccountingEnabled() && !message_memory_.isHeld()) {
+        return;
+    }
+    std::string name = from_ && to_ ? from_->getUUID().getFullName() + " -> " + to_->getUUID().getFullName() : std::to_string(id_);
+    message_memory_.holdForConnection(name, message_);
+}
+
+TokenPtr Connection::prepareToken(const TokenPtr& token) const
+{
+    // parameter outputs publish the same immutable message until the parameter changes,
+    // receivers rely on its identity to skip values they have already applied
+    bool shallow = direct_handoff_ || (from_ && from_->isParameter());
+    TokenPtr msg = shallow ? token->makeShallowCopy() : token->cloneAs<Token>();
+    apex_assert_hard(msg != nullptr);
+
+    if (!isActive() && msg->hasActivityModifier()) {
+        // remove active flag if the connection is inactive
+        msg->setActivityModifier(ActivityModifier::NONE);
+    }
+
+    if (TokenProvenanceConstPtr provenance = msg->getProvenance()) {
+        // provenances are shared between tokens, append the hop to a copy
+        TokenProvenancePtr trace = std::make_shared<TokenProvenance>(*provenance);
+        trace->hops.emplace_back(to_ ? to_->getUUID().parentUUID() : UUID::NONE);
+        trace->hops.back().enqueued = TokenProvenance::now();
+        msg->setProvenance(trace);
+    }
+
+    return msg;
+}
+
 void Connection::notifyMessageSet()
 {
     if (detached_) {
@@ -194,6 +233,16 @@ void Connection::notifyMessageProcessed()
     from_->notifyMessageProcessed(this);
 }
 
+void Connection::setDirectHandoff(bool direct)
+{
+    direct_handoff_ = direct;
+}
+
+bool Connection::isDirectHandoff() const
+{
+    return direct_handoff_;
+}
+
 bool Connection::isActive() const
 {
     return active_;
@@ -235,6 +284,11 @@ Connection::State Connection::getState() const
     return state_;
 }
 
+Connection::State Connection::getSourceState() const
+{
+    return getState();
+}
+
 void Connection::setState(State s)
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
@@ -256,9 +310,30 @@ void Connection::setState(State s)
             break;
     }
 
+    changeState(s);
+}
+
+void Connection::changeState(State s)
+{
+    if (s != state_) {
+        long stamp = now();
+        time_in_state_[static_cast<int>(state_)] += stamp - state_since_;
+        state_since_ = stamp;
+    }
+
     state_ = s;
 }
 
+long Connection::getTimeInState(State s) const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    long time = time_in_state_[static_cast<int>(s)];
+    if (s == state_) {
+        time += now() - state_since_;
+    }
+    return time;
+}
+
 OutputPtr Connection::from() const
 {
     return from_;
@@ -286,7 +361,12 @@ int Connection::id() const
 ConnectionDescription Connection::getDescription() const
 {
     TokenDataConstPtr type = message_ ? message_->getTokenData() : makeEmpty<connection_types::AnyMessage>();
-    return ConnectionDescription(from_->getUUID(), to_->getUUID(), type, id_, isActive(), getFulcrumsCopy());
+    return ConnectionDescription(from_->getUUID(), to_->getUUID(), type, id_, isActive(), getFulcrumsCopy(), getPolicy());
+}
+
+ConnectionPolicy Connection::getPolicy() const
+{
+    return ConnectionPolicy::HANDSHAKE;
 }
 
 bool Connection::contains(Connector* c) const
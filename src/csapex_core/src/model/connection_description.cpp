@@ -9,17 +9,18 @@
 
 using namespace csapex;
 
-ConnectionDescription::ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, bool active, const std::vector<Fulcrum>& fulcrums)
-  : from(from), to(to), from_label(""), to_label(""), type(type), id(id), active(active), fulcrums(fulcrums)
+ConnectionDescription::ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, bool active, const std::vector<Fulcrum>& fulcrums,
+                                             ConnectionPolicy policy)
+  : from(from), to(to), from_label(""), to_label(""), type(type), id(id), active(active), fulcrums(fulcrums), policy(policy)
 {
 }
 
 ConnectionDescription::ConnectionDescription(const ConnectionDescription& other)
-  : from(other.from), to(other.to), from_label(other.from_label), to_label(other.to_label), type(other.type), id(other.id), active(other.active), fulcrums(other.fulcrums)
+  : from(other.from), to(other.to), from_label(other.from_label), to_label(other.to_label), type(other.type), id(other.id), active(other.active), fulcrums(other.fulcrums), policy(other.policy)
 {
 }
 
-ConnectionDescription::ConnectionDescription()
+ConnectionDescription::ConnectionDescription() : id(-1), active(false), policy(ConnectionPolicy::HANDSHAKE)
 {
 }
 
@@ -33,6 +34,7 @@ ConnectionDescription& ConnectionDescription::operator=(const ConnectionDescript
     id = other.id;
     active = other.active;
     fulcrums = other.fulcrums;
+    policy = other.policy;
 
     return *this;
 }
@@ -42,6 +44,12 @@ bool ConnectionDescription::operator==(const ConnectionDescription& other) const
     return from == other.from && to_label == other.to_label;
 }
 
+SemanticVersion ConnectionDescription::getVersion() const
+{
+    // 0.1.0 adds the connection policy
+    return SemanticVersion(0, 1, 0);
+}
+
 void ConnectionDescription::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
     data << from;
@@ -52,6 +60,7 @@ void ConnectionDescription::serialize(SerializationBuffer& data, SemanticVersion
     data << id;
     data << active;
     data << fulcrums;
+    data << policy;
 }
 void ConnectionDescription::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
 {
@@ -63,4 +72,8 @@ void ConnectionDescription::deserialize(const SerializationBuffer& data, const S
     data >> id;
     data >> active;
     data >> fulcrums;
+    policy = ConnectionPolicy::HANDSHAKE;
+    if (version >= SemanticVersion(0, 1, 0)) {
+        data >> policy;
+    }
 }
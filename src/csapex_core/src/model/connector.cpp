@@ -23,6 +23,15 @@ bool Connector::isAsynchronous() const
     return !isSynchronous();
 }
 
+bool Connector::addTap(const OutputTapPtr& /*tap*/)
+{
+    return false;
+}
+
+void Connector::removeTap(const OutputTapPtr& /*tap*/)
+{
+}
+
 ConnectableOwnerPtr Connector::getOwner() const
 {
     return owner_.lock();
@@ -13,8 +13,9 @@
 
 using namespace csapex;
 
-GenericState::GenericState() : silent_(false)
+GenericState::GenericState() : silent_(false), revision_(0)
 {
+    parameter_touched_.connect([this](param::Parameter*) { touch(); });
 }
 
 GenericState::GenericState(const GenericState& copy) : GenericState()
@@ -31,6 +32,9 @@ GenericState::GenericState(GenericState&& move) : GenericState()
     persistent = std::move(move.persistent);
     legacy = std::move(move.legacy);
     order = std::move(move.order);
+    move.parameter_connections_.clear();
+
+    observeParameters();
 }
 
 void GenericState::operator=(const GenericState& copy)
@@ -42,6 +46,9 @@ void GenericState::operator=(const GenericState& copy)
     persistent = copy.persistent;
     legacy = copy.legacy;
     order = copy.order;
+
+    observeParameters();
+    touch();
 }
 
 void GenericState::setParentUUID(const UUID& parent_uuid)
@@ -97,6 +104,38 @@ void GenericState::readYaml(const YAML::Node& node)
         persistent.clear();
         persistent.insert(persistent_v.begin(), persistent_v.end());
     }
+
+    touch();
+}
+
+void GenericState::writeBinary(SerializationBuffer& data) const
+{
+    data << params;
+    data << persistent;
+}
+
+void GenericState::readBinary(const SerializationBuffer& data)
+{
+    std::map<std::string, csapex::param::Parameter::Ptr> serialized_params;
+    data >> serialized_params;
+    for (auto pair : serialized_params) {
+        apex_assert_hard(pair.second);
+        apex_assert_hard(pair.first == pair.second->name());
+        auto pos = params.find(pair.first);
+        if (pos == params.end()) {
+            params[pair.first] = pair.second;
+            legacy_parameter_added(params[pair.first]);
+        } else {
+            param::ParameterPtr p = pos->second;
+            p->cloneDataFrom(*pair.second);
+        }
+        legacy.insert(pair.first);
+    }
+
+    persistent.clear();
+    data >> persistent;
+
+    touch();
 }
 
 void GenericState::serialize(SerializationBuffer& data, SemanticVersion& version) const
@@ -232,6 +271,7 @@ void GenericState::removeTemporaryParameters()
     }
 
     temporary.clear();
+    touch();
 
     triggerParameterSetChanged();
 }
@@ -272,6 +312,9 @@ void GenericState::registerParameter(const csapex::param::Parameter::Ptr& param)
 {
     params[param->name()] = param;
 
+    parameter_connections_[param.get()] = param->parameter_changed.connect(parameter_touched_);
+    touch();
+
     param->setUUID(UUIDProvider::makeTypedUUID_forced(parent_uuid_, "param", param->name()));
 
     (parameter_added)(param);
@@ -281,11 +324,22 @@ void GenericState::registerParameter(const csapex::param::Parameter::Ptr& param)
 void GenericState::unregisterParameter(const csapex::param::Parameter::Ptr& param)
 {
     params.erase(param->name());
+    parameter_connections_.erase(param.get());
+    touch();
 
     (parameter_removed)(param);
     triggerParameterSetChanged();
 }
 
+void GenericState::observeParameters()
+{
+    // copied parameters are shared with the original state, changing them has to bump both revisions
+    parameter_connections_.clear();
+    for (const auto& pair : params) {
+        parameter_connections_[pair.second.get()] = pair.second->parameter_changed.connect(parameter_touched_);
+    }
+}
+
 void GenericState::setFrom(const GenericState& rhs)
 {
     persistent = rhs.persistent;
@@ -302,6 +356,17 @@ void GenericState::setFrom(const GenericState& rhs)
     }
 
     initializePersistentParameters();
+    touch();
+}
+
+uint64_t GenericState::getRevision() const
+{
+    return revision_;
+}
+
+void GenericState::touch()
+{
+    ++revision_;
 }
 
 csapex::param::Parameter& GenericState::operator[](const std::string& name) const
@@ -13,6 +13,7 @@
 #include <csapex/model/node.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/model/node_handle.h>
+#include <csapex/model/node_runner.h>
 #include <csapex/model/node_worker.h>
 #include <csapex/model/node_state.h>
 #include <csapex/model/graph/vertex.h>
@@ -21,9 +22,14 @@
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/subgraph_node.h>
 
+/// SYSTEM
+#include <algorithm>
+#include <deque>
+#include <queue>
+
 using namespace csapex;
 
-GraphImplementation::GraphImplementation() : in_transaction_(false), nf_(nullptr)
+GraphImplementation::GraphImplementation() : next_component_(0), in_transaction_(false), nf_(nullptr)
 {
 }
 
@@ -87,6 +93,7 @@ void GraphImplementation::addNode(NodeFacadeImplementationPtr nf)
     apex_assert_hard_msg(nf, "NodeFacade added is not null");
     graph::VertexPtr vertex = std::make_shared<graph::Vertex>(nf);
     vertices_.push_back(vertex);
+    vertex_index_[nf->getUUID()] = vertex;
 
     nf->getNodeHandle()->setVertex(vertex);
 
@@ -95,7 +102,7 @@ void GraphImplementation::addNode(NodeFacadeImplementationPtr nf)
 
     vertex_added(vertex);
     if (!in_transaction_) {
-        analyzeGraph();
+        analyzeAddedVertex(vertex);
     }
 }
 
@@ -119,37 +126,17 @@ void GraphImplementation::deleteNode(const UUID& uuid)
     NodeHandle* node_handle = findNodeHandle(uuid);
     node_handle->stop();
 
-    graph::VertexPtr removed;
-
-    for (auto it = vertices_.begin(); it != vertices_.end();) {
-        NodeFacadePtr node = (*it)->getNodeFacade();
-        if (node->getUUID() == uuid) {
-            removed = *it;
-            vertices_.erase(it);
-
-            break;
-
-        } else {
-            ++it;
-        }
-    }
+    // the handle knows its vertex, there is no need to compare the UUIDs of all vertices
+    graph::VertexPtr removed = node_handle->getVertex();
+    auto pos = std::find(vertices_.begin(), vertices_.end(), removed);
+    apex_assert_hard(removed && pos != vertices_.end());
+    vertices_.erase(pos);
 
-    apex_assert_hard(removed);
-    apex_assert_hard(removed == node_handle->getVertex());
+    vertex_index_.erase(uuid);
 
     sources_.erase(removed);
     sinks_.erase(removed);
 
-    for (const graph::VertexPtr& source : sources_) {
-        apex_assert_neq(source, removed);
-    }
-    for (const graph::VertexPtr& sink : sinks_) {
-        apex_assert_neq(sink, removed);
-    }
-    for (const graph::VertexPtr& remaining : vertices_) {
-        apex_assert_neq(remaining, removed);
-    }
-
     //        if(NodePtr node = removed->getNode().lock()) {
     //            if(GraphPtr child = std::dynamic_pointer_cast<Graph>(node)) {
     //                child->clear();
@@ -172,12 +159,16 @@ bool GraphImplementation::addConnection(ConnectionPtr connection)
     apex_assert_hard(connection);
     edges_.push_back(connection);
 
-    connection_observations_[connection.get()].push_back(connection->connection_changed.connect([this]() {
+    Connection* observed = connection.get();
+    connection_observations_[observed].push_back(connection->connection_changed.connect([this, observed]() {
         if (!in_transaction_) {
-            analyzeGraph();
+            analyzeConnection(observed);
         }
     }));
 
+    graph::VertexPtr edge_from;
+    graph::VertexPtr edge_to;
+
     if (!std::dynamic_pointer_cast<Event>(connection->from()) && !std::dynamic_pointer_cast<Slot>(connection->to())) {
         NodeHandle* n_from = findNodeHandleForConnector(connection->from()->getUUID());
         NodeHandle* n_to = findNodeHandleForConnector(connection->to()->getUUID());
@@ -194,6 +185,9 @@ bool GraphImplementation::addConnection(ConnectionPtr connection)
 
                 sources_.erase(v_to);
                 sinks_.erase(v_from);
+
+                edge_from = v_from;
+                edge_to = v_to;
             }
         }
     }
@@ -202,7 +196,11 @@ bool GraphImplementation::addConnection(ConnectionPtr connection)
         connection_added(connection->getDescription());
     }
     if (!in_transaction_) {
-        analyzeGraph();
+        if (edge_from && edge_to) {
+            analyzeAddedEdge(edge_from, edge_to, connection);
+        } else {
+            analyzeConnection(connection.get());
+        }
     }
     return true;
 }
@@ -226,6 +224,9 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
 
     out->removeConnection(in.get());
 
+    graph::VertexPtr removed_from;
+    graph::VertexPtr removed_to;
+
     for (std::vector<ConnectionPtr>::iterator c = edges_.begin(); c != edges_.end();) {
         if (*connection == **c) {
             ConnectablePtr to = connection->to();
@@ -258,24 +259,23 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
                         if (!still_connected) {
                             v_to->removeParent(v_from.get());
                             v_from->removeChild(v_to.get());
+
+                            removed_from = v_from;
+                            removed_to = v_to;
                         }
 
                         if (!n_from->getOutputTransition()->hasConnection()) {
                             // verify that v_from is from this graph
-                            for (const graph::VertexPtr& vertex : vertices_) {
-                                if (vertex == v_from) {
-                                    sinks_.insert(v_from);
-                                    break;
-                                }
+                            auto pos = vertex_index_.find(v_from->getUUID());
+                            if (pos != vertex_index_.end() && pos->second == v_from) {
+                                sinks_.insert(v_from);
                             }
                         }
                         if (!n_to->getInputTransition()->hasConnection()) {
                             // verify that v_to is from this graph
-                            for (const graph::VertexPtr& vertex : vertices_) {
-                                if (vertex == v_to) {
-                                    sources_.insert(v_to);
-                                    break;
-                                }
+                            auto pos = vertex_index_.find(v_to->getUUID());
+                            if (pos != vertex_index_.end() && pos->second == v_to) {
+                                sources_.insert(v_to);
                             }
                         }
                     }
@@ -288,10 +288,10 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
                 connection_removed(connection->getDescription());
             }
             if (!in_transaction_) {
-                analyzeGraph();
-            }
-            for (const auto& c : edges_) {
-                apex_assert_hard(c);
+                if (removed_from && removed_to) {
+                    splitComponent(removed_from, removed_to);
+                }
+                analyzeConnection(connection.get());
             }
 
             return;
@@ -322,52 +322,50 @@ void GraphImplementation::analyzeGraph()
 
     calculateDepths();
 
+    if (NodeRunner::isChainFusionEnabled()) {
+        for (const graph::VertexPtr& vertex : vertices_) {
+            updateChainFusion(vertex);
+        }
+    }
+
     state_changed();
 }
 
 void GraphImplementation::buildConnectedComponents()
 {
     /* Find all connected sub components of this graph */
-    std::deque<graph::Vertex*> unmarked;
-    for (auto vertex : vertices_) {
-        unmarked.push_back(vertex.get());
+    components_.clear();
+    for (const graph::VertexPtr& vertex : vertices_) {
         vertex->getNodeCharacteristics().component = -1;
     }
 
-    std::deque<graph::Vertex*> Q;
     int component = 0;
-    while (!unmarked.empty()) {
-        // take a random unmarked node to start bfs from
-        auto* start = unmarked.front();
+    for (const graph::VertexPtr& start : vertices_) {
+        if (start->getNodeCharacteristics().component != -1) {
+            continue;
+        }
+
+        // bfs from the first unmarked vertex
+        std::vector<graph::VertexPtr>& members = components_[component];
+        std::deque<graph::VertexPtr> Q;
         Q.push_back(start);
 
         start->getNodeCharacteristics().component = component;
 
         while (!Q.empty()) {
-            graph::Vertex* front = Q.front();
+            graph::VertexPtr front = Q.front();
             Q.pop_front();
 
-            NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(front->getNodeFacade());
-            apex_assert_hard(local_facade);
-
-            checkNodeState(local_facade->getNodeHandle().get());
-
-            auto it = std::find(unmarked.begin(), unmarked.end(), front);
-            if (it == unmarked.end()) {
-                continue;
-            }
-            unmarked.erase(it);
+            members.push_back(front);
+            checkNodeState(front);
 
             // iterate all neighbors
-            std::vector<graph::Vertex*> neighbors;
-            for (auto parent : front->getParents()) {
-                neighbors.push_back(parent.get());
-            }
-            for (auto child : front->getChildren()) {
-                neighbors.push_back(child.get());
+            std::vector<graph::VertexPtr> neighbors = front->getParents();
+            for (const graph::VertexPtr& child : front->getChildren()) {
+                neighbors.push_back(child);
             }
 
-            for (auto* neighbor : neighbors) {
+            for (const graph::VertexPtr& neighbor : neighbors) {
                 if (neighbor->getNodeCharacteristics().component == -1) {
                     neighbor->getNodeCharacteristics().component = component;
                     Q.push_back(neighbor);
@@ -377,18 +375,23 @@ void GraphImplementation::buildConnectedComponents()
 
         ++component;
     }
+
+    next_component_ = component;
 }
 
-std::set<graph::Vertex*> GraphImplementation::findVerticesThatJoinStreams()
+std::set<graph::Vertex*> GraphImplementation::findVerticesThatJoinStreams(const std::vector<graph::VertexPtr>& vertices)
 {
     std::set<graph::Vertex*> joins;
 
-    for (graph::VertexPtr vertex : vertices_) {
+    for (const graph::VertexPtr& vertex : vertices) {
         vertex->getNodeCharacteristics().depth = -1;
     }
 
     // init node_depth_ and find merging nodes
-    for (const graph::VertexPtr source : sources_) {
+    for (const graph::VertexPtr& source : vertices) {
+        if (sources_.find(source) == sources_.end()) {
+            continue;
+        }
         source->getNodeCharacteristics().depth = 0;
 
         std::deque<const graph::Vertex*> Q;
@@ -413,14 +416,14 @@ std::set<graph::Vertex*> GraphImplementation::findVerticesThatJoinStreams()
     return joins;
 }
 
-std::set<graph::Vertex*> GraphImplementation::findVerticesThatNeedMessages()
+std::set<graph::Vertex*> GraphImplementation::findVerticesThatNeedMessages(const std::vector<graph::VertexPtr>& vertices)
 {
     std::set<graph::Vertex*> vertices_that_need_messages;
 
-    for (const graph::VertexPtr v : vertices_) {
+    for (const graph::VertexPtr& v : vertices) {
         if (v->getNodeFacade()->isProcessingNothingMessages()) {
             vertices_that_need_messages.insert(v.get());
-            break;
+            continue;
         }
 
         NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(v->getNodeFacade());
@@ -438,13 +441,18 @@ std::set<graph::Vertex*> GraphImplementation::findVerticesThatNeedMessages()
 }
 
 void GraphImplementation::calculateDepths()
+{
+    calculateDepths(vertices_);
+}
+
+void GraphImplementation::calculateDepths(const std::vector<graph::VertexPtr>& vertices)
 {
     // start DFSs at each source. assign each node:
     // - depth: the minimum distance to any source
     // - joining: true, iff more than one path leads from any source to a node
 
     // initialize
-    for (const graph::VertexPtr& vertex : vertices_) {
+    for (const graph::VertexPtr& vertex : vertices) {
         NodeCharacteristics& characteristics = vertex->getNodeCharacteristics();
         characteristics.is_joining_vertex = false;
         characteristics.is_joining_vertex_counterpart = false;
@@ -454,7 +462,7 @@ void GraphImplementation::calculateDepths()
         characteristics.is_leading_to_essential_vertex = false;
     }
 
-    std::set<graph::Vertex*> essentials = findVerticesThatNeedMessages();
+    std::set<graph::Vertex*> essentials = findVerticesThatNeedMessages(vertices);
 
     for (const graph::Vertex* essential : essentials) {
         essential->getNodeCharacteristics().is_leading_to_essential_vertex = true;
@@ -475,10 +483,13 @@ void GraphImplementation::calculateDepths()
         }
     }
 
-    std::set<graph::Vertex*> joins = findVerticesThatJoinStreams();
+    std::set<graph::Vertex*> joins = findVerticesThatJoinStreams(vertices);
 
     // populate node_depth_ with minimal depths
-    for (const graph::VertexPtr source : sources_) {
+    for (const graph::VertexPtr& source : vertices) {
+        if (sources_.find(source) == sources_.end()) {
+            continue;
+        }
         source->getNodeCharacteristics().depth = 0;
 
         std::deque<const graph::Vertex*> Q;
@@ -599,6 +610,382 @@ void GraphImplementation::checkNodeState(NodeHandle* nh)
     nh->getOutputTransition()->checkIfEnabled();
 }
 
+void GraphImplementation::checkNodeState(const graph::VertexPtr& vertex)
+{
+    NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+    apex_assert_hard(local_facade);
+
+    checkNodeState(local_facade->getNodeHandle().get());
+}
+
+void GraphImplementation::analyzeAddedVertex(const graph::VertexPtr& vertex)
+{
+    int component = next_component_++;
+    vertex->getNodeCharacteristics().component = component;
+    components_[component].push_back(vertex);
+
+    checkNodeState(vertex);
+    analyzeComponent(component);
+
+    if (NodeRunner::isChainFusionEnabled()) {
+        updateChainFusion(vertex);
+    }
+
+    state_changed();
+}
+
+void GraphImplementation::analyzeAddedEdge(const graph::VertexPtr& from, const graph::VertexPtr& to, const ConnectionPtr& connection)
+{
+    checkNodeState(from);
+    checkNodeState(to);
+
+    int component = mergeComponents(from, to);
+
+    if (to->getParents().size() > 1 || isLeadingToJoin(to)) {
+        // the new edge changes the set of paths leading to a joining vertex
+        // -> the join counterparts have to be recalculated for the whole component
+        analyzeComponent(component);
+
+    } else {
+        repairDepths(to);
+
+        if (to->getNodeCharacteristics().is_leading_to_essential_vertex || connection->to()->isEssential()) {
+            propagateEssential(from);
+        }
+    }
+
+    if (NodeRunner::isChainFusionEnabled()) {
+        updateChainFusionAround(from);
+        updateChainFusion(to);
+    }
+
+    state_changed();
+}
+
+void GraphImplementation::analyzeConnection(const Connection* connection)
+{
+    graph::VertexPtr from = findVertexForConnectorNoThrow(connection->from()->getUUID());
+    graph::VertexPtr to = findVertexForConnectorNoThrow(connection->to()->getUUID());
+
+    if (from) {
+        checkNodeState(from);
+        analyzeComponent(from->getNodeCharacteristics().component);
+    }
+    if (to) {
+        checkNodeState(to);
+        if (!from || from->getNodeCharacteristics().component != to->getNodeCharacteristics().component) {
+            analyzeComponent(to->getNodeCharacteristics().component);
+        }
+    }
+
+    if (NodeRunner::isChainFusionEnabled()) {
+        if (from) {
+            updateChainFusionAround(from);
+        }
+        if (to) {
+            updateChainFusion(to);
+        }
+    }
+
+    state_changed();
+}
+
+bool GraphImplementation::isFusible(const graph::VertexPtr& vertex) const
+{
+    NodeFacadeImplementationPtr facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+    if (!facade || facade->isGraph() || !facade->getNodeRunner()) {
+        return false;
+    }
+    NodePtr node = facade->getNode();
+    return node && !node->isAsynchronous();
+}
+
+void GraphImplementation::updateChainFusion(const graph::VertexPtr& vertex)
+{
+    NodeFacadeImplementationPtr facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+    NodeRunnerPtr runner = facade ? facade->getNodeRunner() : nullptr;
+    if (!runner) {
+        return;
+    }
+
+    NodeRunnerPtr predecessor;
+
+    // a vertex follows its parent directly, if it is the parent's only consumer and vice versa
+    std::vector<graph::VertexPtr> parents = vertex->getParents();
+    if (parents.size() == 1) {
+        const graph::VertexPtr& parent = parents.front();
+        if (parent != vertex && parent->getChildren().size() == 1 && isFusible(parent) && isFusible(vertex)) {
+            predecessor = std::dynamic_pointer_cast<NodeFacadeImplementation>(parent->getNodeFacade())->getNodeRunner();
+        }
+    }
+
+    runner->setFusedPredecessor(predecessor);
+
+    // the vertex is the only consumer of its fused predecessor, so the payload does not have to be copied
+    for (const InputPtr& input : facade->getNodeHandle()->getExternalInputs()) {
+        for (const ConnectionPtr& connection : input->getConnections()) {
+            connection->setDirectHandoff(predecessor != nullptr);
+        }
+    }
+}
+
+void GraphImplementation::updateChainFusionAround(const graph::VertexPtr& vertex)
+{
+    // whether the children can be fused depends on how many siblings they have
+    updateChainFusion(vertex);
+    for (const graph::VertexPtr& child : vertex->getChildren()) {
+        updateChainFusion(child);
+    }
+}
+
+void GraphImplementation::analyzeComponent(int component)
+{
+    auto pos = components_.find(component);
+    if (pos != components_.end()) {
+        calculateDepths(pos->second);
+    }
+}
+
+int GraphImplementation::mergeComponents(const graph::VertexPtr& a, const graph::VertexPtr& b)
+{
+    int component_a = a->getNodeCharacteristics().component;
+    int component_b = b->getNodeCharacteristics().component;
+    if (component_a == component_b) {
+        return component_a;
+    }
+
+    // union by size: relabel the members of the smaller component
+    int target = component_a;
+    int source = component_b;
+    if (components_[component_a].size() < components_[component_b].size()) {
+        std::swap(target, source);
+    }
+
+    std::vector<graph::VertexPtr>& target_members = components_[target];
+    std::vector<graph::VertexPtr>& source_members = components_[source];
+    for (const graph::VertexPtr& member : source_members) {
+        member->getNodeCharacteristics().component = target;
+        target_members.push_back(member);
+    }
+    components_.erase(source);
+
+    return target;
+}
+
+void GraphImplementation::splitComponent(const graph::VertexPtr& a, const graph::VertexPtr& b)
+{
+    int component = a->getNodeCharacteristics().component;
+    apex_assert_hard(component == b->getNodeCharacteristics().component);
+
+    // collect everything that is still reachable from b
+    std::set<graph::Vertex*> reachable;
+    std::deque<graph::VertexPtr> Q;
+    reachable.insert(b.get());
+    Q.push_back(b);
+
+    while (!Q.empty()) {
+        graph::VertexPtr front = Q.front();
+        Q.pop_front();
+
+        std::vector<graph::VertexPtr> neighbors = front->getParents();
+        for (const graph::VertexPtr& child : front->getChildren()) {
+            neighbors.push_back(child);
+        }
+
+        for (const graph::VertexPtr& neighbor : neighbors) {
+            if (neighbor == a) {
+                // still connected via another path
+                return;
+            }
+            if (reachable.insert(neighbor.get()).second) {
+                Q.push_back(neighbor);
+            }
+        }
+    }
+
+    int split = next_component_++;
+    std::vector<graph::VertexPtr>& members = components_[component];
+    std::vector<graph::VertexPtr>& split_members = components_[split];
+    for (auto it = members.begin(); it != members.end();) {
+        if (reachable.find(it->get()) != reachable.end()) {
+            (*it)->getNodeCharacteristics().component = split;
+            split_members.push_back(*it);
+            it = members.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int GraphImplementation::calculateDepthFromParents(const graph::VertexPtr& vertex) const
+{
+    if (sources_.find(vertex) != sources_.end()) {
+        return 0;
+    }
+
+    int depth = -1;
+    for (const graph::VertexPtr& parent : vertex->getParents()) {
+        int parent_depth = parent->getNodeCharacteristics().depth;
+        if (parent_depth >= 0 && (depth < 0 || parent_depth + 1 < depth)) {
+            depth = parent_depth + 1;
+        }
+    }
+    return depth;
+}
+
+void GraphImplementation::repairDepths(const graph::VertexPtr& vertex)
+{
+    int& depth = vertex->getNodeCharacteristics().depth;
+    int new_depth = calculateDepthFromParents(vertex);
+    if (new_depth == depth) {
+        return;
+    }
+
+    if (new_depth >= 0 && (depth < 0 || new_depth < depth)) {
+        // the depth decreased -> only the descendants that get closer to a source change
+        depth = new_depth;
+
+        std::deque<graph::VertexPtr> Q;
+        Q.push_back(vertex);
+        while (!Q.empty()) {
+            graph::VertexPtr top = Q.front();
+            Q.pop_front();
+
+            int top_depth = top->getNodeCharacteristics().depth;
+            for (const graph::VertexPtr& child : top->getChildren()) {
+                int& child_depth = child->getNodeCharacteristics().depth;
+                if (child_depth < 0 || top_depth + 1 < child_depth) {
+                    child_depth = top_depth + 1;
+                    Q.push_back(child);
+                }
+            }
+        }
+        return;
+    }
+
+    // the depth increased -> recalculate the region downstream of the vertex,
+    // seeded with the depths of all parents outside of that region
+    std::vector<graph::VertexPtr> region;
+    std::set<graph::Vertex*> in_region;
+    region.push_back(vertex);
+    in_region.insert(vertex.get());
+    for (std::size_t i = 0; i < region.size(); ++i) {
+        for (const graph::VertexPtr& child : region[i]->getChildren()) {
+            if (in_region.insert(child.get()).second) {
+                region.push_back(child);
+            }
+        }
+    }
+
+    for (const graph::VertexPtr& member : region) {
+        member->getNodeCharacteristics().depth = -1;
+    }
+
+    typedef std::pair<int, graph::VertexPtr> Entry;
+    auto compare = [](const Entry& lhs, const Entry& rhs) { return lhs.first > rhs.first; };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(compare)> Q(compare);
+
+    for (const graph::VertexPtr& member : region) {
+        int seed_depth = -1;
+        if (sources_.find(member) != sources_.end()) {
+            seed_depth = 0;
+        } else {
+            for (const graph::VertexPtr& parent : member->getParents()) {
+                if (in_region.find(parent.get()) != in_region.end()) {
+                    continue;
+                }
+                int parent_depth = parent->getNodeCharacteristics().depth;
+                if (parent_depth >= 0 && (seed_depth < 0 || parent_depth + 1 < seed_depth)) {
+                    seed_depth = parent_depth + 1;
+                }
+            }
+        }
+
+        if (seed_depth >= 0) {
+            member->getNodeCharacteristics().depth = seed_depth;
+            Q.push(Entry(seed_depth, member));
+        }
+    }
+
+    while (!Q.empty()) {
+        Entry top = Q.top();
+        Q.pop();
+
+        if (top.first > top.second->getNodeCharacteristics().depth) {
+            // outdated entry
+            continue;
+        }
+
+        for (const graph::VertexPtr& child : top.second->getChildren()) {
+            int& child_depth = child->getNodeCharacteristics().depth;
+            if (child_depth < 0 || top.first + 1 < child_depth) {
+                child_depth = top.first + 1;
+                Q.push(Entry(child_depth, child));
+            }
+        }
+    }
+}
+
+void GraphImplementation::propagateEssential(const graph::VertexPtr& vertex)
+{
+    std::deque<graph::VertexPtr> Q;
+    Q.push_back(vertex);
+    while (!Q.empty()) {
+        graph::VertexPtr top = Q.back();
+        Q.pop_back();
+
+        NodeCharacteristics& characteristics = top->getNodeCharacteristics();
+        if (characteristics.is_leading_to_essential_vertex) {
+            continue;
+        }
+        characteristics.is_leading_to_essential_vertex = true;
+
+        for (const graph::VertexPtr& parent : top->getParents()) {
+            Q.push_back(parent);
+        }
+    }
+}
+
+bool GraphImplementation::isLeadingToJoin(const graph::VertexPtr& vertex) const
+{
+    std::set<graph::Vertex*> visited;
+    std::deque<graph::VertexPtr> Q;
+    Q.push_back(vertex);
+    visited.insert(vertex.get());
+
+    while (!Q.empty()) {
+        graph::VertexPtr top = Q.back();
+        Q.pop_back();
+
+        if (top->getNodeCharacteristics().is_joining_vertex) {
+            return true;
+        }
+
+        for (const graph::VertexPtr& child : top->getChildren()) {
+            if (visited.insert(child.get()).second) {
+                Q.push_back(child);
+            }
+        }
+    }
+
+    return false;
+}
+
+graph::VertexPtr GraphImplementation::findVertexForConnectorNoThrow(const UUID& connector_uuid) const noexcept
+{
+    UUID owner = connector_uuid.parentUUID();
+    if (owner.empty() || owner.composite()) {
+        // connectors of this graph's own node or of nested graphs are no vertices of this graph
+        return nullptr;
+    }
+
+    NodeHandle* nh = findNodeHandleNoThrow(owner);
+    if (!nh) {
+        return nullptr;
+    }
+    return nh->getVertex();
+}
+
 int GraphImplementation::getComponent(const UUID& node_uuid) const
 {
     NodeHandle* node = findNodeHandleNoThrow(node_uuid);
@@ -701,13 +1088,11 @@ NodeHandle* GraphImplementation::findNodeHandleNoThrow(const UUID& uuid) const n
         }
 
     } else {
-        for (const auto vertex : vertices_) {
-            NodeFacadePtr facade = vertex->getNodeFacade();
-            if (facade->getUUID() == uuid) {
-                NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(facade);
-                apex_assert_hard(local_facade);
-                return local_facade->getNodeHandle().get();
-            }
+        auto pos = vertex_index_.find(uuid);
+        if (pos != vertex_index_.end()) {
+            NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(pos->second->getNodeFacade());
+            apex_assert_hard(local_facade);
+            return local_facade->getNodeHandle().get();
         }
     }
 
@@ -776,11 +1161,9 @@ NodeFacadePtr GraphImplementation::findNodeFacadeNoThrow(const UUID& uuid) const
         }
 
     } else {
-        for (const auto vertex : vertices_) {
-            NodeFacadePtr nf = vertex->getNodeFacade();
-            if (nf->getUUID() == uuid) {
-                return nf;
-            }
+        auto pos = vertex_index_.find(uuid);
+        if (pos != vertex_index_.end()) {
+            return pos->second->getNodeFacade();
         }
     }
 
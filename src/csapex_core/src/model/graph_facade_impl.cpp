@@ -11,7 +11,8 @@
 #include <csapex/model/node_runner.h>
 #include <csapex/model/node_handle.h>
 #include <csapex/scheduling/thread_pool.h>
-#include <csapex/msg/direct_connection.h>
+#include <csapex/model/connection.h>
+#include <csapex/msg/connection_factory.h>
 #include <csapex/model/connectable.h>
 #include <csapex/msg/input.h>
 #include <csapex/msg/output.h>
@@ -216,9 +217,9 @@ void GraphFacadeImplementation::stop()
     stopped();
 }
 
-ConnectionPtr GraphFacadeImplementation::connect(OutputPtr output, InputPtr input)
+ConnectionPtr GraphFacadeImplementation::connect(OutputPtr output, InputPtr input, ConnectionPolicy policy)
 {
-    auto c = DirectConnection::connect(output, input);
+    auto c = connection_factory::connect(output, input, policy);
     graph_->addConnection(c);
     return c;
 }
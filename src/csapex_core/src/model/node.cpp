@@ -19,7 +19,13 @@
 
 using namespace csapex;
 
-Node::Node() : adebug(std::cout, ""), ainfo(std::cout, ""), awarn(std::cout, ""), aerr(std::cerr, ""), node_handle_(nullptr), guard_(-1)
+Node::Node()
+  : adebug(std::cout, "", StreamRelay::Level::DEBUG)
+  , ainfo(std::cout, "", StreamRelay::Level::INFO)
+  , awarn(std::cout, "", StreamRelay::Level::WARNING)
+  , aerr(std::cerr, "", StreamRelay::Level::ERROR)
+  , node_handle_(nullptr)
+  , guard_(-1)
 {
 }
 
@@ -11,6 +11,7 @@
 #include <csapex/model/direct_node_worker.h>
 #include <csapex/model/subprocess_node_worker.h>
 #include <csapex/model/subgraph_node.h>
+#include <csapex/model/token_latency_statistics.h>
 #include <csapex/msg/input.h>
 #include <csapex/msg/input_transition.h>
 #include <csapex/msg/output.h>
@@ -414,6 +415,15 @@ void NodeFacadeImplementation::setProfiling(bool profiling)
     }
 }
 
+TokenLatencyStatistics NodeFacadeImplementation::getTokenLatencyStatistics() const
+{
+    if (nw_) {
+        return nw_->getTokenLatencyStatistics();
+    } else {
+        return TokenLatencyStatistics();
+    }
+}
+
 ExecutionState NodeFacadeImplementation::getExecutionState() const
 {
     if (nw_) {
@@ -541,13 +551,13 @@ std::string NodeFacadeImplementation::getLoggerOutput(ErrorState::ErrorLevel lev
     if (NodePtr node = nh_->getNode().lock()) {
         switch (level) {
             case ErrorState::ErrorLevel::ERROR:
-                return node->aerr.history().str();
+                return node->aerr.history();
             case ErrorState::ErrorLevel::WARNING:
-                return node->awarn.history().str();
+                return node->awarn.history();
             case ErrorState::ErrorLevel::INFO:
-                return node->ainfo.history().str();
+                return node->ainfo.history();
             case ErrorState::ErrorLevel::NONE:
-                return node->ainfo.history().str();
+                return node->ainfo.history();
         }
     }
     return {};
@@ -24,6 +24,7 @@
 #include <csapex/utility/uuid_provider.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <iostream>
 
 using namespace csapex;
@@ -309,6 +310,11 @@ void NodeHandle::makeParameterConnectableTyped(csapex::param::ParameterPtr param
         return;
     }
 
+    ParameterPortPtr port = std::make_shared<ParameterPort>();
+    port->parameter = p;
+    port->publish_pending = true;
+    port->apply_pending = true;
+
     {
         InputPtr cin = std::make_shared<Input>(uuid_provider->makeDerivedUUID(getUUID(), std::string("in_") + p->name()), shared_from_this());
         cin->setType(makeEmpty<T>());
@@ -318,6 +324,7 @@ void NodeHandle::makeParameterConnectableTyped(csapex::param::ParameterPtr param
 
         param_2_input_[p->name()] = cin;
         input_2_param_[cin->getUUID()] = p;
+        port->input = cin.get();
 
         manageInput(cin);
     }
@@ -329,9 +336,17 @@ void NodeHandle::makeParameterConnectableTyped(csapex::param::ParameterPtr param
 
         param_2_output_[p->name()] = cout;
         output_2_param_[cout->getUUID()] = p;
+        port->output = cout.get();
 
         manageOutput(cout);
     }
+
+    ParameterPort* raw_port = port.get();
+    port->observer = p->parameter_changed.connect([raw_port](csapex::param::Parameter*) {
+        raw_port->publish_pending = true;
+        raw_port->apply_pending = true;
+    });
+    parameter_ports_.push_back(port);
 }
 
 void NodeHandle::makeParameterConnectable(csapex::param::ParameterPtr p)
@@ -422,19 +437,34 @@ void NodeHandle::makeParameterNotConnectable(csapex::param::ParameterPtr p)
 
     apex_assert_hard(param_2_output_.erase(p->name()) != 0);
     apex_assert_hard(output_2_param_.erase(cout->getUUID()) != 0);
+
+    parameter_ports_.erase(std::remove_if(parameter_ports_.begin(), parameter_ports_.end(), [cin](const ParameterPortPtr& port) { return port->input == cin; }), parameter_ports_.end());
+}
+
+const std::vector<NodeHandle::ParameterPortPtr>& NodeHandle::getParameterPorts() const
+{
+    return parameter_ports_;
 }
 
 bool NodeHandle::updateParameterValues()
 {
     bool change = false;
-    for (auto pair : param_2_input_) {
-        InputPtr cin = pair.second.lock();
-        if (cin) {
-            apex_assert_hard(cin->isOptional());
-            if (msg::hasMessage(cin.get())) {
-                updateParameterValue(cin.get());
-                change = true;
-            }
+    for (const ParameterPortPtr& port : parameter_ports_) {
+        Input* cin = port->input;
+        if (!cin->isConnected() || !msg::hasMessage(cin)) {
+            continue;
+        }
+
+        // the same message is received again as long as the source parameter is unchanged
+        TokenDataConstPtr message = msg::getMessage(cin);
+        bool parameter_changed = port->apply_pending.exchange(false);
+        if (message == port->applied && !parameter_changed) {
+            continue;
+        }
+
+        port->applied = message;
+        if (updateParameterValue(cin, port->parameter)) {
+            change = true;
         }
     }
 
@@ -444,38 +474,36 @@ bool NodeHandle::updateParameterValues()
 namespace
 {
 template <typename V>
-void updateParameterValueFrom(csapex::param::Parameter* p, Input* source)
+bool updateParameterValueFrom(csapex::param::Parameter* p, Input* source)
 {
     auto current = p->as<V>();
     auto next = msg::getValue<V>(source);
     if (current != next) {
         p->set<V>(next);
+        return true;
     }
+    return false;
 }
 }  // namespace
 
-void NodeHandle::updateParameterValue(Connectable* s)
+bool NodeHandle::updateParameterValue(Input* source, csapex::param::Parameter* p)
 {
-    Input* source = dynamic_cast<Input*>(s);
-    apex_assert_hard(source);
-
-    csapex::param::Parameter* p = input_2_param_.at(source->getUUID());
-
     if (msg::isExactValue<int>(source)) {
-        updateParameterValueFrom<int>(p, source);
+        return updateParameterValueFrom<int>(p, source);
     } else if (msg::isExactValue<bool>(source)) {
-        updateParameterValueFrom<bool>(p, source);
+        return updateParameterValueFrom<bool>(p, source);
     } else if (msg::isExactValue<double>(source)) {
-        updateParameterValueFrom<double>(p, source);
+        return updateParameterValueFrom<double>(p, source);
     } else if (msg::isExactValue<std::string>(source)) {
-        updateParameterValueFrom<std::string>(p, source);
+        return updateParameterValueFrom<std::string>(p, source);
     } else if (msg::isExactValue<std::pair<int, int>>(source)) {
-        updateParameterValueFrom<std::pair<int, int>>(p, source);
+        return updateParameterValueFrom<std::pair<int, int>>(p, source);
     } else if (msg::isExactValue<std::pair<double, double>>(source)) {
-        updateParameterValueFrom<std::pair<double, double>>(p, source);
-    } else if (msg::hasMessage(source) && !msg::isMessage<connection_types::MarkerMessage>(source)) {
+        return updateParameterValueFrom<std::pair<double, double>>(p, source);
+    } else if (msg::hasMessage(source) && !msg::getMessage(source)->isMarker()) {
         node_->ainfo << "parameter " << p->name() << " got a message of unsupported type" << std::endl;
     }
+    return false;
 }
 
 Input* NodeHandle::addInput(TokenDataConstPtr type, const std::string& label, bool optional)
@@ -11,7 +11,7 @@
 
 using namespace csapex;
 
-NodeModifier::NodeModifier() : variadic_(false), node_worker_(nullptr)
+NodeModifier::NodeModifier() : variadic_(false), batch_processing_(false), node_worker_(nullptr)
 {
 }
 NodeModifier::~NodeModifier()
@@ -29,6 +29,16 @@ void NodeModifier::setVariadic(bool variadic)
     variadic_ = variadic;
 }
 
+void NodeModifier::setBatchProcessing(bool batch_processing)
+{
+    batch_processing_ = batch_processing;
+}
+
+bool NodeModifier::isBatchProcessing() const
+{
+    return batch_processing_;
+}
+
 Slot* NodeModifier::addSlot(const std::string& label, std::function<void()> callback, bool active, bool blocking)
 {
     return addSlot(makeEmpty<connection_types::AnyMessage>(), label, [callback](const TokenPtr&) { callback(); }, active, blocking);
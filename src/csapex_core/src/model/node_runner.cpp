@@ -19,6 +19,15 @@
 
 using namespace csapex;
 
+namespace
+{
+std::atomic<bool> g_chain_fusion_enabled(false);
+
+// runners that have become ready while executing a fused chain on this thread
+thread_local std::vector<NodeRunnerPtr>* g_fused_continuations = nullptr;
+thread_local const NodeRunner* g_executing_runner = nullptr;
+}  // namespace
+
 NodeRunner::NodeRunner(NodeWorkerPtr worker)
   : worker_(worker)
   , nh_(worker->getNodeHandle())
@@ -31,6 +40,8 @@ NodeRunner::NodeRunner(NodeWorkerPtr worker)
   , waiting_for_execution_(false)
   , waiting_for_step_(false)
   , suppress_exceptions_(true)
+  , fused_pending_(false)
+  , fused_executions_(0)
 {
     nh_->getNodeState()->max_frequency_changed.connect([this]() {
         max_frequency_ = nh_->getNodeState()->getMaximumFrequency();
@@ -90,7 +101,7 @@ void NodeRunner::connectNodeWorker()
     execute_ = std::make_shared<Task>(std::string("process ") + nh_->getUUID().getFullName(),
                                       [this_weak]() {
                                           if (auto self = this_weak.lock()) {
-                                              self->execute();
+                                              self->executeChain();
                                           }
                                       },
                                       0, this);
@@ -160,7 +171,9 @@ void NodeRunner::scheduleProcess()
             // execute_->setPriority(std::max<long>(0, worker_->getSequenceNumber()));
             // if(worker_->canExecute()) {
             if (!waiting_for_execution_) {
-                schedule(execute_);
+                if (!continueFusedChain()) {
+                    schedule(execute_);
+                }
             }
             //}
         }
@@ -172,6 +185,81 @@ void NodeRunner::checkParameters()
     worker_->handleChangedParameters();
 }
 
+bool NodeRunner::continueFusedChain()
+{
+    if (!g_fused_continuations || !g_chain_fusion_enabled) {
+        return false;
+    }
+
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    NodeRunnerPtr predecessor = fused_predecessor_.lock();
+    if (!predecessor || predecessor.get() != g_executing_runner) {
+        return false;
+    }
+    // only runners of the same thread group may share a task
+    if (!scheduler_ || predecessor->getScheduler() != scheduler_) {
+        return false;
+    }
+
+    if (!fused_pending_.exchange(true)) {
+        g_fused_continuations->push_back(std::dynamic_pointer_cast<NodeRunner>(shared_from_this()));
+    }
+    return true;
+}
+
+void NodeRunner::executeChain()
+{
+    if (g_fused_continuations) {
+        execute();
+        return;
+    }
+
+    std::vector<NodeRunnerPtr> continuations;
+    std::size_t next = 0;
+
+    g_fused_continuations = &continuations;
+    g_executing_runner = this;
+
+    try {
+        execute();
+
+        // executing a member of the chain can append its successor
+        while (next < continuations.size()) {
+            NodeRunnerPtr runner = continuations[next++];
+            runner->fused_pending_ = false;
+
+            if (runner->paused_) {
+                // resuming the runner schedules it again
+                continue;
+            }
+            if (runner->getScheduler() != scheduler_) {
+                // the runner has been moved to another thread group since it joined the chain
+                runner->schedule(runner->execute_);
+                continue;
+            }
+
+            g_executing_runner = runner.get();
+            ++runner->fused_executions_;
+            runner->execute();
+        }
+
+    } catch (...) {
+        g_fused_continuations = nullptr;
+        g_executing_runner = nullptr;
+
+        // don't lose the remaining members of the chain
+        for (; next < continuations.size(); ++next) {
+            NodeRunnerPtr runner = continuations[next];
+            runner->fused_pending_ = false;
+            runner->schedule(runner->execute_);
+        }
+        throw;
+    }
+
+    g_fused_continuations = nullptr;
+    g_executing_runner = nullptr;
+}
+
 void NodeRunner::execute()
 {
     if (stepping_ && can_step_ <= 0) {
@@ -382,3 +470,30 @@ void NodeRunner::setNodeWorker(NodeWorkerPtr worker)
     worker_ = worker;
     connectNodeWorker();
 }
+
+void NodeRunner::setFusedPredecessor(NodeRunnerWeakPtr predecessor)
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    fused_predecessor_ = predecessor;
+}
+
+NodeRunnerPtr NodeRunner::getFusedPredecessor() const
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    return fused_predecessor_.lock();
+}
+
+long NodeRunner::getFusedExecutionCount() const
+{
+    return fused_executions_;
+}
+
+void NodeRunner::setChainFusionEnabled(bool enabled)
+{
+    g_chain_fusion_enabled = enabled;
+}
+
+bool NodeRunner::isChainFusionEnabled()
+{
+    return g_chain_fusion_enabled;
+}
@@ -31,6 +31,7 @@ NodeState::NodeState(const NodeHandle* parent)
   , b_(-1)
   , exec_mode_(ExecutionMode::SEQUENTIAL)
   , exec_type_(ExecutionType::AUTO)
+  , revision_(0)
 {
     if (parent) {
         label_ = parent->getUUID().getFullName();
@@ -78,6 +79,8 @@ NodeState& NodeState::operator=(const NodeState& rhs)
 
     parameter_state->setFrom(*rhs.parameter_state);
 
+    ++revision_;
+
     // then trigger the signals
     (max_frequency_changed)();
     (pos_changed)();
@@ -101,6 +104,7 @@ void NodeState::setMaximumFrequency(double f)
 {
     if (max_frequency_ != f) {
         max_frequency_ = f;
+        ++revision_;
         (max_frequency_changed)();
     }
 }
@@ -119,6 +123,7 @@ void NodeState::setPos(const Point& value, bool quiet)
 {
     if (pos_ != value) {
         pos_ = value;
+        ++revision_;
         if (!quiet) {
             (pos_changed)();
         }
@@ -134,6 +139,7 @@ void NodeState::setZ(long value)
 {
     if (z_ != value) {
         z_ = value;
+        ++revision_;
         (z_changed)();
     }
 }
@@ -151,6 +157,7 @@ void NodeState::setColor(int r, int g, int b)
         r_ = r;
         g_ = g;
         b_ = b;
+        ++revision_;
         (color_changed)();
     }
 }
@@ -164,6 +171,7 @@ void NodeState::setLabel(const std::string& label)
 {
     if (label_ != label) {
         label_ = label;
+        ++revision_;
         (label_changed)();
     }
 }
@@ -177,6 +185,7 @@ void NodeState::setMinimized(bool value)
 {
     if (minimized_ != value) {
         minimized_ = value;
+        ++revision_;
         (minimized_changed)();
     }
 }
@@ -190,6 +199,7 @@ void NodeState::setMuted(bool value)
 {
     if (muted_ != value) {
         muted_ = value;
+        ++revision_;
         (muted_changed)();
     }
 }
@@ -202,6 +212,7 @@ void NodeState::setEnabled(bool value)
 {
     if (enabled_ != value) {
         enabled_ = value;
+        ++revision_;
         (enabled_changed)();
     }
 }
@@ -215,6 +226,7 @@ void NodeState::setActive(bool value)
 {
     if (active_ != value) {
         active_ = value;
+        ++revision_;
         (active_changed)();
     }
 }
@@ -228,6 +240,7 @@ void NodeState::setFlipped(bool value)
 {
     if (flipped_ != value) {
         flipped_ = value;
+        ++revision_;
         (flipped_changed)();
     }
 }
@@ -241,6 +254,11 @@ void NodeState::setParameterState(const GenericStatePtr& value)
     parameter_state->setFrom(*value);
 }
 
+uint64_t NodeState::getRevision() const
+{
+    return revision_ + parameter_state->getRevision();
+}
+
 const NodeHandle* NodeState::getParent() const
 {
     return parent_;
@@ -250,6 +268,7 @@ void NodeState::setParent(const NodeHandle* value)
 {
     if (parent_ != value) {
         parent_ = value;
+        ++revision_;
         (parent_changed)();
     }
 }
@@ -270,6 +289,7 @@ void NodeState::setThread(const std::string& name, int id)
         thread_id_ = id;
         thread_name_ = name;
 
+        ++revision_;
         (thread_changed)();
     }
 }
@@ -283,6 +303,7 @@ void NodeState::setExecutionMode(ExecutionMode mode)
     if (exec_mode_ != mode) {
         exec_mode_ = mode;
 
+        ++revision_;
         (execution_mode_changed)();
     }
 }
@@ -296,6 +317,7 @@ void NodeState::setExecutionType(ExecutionType type)
     if (exec_type_ != type) {
         exec_type_ = type;
 
+        ++revision_;
         (execution_type_changed)();
     }
 }
@@ -309,6 +331,7 @@ void NodeState::setLoggerLevel(int level)
     if (logger_level_ != level) {
         logger_level_ = level;
 
+        ++revision_;
         (logger_level_changed)();
     }
 }
@@ -466,6 +489,81 @@ void NodeState::readYaml(const YAML::Node& node)
     }
 }
 
+void NodeState::writeBinary(SerializationBuffer& data) const
+{
+    data << max_frequency_;
+    data << label_;
+    data << pos_.x << pos_.y;
+    data << r_ << g_ << b_;
+    data << z_;
+    data << minimized_;
+    data << muted_;
+    data << enabled_;
+    data << flipped_;
+    data << exec_mode_;
+    data << exec_type_;
+    data << logger_level_;
+    data << dictionary;
+
+    parameter_state->writeBinary(data);
+}
+
+void NodeState::readBinary(const SerializationBuffer& data)
+{
+    double max_frequency;
+    data >> max_frequency;
+    setMaximumFrequency(max_frequency);
+
+    std::string label;
+    data >> label;
+    if (label.empty()) {
+        label = parent_->getUUID().getFullName();
+    }
+    setLabel(label);
+
+    Point pos;
+    data >> pos.x >> pos.y;
+    setPos(pos);
+
+    int r, g, b;
+    data >> r >> g >> b;
+    setColor(r, g, b);
+
+    long z;
+    data >> z;
+    setZ(z);
+
+    bool flag;
+    data >> flag;
+    setMinimized(flag);
+    data >> flag;
+    setMuted(flag);
+    data >> flag;
+    setEnabled(flag);
+    data >> flag;
+    setFlipped(flag);
+
+    ExecutionMode mode;
+    data >> mode;
+    setExecutionMode(mode);
+
+    ExecutionType type;
+    data >> type;
+    setExecutionType(type);
+
+    int logger_level;
+    data >> logger_level;
+    setLoggerLevel(logger_level);
+
+    std::map<std::string, boost::any> dict;
+    data >> dict;
+    for (const auto& pair : dict) {
+        dictionary[pair.first] = pair.second;
+    }
+
+    parameter_state->readBinary(data);
+}
+
 void NodeState::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
     data << max_frequency_;
@@ -533,6 +631,8 @@ void NodeState::deserialize(const SerializationBuffer& data, const SemanticVersi
     if (yaml.IsDefined()) {
         parameter_state->readYaml(yaml);
     }
+
+    ++revision_;
 }
 
 bool NodeState::hasDictionaryEntry(const std::string& key) const
@@ -543,6 +643,7 @@ bool NodeState::hasDictionaryEntry(const std::string& key) const
 void NodeState::deleteDictionaryEntry(const std::string& key)
 {
     dictionary.erase(key);
+    ++revision_;
 }
 
 template <typename T>
@@ -554,6 +655,7 @@ template <typename T>
 void NodeState::setDictionaryEntry(const std::string& key, const T& value)
 {
     dictionary[key] = value;
+    ++revision_;
 }
 
 namespace csapex
@@ -11,7 +11,11 @@
 #include <csapex/model/node_modifier.h>
 #include <csapex/model/node_state.h>
 #include <csapex/model/subgraph_node.h>
+#include <csapex/model/token.h>
+#include <csapex/model/token_memory.h>
+#include <csapex/model/token_provenance.h>
 #include <csapex/msg/any_message.h>
+#include <csapex/msg/batch_message.h>
 #include <csapex/msg/end_of_sequence_message.h>
 #include <csapex/msg/generic_value_message.hpp>
 #include <csapex/msg/input.h>
@@ -49,6 +53,10 @@ NodeWorker::NodeWorker(NodeHandlePtr node_handle)
   , trigger_deactivated_(nullptr)
   , slot_enable_(nullptr)
   , slot_disable_(nullptr)
+  , process_start_(0)
+  , processing_time_(0)
+  , process_count_(0)
+  , trace_dequeued_(0)
   , guard_(-1)
 {
     //    node_handle->setNodeWorker(this);
@@ -344,10 +352,9 @@ bool NodeWorker::allInputsArePresent()
         }
 
         if (cin->hasReceived()) {
-            if (auto m = std::dynamic_pointer_cast<connection_types::MarkerMessage const>(cin->getToken()->getTokenData())) {
-                if (!std::dynamic_pointer_cast<connection_types::NoMessage const>(m)) {
-                    return false;
-                }
+            TokenDataConstPtr data = cin->getToken()->getTokenData();
+            if (data->isMarker() && !data->isNoMessage()) {
+                return false;
             }
         }
     }
@@ -362,10 +369,9 @@ connection_types::MarkerMessageConstPtr NodeWorker::getFirstMarkerMessage()
     for (const InputPtr& cin : node_handle_->getExternalInputs()) {
         apex_assert_hard(cin->hasReceived() || (cin->isOptional() && !cin->isConnected()));
         if (cin->hasReceived()) {
-            if (auto m = std::dynamic_pointer_cast<connection_types::MarkerMessage const>(cin->getToken()->getTokenData())) {
-                if (cin->isConnected()) {
-                    return m;
-                }
+            TokenDataConstPtr data = cin->getToken()->getTokenData();
+            if (data->isMarker() && cin->isConnected()) {
+                return std::static_pointer_cast<connection_types::MarkerMessage const>(data);
             }
         }
     }
@@ -425,11 +431,23 @@ void NodeWorker::processNode()
 
     try {
         apex_assert_hard(node->getNodeHandle());
+        bool batch = hasIncomingBatch();
+        bool unroll_batch = batch && !node_handle_->isBatchProcessing();
         if (sync) {
-            node->process(*node_handle_, *node);
+            if (unroll_batch) {
+                processBatchElementwise(*node);
+            } else {
+                node->process(*node_handle_, *node);
+                if (batch) {
+                    forwardBatchMarkers(*node);
+                }
+            }
 
         } else {
             try {
+                if (unroll_batch) {
+                    throw std::runtime_error("asynchronous nodes have to opt into batch processing to receive batches");
+                }
                 // TRACE node->ainfo << "process async" << std::endl;
                 node->process(*node_handle_, *node, [this, node](ProcessingFunction f) {
                     node_handle_->execution_requested([this, f, node]() {
@@ -462,6 +480,159 @@ void NodeWorker::processNode()
     }
 }
 
+bool NodeWorker::hasIncomingBatch() const
+{
+    return node_handle_->getInputTransition()->hasForwardedBatch();
+}
+
+void NodeWorker::processBatchElementwise(Node& node)
+{
+    struct BatchedInput
+    {
+        InputPtr input;
+        TokenPtr token;
+        connection_types::BatchMessage::ConstPtr batch;
+    };
+
+    std::vector<BatchedInput> batched_inputs;
+    std::size_t batch_size = 0;
+    for (const InputPtr& input : node_handle_->getExternalInputs()) {
+        if (!input->hasReceived()) {
+            continue;
+        }
+        TokenPtr token = input->getToken();
+        if (token && token->getTokenData()->isBatch()) {
+            auto batch = std::static_pointer_cast<connection_types::BatchMessage const>(token->getTokenData());
+            if (!batched_inputs.empty() && batch->size() != batch_size) {
+                throw std::runtime_error("the inputs received batches of different sizes");
+            }
+            batch_size = batch->size();
+            batched_inputs.push_back(BatchedInput{ input, token, batch });
+        }
+    }
+
+    // the inputs get their batches back, even if processing an element fails
+    struct RestoreTokens
+    {
+        const std::vector<BatchedInput>& inputs;
+
+        ~RestoreTokens()
+        {
+            for (const BatchedInput& batched : inputs) {
+                batched.input->replaceToken(batched.token);
+            }
+        }
+    } restore{ batched_inputs };
+
+    std::vector<OutputPtr> outputs = node_handle_->getExternalOutputs();
+    std::vector<connection_types::BatchMessage::Ptr> output_batches(outputs.size());
+
+    // inputs without a batch keep their single token for all elements
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        connection_types::MarkerMessageConstPtr marker;
+        for (const BatchedInput& batched : batched_inputs) {
+            const TokenDataConstPtr& data = batched.batch->elements[i];
+            if (data->isMarker()) {
+                if (!marker) {
+                    marker = std::static_pointer_cast<connection_types::MarkerMessage const>(data);
+                }
+                continue;
+            }
+            TokenPtr element = std::make_shared<Token>(data);
+            element->setSequenceNumber(batched.token->getSequenceNumber());
+            batched.input->replaceToken(element);
+        }
+
+        if (marker) {
+            // markers are handled like a single token, but stay at their position in the batch
+            processMarker(marker);
+        } else {
+            node.process(*node_handle_, node);
+        }
+
+        for (std::size_t o = 0; o < outputs.size(); ++o) {
+            const OutputPtr& output = outputs[o];
+            if (!output->hasMessage()) {
+                continue;
+            }
+            TokenPtr published = output->getAddedToken();
+            output->clearBuffer();
+            if (!output_batches[o]) {
+                output_batches[o] = std::make_shared<connection_types::BatchMessage>();
+                output_batches[o]->elements.reserve(batch_size);
+            }
+            output_batches[o]->elements.push_back(published->getTokenData());
+        }
+    }
+
+    // re-batch the results, a lone marker is sent as it is
+    for (std::size_t o = 0; o < outputs.size(); ++o) {
+        const connection_types::BatchMessage::Ptr& batch = output_batches[o];
+        if (!batch) {
+            continue;
+        }
+        if (batch->size() == 1 && batch->elements.front()->isMarker()) {
+            msg::publish(outputs[o].get(), batch->elements.front());
+        } else {
+            msg::publish(outputs[o].get(), batch);
+        }
+    }
+}
+
+void NodeWorker::forwardBatchMarkers(Node& node)
+{
+    // nodes that process batches only see the messages, the markers are passed on after them
+    std::vector<connection_types::MarkerMessageConstPtr> markers;
+    for (const InputPtr& input : node_handle_->getExternalInputs()) {
+        if (!input->hasReceived()) {
+            continue;
+        }
+        TokenDataConstPtr data = input->getToken()->getTokenData();
+        if (!data->isBatch()) {
+            continue;
+        }
+        for (const TokenDataConstPtr& element : std::static_pointer_cast<connection_types::BatchMessage const>(data)->elements) {
+            if (element->isMarker()) {
+                markers.push_back(std::static_pointer_cast<connection_types::MarkerMessage const>(element));
+            }
+        }
+        if (!markers.empty()) {
+            break;
+        }
+    }
+
+    if (markers.empty()) {
+        return;
+    }
+
+    for (const connection_types::MarkerMessageConstPtr& marker : markers) {
+        if (!marker->isNoMessage() || node.processNothingMarkers()) {
+            node.processMarker(marker);
+        }
+    }
+
+    for (const OutputPtr& output : node_handle_->getExternalOutputs()) {
+        auto batch = std::make_shared<connection_types::BatchMessage>();
+        if (output->hasMessage()) {
+            TokenDataConstPtr published = output->getAddedToken()->getTokenData();
+            output->clearBuffer();
+            if (published->isBatch()) {
+                batch->elements = std::static_pointer_cast<connection_types::BatchMessage const>(published)->elements;
+            } else {
+                batch->elements.push_back(published);
+            }
+        }
+        for (const connection_types::MarkerMessageConstPtr& marker : markers) {
+            if (!marker->isNoMessage()) {
+                batch->elements.push_back(marker);
+            }
+        }
+        if (!batch->empty()) {
+            msg::publish(output.get(), batch);
+        }
+    }
+}
+
 void NodeWorker::processSlot(const SlotWeakPtr& slot_w)
 {
     if (SlotPtr slot = slot_w.lock()) {
@@ -536,9 +707,7 @@ bool NodeWorker::processMarker(const connection_types::MarkerMessageConstPtr& ma
     NodePtr node = node_handle_->getNode().lock();
     apex_assert_hard(node);
 
-    auto no_message = std::dynamic_pointer_cast<connection_types::NoMessage const>(marker);
-
-    if (no_message) {
+    if (marker->isNoMessage()) {
         if (node->processNothingMarkers()) {
             // process the marker
             node->processMarker(marker);
@@ -576,6 +745,8 @@ bool NodeWorker::startProcessingMessages()
         apex_assert_hard(canProcess());
         apex_assert_hard(!is_processing_);
 
+        trace_dequeued_ = TokenProvenance::isTracingEnabled() ? TokenProvenance::now() : 0;
+
         node_handle_->getInputTransition()->forwardMessages();
 
         apex_assert_hard(node_handle_->getInputTransition()->areMessagesComplete());
@@ -632,6 +803,8 @@ bool NodeWorker::startProcessingMessages()
 
         startProfilerInterval(ActivityType::PROCESS);
 
+        process_start_ = TokenProvenance::now();
+
         // actually call the process function
         processNode();
         return true;
@@ -659,10 +832,18 @@ void NodeWorker::finishProcessing()
 {
     // TRACE getNode()->ainfo << "finish processing" << std::endl;
     if (isProcessing()) {
+        long process_end = TokenProvenance::now();
+        processing_time_ += process_end - process_start_;
+        ++process_count_;
+
         signalExecutionFinished();
 
         // TRACE getNode()->ainfo << "finish processing -> forward messages" << std::endl;
 
+        if (TokenProvenance::isTracingEnabled()) {
+            traceMessages(process_end);
+        }
+
         publishParameters();
         forwardMessages();
 
@@ -672,6 +853,67 @@ void NodeWorker::finishProcessing()
     }
 }
 
+void NodeWorker::traceMessages(long process_end)
+{
+    // the produced messages continue the oldest incoming trace, sources start a new trace
+    TokenProvenanceConstPtr incoming;
+    for (const InputPtr& input : node_handle_->getExternalInputs()) {
+        TokenPtr token = input->getToken();
+        if (!token) {
+            continue;
+        }
+        TokenProvenanceConstPtr provenance = token->getProvenance();
+        if (provenance && (!incoming || provenance->getOrigin() < incoming->getOrigin())) {
+            incoming = provenance;
+        }
+    }
+
+    TokenProvenancePtr provenance = incoming ? std::make_shared<TokenProvenance>(*incoming) : std::make_shared<TokenProvenance>();
+    if (provenance->hops.empty() || provenance->hops.back().node != getUUID()) {
+        provenance->hops.emplace_back(getUUID());
+    }
+
+    TokenHop& hop = provenance->hops.back();
+    if (incoming) {
+        hop.dequeued = trace_dequeued_;
+    }
+    hop.process_start = process_start_;
+    hop.process_end = process_end;
+
+    {
+        std::unique_lock<std::mutex> lock(latency_mutex_);
+        latency_statistics_.record(*provenance);
+    }
+
+    for (const OutputPtr& output : node_handle_->getExternalOutputs()) {
+        if (TokenPtr token = output->getAddedToken()) {
+            token->setProvenance(provenance);
+        }
+    }
+}
+
+TokenLatencyStatistics NodeWorker::getTokenLatencyStatistics() const
+{
+    std::unique_lock<std::mutex> lock(latency_mutex_);
+    return latency_statistics_;
+}
+
+long NodeWorker::getProcessingTime() const
+{
+    return processing_time_;
+}
+
+long NodeWorker::getProcessCount() const
+{
+    return process_count_;
+}
+
+void NodeWorker::resetTokenLatencyStatistics()
+{
+    std::unique_lock<std::mutex> lock(latency_mutex_);
+    latency_statistics_.clear();
+}
+
 void NodeWorker::signalExecutionFinished()
 {
     stopActiveProfilerInterval();
@@ -731,6 +973,11 @@ void NodeWorker::finishTimer(Timer::Ptr t)
 
     t->finish();
     if (t->isEnabled()) {
+        if (TokenMemoryTracker::isAccountingEnabled()) {
+            TokenMemoryStatistics::Usage usage = TokenMemoryTracker::instance().getNodeUsage(node_handle_->getUUID());
+            t->root->setValue("held tokens", usage.count);
+            t->root->setValue("held bytes", usage.bytes);
+        }
         interval_end(this, t->root);
     }
 }
@@ -774,6 +1021,44 @@ bool NodeWorker::canExecute()
     }
 }
 
+namespace
+{
+TokenDataConstPtr makeParameterMessage(const csapex::param::Parameter& p)
+{
+    if (p.is<int>()) {
+        return std::make_shared<connection_types::GenericValueMessage<int>>(p.as<int>(), "/");
+    } else if (p.is<double>()) {
+        return std::make_shared<connection_types::GenericValueMessage<double>>(p.as<double>(), "/");
+    } else if (p.is<bool>()) {
+        return std::make_shared<connection_types::GenericValueMessage<bool>>(p.as<bool>(), "/");
+    } else if (p.is<std::string>()) {
+        return std::make_shared<connection_types::GenericValueMessage<std::string>>(p.as<std::string>(), "/");
+    } else if (p.is<std::pair<int, int>>()) {
+        return std::make_shared<connection_types::GenericValueMessage<std::pair<int, int>>>(p.as<std::pair<int, int>>(), "/");
+    } else if (p.is<std::pair<double, double>>()) {
+        return std::make_shared<connection_types::GenericValueMessage<std::pair<double, double>>>(p.as<std::pair<double, double>>(), "/");
+    }
+    return nullptr;
+}
+
+void publishParameterPort(NodeHandle::ParameterPort& port)
+{
+    if (!port.output->isConnected()) {
+        return;
+    }
+
+    // the message is only rebuilt when the parameter has changed since it was last sent
+    bool changed = port.publish_pending.exchange(false);
+    if (changed || !port.published) {
+        port.published = makeParameterMessage(*port.parameter);
+    }
+
+    if (port.published) {
+        msg::publish(port.output, port.published);
+    }
+}
+}  // namespace
+
 void NodeWorker::publishParameters()
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
@@ -781,43 +1066,21 @@ void NodeWorker::publishParameters()
     apex_assert_hard(isProcessing());
 
     if (!node_handle_->isSink()) {
-        for (auto pair : node_handle_->outputToParamMap()) {
-            auto out = pair.first;
-            auto p = pair.second;
-            publishParameterOn(*p, node_handle_->getOutput(out).get());
+        for (const NodeHandle::ParameterPortPtr& port : node_handle_->getParameterPorts()) {
+            publishParameterPort(*port);
         }
     }
 }
 
 void NodeWorker::publishParameter(csapex::param::Parameter* p)
 {
-    auto map = node_handle_->paramToOutputMap();
-    if (map.find(p->name()) != map.end()) {
-        OutputPtr out = map.at(p->name()).lock();
-        if (out) {
-            publishParameterOn(*p, out.get());
+    for (const NodeHandle::ParameterPortPtr& port : node_handle_->getParameterPorts()) {
+        if (port->parameter == p) {
+            publishParameterPort(*port);
         }
     }
 }
 
-void NodeWorker::publishParameterOn(const csapex::param::Parameter& p, Output* out)
-{
-    if (out->isConnected()) {
-        if (p.is<int>())
-            msg::publish(out, p.as<int>());
-        else if (p.is<double>())
-            msg::publish(out, p.as<double>());
-        if (p.is<bool>())
-            msg::publish(out, p.as<bool>());
-        else if (p.is<std::string>())
-            msg::publish(out, p.as<std::string>());
-        else if (p.is<std::pair<int, int>>())
-            msg::publish(out, p.as<std::pair<int, int>>());
-        else if (p.is<std::pair<double, double>>())
-            msg::publish(out, p.as<std::pair<double, double>>());
-    }
-}
-
 void NodeWorker::sendEvents(bool active)
 {
     bool sent_active_external = false;
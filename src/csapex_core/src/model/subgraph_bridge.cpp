@@ -0,0 +1,34 @@
+/// HEADER
+#include <csapex/model/subgraph_bridge.h>
+
+/// SYSTEM
+#include <stdexcept>
+
+using namespace csapex;
+
+void SubgraphBridgeFactory::setConstructor(Constructor constructor)
+{
+    std::unique_lock<std::recursive_mutex> lock(constructor_mutex_);
+    constructor_ = constructor;
+}
+
+bool SubgraphBridgeFactory::canMakeBridges() const
+{
+    std::unique_lock<std::recursive_mutex> lock(constructor_mutex_);
+    return static_cast<bool>(constructor_);
+}
+
+SubgraphBridgePtr SubgraphBridgeFactory::makeBridge(const std::string& host, int port, const AUUID& remote_subgraph) const
+{
+    Constructor constructor;
+    {
+        std::unique_lock<std::recursive_mutex> lock(constructor_mutex_);
+        constructor = constructor_;
+    }
+
+    if (!constructor) {
+        throw std::runtime_error("remote subgraphs are not supported, csapex_remote is not loaded");
+    }
+
+    return constructor(host, port, remote_subgraph);
+}
@@ -15,6 +15,7 @@
 #include <csapex/param/parameter_factory.h>
 #include <csapex/param/bitset_parameter.h>
 #include <csapex/utility/debug.h>
+#include <csapex/utility/uuid_provider.h>
 #include <csapex/model/node_worker.h>
 
 /// SYSTEM
@@ -37,6 +38,7 @@ SubgraphNode::SubgraphNode(GraphImplementationPtr graph)
   ,
 
   guard_(-1)
+  , is_driven_externally_(false)
 {
     transition_relay_in_->setActivationFunction(delegate::Delegate0<>(this, &SubgraphNode::subgraphHasProducedAllMessages));
     observe(transition_relay_out_->messages_processed, delegate::Delegate0<>(this, &SubgraphNode::currentIterationIsProcessed));
@@ -144,6 +146,13 @@ bool SubgraphNode::canProcess() const
         // TRACE ainfo << "cannot process: not initialized" << std::endl;
         return false;
     }
+    if (is_driven_externally_) {
+        return false;
+    }
+    if (isBridged()) {
+        // the nested graph is not used, the relays don't matter
+        return true;
+    }
     if (!transition_relay_out_->canStartSendingMessages()) {
         // TRACE ainfo << "cannot process, out relay cannot send" << std::endl;
         return false;
@@ -176,10 +185,57 @@ void SubgraphNode::setupParameters(Parameterizable& params)
                                            setIterationEnabled(id, iterate);
                                        }
                                    });
+
+    params.addParameter(param::ParameterFactory::declareBool("remote", param::ParameterDescription("When true, the subgraph is executed by another csapex server"), false),
+                        [this](param::Parameter*) { updateRemoteBridge(); });
+    std::function<bool()> is_remote = [this]() { return readParameter<bool>("remote"); };
+    params.addConditionalParameter(param::ParameterFactory::declareText("remote/host", param::ParameterDescription("Host of the server that executes the subgraph"), "localhost"), is_remote,
+                                   [this](param::Parameter*) { updateRemoteBridge(); });
+    params.addConditionalParameter(param::ParameterFactory::declareRange("remote/port", param::ParameterDescription("Port of the server that executes the subgraph"), 1, 65535, 42123, 1), is_remote,
+                                   [this](param::Parameter*) { updateRemoteBridge(); });
+    params.addConditionalParameter(param::ParameterFactory::declareText("remote/subgraph", param::ParameterDescription("UUID of the subgraph on the server, its ports have to have the same labels"), ""),
+                                   is_remote, [this](param::Parameter*) { updateRemoteBridge(); });
+}
+
+void SubgraphNode::updateRemoteBridge()
+{
+    // only the bridge created here is replaced, a bridge that was set explicitly stays
+    if (remote_bridge_ && getBridge() == remote_bridge_) {
+        setBridge(nullptr);
+    }
+    remote_bridge_.reset();
+
+    if (!readParameter<bool>("remote")) {
+        node_modifier_->setNoError();
+        return;
+    }
+
+    std::string remote_subgraph = readParameter<std::string>("remote/subgraph");
+    if (remote_subgraph.empty()) {
+        node_modifier_->setWarning("no remote subgraph specified");
+        return;
+    }
+
+    try {
+        AUUID uuid(UUIDProvider::makeUUID_without_parent(remote_subgraph));
+        remote_bridge_ = SubgraphBridgeFactory::instance().makeBridge(readParameter<std::string>("remote/host"), readParameter<int>("remote/port"), uuid);
+        setBridge(remote_bridge_);
+        node_modifier_->setNoError();
+
+    } catch (const std::exception& e) {
+        node_modifier_->setError(std::string("cannot connect to the remote subgraph: ") + e.what());
+    }
 }
 
 void SubgraphNode::process(NodeModifier& node_modifier, Parameterizable& params, Continuation continuation)
 {
+    // the bridge can be replaced concurrently, this pass has to stick to the one it started with
+    SubgraphBridgePtr bridge = getBridge();
+    if (bridge) {
+        processBridged(bridge, node_modifier, continuation);
+        return;
+    }
+
     {
         std::unique_lock<std::recursive_mutex> lock(continuation_mutex_);
         continuation_ = continuation;
@@ -216,6 +272,11 @@ void SubgraphNode::process(NodeModifier& node_modifier, Parameterizable& params,
         }
     }
 
+    sendRelayMessages();
+}
+
+void SubgraphNode::sendRelayMessages()
+{
     if (transition_relay_out_->hasConnection()) {
         // TRACE ainfo << "send internal output messages" << std::endl;
         transition_relay_out_->sendMessages(node_handle_->isActive());
@@ -228,6 +289,102 @@ void SubgraphNode::process(NodeModifier& node_modifier, Parameterizable& params,
     }
 }
 
+void SubgraphNode::processBridged(const SubgraphBridgePtr& bridge, NodeModifier& node_modifier, Continuation continuation)
+{
+    SubgraphMessages inputs;
+    for (const InputPtr& i : node_modifier.getMessageInputs()) {
+        if (msg::hasMessage(i.get())) {
+            inputs[i->getLabel()] = msg::getMessage(i.get());
+        }
+    }
+
+    bridge->process(inputs,
+                    [continuation](const SubgraphMessages& outputs) {
+                        continuation([outputs](csapex::NodeModifier& node_modifier, Parameterizable& /*parameters*/) {
+                            for (const OutputPtr& o : node_modifier.getMessageOutputs()) {
+                                auto pos = outputs.find(o->getLabel());
+                                if (pos != outputs.end()) {
+                                    msg::publish(o.get(), pos->second);
+                                }
+                            }
+                        });
+                    },
+                    [continuation](const std::string& error) {
+                        // throwing here would skip finishing the pass, the node would never process again
+                        continuation([error](csapex::NodeModifier& node_modifier, Parameterizable& /*parameters*/) { node_modifier.setError(error); });
+                    });
+}
+
+void SubgraphNode::processExternally(const SubgraphMessages& inputs, SubgraphBridge::Callback done)
+{
+    apex_assert_hard(is_initialized_);
+    apex_assert_hard(is_driven_externally_);
+    // checked before the continuation is set, a pass that cannot start must not block the next one
+    apex_assert_hard(transition_relay_out_->areAllConnections(Connection::State::NOT_INITIALIZED));
+    apex_assert_hard(transition_relay_out_->canStartSendingMessages());
+
+    {
+        std::unique_lock<std::recursive_mutex> lock(continuation_mutex_);
+        apex_assert_hard(!continuation_);
+        continuation_ = [this, done](ProcessingFunction /*function*/) {
+            // nobody reads the external outputs, so they are collected and cleared here
+            SubgraphMessages outputs;
+            for (const OutputPtr& o : node_modifier_->getMessageOutputs()) {
+                if (o->hasMessage()) {
+                    outputs[o->getLabel()] = o->getAddedToken()->getTokenData();
+                }
+                o->clearBuffer();
+            }
+
+            notifyMessagesProcessed();
+
+            done(outputs);
+        };
+    }
+
+    is_iterating_ = false;
+    has_sent_current_iteration_ = false;
+    is_subgraph_finished_ = false;
+
+    for (const InputPtr& i : node_modifier_->getMessageInputs()) {
+        auto pos = inputs.find(i->getLabel());
+        if (pos != inputs.end()) {
+            OutputPtr o = external_to_internal_outputs_.at(i->getUUID());
+            msg::publish(o.get(), pos->second);
+        }
+    }
+
+    sendRelayMessages();
+}
+
+void SubgraphNode::setBridge(SubgraphBridgePtr bridge)
+{
+    std::unique_lock<std::recursive_mutex> lock(bridge_mutex_);
+    bridge_ = bridge;
+}
+
+SubgraphBridgePtr SubgraphNode::getBridge() const
+{
+    std::unique_lock<std::recursive_mutex> lock(bridge_mutex_);
+    return bridge_;
+}
+
+bool SubgraphNode::isBridged() const
+{
+    std::unique_lock<std::recursive_mutex> lock(bridge_mutex_);
+    return bridge_ != nullptr;
+}
+
+void SubgraphNode::setDrivenExternally(bool driven_externally)
+{
+    is_driven_externally_ = driven_externally;
+}
+
+bool SubgraphNode::isDrivenExternally() const
+{
+    return is_driven_externally_;
+}
+
 bool SubgraphNode::isAsynchronous() const
 {
     return true;
@@ -44,20 +44,23 @@
 
 using namespace csapex;
 
-SubprocessNodeWorker::SubprocessNodeWorker(NodeHandlePtr node_handle) : NodeWorker(node_handle), pid_(-1), subprocess_(new Subprocess(node_handle->getUUID().getFullName()))
+SubprocessNodeWorker::SubprocessNodeWorker(NodeHandlePtr node_handle) : SubprocessNodeWorker(node_handle, SubprocessPool::instance().acquire(*node_handle))
 {
 }
 
-void SubprocessNodeWorker::initialize()
+SubprocessNodeWorker::SubprocessNodeWorker(NodeHandlePtr node_handle, std::shared_ptr<SubprocessHost> host) : NodeWorker(node_handle), host_(host)
 {
-    pid_ = subprocess_->fork([this]() { runSubprocessLoop(); });
+    host_->add(this);
+}
 
+void SubprocessNodeWorker::initialize()
+{
     observe(node_handle_->connector_created, [this](ConnectablePtr c, bool internal) {
         if (!internal) {
             node_handle_->execution_requested([this, c]() {
                 SerializationBuffer msg;
                 c->getDescription().serializeVersioned(msg);
-                subprocess_->in.write({ SubprocessChannel::MessageType::PORT_ADD, msg.data(), msg.size() });
+                host_->send(this, SubprocessChannel::MessageType::PORT_ADD, msg.data(), msg.size());
             });
         }
     });
@@ -65,92 +68,75 @@ void SubprocessNodeWorker::initialize()
         node_handle_->execution_requested([this]() {
             SerializationBuffer msg;
             getNodeHandle()->getNodeState()->serializeVersioned(msg);
-            subprocess_->in.write({ SubprocessChannel::MessageType::NODE_STATE_CHANGED, msg.data(), msg.size() });
+            host_->send(this, SubprocessChannel::MessageType::NODE_STATE_CHANGED, msg.data(), msg.size());
         });
     });
 
     NodeWorker::initialize();
 }
 
-void SubprocessNodeWorker::runSubprocessLoop()
+void SubprocessNodeWorker::prepareSubprocess()
 {
-    NodePtr node = getNode();
+    observe(getNode()->getParameterState()->parameter_changed, [this](param::Parameter* p) { changed_parameters_.push_back(p); });
+}
 
-    try {
-        observe(node->getParameterState()->parameter_changed, [&](param::Parameter* p) { changed_parameters_.push_back(p); });
+void SubprocessNodeWorker::handleSubprocessMessage(const SubprocessChannel::Message& msg)
+{
+    NodePtr node = getNode();
 
-        while (subprocess_->isActive()) {
-            // wait for a message
-            SubprocessChannel::Message msg = subprocess_->in.read();
-            if (msg.type == SubprocessChannel::MessageType::SHUTDOWN) {
-                return;
+    switch (msg.type) {
+        case SubprocessChannel::MessageType::PARAMETER_UPDATE:
+            handleParameterUpdate(msg);
+            break;
+
+        case SubprocessChannel::MessageType::PROCESS_SYNC:
+        case SubprocessChannel::MessageType::PROCESS_ASYNC:
+            handleProcessChild(msg);
+            break;
+
+        case SubprocessChannel::MessageType::PROCESS_SLOT:
+            handleProcessSlotChild(msg);
+            break;
+
+        case SubprocessChannel::MessageType::NODE_STATE_CHANGED:
+            node->stateChanged();
+            break;
+
+        case SubprocessChannel::MessageType::PORT_ADD: {
+            ConnectorDescription des;
+            SerializationBuffer buffer(msg.data, msg.length);
+            des.deserializeVersioned(buffer);
+            if (des.is_variadic) {
+                switch (des.connector_type) {
+                    case ConnectorType::INPUT: {
+                        auto vi = std::dynamic_pointer_cast<VariadicInputs>(getNode());
+                        vi->createVariadicInput(des.token_type, des.label, des.optional);
+                    } break;
+                    case ConnectorType::OUTPUT: {
+                        auto vo = std::dynamic_pointer_cast<VariadicOutputs>(getNode());
+                        vo->createVariadicOutput(des.token_type, des.label);
+                    } break;
+                    default:
+                        break;
+                }
+            } else {
+                switch (des.connector_type) {
+                    case ConnectorType::INPUT:
+                        getNodeHandle()->addInput(des.token_type, des.label, des.optional);
+                        break;
+                    case ConnectorType::OUTPUT:
+                        getNodeHandle()->addOutput(des.token_type, des.label);
+                        break;
+                    default:
+                        break;
+                }
             }
 
-            switch (msg.type) {
-                case SubprocessChannel::MessageType::PARAMETER_UPDATE:
-                    handleParameterUpdate(msg);
-                    break;
-
-                case SubprocessChannel::MessageType::PROCESS_SYNC:
-                case SubprocessChannel::MessageType::PROCESS_ASYNC:
-                    handleProcessChild(msg);
-                    break;
-
-                case SubprocessChannel::MessageType::PROCESS_SLOT:
-                    handleProcessSlotChild(msg);
-                    break;
-
-                case SubprocessChannel::MessageType::NODE_STATE_CHANGED:
-                    node->stateChanged();
-                    break;
-
-                case SubprocessChannel::MessageType::PORT_ADD: {
-                    ConnectorDescription des;
-                    SerializationBuffer buffer(msg.data, msg.length);
-                    des.deserializeVersioned(buffer);
-                    if (des.is_variadic) {
-                        switch (des.connector_type) {
-                            case ConnectorType::INPUT: {
-                                auto vi = std::dynamic_pointer_cast<VariadicInputs>(getNode());
-                                vi->createVariadicInput(des.token_type, des.label, des.optional);
-                            } break;
-                            case ConnectorType::OUTPUT: {
-                                auto vo = std::dynamic_pointer_cast<VariadicOutputs>(getNode());
-                                vo->createVariadicOutput(des.token_type, des.label);
-                            } break;
-                            default:
-                                break;
-                        }
-                    } else {
-                        switch (des.connector_type) {
-                            case ConnectorType::INPUT:
-                                getNodeHandle()->addInput(des.token_type, des.label, des.optional);
-                                break;
-                            case ConnectorType::OUTPUT:
-                                getNodeHandle()->addOutput(des.token_type, des.label);
-                                break;
-                            default:
-                                break;
-                        }
-                    }
-
-                } break;
-
-                default:
-                    node->aerr << "subprocess received unknown message: " << (int)msg.type << std::endl;
-                    break;
-            }
-        }
+        } break;
 
-    } catch (const SubprocessChannel::ShutdownException& e) {
-        // ignore
-
-    } catch (const boost::interprocess::interprocess_exception& e) {
-        std::cout << "interprocess exception " << getUUID() << " >> error: " << e.what() << std::endl;
-        std::cout << "native error: " << e.get_native_error() << std::endl;
-        std::cout << "error code:   " << e.get_error_code() << std::endl;
-    } catch (const std::exception& e) {
-        std::cout << "subprocess " << getUUID() << " >> error: " << e.what() << std::endl;
+        default:
+            node->aerr << "subprocess received unknown message: " << (int)msg.type << std::endl;
+            break;
     }
 }
 
@@ -284,14 +270,16 @@ void SubprocessNodeWorker::finishHandleProcessChild()
         node->aerr << "unknown error in finishHandleProcessChild" << std::endl;
     }
 
-    subprocess_->flush();
+    host_->flush();
 
-    subprocess_->out.write({ SubprocessChannel::MessageType::PROCESS_FINISHED, result_emitter.c_str() });
+    host_->send(this, SubprocessChannel::MessageType::PROCESS_FINISHED, result_emitter.c_str());
 }
 
 SubprocessNodeWorker::~SubprocessNodeWorker()
 {
     stopObserving();
+
+    host_->remove(this);
 }
 
 void SubprocessNodeWorker::handleParameterUpdate(const SubprocessChannel::Message& msg)
@@ -331,8 +319,6 @@ void SubprocessNodeWorker::handleProcessParent(const SubprocessChannel::Message&
 
 void SubprocessNodeWorker::processNode()
 {
-    apex_assert(pid_ != -1);
-
     std::unique_lock<std::recursive_mutex> lock(current_exec_mode_mutex_);
 
     NodePtr node = node_handle_->getNode().lock();
@@ -343,7 +329,7 @@ void SubprocessNodeWorker::processNode()
     try {
         apex_assert_hard(node->getNodeHandle());
         if (sync) {
-            apex_assert_msg(pid_ != 0, "processNode called in subprocess");
+            apex_assert_msg(!host_->isChild(), "processNode called in subprocess");
             startSubprocess(SubprocessChannel::MessageType::PROCESS_SYNC);
 
         } else {
@@ -390,12 +376,12 @@ void SubprocessNodeWorker::startSubprocess(const SubprocessChannel::MessageType
     YAML::Emitter emitter;
     emitter << yaml;
 
-    subprocess_->in.write({ type, emitter.c_str() });
+    host_->send(this, type, emitter.c_str());
 }
 
 void SubprocessNodeWorker::processSlot(const SlotWeakPtr& slot_w)
 {
-    apex_assert_msg(pid_ != 0, "processSlot called in subprocess");
+    apex_assert_msg(!host_->isChild(), "processSlot called in subprocess");
 
     SlotPtr slot = slot_w.lock();
     apex_assert_hard(slot);
@@ -428,7 +414,7 @@ void SubprocessNodeWorker::startSubprocessSlot(const SlotPtr& slot)
         YAML::Emitter emitter;
         emitter << yaml;
 
-        subprocess_->in.write({ SubprocessChannel::MessageType::PROCESS_SLOT, emitter.c_str() });
+        host_->send(this, SubprocessChannel::MessageType::PROCESS_SLOT, emitter.c_str());
 
         finishSubprocess();
     }
@@ -442,7 +428,8 @@ void SubprocessNodeWorker::finishSubprocess()
     // wait for the end of processing
 
     while (!done_processing) {
-        SubprocessChannel::Message msg = subprocess_->out.read();
+        SubprocessHost::Envelope envelope = host_->receive(this);
+        SubprocessChannel::Message msg(envelope.type, envelope.payload);
         switch (msg.type) {
             case SubprocessChannel::MessageType::PARAMETER_UPDATE:
                 handleParameterUpdate(msg);
@@ -465,6 +452,12 @@ void SubprocessNodeWorker::finishSubprocess()
                 done_processing = true;
                 break;
 
+            case SubprocessChannel::MessageType::CHILD_ERROR:
+                setError(true, std::string("Child has failed: ") + msg.toString(), ErrorLevel::ERROR);
+                crashed = true;
+                done_processing = true;
+                break;
+
             default:
                 setError(true, std::string("Unhandled subprocess message: ") + std::to_string((int)msg.type), ErrorLevel::WARNING);
                 break;
@@ -474,30 +467,28 @@ void SubprocessNodeWorker::finishSubprocess()
     if (crashed) {
         getNode()->aerr << "*** node crashed! ***" << std::endl;
 
-        std::string out = subprocess_->getChildStdOut();
+        std::string out = host_->readChildStdOut();
         if (!out.empty()) {
             getNode()->aerr << "*** STDOUT: ***" << std::endl;
             getNode()->aerr << out << std::endl;
         }
 
-        std::string err = subprocess_->getChildStdErr();
+        std::string err = host_->readChildStdErr();
         if (!err.empty()) {
             getNode()->aerr << "*** STDERR: ***" << std::endl;
             getNode()->aerr << err << std::endl;
         }
 
+        // the host restarts the process with the next request, together with all other nodes it runs
         getNode()->aerr << "*** restarting subprocess ***" << std::endl;
 
-        subprocess_.reset(new Subprocess(getUUID().getFullName()));
-        pid_ = subprocess_->fork([this]() { runSubprocessLoop(); });
-
     } else {
-        std::string out = subprocess_->getChildStdOut();
+        std::string out = host_->readChildStdOut();
         if (!out.empty()) {
             getNode()->ainfo << out << std::endl;
         }
 
-        std::string err = subprocess_->getChildStdErr();
+        std::string err = host_->readChildStdErr();
         if (!err.empty()) {
             getNode()->aerr << err << std::endl;
         }
@@ -513,11 +504,9 @@ void SubprocessNodeWorker::finishProcessing()
 
 void SubprocessNodeWorker::transmitParameter(const param::ParameterPtr& p)
 {
-    SubprocessChannel& channel = subprocess_->isChild() ? subprocess_->out : subprocess_->in;
-
     SerializationBuffer buffer = PacketSerializer::serializePacket(p);
 
-    channel.write({ SubprocessChannel::MessageType::PARAMETER_UPDATE, buffer.data(), buffer.size() });
+    host_->send(this, SubprocessChannel::MessageType::PARAMETER_UPDATE, buffer.data(), buffer.size());
 }
 
 void SubprocessNodeWorker::handleChangedParametersImpl(const Parameterizable::ChangedParameterList& changed_params)
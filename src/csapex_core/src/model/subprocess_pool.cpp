@@ -0,0 +1,558 @@
+/// HEADER
+#include <csapex/model/subprocess_pool.h>
+
+/// COMPONENT
+#include <csapex/factory/node_factory_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_state.h>
+#include <csapex/model/subprocess_node_worker.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/assert.h>
+#include <csapex/utility/uuid_provider.h>
+
+/// SYSTEM
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <boost/interprocess/exceptions.hpp>
+
+using namespace csapex;
+
+namespace
+{
+bool isRequest(SubprocessChannel::MessageType type)
+{
+    return type == SubprocessChannel::MessageType::PROCESS_SYNC || type == SubprocessChannel::MessageType::PROCESS_ASYNC || type == SubprocessChannel::MessageType::PROCESS_SLOT;
+}
+
+bool isCrash(SubprocessChannel::MessageType type)
+{
+    return type == SubprocessChannel::MessageType::CHILD_SIGNAL || type == SubprocessChannel::MessageType::CHILD_EXIT || type == SubprocessChannel::MessageType::CHILD_ERROR;
+}
+
+/**
+ * Every message starts with the length of the client's name and the name itself, followed by the payload of the node.
+ */
+std::string encode(const std::string& client, const uint8_t* data, std::size_t length)
+{
+    uint32_t client_length = client.size();
+
+    std::string buffer;
+    buffer.reserve(sizeof(client_length) + client.size() + length);
+    buffer.append(reinterpret_cast<const char*>(&client_length), sizeof(client_length));
+    buffer.append(client);
+    if (data) {
+        buffer.append(reinterpret_cast<const char*>(data), length);
+    }
+    return buffer;
+}
+
+bool decode(const SubprocessChannel::Message& msg, std::string& client, std::string& payload)
+{
+    uint32_t client_length;
+    if (!msg.data || msg.length < sizeof(client_length)) {
+        return false;
+    }
+    std::memcpy(&client_length, msg.data, sizeof(client_length));
+    if (msg.length < sizeof(client_length) + client_length) {
+        return false;
+    }
+
+    const char* begin = reinterpret_cast<const char*>(msg.data) + sizeof(client_length);
+    client.assign(begin, client_length);
+    payload.assign(begin + client_length, msg.length - sizeof(client_length) - client_length);
+    return true;
+}
+
+std::string readFrom(const std::string& output, std::size_t& offset)
+{
+    if (output.size() < offset) {
+        // the process was restarted and has produced less output so far
+        offset = 0;
+    }
+    std::string unread = output.substr(offset);
+    offset = output.size();
+    return unread;
+}
+}  // namespace
+
+///
+/// HOST
+///
+
+SubprocessHost::SubprocessHost(const std::string& name_space, NodeFactoryImplementationPtr node_factory)
+  : name_space_(name_space), node_factory_(node_factory), child_pid_(-1), running_(false), starting_(false), is_child_(false), restarts_(0), cout_offset_(0), cerr_offset_(0)
+{
+}
+
+SubprocessHost::~SubprocessHost()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    stop(lock);
+}
+
+void SubprocessHost::add(SubprocessNodeWorker* worker)
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_, std::defer_lock);
+    if (!is_child_) {
+        // the child adopts nodes on its only thread, the lock might have been held by another thread of the parent during the fork
+        lock.lock();
+    }
+    // a replacement worker of the same node takes over its name, the child is introduced to it like to a new node
+    clients_[worker->getUUID().getFullName()] = Client{ worker, {}, false };
+}
+
+void SubprocessHost::remove(SubprocessNodeWorker* worker)
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_, std::defer_lock);
+    if (!is_child_) {
+        lock.lock();
+    }
+    auto pos = clients_.find(worker->getUUID().getFullName());
+    if (pos != clients_.end() && pos->second.worker == worker) {
+        clients_.erase(pos);
+    }
+    forked_workers_.erase(worker);
+    changed_.notify_all();
+}
+
+std::size_t SubprocessHost::getNodeCount() const
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    return clients_.size();
+}
+
+bool SubprocessHost::isChild() const
+{
+    return is_child_;
+}
+
+bool SubprocessHost::isRunning() const
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    return running_;
+}
+
+int SubprocessHost::getRestartCount() const
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    return restarts_;
+}
+
+pid_t SubprocessHost::getChildPid() const
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    return child_pid_;
+}
+
+bool SubprocessHost::isBusy() const
+{
+    for (const auto& pair : clients_) {
+        if (pair.second.waiting) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SubprocessHost::send(SubprocessNodeWorker* worker, SubprocessChannel::MessageType type, const std::string& data)
+{
+    send(worker, type, reinterpret_cast<const uint8_t*>(data.c_str()), data.size());
+}
+
+void SubprocessHost::send(SubprocessNodeWorker* worker, SubprocessChannel::MessageType type, const uint8_t* data, std::size_t length)
+{
+    std::string client = worker->getUUID().getFullName();
+    std::string buffer = encode(client, data, length);
+
+    if (is_child_) {
+        // the child owns a copy of this object, the lock might have been held by another thread of the parent during the fork
+        subprocess_->out.write({ type, reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size() });
+        return;
+    }
+
+    std::shared_ptr<Subprocess> subprocess;
+    std::string introduction;
+    {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+        if (isRequest(type)) {
+            if (ensureRunning(lock, worker)) {
+                NodeHandlePtr node_handle = worker->getNodeHandle();
+                SerializationBuffer description;
+                description << node_handle->getType();
+                node_handle->getNodeState()->serializeVersioned(description);
+                introduction = encode(client, description.data(), description.size());
+            }
+
+            auto pos = clients_.find(client);
+            apex_assert_hard(pos != clients_.end());
+            pos->second.waiting = true;
+
+        } else if (!running_ || forked_workers_.find(worker) == forked_workers_.end()) {
+            return;
+        }
+        subprocess = subprocess_;
+    }
+
+    // writing can block until the child has read the previous message, which in turn can wait for the relay
+    if (!introduction.empty()) {
+        subprocess->in.write({ SubprocessChannel::MessageType::NODE_ADD, reinterpret_cast<const uint8_t*>(introduction.data()), introduction.size() });
+    }
+    subprocess->in.write({ type, reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size() });
+}
+
+SubprocessHost::Envelope SubprocessHost::receive(SubprocessNodeWorker* worker)
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+
+    auto pos = clients_.find(worker->getUUID().getFullName());
+    apex_assert_hard(pos != clients_.end());
+
+    Client& client = pos->second;
+    changed_.wait(lock, [&client]() { return !client.inbox.empty(); });
+
+    Envelope envelope = std::move(client.inbox.front());
+    client.inbox.pop_front();
+    return envelope;
+}
+
+void SubprocessHost::flush()
+{
+    subprocess_->flush();
+}
+
+std::string SubprocessHost::readChildStdOut()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    return subprocess_ ? readFrom(subprocess_->getChildStdOut(), cout_offset_) : std::string();
+}
+
+std::string SubprocessHost::readChildStdErr()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    return subprocess_ ? readFrom(subprocess_->getChildStdErr(), cerr_offset_) : std::string();
+}
+
+bool SubprocessHost::ensureRunning(std::unique_lock<std::recursive_mutex>& lock, SubprocessNodeWorker* worker)
+{
+    while (true) {
+        changed_.wait(lock, [this]() { return !starting_; });
+
+        if (!running_) {
+            break;
+        }
+        if (forked_workers_.find(worker) != forked_workers_.end()) {
+            return false;
+        }
+        if (node_factory_) {
+            // the child constructs the node itself, the other nodes keep their state
+            forked_workers_.insert(worker);
+            return true;
+        }
+        if (!isBusy()) {
+            break;
+        }
+
+        // the child has to answer the requests of the other nodes before it can be replaced
+        changed_.wait(lock, [this]() { return starting_ || !running_ || !isBusy(); });
+    }
+
+    starting_ = true;
+    if (subprocess_) {
+        ++restarts_;
+    }
+    stop(lock);
+
+    start();
+
+    starting_ = false;
+    changed_.notify_all();
+    return false;
+}
+
+void SubprocessHost::start()
+{
+    forked_workers_.clear();
+    for (const auto& pair : clients_) {
+        forked_workers_.insert(pair.second.worker);
+    }
+    cout_offset_ = 0;
+    cerr_offset_ = 0;
+
+    subprocess_ = std::make_shared<Subprocess>(name_space_);
+    child_pid_ = subprocess_->fork([this]() { runChild(); });
+
+    running_ = true;
+
+    std::shared_ptr<Subprocess> subprocess = subprocess_;
+    relay_thread_ = std::thread([this, subprocess]() { relay(subprocess); });
+}
+
+void SubprocessHost::stop(std::unique_lock<std::recursive_mutex>& lock)
+{
+    running_ = false;
+
+    std::shared_ptr<Subprocess> subprocess = std::move(subprocess_);
+    std::thread relay_thread = std::move(relay_thread_);
+
+    // the relay needs the lock to deliver its last message
+    lock.unlock();
+
+    if (subprocess) {
+        subprocess->in.shutdown();
+        subprocess->out.shutdown();
+    }
+    if (relay_thread.joinable()) {
+        relay_thread.join();
+    }
+    // destroying the subprocess joins the child
+    subprocess.reset();
+
+    lock.lock();
+}
+
+void SubprocessHost::runChild()
+{
+    is_child_ = true;
+
+    // the child has its own copy of all hosted nodes and is the only thread using this copy
+    for (auto& pair : clients_) {
+        pair.second.worker->prepareSubprocess();
+    }
+
+    try {
+        while (subprocess_->isActive()) {
+            std::string client;
+            Envelope envelope;
+            {
+                // wait for a message
+                SubprocessChannel::Message msg = subprocess_->in.read();
+                if (msg.type == SubprocessChannel::MessageType::SHUTDOWN) {
+                    return;
+                }
+                envelope.type = msg.type;
+                if (!decode(msg, client, envelope.payload)) {
+                    std::cout << "subprocess " << name_space_ << " >> received an invalid message" << std::endl;
+                    continue;
+                }
+                // releasing the message lets the parent send the next one while this one is handled
+            }
+
+            if (envelope.type == SubprocessChannel::MessageType::NODE_ADD) {
+                try {
+                    adopt(client, envelope.payload);
+                } catch (const std::exception& e) {
+                    std::cout << "subprocess " << client << " >> cannot adopt node: " << e.what() << std::endl;
+                }
+                continue;
+            }
+
+            auto pos = clients_.find(client);
+            if (pos == clients_.end()) {
+                continue;
+            }
+
+            SubprocessNodeWorker* worker = pos->second.worker;
+            try {
+                worker->handleSubprocessMessage(SubprocessChannel::Message(envelope.type, envelope.payload));
+
+            } catch (const std::exception& e) {
+                // the other nodes of this process are not affected
+                std::cout << "subprocess " << worker->getUUID() << " >> error: " << e.what() << std::endl;
+            }
+        }
+
+    } catch (const SubprocessChannel::ShutdownException& e) {
+        // ignore
+
+    } catch (const boost::interprocess::interprocess_exception& e) {
+        std::cout << "interprocess exception " << name_space_ << " >> error: " << e.what() << std::endl;
+        std::cout << "native error: " << e.get_native_error() << std::endl;
+        std::cout << "error code:   " << e.get_error_code() << std::endl;
+    }
+}
+
+void SubprocessHost::adopt(const std::string& client, const std::string& payload)
+{
+    SerializationBuffer description(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+    std::string type;
+    description >> type;
+    NodeStatePtr state = std::make_shared<NodeState>(nullptr);
+    state->deserializeVersioned(description);
+    // the child is the process that executes the node
+    state->setExecutionType(ExecutionType::DIRECT);
+
+    // the node is registered with the copy of its graph, if the child has one
+    UUID parent = UUIDProvider::makeUUID_without_parent(client).parentUUID();
+    UUIDProviderPtr uuid_provider;
+    for (const auto& pair : clients_) {
+        NodeHandlePtr sibling = pair.second.worker->getNodeHandle();
+        if (sibling->getUUID().parentUUID() == parent && sibling->getUUIDProvider()) {
+            uuid_provider = sibling->getUUIDProvider()->shared_from_this();
+            break;
+        }
+    }
+    if (!uuid_provider) {
+        if (!adopted_uuid_provider_) {
+            adopted_uuid_provider_ = std::make_shared<UUIDProvider>();
+        }
+        uuid_provider = adopted_uuid_provider_;
+    }
+
+    NodeFacadeImplementationPtr node = node_factory_->makeNode(type, UUIDProvider::makeUUID_forced(uuid_provider, client), uuid_provider, state);
+    if (!node) {
+        throw std::runtime_error(std::string("cannot construct node of type ") + type);
+    }
+
+    // the worker registers itself as client under the name of the node
+    node->replaceNodeWorker(std::shared_ptr<SubprocessNodeWorker>(new SubprocessNodeWorker(node->getNodeHandle(), shared_from_this())));
+    auto pos = clients_.find(client);
+    apex_assert_hard(pos != clients_.end());
+    pos->second.worker->prepareSubprocess();
+
+    adopted_nodes_.push_back(node);
+}
+
+void SubprocessHost::relay(std::shared_ptr<Subprocess> subprocess)
+{
+    try {
+        while (true) {
+            std::string client;
+            Envelope envelope;
+            {
+                SubprocessChannel::Message msg = subprocess->out.read();
+                envelope.type = msg.type;
+                if (isCrash(msg.type)) {
+                    envelope.payload = msg.toString();
+                } else if (!decode(msg, client, envelope.payload)) {
+                    continue;
+                }
+            }
+
+            std::unique_lock<std::recursive_mutex> lock(mutex_);
+            if (isCrash(envelope.type)) {
+                // every node waiting for the child is affected, the next request restarts it
+                running_ = false;
+                for (auto& pair : clients_) {
+                    Client& waiting = pair.second;
+                    if (waiting.waiting) {
+                        waiting.inbox.push_back(envelope);
+                        waiting.waiting = false;
+                    }
+                }
+                changed_.notify_all();
+                return;
+            }
+
+            auto pos = clients_.find(client);
+            if (pos != clients_.end()) {
+                if (envelope.type == SubprocessChannel::MessageType::PROCESS_FINISHED) {
+                    pos->second.waiting = false;
+                }
+                pos->second.inbox.push_back(std::move(envelope));
+                changed_.notify_all();
+            }
+        }
+
+    } catch (const SubprocessChannel::ShutdownException& e) {
+        // the host is stopped
+    }
+}
+
+///
+/// POOL
+///
+
+SubprocessPool::SubprocessPool() : granularity_(IsolationGranularity::NODE), worker_count_(std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+IsolationGranularity SubprocessPool::parseGranularity(const std::string& name)
+{
+    if (name == "node") {
+        return IsolationGranularity::NODE;
+    } else if (name == "graph") {
+        return IsolationGranularity::GRAPH;
+    } else if (name == "shared") {
+        return IsolationGranularity::SHARED;
+    }
+    throw std::runtime_error(std::string("unknown isolation granularity: ") + name);
+}
+
+void SubprocessPool::setGranularity(IsolationGranularity granularity)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    granularity_ = granularity;
+}
+
+IsolationGranularity SubprocessPool::getGranularity() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return granularity_;
+}
+
+void SubprocessPool::setNodeFactory(NodeFactoryImplementationPtr node_factory)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    node_factory_ = node_factory;
+}
+
+void SubprocessPool::setWorkerCount(std::size_t count)
+{
+    apex_assert_hard(count > 0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    worker_count_ = count;
+}
+
+std::size_t SubprocessPool::getWorkerCount() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return worker_count_;
+}
+
+std::shared_ptr<SubprocessHost> SubprocessPool::acquire(const NodeHandle& node_handle)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (auto it = hosts_.begin(); it != hosts_.end();) {
+        if (it->second.expired()) {
+            it = hosts_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::string key;
+    switch (granularity_) {
+        case IsolationGranularity::NODE:
+            key = node_handle.getUUID().getFullName();
+            break;
+        case IsolationGranularity::GRAPH:
+            key = "graph_" + node_handle.getUUID().parentUUID().getFullName();
+            break;
+        case IsolationGranularity::SHARED: {
+            // the least loaded process gets the node
+            std::size_t min_load = std::numeric_limits<std::size_t>::max();
+            for (std::size_t i = 0; i < worker_count_; ++i) {
+                std::string candidate = "shared_" + std::to_string(i);
+                auto pos = hosts_.find(candidate);
+                std::shared_ptr<SubprocessHost> host = pos != hosts_.end() ? pos->second.lock() : nullptr;
+                std::size_t load = host ? host->getNodeCount() : 0;
+                if (load < min_load) {
+                    min_load = load;
+                    key = candidate;
+                }
+            }
+        } break;
+    }
+
+    std::shared_ptr<SubprocessHost> host = hosts_[key].lock();
+    if (!host) {
+        host = std::make_shared<SubprocessHost>(key, node_factory_.lock());
+        hosts_[key] = host;
+    }
+    return host;
+}
@@ -41,11 +41,32 @@ void Token::setSequenceNumber(int seq_no) const
     seq_no_ = seq_no;
 }
 
+TokenProvenanceConstPtr Token::getProvenance() const
+{
+    return provenance_;
+}
+
+void Token::setProvenance(const TokenProvenanceConstPtr& provenance)
+{
+    provenance_ = provenance;
+}
+
 void Token::cloneData(const Token& other)
 {
     data_ = other.data_->cloneAs<TokenData>();
     activity_modifier_ = other.activity_modifier_;
     seq_no_ = other.seq_no_;
+    provenance_ = other.provenance_;
+}
+
+Token::Ptr Token::makeShallowCopy() const
+{
+    Ptr copy{ new Token };
+    copy->data_ = data_;
+    copy->activity_modifier_ = activity_modifier_;
+    copy->seq_no_ = seq_no_;
+    copy->provenance_ = provenance_;
+    return copy;
 }
 
 Token::Ptr Token::makeEmpty()
@@ -12,16 +12,16 @@
 
 using namespace csapex;
 
-TokenData::TokenData()
+TokenData::TokenData() : kind_(KIND_DATA)
 {
 }
 
-TokenData::TokenData(const std::string& type_name) : type_name_(type_name)
+TokenData::TokenData(const std::string& type_name) : type_name_(type_name), kind_(KIND_DATA)
 {
     setDescriptiveName(type_name);
 }
 
-TokenData::TokenData(const std::string& type_name, const std::string& descriptive_name) : type_name_(type_name), descriptive_name_(descriptive_name)
+TokenData::TokenData(const std::string& type_name, const std::string& descriptive_name) : type_name_(type_name), descriptive_name_(descriptive_name), kind_(KIND_DATA)
 {
 }
 
@@ -34,6 +34,11 @@ void TokenData::setDescriptiveName(const std::string& name)
     descriptive_name_ = name;
 }
 
+void TokenData::addKind(Kind kind)
+{
+    kind_ |= kind;
+}
+
 bool TokenData::canConnectTo(const TokenData* other_side) const
 {
     return other_side->acceptsConnectionFrom(this);
@@ -75,6 +80,11 @@ bool TokenData::isValid() const
     return true;
 }
 
+std::size_t TokenData::getByteSize() const
+{
+    return sizeof(TokenData) + type_name_.capacity() + descriptive_name_.capacity();
+}
+
 bool TokenData::isContainer() const
 {
     return false;
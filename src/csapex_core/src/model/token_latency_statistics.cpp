@@ -0,0 +1,141 @@
+/// HEADER
+#include <csapex/model/token_latency_statistics.h>
+
+/// PROJECT
+#include <csapex/model/token_provenance.h>
+#include <csapex/serialization/io/std_io.h>
+
+/// SYSTEM
+#include <algorithm>
+
+using namespace csapex;
+
+const std::size_t TokenLatencyStatistics::BUCKETS;
+
+TokenLatencyStatistics::Path::Path() : count(0), latency_sum(0), latency_max(0), queued_sum(0), processing_sum(0), histogram(BUCKETS, 0)
+{
+}
+
+double TokenLatencyStatistics::Path::getMeanLatency() const
+{
+    return count > 0 ? latency_sum / static_cast<double>(count) : 0.0;
+}
+
+double TokenLatencyStatistics::Path::getMeanQueuedTime() const
+{
+    return count > 0 ? queued_sum / static_cast<double>(count) : 0.0;
+}
+
+double TokenLatencyStatistics::Path::getMeanProcessingTime() const
+{
+    return count > 0 ? processing_sum / static_cast<double>(count) : 0.0;
+}
+
+int64_t TokenLatencyStatistics::Path::getPercentile(double p) const
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * count + 0.5));
+    uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+        seen += histogram[bucket];
+        if (seen >= rank) {
+            return std::min(latency_max, (int64_t(1) << (bucket + 1)) - 1);
+        }
+    }
+    return latency_max;
+}
+
+TokenLatencyStatistics::TokenLatencyStatistics()
+{
+}
+
+void TokenLatencyStatistics::record(const TokenProvenance& provenance)
+{
+    if (provenance.hops.empty()) {
+        return;
+    }
+
+    std::string key;
+    for (const TokenHop& hop : provenance.hops) {
+        if (!key.empty()) {
+            key += " > ";
+        }
+        key += hop.node.getFullName();
+    }
+
+    Path& path = paths_[key];
+    if (path.nodes.empty()) {
+        path.nodes.reserve(provenance.hops.size());
+        for (const TokenHop& hop : provenance.hops) {
+            path.nodes.push_back(hop.node.getFullName());
+        }
+    }
+
+    int64_t latency = std::max(0l, provenance.hops.back().process_end - provenance.getOrigin());
+
+    std::size_t bucket = 0;
+    while (bucket + 1 < BUCKETS && (latency >> (bucket + 1)) > 0) {
+        ++bucket;
+    }
+
+    ++path.count;
+    path.latency_sum += latency;
+    path.latency_max = std::max(path.latency_max, latency);
+    path.queued_sum += provenance.getQueuedTime();
+    path.processing_sum += provenance.getProcessingTime();
+    ++path.histogram[bucket];
+}
+
+void TokenLatencyStatistics::clear()
+{
+    paths_.clear();
+}
+
+bool TokenLatencyStatistics::empty() const
+{
+    return paths_.empty();
+}
+
+const std::map<std::string, TokenLatencyStatistics::Path>& TokenLatencyStatistics::getPaths() const
+{
+    return paths_;
+}
+
+void TokenLatencyStatistics::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << paths_.size();
+    for (const auto& pair : paths_) {
+        const Path& path = pair.second;
+        data << pair.first;
+        data << path.nodes;
+        data << path.count;
+        data << path.latency_sum;
+        data << path.latency_max;
+        data << path.queued_sum;
+        data << path.processing_sum;
+        data << path.histogram;
+    }
+}
+
+void TokenLatencyStatistics::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    paths_.clear();
+
+    std::size_t n;
+    data >> n;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string key;
+        data >> key;
+        Path& path = paths_[key];
+        data >> path.nodes;
+        data >> path.count;
+        data >> path.latency_sum;
+        data >> path.latency_max;
+        data >> path.queued_sum;
+        data >> path.processing_sum;
+        data >> path.histogram;
+    }
+}
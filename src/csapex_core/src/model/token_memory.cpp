@@ -0,0 +1,338 @@
+/// HEADER
+#include <csapex/model/token_memory.h>
+
+/// PROJECT
+#include <csapex/model/token.h>
+#include <csapex/model/token_data.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/utility/assert.h>
+
+/// SYSTEM
+#include <atomic>
+
+using namespace csapex;
+
+namespace
+{
+std::atomic<bool> g_accounting_enabled(false);
+
+void serializeUsage(SerializationBuffer& data, const TokenMemoryStatistics::Usage& usage)
+{
+    data << usage.count;
+    data << usage.bytes;
+}
+
+void deserializeUsage(const SerializationBuffer& data, TokenMemoryStatistics::Usage& usage)
+{
+    data >> usage.count;
+    data >> usage.bytes;
+}
+
+void serializeUsageMap(SerializationBuffer& data, const TokenMemoryStatistics::UsageMap& map)
+{
+    data << map.size();
+    for (const auto& pair : map) {
+        data << pair.first;
+        serializeUsage(data, pair.second);
+    }
+}
+
+void deserializeUsageMap(const SerializationBuffer& data, TokenMemoryStatistics::UsageMap& map)
+{
+    map.clear();
+
+    std::size_t n;
+    data >> n;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string key;
+        data >> key;
+        deserializeUsage(data, map[key]);
+    }
+}
+}  // namespace
+
+///
+/// STATISTICS
+///
+
+TokenMemoryStatistics::Usage::Usage() : count(0), bytes(0)
+{
+}
+
+TokenMemoryStatistics::TokenMemoryStatistics()
+{
+}
+
+bool TokenMemoryStatistics::empty() const
+{
+    return total_.count == 0;
+}
+
+const TokenMemoryStatistics::Usage& TokenMemoryStatistics::getTotal() const
+{
+    return total_;
+}
+
+const TokenMemoryStatistics::UsageMap& TokenMemoryStatistics::getTypes() const
+{
+    return types_;
+}
+
+const TokenMemoryStatistics::UsageMap& TokenMemoryStatistics::getOutputs() const
+{
+    return outputs_;
+}
+
+const TokenMemoryStatistics::UsageMap& TokenMemoryStatistics::getNodes() const
+{
+    return nodes_;
+}
+
+const TokenMemoryStatistics::UsageMap& TokenMemoryStatistics::getConnections() const
+{
+    return connections_;
+}
+
+TokenMemoryStatistics::Usage TokenMemoryStatistics::getNodeUsage(const UUID& node) const
+{
+    auto pos = nodes_.find(node.getFullName());
+    return pos != nodes_.end() ? pos->second : Usage();
+}
+
+void TokenMemoryStatistics::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    serializeUsage(data, total_);
+    serializeUsageMap(data, types_);
+    serializeUsageMap(data, outputs_);
+    serializeUsageMap(data, nodes_);
+    serializeUsageMap(data, connections_);
+}
+
+void TokenMemoryStatistics::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    deserializeUsage(data, total_);
+    deserializeUsageMap(data, types_);
+    deserializeUsageMap(data, outputs_);
+    deserializeUsageMap(data, nodes_);
+    deserializeUsageMap(data, connections_);
+}
+
+///
+/// TRACKER
+///
+
+bool TokenMemoryTracker::isAccountingEnabled()
+{
+    return g_accounting_enabled;
+}
+
+void TokenMemoryTracker::setAccountingEnabled(bool enabled)
+{
+    g_accounting_enabled = enabled;
+}
+
+TokenMemoryTracker::TokenMemoryTracker()
+{
+}
+
+TokenMemoryStatistics TokenMemoryTracker::getStatistics() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+TokenMemoryStatistics::Usage TokenMemoryTracker::getNodeUsage(const UUID& node) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return statistics_.getNodeUsage(node);
+}
+
+std::size_t TokenMemoryTracker::acquire(const TokenDataConstPtr& data)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto pos = payloads_.find(data.get());
+    if (pos != payloads_.end()) {
+        ++pos->second.leases;
+        return pos->second.bytes;
+    }
+
+    // the size is determined once, payloads must not change while they are in flight
+    lock.unlock();
+    Payload payload{ 1, data->getByteSize(), data->descriptiveName() };
+    lock.lock();
+
+    auto inserted = payloads_.emplace(data.get(), payload);
+    if (!inserted.second) {
+        ++inserted.first->second.leases;
+        return inserted.first->second.bytes;
+    }
+
+    ++statistics_.total_.count;
+    statistics_.total_.bytes += payload.bytes;
+    add(statistics_.types_, payload.type, payload.bytes);
+
+    return payload.bytes;
+}
+
+void TokenMemoryTracker::release(const TokenDataConstPtr& data)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto pos = payloads_.find(data.get());
+    apex_assert_hard(pos != payloads_.end());
+
+    Payload& payload = pos->second;
+    if (--payload.leases > 0) {
+        return;
+    }
+
+    --statistics_.total_.count;
+    statistics_.total_.bytes -= payload.bytes;
+    remove(statistics_.types_, payload.type, payload.bytes);
+
+    payloads_.erase(pos);
+}
+
+void TokenMemoryTracker::add(TokenMemoryStatistics::UsageMap& map, const std::string& key, std::size_t bytes)
+{
+    TokenMemoryStatistics::Usage& usage = map[key];
+    ++usage.count;
+    usage.bytes += bytes;
+}
+
+void TokenMemoryTracker::remove(TokenMemoryStatistics::UsageMap& map, const std::string& key, std::size_t bytes)
+{
+    auto pos = map.find(key);
+    apex_assert_hard(pos != map.end());
+
+    TokenMemoryStatistics::Usage& usage = pos->second;
+    --usage.count;
+    usage.bytes -= bytes;
+
+    if (usage.count == 0) {
+        map.erase(pos);
+    }
+}
+
+void TokenMemoryTracker::addOutput(const std::string& output, const std::string& node, std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    add(statistics_.outputs_, output, bytes);
+    add(statistics_.nodes_, node, bytes);
+}
+
+void TokenMemoryTracker::removeOutput(const std::string& output, const std::string& node, std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    remove(statistics_.outputs_, output, bytes);
+    remove(statistics_.nodes_, node, bytes);
+}
+
+void TokenMemoryTracker::addConnection(const std::string& connection, std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    add(statistics_.connections_, connection, bytes);
+}
+
+void TokenMemoryTracker::removeConnection(const std::string& connection, std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    remove(statistics_.connections_, connection, bytes);
+}
+
+///
+/// LEASE
+///
+
+TokenMemoryLease::TokenMemoryLease() : holder_(Holder::NONE), bytes_(0)
+{
+}
+
+TokenMemoryLease::~TokenMemoryLease()
+{
+    release();
+}
+
+bool TokenMemoryLease::isHeld() const
+{
+    return data_ != nullptr;
+}
+
+bool TokenMemoryLease::holds(const TokenPtr& token) const
+{
+    return token && data_ == token->getTokenData();
+}
+
+bool TokenMemoryLease::acquire(const TokenPtr& token)
+{
+    release();
+
+    if (!token || !TokenMemoryTracker::isAccountingEnabled()) {
+        return false;
+    }
+
+    data_ = token->getTokenData();
+    if (!data_) {
+        return false;
+    }
+
+    bytes_ = TokenMemoryTracker::instance().acquire(data_);
+    return true;
+}
+
+void TokenMemoryLease::holdForOutput(const UUID& output, const TokenPtr& token)
+{
+    if (!data_ && !TokenMemoryTracker::isAccountingEnabled()) {
+        return;
+    }
+    if (holds(token)) {
+        return;
+    }
+    if (acquire(token)) {
+        holder_ = Holder::OUTPUT;
+        site_ = output.getFullName();
+        node_ = output.parentUUID().getFullName();
+        TokenMemoryTracker::instance().addOutput(site_, node_, bytes_);
+    }
+}
+
+void TokenMemoryLease::holdForConnection(const std::string& connection, const TokenPtr& token)
+{
+    if (!data_ && !TokenMemoryTracker::isAccountingEnabled()) {
+        return;
+    }
+    if (holds(token)) {
+        return;
+    }
+    if (acquire(token)) {
+        holder_ = Holder::CONNECTION;
+        site_ = connection;
+        TokenMemoryTracker::instance().addConnection(site_, bytes_);
+    }
+}
+
+void TokenMemoryLease::release()
+{
+    if (!data_) {
+        return;
+    }
+
+    // a lease that was taken is always returned, even if accounting has been disabled in the meantime
+    TokenMemoryTracker& tracker = TokenMemoryTracker::instance();
+    switch (holder_) {
+        case Holder::OUTPUT:
+            tracker.removeOutput(site_, node_, bytes_);
+            break;
+        case Holder::CONNECTION:
+            tracker.removeConnection(site_, bytes_);
+            break;
+        case Holder::NONE:
+            break;
+    }
+    tracker.release(data_);
+
+    holder_ = Holder::NONE;
+    data_.reset();
+    bytes_ = 0;
+}
@@ -0,0 +1,63 @@
+/// HEADER
+#include <csapex/model/token_provenance.h>
+
+/// SYSTEM
+#include <atomic>
+#include <chrono>
+
+using namespace csapex;
+
+namespace
+{
+std::atomic<bool> g_tracing_enabled(false);
+}
+
+TokenHop::TokenHop() : enqueued(0), dequeued(0), process_start(0), process_end(0)
+{
+}
+
+TokenHop::TokenHop(const UUID& node) : node(node), enqueued(0), dequeued(0), process_start(0), process_end(0)
+{
+}
+
+bool TokenProvenance::isTracingEnabled()
+{
+    return g_tracing_enabled.load(std::memory_order_relaxed);
+}
+
+void TokenProvenance::setTracingEnabled(bool enabled)
+{
+    g_tracing_enabled = enabled;
+}
+
+long TokenProvenance::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+long TokenProvenance::getOrigin() const
+{
+    return hops.empty() ? 0 : hops.front().process_start;
+}
+
+long TokenProvenance::getQueuedTime() const
+{
+    long sum = 0;
+    for (const TokenHop& hop : hops) {
+        if (hop.enqueued > 0 && hop.dequeued > 0) {
+            sum += hop.dequeued - hop.enqueued;
+        }
+    }
+    return sum;
+}
+
+long TokenProvenance::getProcessingTime() const
+{
+    long sum = 0;
+    for (const TokenHop& hop : hops) {
+        if (hop.process_start > 0 && hop.process_end > 0) {
+            sum += hop.process_end - hop.process_start;
+        }
+    }
+    return sum;
+}
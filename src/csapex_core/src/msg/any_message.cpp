@@ -11,6 +11,7 @@ using namespace connection_types;
 
 AnyMessage::AnyMessage() : Message(type<AnyMessage>::name(), "/", 0)
 {
+    addKind(KIND_ANY);
 }
 
 bool AnyMessage::canConnectTo(const TokenData*) const
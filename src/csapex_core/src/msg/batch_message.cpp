@@ -0,0 +1,77 @@
+/// HEADER
+#include <csapex/msg/batch_message.h>
+
+/// PROJECT
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/message_serializer.h>
+#include <csapex/utility/register_msg.h>
+
+CSAPEX_REGISTER_MESSAGE(csapex::connection_types::BatchMessage)
+
+using namespace csapex;
+using namespace connection_types;
+
+BatchMessage::BatchMessage() : Message(type<BatchMessage>::name(), "/", 0)
+{
+    addKind(KIND_BATCH);
+}
+
+std::size_t BatchMessage::size() const
+{
+    return elements.size();
+}
+
+bool BatchMessage::empty() const
+{
+    return elements.empty();
+}
+
+bool BatchMessage::containsMarkers() const
+{
+    for (const TokenDataConstPtr& element : elements) {
+        if (element->isMarker()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BatchMessage::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    Message::serialize(data, version);
+    data << elements;
+}
+void BatchMessage::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    Message::deserialize(data, version);
+    elements.clear();
+    data >> elements;
+}
+
+/// YAML
+namespace YAML
+{
+Node convert<csapex::connection_types::BatchMessage>::encode(const csapex::connection_types::BatchMessage& rhs)
+{
+    Node node = convert<csapex::connection_types::Message>::encode(rhs);
+    for (const csapex::TokenDataConstPtr& element : rhs.elements) {
+        node["elements"].push_back(csapex::MessageSerializer::serializeYamlMessage(*element));
+    }
+    return node;
+}
+
+bool convert<csapex::connection_types::BatchMessage>::decode(const Node& node, csapex::connection_types::BatchMessage& rhs)
+{
+    if (!node.IsMap()) {
+        return false;
+    }
+    convert<csapex::connection_types::Message>::decode(node, rhs);
+    rhs.elements.clear();
+    if (node["elements"].IsDefined()) {
+        for (const Node& element : node["elements"]) {
+            rhs.elements.push_back(csapex::MessageSerializer::readYaml(element));
+        }
+    }
+    return true;
+}
+}  // namespace YAML
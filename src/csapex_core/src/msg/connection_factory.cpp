@@ -0,0 +1,30 @@
+/// HEADER
+#include <csapex/msg/connection_factory.h>
+
+/// PROJECT
+#include <csapex/msg/direct_connection.h>
+#include <csapex/msg/latest_value_connection.h>
+
+using namespace csapex;
+
+ConnectionPtr connection_factory::connect(OutputPtr from, InputPtr to, ConnectionPolicy policy)
+{
+    switch (policy) {
+        case ConnectionPolicy::LATEST_VALUE:
+            return LatestValueConnection::connect(from, to);
+        case ConnectionPolicy::HANDSHAKE:
+        default:
+            return DirectConnection::connect(from, to);
+    }
+}
+
+ConnectionPtr connection_factory::connect(OutputPtr from, InputPtr to, int id, ConnectionPolicy policy)
+{
+    switch (policy) {
+        case ConnectionPolicy::LATEST_VALUE:
+            return LatestValueConnection::connect(from, to, id);
+        case ConnectionPolicy::HANDSHAKE:
+        default:
+            return DirectConnection::connect(from, to, id);
+    }
+}
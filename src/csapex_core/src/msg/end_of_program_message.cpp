@@ -11,6 +11,7 @@ using namespace connection_types;
 
 EndOfProgramMessage::EndOfProgramMessage() : EndOfSequenceMessage(type<EndOfProgramMessage>::name())
 {
+    addKind(KIND_END_OF_PROGRAM);
 }
 
 /// YAML
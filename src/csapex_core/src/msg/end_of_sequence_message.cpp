@@ -11,10 +11,12 @@ using namespace connection_types;
 
 EndOfSequenceMessage::EndOfSequenceMessage() : MarkerMessage(type<EndOfSequenceMessage>::name(), 0)
 {
+    addKind(KIND_END_OF_SEQUENCE);
 }
 
 EndOfSequenceMessage::EndOfSequenceMessage(const std::string& name) : MarkerMessage(name, 0)
 {
+    addKind(KIND_END_OF_SEQUENCE);
 }
 
 void EndOfSequenceMessage::serialize(SerializationBuffer& data, SemanticVersion& version) const
@@ -69,7 +69,7 @@ bool GenericVectorMessage::AnythingImplementation::acceptsConnectionFrom(const T
     } else if (dynamic_cast<const GenericVectorMessage*>(other_side)) {
         return true;
     } else {
-        return dynamic_cast<const AnyMessage*>(other_side) != nullptr;
+        return other_side->isAny();
     }
 }
 
@@ -69,7 +69,7 @@ bool Input::hasMessage() const
     }
 
     std::unique_lock<std::mutex> lock(message_mutex_);
-    return !std::dynamic_pointer_cast<connection_types::MarkerMessage const>(message_->getTokenData());
+    return !message_->getTokenData()->isMarker();
 }
 
 void Input::stop()
@@ -138,7 +138,7 @@ void Input::setToken(TokenPtr message)
 {
     apex_assert_hard(message != nullptr);
 
-    if (!std::dynamic_pointer_cast<connection_types::MarkerMessage const>(message->getTokenData())) {
+    if (!message->getTokenData()->isMarker()) {
         int s = message->getSequenceNumber();
 
         //    if(s < sequenceNumber()) {
@@ -160,6 +160,14 @@ void Input::setToken(TokenPtr message)
     message_set(this);
 }
 
+void Input::replaceToken(TokenPtr message)
+{
+    apex_assert_hard(message != nullptr);
+
+    std::unique_lock<std::mutex> lock(message_mutex_);
+    message_ = message;
+}
+
 void Input::notifyMessageAvailable(Connection* connection)
 {
     message_available(connection);
@@ -15,11 +15,11 @@
 
 using namespace csapex;
 
-InputTransition::InputTransition(delegate::Delegate0<> activation_fn) : Transition(activation_fn), forwarded_(false), processed_(false)
+InputTransition::InputTransition(delegate::Delegate0<> activation_fn) : Transition(activation_fn), forwarded_(false), processed_(false), has_batch_(false)
 {
 }
 
-InputTransition::InputTransition() : Transition(), forwarded_(false), processed_(false)
+InputTransition::InputTransition() : Transition(), forwarded_(false), processed_(false), has_batch_(false)
 {
 }
 
@@ -96,6 +96,7 @@ void InputTransition::reset()
 
     forwarded_ = false;
     processed_ = false;
+    has_batch_ = false;
 
     Transition::reset();
 }
@@ -246,6 +247,8 @@ void InputTransition::forwardMessages()
         return;
     }
 
+    has_batch_ = false;
+
     if (hasConnection()) {
         apex_assert_hard(!forwarded_);
 
@@ -267,6 +270,10 @@ void InputTransition::forwardMessages()
                 TokenPtr token = connection->getToken();
                 apex_assert_hard(token != nullptr);
                 input->setToken(token);
+
+                if (token->getTokenData()->isBatch()) {
+                    has_batch_ = true;
+                }
             } else {
                 input->setToken(connection_types::makeEmptyToken<connection_types::NoMessage>());
             }
@@ -293,6 +300,11 @@ void InputTransition::forwardMessages()
     forwarded_ = true;
 }
 
+bool InputTransition::hasForwardedBatch() const
+{
+    return has_batch_;
+}
+
 bool InputTransition::areMessagesProcessed() const
 {
     return processed_;
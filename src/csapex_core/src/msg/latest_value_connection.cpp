@@ -0,0 +1,140 @@
+/// HEADER
+#include <csapex/msg/latest_value_connection.h>
+
+/// PROJECT
+#include <csapex/model/token.h>
+#include <csapex/model/token_data.h>
+#include <csapex/msg/input.h>
+#include <csapex/msg/output.h>
+#include <csapex/utility/assert.h>
+
+using namespace csapex;
+
+namespace
+{
+bool isValue(const TokenPtr& token)
+{
+    return token && !token->getTokenData()->isMarker();
+}
+}  // namespace
+
+ConnectionPtr LatestValueConnection::connect(OutputPtr from, InputPtr to)
+{
+    apex_assert_hard(from);
+    apex_assert_hard(to);
+    if (!Connection::canBeConnectedTo(from.get(), to.get())) {
+        return nullptr;
+    }
+    ConnectionPtr r(new LatestValueConnection(from, to));
+    from->addConnection(r);
+    to->addConnection(r);
+    return r;
+}
+ConnectionPtr LatestValueConnection::connect(OutputPtr from, InputPtr to, int id)
+{
+    apex_assert_hard(from);
+    apex_assert_hard(to);
+    if (!Connection::canBeConnectedTo(from.get(), to.get())) {
+        return nullptr;
+    }
+    ConnectionPtr r(new LatestValueConnection(from, to, id));
+    from->addConnection(r);
+    to->addConnection(r);
+    return r;
+}
+
+LatestValueConnection::~LatestValueConnection()
+{
+}
+
+LatestValueConnection::LatestValueConnection(OutputPtr from, InputPtr to) : Connection(from, to), delivering_(false), dropped_(0)
+{
+}
+
+LatestValueConnection::LatestValueConnection(OutputPtr from, InputPtr to, int id) : Connection(from, to, id), delivering_(false), dropped_(0)
+{
+}
+
+ConnectionPolicy LatestValueConnection::getPolicy() const
+{
+    return ConnectionPolicy::LATEST_VALUE;
+}
+
+Connection::State LatestValueConnection::getSourceState() const
+{
+    // the output never has to wait for the input
+    return State::DONE;
+}
+
+long LatestValueConnection::getDroppedCount() const
+{
+    return dropped_;
+}
+
+void LatestValueConnection::setToken(const TokenPtr& token)
+{
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+
+        bool replaced = false;
+        if (isValue(token)) {
+            if (!pending_.empty()) {
+                if (isValue(pending_.back())) {
+                    pending_.back() = token;
+                    replaced = true;
+                }
+
+            } else if (state_ == State::UNREAD && isValue(message_)) {
+                // the input has been notified but did not read the value yet, hand it the newer one instead
+                message_ = prepareToken(token);
+                updateMemoryLease();
+                replaced = true;
+            }
+        }
+
+        if (replaced) {
+            ++dropped_;
+        } else {
+            pending_.push_back(token);
+        }
+    }
+
+    deliverPending();
+}
+
+void LatestValueConnection::reset()
+{
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        pending_.clear();
+    }
+    Connection::reset();
+}
+
+void LatestValueConnection::notifyMessageProcessed()
+{
+    // the output was released when the token arrived, the input is ready for the next one
+    deliverPending();
+}
+
+void LatestValueConnection::deliverPending()
+{
+    while (true) {
+        TokenPtr next;
+        {
+            std::unique_lock<std::recursive_mutex> lock(sync);
+            if (delivering_ || state_ != State::NOT_INITIALIZED || pending_.empty()) {
+                return;
+            }
+            next = pending_.front();
+            pending_.pop_front();
+            delivering_ = true;
+        }
+
+        // the input is notified without holding the lock, tokens that arrive in the meantime stay pending
+        Connection::setToken(next);
+
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        delivering_ = false;
+    }
+}
@@ -6,6 +6,7 @@ using namespace connection_types;
 
 MarkerMessage::MarkerMessage(const std::string& name, Stamp stamp) : Message(name, "/", stamp)
 {
+    addKind(KIND_MARKER);
 }
 
 bool MarkerMessage::canConnectTo(const TokenData*) const
@@ -0,0 +1,122 @@
+/// HEADER
+#include <csapex/msg/message_log_provider.h>
+
+/// COMPONENT
+#include <csapex/core/settings.h>
+#include <csapex/param/parameter_factory.h>
+#include <csapex/param/range_parameter.h>
+#include <csapex/serialization/message_log.h>
+
+/// SYSTEM
+#include <algorithm>
+
+using namespace csapex;
+
+std::shared_ptr<MessageProvider> MessageLogProvider::make()
+{
+    return std::shared_ptr<MessageProvider>(new MessageLogProvider);
+}
+
+MessageLogProvider::MessageLogProvider() : position_(0), requested_position_(0), stamp_start_(0)
+{
+    state.addParameter(csapex::param::ParameterFactory::declareBool("playback/original_timing", true));
+    state.addParameter(csapex::param::ParameterFactory::declareBool("playback/loop", false));
+    state.addParameter(csapex::param::ParameterFactory::declareRange("playback/position", 0, 0, 0, 1));
+}
+
+MessageLogProvider::~MessageLogProvider()
+{
+}
+
+void MessageLogProvider::load(const std::string& file)
+{
+    reader_.reset(new MessageLogReader(file));
+
+    if (reader_->count() > 0) {
+        setType(reader_->read(0)->toType());
+    }
+    setSlotCount(1);
+
+    if (auto position = std::dynamic_pointer_cast<param::RangeParameter>(state.getParameter("playback/position"))) {
+        position->setInterval<int>(0, std::max<int>(0, reader_->count() - 1));
+    }
+
+    seek(0);
+}
+
+void MessageLogProvider::parameterChanged()
+{
+    int requested = state.readParameter<int>("playback/position");
+    if (requested != requested_position_) {
+        requested_position_ = requested;
+        seek(requested);
+    }
+}
+
+void MessageLogProvider::seek(std::size_t index)
+{
+    position_ = index;
+    playback_start_ = std::chrono::steady_clock::now();
+    stamp_start_ = (reader_ && index < reader_->count()) ? reader_->getStamp(index) : 0;
+}
+
+std::size_t MessageLogProvider::getPosition() const
+{
+    return position_;
+}
+
+std::size_t MessageLogProvider::count() const
+{
+    return reader_ ? reader_->count() : 0;
+}
+
+void MessageLogProvider::restart()
+{
+    seek(0);
+}
+
+bool MessageLogProvider::hasNext()
+{
+    if (!reader_ || reader_->count() == 0) {
+        return false;
+    }
+
+    if (position_ >= reader_->count()) {
+        if (!state.readParameter<bool>("playback/loop")) {
+            return false;
+        }
+        seek(0);
+    }
+
+    if (state.readParameter<bool>("playback/original_timing")) {
+        auto due = playback_start_ + std::chrono::microseconds(reader_->getStamp(position_) - stamp_start_);
+        return std::chrono::steady_clock::now() >= due;
+    }
+    return true;
+}
+
+connection_types::Message::Ptr MessageLogProvider::next(std::size_t /*slot*/)
+{
+    if (!reader_ || position_ >= reader_->count()) {
+        return nullptr;
+    }
+    return std::dynamic_pointer_cast<connection_types::Message>(reader_->read(position_++));
+}
+
+std::vector<std::string> MessageLogProvider::getExtensions() const
+{
+    return { Settings::message_log_extension };
+}
+
+GenericStatePtr MessageLogProvider::getState() const
+{
+    GenericStatePtr r(new GenericState(state));
+    return r;
+}
+
+void MessageLogProvider::setParameterState(GenericStatePtr memento)
+{
+    if (memento) {
+        state.setFrom(*memento);
+    }
+}
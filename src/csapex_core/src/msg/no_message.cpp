@@ -11,6 +11,7 @@ using namespace connection_types;
 
 NoMessage::NoMessage() : MarkerMessage(type<NoMessage>::name(), 0)
 {
+    addKind(KIND_NO_MESSAGE);
 }
 
 void NoMessage::serialize(SerializationBuffer& data, SemanticVersion& version) const
@@ -9,14 +9,16 @@
 #include <csapex/msg/token_traits.h>
 #include <csapex/utility/debug.h>
 #include <csapex/msg/output_transition.h>
+#include <csapex/msg/output_tap.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
 using namespace csapex;
 
-Output::Output(const UUID& uuid, ConnectableOwnerWeakPtr owner) : Connectable(uuid, owner), transition_(nullptr), state_(State::IDLE)
+Output::Output(const UUID& uuid, ConnectableOwnerWeakPtr owner) : Connectable(uuid, owner), transition_(nullptr), state_(State::IDLE), has_taps_(false)
 {
 }
 
@@ -60,7 +62,7 @@ void Output::notifyMessageProcessed()
 void Output::notifyMessageProcessed(Connection* connection)
 {
     for (auto connection : connections_) {
-        if (connection->getState() != Connection::State::DONE) {
+        if (connection->getSourceState() != Connection::State::DONE) {
             return;
         }
     }
@@ -108,6 +110,49 @@ std::vector<ConnectionPtr> Output::getConnections() const
     return connections_;
 }
 
+bool Output::addTap(const OutputTapPtr& tap)
+{
+    std::unique_lock<std::mutex> lock(taps_mutex_);
+    taps_.push_back(tap);
+    has_taps_ = true;
+    return true;
+}
+
+void Output::removeTap(const OutputTapPtr& tap)
+{
+    std::unique_lock<std::mutex> lock(taps_mutex_);
+    taps_.erase(std::remove_if(taps_.begin(), taps_.end(),
+                               [&tap](const OutputTapWeakPtr& t) {
+                                   OutputTapPtr locked = t.lock();
+                                   return !locked || locked == tap;
+                               }),
+                taps_.end());
+    has_taps_ = !taps_.empty();
+}
+
+bool Output::hasTaps() const
+{
+    return has_taps_;
+}
+
+void Output::offerToTaps(const TokenPtr& token)
+{
+    if (!has_taps_) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(taps_mutex_);
+    for (auto it = taps_.begin(); it != taps_.end();) {
+        if (OutputTapPtr tap = it->lock()) {
+            tap->offer(token);
+            ++it;
+        } else {
+            it = taps_.erase(it);
+        }
+    }
+    has_taps_ = !taps_.empty();
+}
+
 void Output::removeAllConnectionsNotUndoable()
 {
     std::unique_lock<std::recursive_mutex> lock(sync_mutex);
@@ -148,7 +193,7 @@ bool Output::isConnected() const
 bool Output::canReceiveToken() const
 {
     for (const ConnectionPtr& connection : connections_) {
-        if (connection->getState() != Connection::State::NOT_INITIALIZED) {
+        if (connection->getSourceState() != Connection::State::NOT_INITIALIZED) {
             return false;
         }
     }
@@ -158,7 +203,7 @@ bool Output::canReceiveToken() const
 bool Output::canSendMessages() const
 {
     for (const ConnectionPtr& connection : connections_) {
-        if (connection->getState() == Connection::State::NOT_INITIALIZED) {
+        if (connection->getSourceState() == Connection::State::NOT_INITIALIZED) {
             return false;
         }
     }
@@ -182,6 +227,8 @@ void Output::publish()
         }
     }
 
+    offerToTaps(msg);
+
     if (!sent) {
         notifyMessageProcessed();
     }
@@ -195,7 +242,7 @@ void Output::republish()
         apex_assert_hard(msg);
 
         for (auto connection : connections_) {
-            if (connection->isEnabled() && connection->getState() == Connection::State::DONE) {
+            if (connection->isEnabled() && connection->getSourceState() == Connection::State::DONE) {
                 connection->setToken(msg);
             }
         }
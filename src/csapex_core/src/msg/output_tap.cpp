@@ -0,0 +1,115 @@
+/// HEADER
+#include <csapex/msg/output_tap.h>
+
+/// PROJECT
+#include <csapex/model/token.h>
+#include <csapex/model/token_provenance.h>
+#include <csapex/utility/assert.h>
+
+/// SYSTEM
+#include <iostream>
+
+using namespace csapex;
+
+namespace
+{
+long periodOf(double max_frequency)
+{
+    return max_frequency > 0.0 ? static_cast<long>(1e6 / max_frequency) : 0;
+}
+}  // namespace
+
+OutputTap::OutputTap(Callback callback, double max_frequency)
+  : callback_(callback), min_period_(periodOf(max_frequency)), last_accepted_(0), delivered_(0), dropped_(0), running_(true)
+{
+    delivery_thread_ = std::thread(&OutputTap::deliveryLoop, this);
+}
+
+OutputTap::~OutputTap()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        running_ = false;
+        pending_.reset();
+    }
+    pending_changed_.notify_all();
+
+    apex_assert_hard_msg(delivery_thread_.get_id() != std::this_thread::get_id(), "an output tap cannot be released from its own callback");
+    delivery_thread_.join();
+}
+
+bool OutputTap::offer(const TokenConstPtr& token)
+{
+    if (!token || token->getTokenData()->isNoMessage()) {
+        return false;
+    }
+
+    // the producer must never wait for the viewer, if the tap is busy the token is dropped
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || !running_) {
+        ++dropped_;
+        return false;
+    }
+
+    long stamp = TokenProvenance::now();
+    if (last_accepted_ != 0 && stamp - last_accepted_ < min_period_) {
+        ++dropped_;
+        return false;
+    }
+
+    if (pending_) {
+        // the previous token was never picked up
+        ++dropped_;
+    }
+    pending_ = token;
+    last_accepted_ = stamp;
+
+    lock.unlock();
+    pending_changed_.notify_one();
+    return true;
+}
+
+void OutputTap::setMaximumFrequency(double max_frequency)
+{
+    min_period_ = periodOf(max_frequency);
+}
+
+double OutputTap::getMaximumFrequency() const
+{
+    long period = min_period_;
+    return period > 0 ? 1e6 / period : 0.0;
+}
+
+long OutputTap::getDeliveredCount() const
+{
+    return delivered_;
+}
+
+long OutputTap::getDroppedCount() const
+{
+    return dropped_;
+}
+
+void OutputTap::deliveryLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        pending_changed_.wait(lock, [this]() { return !running_ || pending_; });
+        if (!running_) {
+            break;
+        }
+
+        TokenConstPtr token = std::move(pending_);
+        pending_.reset();
+
+        lock.unlock();
+        try {
+            callback_(token);
+            ++delivered_;
+        } catch (const std::exception& e) {
+            std::cerr << "output tap callback failed: " << e.what() << std::endl;
+        }
+        token.reset();
+        lock.lock();
+    }
+}
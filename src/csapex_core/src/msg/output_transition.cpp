@@ -124,6 +124,11 @@ long OutputTransition::getSequenceNumber() const
     return sequence_number_;
 }
 
+Connection::State OutputTransition::getConnectionState(const ConnectionPtr& connection) const
+{
+    return connection->getSourceState();
+}
+
 bool OutputTransition::isEnabled() const
 {
     return canStartSendingMessages();
@@ -245,7 +250,8 @@ void OutputTransition::fillConnections()
         OutputPtr out = pair.second;
         apex_assert_hard(out);
         if (out->isEnabled()) {
-            if (!out->isConnected()) {
+            // connections that do not handshake are done as soon as they hold the token
+            if (!out->isConnected() || out->canReceiveToken()) {
                 out->notifyMessageProcessed();
             }
         }
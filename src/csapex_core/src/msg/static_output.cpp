@@ -8,6 +8,7 @@
 #include <csapex/utility/assert.h>
 #include <csapex/msg/output_transition.h>
 #include <csapex/msg/no_message.h>
+#include <csapex/msg/batch_message.h>
 
 /// SYSTEM
 #include <iostream>
@@ -22,7 +23,13 @@ void StaticOutput::addMessage(TokenPtr message)
 {
     apex_assert_hard(message);
     const auto& data = message->getTokenData();
-    if (!std::dynamic_pointer_cast<connection_types::MarkerMessage const>(data)) {
+    if (data->isBatch()) {
+        // a batch carries messages of the output's type
+        const auto& elements = std::static_pointer_cast<connection_types::BatchMessage const>(data)->elements;
+        if (!elements.empty()) {
+            setType(elements.front()->toType());
+        }
+    } else if (!data->isMarker()) {
         setType(data->toType());
     }
 
@@ -31,6 +38,7 @@ void StaticOutput::addMessage(TokenPtr message)
     std::unique_lock<std::recursive_mutex> lock(message_mutex_);
     apex_assert_hard(message != nullptr);
     message_to_send_ = message;
+    updateMemoryLeases();
 }
 
 bool StaticOutput::hasMessage()
@@ -45,13 +53,8 @@ bool StaticOutput::hasMarkerMessage()
     if (!message_to_send_) {
         return false;
     }
-    if (auto m = std::dynamic_pointer_cast<connection_types::MarkerMessage const>(message_to_send_->getTokenData())) {
-        if (!std::dynamic_pointer_cast<connection_types::NoMessage const>(m)) {
-            return true;
-        }
-    }
-
-    return false;
+    TokenDataConstPtr data = message_to_send_->getTokenData();
+    return data->isMarker() && !data->isNoMessage();
 }
 
 TokenPtr StaticOutput::getToken() const
@@ -100,7 +103,7 @@ bool StaticOutput::commitMessages(bool is_activated)
         ++seq_no_;
 
         committed_message_->setSequenceNumber(seq_no_);
-        if (hasActiveConnection() && (send_activator || send_deactivator) && !std::dynamic_pointer_cast<connection_types::NoMessage const>(committed_message_->getTokenData())) {
+        if (hasActiveConnection() && (send_activator || send_deactivator) && !committed_message_->getTokenData()->isNoMessage()) {
             sent_activator_message = true;
             if (send_activator) {
                 committed_message_->setActivityModifier(ActivityModifier::ACTIVATE);
@@ -112,6 +115,8 @@ bool StaticOutput::commitMessages(bool is_activated)
         }
 
         ++count_;
+
+        updateMemoryLeases();
     }
     messageSent(this);
 
@@ -125,6 +130,7 @@ void StaticOutput::reset()
     std::unique_lock<std::recursive_mutex> lock(message_mutex_);
     committed_message_.reset();
     message_to_send_.reset();
+    updateMemoryLeases();
 }
 
 void StaticOutput::disable()
@@ -134,6 +140,7 @@ void StaticOutput::disable()
     std::unique_lock<std::recursive_mutex> lock(message_mutex_);
     message_to_send_.reset();
     committed_message_.reset();
+    updateMemoryLeases();
 }
 
 TokenPtr StaticOutput::getToken()
@@ -151,4 +158,14 @@ void StaticOutput::clearBuffer()
 {
     std::unique_lock<std::recursive_mutex> lock(message_mutex_);
     message_to_send_.reset();
+    updateMemoryLeases();
+}
+
+void StaticOutput::updateMemoryLeases()
+{
+    if (!TokenMemoryTracker::isAccountingEnabled() && !message_to_send_memory_.isHeld() && !committed_message_memory_.isHeld()) {
+        return;
+    }
+    message_to_send_memory_.holdForOutput(getUUID(), message_to_send_);
+    committed_message_memory_.holdForOutput(getUUID(), committed_message_);
 }
@@ -63,11 +63,16 @@ void Transition::checkIfEnabled()
     }
 }
 
+Connection::State Transition::getConnectionState(const ConnectionPtr& connection) const
+{
+    return connection->getState();
+}
+
 bool Transition::areAllConnections(Connection::State state) const
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
     for (const ConnectionPtr& connection : connections_) {
-        if (connection->isEnabled() && connection->getState() != state) {
+        if (connection->isEnabled() && getConnectionState(connection) != state) {
             return false;
         }
     }
@@ -78,7 +83,7 @@ bool Transition::areAllConnections(Connection::State a, Connection::State b) con
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
     for (const ConnectionPtr& connection : connections_) {
-        auto s = connection->getState();
+        auto s = getConnectionState(connection);
         if (connection->isEnabled() && s != a && s != b) {
             return false;
         }
@@ -90,7 +95,7 @@ bool Transition::areAllConnections(Connection::State a, Connection::State b, Con
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
     for (const ConnectionPtr& connection : connections_) {
-        auto s = connection->getState();
+        auto s = getConnectionState(connection);
         if (connection->isEnabled() && s != a && s != b && s != c) {
             return false;
         }
@@ -102,7 +107,7 @@ bool Transition::isOneConnection(Connection::State state) const
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
     for (const ConnectionPtr& connection : connections_) {
-        if (connection->isEnabled() && connection->getState() == state) {
+        if (connection->isEnabled() && getConnectionState(connection) == state) {
             return true;
         }
     }
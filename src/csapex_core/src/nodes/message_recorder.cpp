@@ -0,0 +1,90 @@
+/// HEADER
+#include <csapex/nodes/message_recorder.h>
+
+/// PROJECT
+#include <csapex/core/settings.h>
+#include <csapex/model/node_modifier.h>
+#include <csapex/model/token_provenance.h>
+#include <csapex/msg/any_message.h>
+#include <csapex/msg/io.h>
+#include <csapex/param/parameter_factory.h>
+#include <csapex/serialization/message_log.h>
+
+/// SYSTEM
+#include <limits>
+
+using namespace csapex;
+
+MessageRecorder::MessageRecorder() : in_(nullptr), recording_(false), stamp_offset_(0), recorded_(0)
+{
+}
+
+MessageRecorder::~MessageRecorder()
+{
+    close();
+}
+
+void MessageRecorder::setup(NodeModifier& node_modifier)
+{
+    in_ = node_modifier.addInput<connection_types::AnyMessage>("message");
+}
+
+void MessageRecorder::setupParameters(Parameterizable& parameters)
+{
+    parameters.addParameter(param::ParameterFactory::declareFileOutputPath("file", "", "*" + Settings::message_log_extension), [this](param::Parameter* p) {
+        std::unique_lock<std::recursive_mutex> lock(writer_mutex_);
+        path_ = p->as<std::string>();
+        close();
+    });
+    parameters.addParameter(param::ParameterFactory::declareBool("recording", false), [this](param::Parameter* p) {
+        std::unique_lock<std::recursive_mutex> lock(writer_mutex_);
+        recording_ = p->as<bool>();
+        if (!recording_) {
+            close();
+        }
+    });
+}
+
+void MessageRecorder::process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+{
+    std::unique_lock<std::recursive_mutex> lock(writer_mutex_);
+    if (!recording_ || path_.empty()) {
+        return;
+    }
+
+    TokenDataConstPtr message = msg::getMessage(in_);
+    if (!message || message->isMarker()) {
+        return;
+    }
+
+    if (!writer_) {
+        writer_.reset(new MessageLogWriter(path_));
+
+        // the steady clock has no fixed epoch, stamps of an earlier run can be larger than ours.
+        // Continue right after the last record so that the stamps in the log never go backwards.
+        int64_t last = writer_->getLastStamp();
+        stamp_offset_ = last == std::numeric_limits<int64_t>::min() ? 0 : last + 1 - TokenProvenance::now();
+    }
+    writer_->write(*message, TokenProvenance::now() + stamp_offset_);
+    ++recorded_;
+}
+
+void MessageRecorder::tearDown()
+{
+    close();
+}
+
+void MessageRecorder::close()
+{
+    std::unique_lock<std::recursive_mutex> lock(writer_mutex_);
+    if (writer_) {
+        writer_->flush();
+        writer_.reset();
+    }
+}
+
+std::size_t MessageRecorder::getRecordedCount() const
+{
+    std::unique_lock<std::recursive_mutex> lock(writer_mutex_);
+    return recorded_;
+}
@@ -26,6 +26,16 @@ void Interval::setActive(bool active)
     active_ = active;
 }
 
+void Interval::setValue(const std::string& name, double value)
+{
+    values_[name] = value;
+}
+
+const std::map<std::string, double>& Interval::getValues() const
+{
+    return values_;
+}
+
 bool Interval::isStopped() const
 {
     return stopped_;
@@ -97,6 +107,12 @@ std::shared_ptr<Interval> Interval::makeEmpty()
     return std::shared_ptr<Interval>(new Interval);
 }
 
+SemanticVersion Interval::getVersion() const
+{
+    // 0.1.0 adds the values
+    return SemanticVersion(0, 1, 0);
+}
+
 void Interval::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
     data << name_;
@@ -110,6 +126,7 @@ void Interval::serialize(SerializationBuffer& data, SemanticVersion& version) co
     data << active_;
 
     data << sub;
+    data << values_;
 }
 void Interval::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
 {
@@ -129,4 +146,8 @@ void Interval::deserialize(const SerializationBuffer& data, const SemanticVersio
     data >> active_;
 
     data >> sub;
+    values_.clear();
+    if (version >= SemanticVersion(0, 1, 0)) {
+        data >> values_;
+    }
 }
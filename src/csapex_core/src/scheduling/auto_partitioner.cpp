@@ -0,0 +1,346 @@
+/// HEADER
+#include <csapex/scheduling/auto_partitioner.h>
+
+/// PROJECT
+#include <csapex/command/delete_thread.h>
+#include <csapex/command/dispatcher.h>
+#include <csapex/command/meta.h>
+#include <csapex/command/switch_thread.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph/vertex.h>
+#include <csapex/model/node_characteristics.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/model/node_worker.h>
+#include <csapex/model/token_provenance.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+using namespace csapex;
+
+const std::string AutoPartitioner::GROUP_PREFIX = "auto partition ";
+
+namespace
+{
+long now()
+{
+    return TokenProvenance::now();
+}
+
+// the current group counts like an additional neighbor, so that balanced partitions stay stable
+const double STICKINESS = 0.5;
+
+// a partition may exceed the mean load by this fraction before its score drops to zero
+const double SLACK = 0.1;
+}  // namespace
+
+PartitionReport::PartitionReport() : cut_edges(0), total_edges(0), moved_nodes(0), imbalance(0.0)
+{
+}
+
+std::ostream& csapex::operator<<(std::ostream& out, const PartitionReport& report)
+{
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < report.group_load.size(); ++i) {
+        out << AutoPartitioner::GROUP_PREFIX << i << ": " << report.group_size[i] << " nodes, load " << report.group_load[i] << '\n';
+    }
+    out << "cut edges: " << report.cut_edges << " / " << report.total_edges << ", imbalance: " << report.imbalance << ", moved: " << report.moved_nodes << '\n';
+    out.flags(flags);
+    return out;
+}
+
+AutoPartitioner::AutoPartitioner(ThreadPool& thread_pool, GraphFacadeImplementationPtr root, CommandDispatcherPtr dispatcher)
+  : thread_pool_(thread_pool), root_(root), dispatcher_(dispatcher), interval_(10000), last_update_(now()), imbalance_threshold_(1.25)
+{
+}
+
+void AutoPartitioner::setInterval(long interval_ms)
+{
+    interval_ = interval_ms;
+}
+
+long AutoPartitioner::getInterval() const
+{
+    return interval_;
+}
+
+void AutoPartitioner::setImbalanceThreshold(double threshold)
+{
+    imbalance_threshold_ = threshold;
+}
+
+double AutoPartitioner::getImbalanceThreshold() const
+{
+    return imbalance_threshold_;
+}
+
+PartitionReport AutoPartitioner::getReport() const
+{
+    return report_;
+}
+
+bool AutoPartitioner::isMovable(ThreadGroup* group) const
+{
+    return group->id() == ThreadGroup::PRIVATE_THREAD || group->id() == ThreadGroup::DEFAULT_GROUP_ID || group->getName().compare(0, GROUP_PREFIX.size(), GROUP_PREFIX) == 0;
+}
+
+std::vector<ThreadGroup*> AutoPartitioner::ensureGroups(int count)
+{
+    std::vector<ThreadGroup*> groups;
+    for (int i = 0; i < count; ++i) {
+        std::string name = GROUP_PREFIX + std::to_string(i);
+
+        ThreadGroup* group = nullptr;
+        for (const ThreadGroupPtr& existing : thread_pool_.getGroups()) {
+            if (existing->getName() == name) {
+                group = existing.get();
+                break;
+            }
+        }
+        if (!group) {
+            group = thread_pool_.createGroup(name);
+        }
+        groups.push_back(group);
+    }
+    return groups;
+}
+
+void AutoPartitioner::collect(GraphFacadeImplementation& graph_facade, long window, std::vector<Item>& items, std::map<AUUID, long>& samples)
+{
+    GraphImplementationPtr graph = graph_facade.getLocalGraph();
+
+    std::unordered_map<graph::Vertex*, std::size_t> index;
+
+    for (const graph::VertexPtr& vertex : *graph) {
+        NodeFacadeImplementationPtr nf = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+        NodeRunnerPtr runner = nf ? nf->getNodeRunner() : nullptr;
+        if (!runner) {
+            continue;
+        }
+
+        ThreadGroup* group = nullptr;
+        try {
+            group = thread_pool_.getGroupFor(runner.get());
+        } catch (const std::runtime_error&) {
+            continue;
+        }
+
+        if (isMovable(group)) {
+            Item item;
+            item.runner = runner;
+            item.graph = graph_facade.getAbsoluteUUID();
+            item.node = nf->getUUID();
+            item.depth = vertex->getNodeCharacteristics().depth;
+            item.load = 0.0;
+            item.current = group->id();
+
+            if (NodeWorkerPtr worker = nf->getNodeWorker().lock()) {
+                long processing_time = worker->getProcessingTime();
+                samples[nf->getAUUID()] = processing_time;
+
+                auto pos = processing_time_.find(nf->getAUUID());
+                if (pos != processing_time_.end() && window > 0) {
+                    item.load = std::max(0L, processing_time - pos->second) / static_cast<double>(window);
+                }
+            }
+
+            index[vertex.get()] = items.size();
+            items.push_back(item);
+        }
+
+        if (nf->isGraph()) {
+            if (GraphFacadeImplementationPtr subgraph = graph_facade.getLocalSubGraph(nf->getUUID())) {
+                collect(*subgraph, window, items, samples);
+            }
+        }
+    }
+
+    for (const auto& entry : index) {
+        Item& item = items[entry.second];
+        for (const graph::VertexPtr& child : entry.first->getChildren()) {
+            auto pos = index.find(child.get());
+            if (pos != index.end() && pos->second != entry.second) {
+                item.neighbors.push_back(pos->second);
+                items[pos->second].neighbors.push_back(entry.second);
+            }
+        }
+    }
+}
+
+PartitionReport AutoPartitioner::evaluate(const std::vector<Item>& items, const std::vector<int>& assignment, std::size_t groups) const
+{
+    PartitionReport report;
+    report.group_load.resize(groups, 0.0);
+    report.group_size.resize(groups, 0);
+
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        if (assignment[i] >= 0) {
+            report.group_load[assignment[i]] += items[i].load;
+            report.group_size[assignment[i]]++;
+        }
+        for (std::size_t neighbor : items[i].neighbors) {
+            // every edge is stored at both ends
+            if (neighbor > i) {
+                report.total_edges++;
+                if (assignment[i] != assignment[neighbor]) {
+                    report.cut_edges++;
+                }
+            }
+        }
+    }
+
+    double total = std::accumulate(report.group_load.begin(), report.group_load.end(), 0.0);
+    if (total > 0.0 && groups > 0) {
+        double max = *std::max_element(report.group_load.begin(), report.group_load.end());
+        report.imbalance = max / (total / groups);
+    } else {
+        report.imbalance = 1.0;
+    }
+    return report;
+}
+
+void AutoPartitioner::tick()
+{
+    if (thread_pool_.getAutoPartitionGroupCount() <= 0 || now() - last_update_ < interval_ * 1000) {
+        return;
+    }
+
+    PartitionReport report = partition();
+    if (report.moved_nodes > 0) {
+        partition_changed(report);
+    }
+}
+
+PartitionReport AutoPartitioner::partition()
+{
+    long stamp = now();
+    long window = stamp - last_update_;
+    last_update_ = stamp;
+
+    int count = thread_pool_.getAutoPartitionGroupCount();
+    if (count <= 0) {
+        return report_;
+    }
+
+    std::vector<ThreadGroup*> groups = ensureGroups(count);
+    std::map<int, int> partition_of_group;
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        partition_of_group[groups[g]->id()] = g;
+    }
+
+    std::vector<Item> items;
+    std::map<AUUID, long> samples;
+    collect(*root_, window, items, samples);
+    processing_time_ = std::move(samples);
+
+    std::vector<int> current(items.size(), -1);
+    bool complete = true;
+    double total_load = 0.0;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        auto pos = partition_of_group.find(items[i].current);
+        if (pos != partition_of_group.end()) {
+            current[i] = pos->second;
+        } else {
+            complete = false;
+        }
+        total_load += items[i].load;
+    }
+
+    // without measurements, every node counts the same
+    if (total_load <= 0.0) {
+        for (Item& item : items) {
+            item.load = 1.0;
+        }
+        total_load = items.size();
+    }
+
+    PartitionReport current_report = evaluate(items, current, groups.size());
+    if (complete && current_report.imbalance <= imbalance_threshold_) {
+        report_ = current_report;
+        return report_;
+    }
+
+    std::vector<std::size_t> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&items](std::size_t a, std::size_t b) { return items[a].depth < items[b].depth; });
+
+    double capacity = (1.0 + SLACK) * total_load / groups.size();
+
+    std::vector<int> assignment(items.size(), -1);
+    std::vector<double> load(groups.size(), 0.0);
+    for (std::size_t i : order) {
+        const Item& item = items[i];
+
+        std::vector<double> affinity(groups.size(), 1.0);
+        for (std::size_t neighbor : item.neighbors) {
+            if (assignment[neighbor] >= 0) {
+                affinity[assignment[neighbor]] += 1.0;
+            }
+        }
+        if (current[i] >= 0) {
+            affinity[current[i]] += STICKINESS;
+        }
+
+        int best = 0;
+        double best_score = -std::numeric_limits<double>::infinity();
+        for (std::size_t g = 0; g < groups.size(); ++g) {
+            double score = affinity[g] * (1.0 - load[g] / capacity);
+            if (score > best_score || (score == best_score && load[g] < load[best])) {
+                best_score = score;
+                best = g;
+            }
+        }
+
+        assignment[i] = best;
+        load[best] += item.load;
+    }
+
+    PartitionReport report = evaluate(items, assignment, groups.size());
+
+    std::shared_ptr<command::Meta> cmd;
+    if (dispatcher_) {
+        cmd = std::make_shared<command::Meta>(root_->getAbsoluteUUID(), "auto partition");
+    }
+
+    std::map<int, std::size_t> moved_out;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        if (assignment[i] != current[i]) {
+            int group = groups[assignment[i]]->id();
+            if (cmd) {
+                cmd->add(std::make_shared<command::SwitchThread>(items[i].graph, items[i].node, group));
+            } else {
+                thread_pool_.addToGroup(items[i].runner.get(), group);
+            }
+            moved_out[items[i].current]++;
+            report.moved_nodes++;
+        }
+    }
+
+    // groups of a previous, larger partition are dropped once they are empty
+    for (const ThreadGroupPtr& group : thread_pool_.getGroups()) {
+        if (isMovable(group.get()) && group->id() >= ThreadGroup::MINIMUM_THREAD_ID && partition_of_group.find(group->id()) == partition_of_group.end() &&
+            group->size() == moved_out[group->id()]) {
+            if (cmd) {
+                cmd->add(std::make_shared<command::DeleteThread>(group->id()));
+            } else {
+                thread_pool_.removeGroup(group->id());
+            }
+        }
+    }
+
+    if (cmd && report.moved_nodes > 0) {
+        dispatcher_->execute(cmd);
+    }
+
+    report_ = report;
+    return report;
+}
@@ -14,6 +14,7 @@
 #include <csapex/profiling/interlude.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <iostream>
 #include <yaml-cpp/yaml.h>
 
@@ -260,6 +261,7 @@ void ThreadGroup::clear()
     {
         std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
         tasks_.clear();
+        queued_tasks_.clear();
     }
 
     std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
@@ -312,14 +314,13 @@ std::vector<TaskPtr> ThreadGroup::remove(TaskGenerator* generator)
 
     TaskGeneratorPtr removed;
 
-    for (auto it = tasks_.begin(); it != tasks_.end();) {
-        TaskPtr task = *it;
-        if (task->getParent() == generator) {
-            remaining_tasks.push_back(task);
-            it = tasks_.erase(it);
-        } else {
-            ++it;
+    auto queued = queued_tasks_.find(generator);
+    if (queued != queued_tasks_.end()) {
+        for (const TaskQueue::iterator& it : queued->second) {
+            remaining_tasks.push_back(*it);
+            tasks_.erase(it);
         }
+        queued_tasks_.erase(queued);
     }
 
     for (auto it = generators_.begin(); it != generators_.end();) {
@@ -346,17 +347,14 @@ void ThreadGroup::schedule(TaskPtr task)
 
     std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
 
-    if (!tasks_.empty()) {
-        //        for(const TaskPtr& t : tasks_) {
-        for (auto it = tasks_.begin(); it != tasks_.end(); ++it) {
-            const TaskPtr& t = *it;
-            if (t.get() == task.get()) {
-                return;
-            }
+    std::vector<TaskQueue::iterator>& queued = queued_tasks_[task->getParent()];
+    for (const TaskQueue::iterator& it : queued) {
+        if (it->get() == task.get()) {
+            return;
         }
     }
 
-    tasks_.insert(task);
+    queued.push_back(tasks_.insert(task));
 
     task->setScheduled(true);
 
@@ -406,8 +404,7 @@ bool ThreadGroup::executeNextTask()
 {
     std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
     if (!tasks_.empty()) {
-        TaskPtr task = *tasks_.begin();
-        tasks_.erase(tasks_.begin());
+        TaskPtr task = dequeue(tasks_.begin());
 
         task->setScheduled(false);
 
@@ -427,6 +424,22 @@ bool ThreadGroup::executeNextTask()
     return false;
 }
 
+TaskPtr ThreadGroup::dequeue(TaskQueue::iterator it)
+{
+    TaskPtr task = *it;
+
+    auto queued = queued_tasks_.find(task->getParent());
+    apex_assert_hard(queued != queued_tasks_.end());
+    std::vector<TaskQueue::iterator>& generator_tasks = queued->second;
+    generator_tasks.erase(std::find(generator_tasks.begin(), generator_tasks.end(), it));
+    if (generator_tasks.empty()) {
+        queued_tasks_.erase(queued);
+    }
+
+    tasks_.erase(it);
+    return task;
+}
+
 void ThreadGroup::executeTask(const TaskPtr& task)
 {
     try {
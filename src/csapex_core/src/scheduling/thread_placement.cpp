@@ -0,0 +1,378 @@
+/// HEADER
+#include <csapex/scheduling/thread_placement.h>
+
+/// PROJECT
+#include <csapex/model/connection.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph/vertex.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/model/token.h>
+#include <csapex/model/token_provenance.h>
+#include <csapex/msg/input.h>
+#include <csapex/msg/output.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex/serialization/message_serializer.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/cpu_affinity.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <iomanip>
+
+using namespace csapex;
+
+namespace
+{
+long now()
+{
+    return TokenProvenance::now();
+}
+
+ThreadGroup* findGroup(ThreadPool& thread_pool, const NodeRunnerPtr& runner)
+{
+    if (!runner) {
+        return nullptr;
+    }
+    try {
+        return thread_pool.getGroupFor(runner.get());
+    } catch (const std::runtime_error&) {
+        return nullptr;
+    }
+}
+
+// union find over thread groups, only used while computing a placement
+struct Clusters
+{
+    ThreadGroup* find(ThreadGroup* group)
+    {
+        auto pos = parent.find(group);
+        if (pos == parent.end()) {
+            parent[group] = group;
+            size[group] = 1;
+            return group;
+        }
+        if (pos->second == group) {
+            return group;
+        }
+        ThreadGroup* root = find(pos->second);
+        parent[group] = root;
+        return root;
+    }
+
+    void merge(ThreadGroup* a, ThreadGroup* b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a != b) {
+            parent[b] = a;
+            size[a] += size[b];
+        }
+    }
+
+    std::map<ThreadGroup*, ThreadGroup*> parent;
+    std::map<ThreadGroup*, std::size_t> size;
+};
+}  // namespace
+
+GroupPlacement::GroupPlacement() : group(-1), domain(-1), numa_node(-1)
+{
+}
+
+PlacementReport::PlacementReport() : total_traffic(0.0), cross_domain_traffic(0.0), cross_numa_traffic(0.0)
+{
+}
+
+std::ostream& csapex::operator<<(std::ostream& out, const PlacementReport& report)
+{
+    out << std::left << std::setw(40) << "thread group" << std::right << std::setw(8) << "domain" << std::setw(8) << "numa" << '\n';
+    for (const GroupPlacement& group : report.groups) {
+        out << std::left << std::setw(40) << group.name << std::right << std::setw(8) << group.domain << std::setw(8) << group.numa_node << '\n';
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2);
+    out << "traffic between groups: " << report.total_traffic / 1e6 << " MB/s\n";
+    out << "crossing cache domains: " << report.cross_domain_traffic / 1e6 << " MB/s\n";
+    out << "crossing numa nodes:    " << report.cross_numa_traffic / 1e6 << " MB/s\n";
+    out.flags(flags);
+    return out;
+}
+
+ThreadPlacement::ThreadPlacement(ThreadPool& thread_pool, GraphFacadeImplementationPtr root, const CpuTopology& topology)
+  : thread_pool_(thread_pool), root_(root), topology_(topology), enabled_(false), interval_(5000), last_update_(now())
+{
+}
+
+void ThreadPlacement::setEnabled(bool enabled)
+{
+    enabled_ = enabled;
+}
+
+bool ThreadPlacement::isEnabled() const
+{
+    return enabled_;
+}
+
+void ThreadPlacement::setInterval(long interval_ms)
+{
+    interval_ = interval_ms;
+}
+
+long ThreadPlacement::getInterval() const
+{
+    return interval_;
+}
+
+const CpuTopology& ThreadPlacement::getTopology() const
+{
+    return topology_;
+}
+
+void ThreadPlacement::tick()
+{
+    if (enabled_ && now() - last_update_ >= interval_ * 1000) {
+        DomainMap previous = assignment_;
+        PlacementReport report = place();
+        if (assignment_ != previous) {
+            placement_changed(report);
+        }
+    }
+}
+
+double ThreadPlacement::estimateMessageSize(const ConnectionPtr& connection)
+{
+    double& size = message_sizes_[connection->id()];
+
+    TokenPtr token = connection->getToken();
+    TokenDataConstPtr data = token ? token->getTokenData() : nullptr;
+    if (data && !data->isMarker()) {
+        try {
+            SerializationBuffer buffer;
+            MessageSerializer::serializeBinaryMessage(*data, buffer);
+            double sample = static_cast<double>(buffer.size());
+            size = size > 0.0 ? 0.5 * (size + sample) : sample;
+
+        } catch (const std::exception&) {
+            // the message type cannot be serialized, keep the last estimate
+        }
+    }
+    return size;
+}
+
+void ThreadPlacement::collectTraffic(GraphFacadeImplementation& graph_facade, TrafficMap& traffic, std::set<ThreadGroup*>& groups)
+{
+    GraphImplementationPtr graph = graph_facade.getLocalGraph();
+
+    for (const graph::VertexPtr& vertex : *graph) {
+        NodeFacadeImplementationPtr nf = std::dynamic_pointer_cast<NodeFacadeImplementation>(vertex->getNodeFacade());
+        if (!nf) {
+            continue;
+        }
+
+        ThreadGroup* from = findGroup(thread_pool_, nf->getNodeRunner());
+        if (!from) {
+            continue;
+        }
+        groups.insert(from);
+
+        NodeHandlePtr nh = nf->getNodeHandle();
+        double frequency = nh->getRate().getEffectiveFrequency();
+
+        for (const OutputPtr& output : nh->getExternalOutputs()) {
+            for (const ConnectionPtr& connection : output->getConnections()) {
+                NodeHandle* target = graph->findNodeHandleForConnectorNoThrow(connection->to()->getUUID());
+                ThreadGroup* to = target ? findGroup(thread_pool_, target->getNodeRunner()) : nullptr;
+                if (!to || to == from) {
+                    continue;
+                }
+                groups.insert(to);
+
+                double bytes_per_second = estimateMessageSize(connection) * frequency;
+                traffic[std::make_pair(std::min(from, to), std::max(from, to))] += bytes_per_second;
+            }
+        }
+
+        if (nf->isGraph()) {
+            if (GraphFacadeImplementationPtr subgraph = graph_facade.getLocalSubGraph(nf->getUUID())) {
+                collectTraffic(*subgraph, traffic, groups);
+            }
+        }
+    }
+}
+
+int ThreadPlacement::findDomain(ThreadGroup* group) const
+{
+    std::vector<bool> cpus = group->getCpuAffinity()->get();
+
+    int domain = -1;
+    for (std::size_t cpu = 0; cpu < cpus.size(); ++cpu) {
+        if (!cpus[cpu]) {
+            continue;
+        }
+        const CpuDomain* cpu_domain = topology_.getDomainOf(cpu);
+        if (!cpu_domain || (domain != -1 && domain != cpu_domain->id)) {
+            return -1;
+        }
+        domain = cpu_domain->id;
+    }
+    return domain;
+}
+
+PlacementReport ThreadPlacement::evaluate(const TrafficMap& traffic, const std::set<ThreadGroup*>& groups, const DomainMap& domains) const
+{
+    PlacementReport report;
+
+    const std::vector<CpuDomain>& all_domains = topology_.getDomains();
+    auto numa_node_of = [&](ThreadGroup* group) {
+        auto pos = domains.find(group);
+        return (pos == domains.end() || pos->second < 0) ? -1 : all_domains.at(pos->second).numa_node;
+    };
+    auto domain_of = [&](ThreadGroup* group) {
+        auto pos = domains.find(group);
+        return pos == domains.end() ? -1 : pos->second;
+    };
+
+    for (ThreadGroup* group : groups) {
+        GroupPlacement placement;
+        placement.group = group->id();
+        placement.name = group->getName();
+        placement.domain = domain_of(group);
+        placement.numa_node = numa_node_of(group);
+        report.groups.push_back(placement);
+    }
+    std::sort(report.groups.begin(), report.groups.end(), [](const GroupPlacement& a, const GroupPlacement& b) { return a.name < b.name; });
+
+    // an unpinned thread can run anywhere, so its traffic crosses nodes with the corresponding probability
+    double numa_nodes = static_cast<double>(topology_.getNumaNodeCount());
+    double unpinned_crossing = numa_nodes > 1.0 ? 1.0 - 1.0 / numa_nodes : 0.0;
+
+    for (const auto& entry : traffic) {
+        double bytes = entry.second;
+        report.total_traffic += bytes;
+
+        int domain_a = domain_of(entry.first.first);
+        int domain_b = domain_of(entry.first.second);
+        if (domain_a < 0 || domain_b < 0) {
+            report.cross_domain_traffic += all_domains.size() > 1 ? bytes : 0.0;
+            report.cross_numa_traffic += bytes * unpinned_crossing;
+        } else {
+            if (domain_a != domain_b) {
+                report.cross_domain_traffic += bytes;
+            }
+            if (numa_node_of(entry.first.first) != numa_node_of(entry.first.second)) {
+                report.cross_numa_traffic += bytes;
+            }
+        }
+    }
+
+    return report;
+}
+
+PlacementReport ThreadPlacement::estimate()
+{
+    TrafficMap traffic;
+    std::set<ThreadGroup*> groups;
+    collectTraffic(*root_, traffic, groups);
+
+    DomainMap domains;
+    for (ThreadGroup* group : groups) {
+        domains[group] = findDomain(group);
+    }
+
+    PlacementReport report = evaluate(traffic, groups, domains);
+
+    std::unique_lock<std::mutex> lock(report_mutex_);
+    report_ = report;
+    return report;
+}
+
+PlacementReport ThreadPlacement::place()
+{
+    last_update_ = now();
+
+    TrafficMap traffic;
+    std::set<ThreadGroup*> groups;
+    collectTraffic(*root_, traffic, groups);
+
+    const std::vector<CpuDomain>& domains = topology_.getDomains();
+    std::size_t max_capacity = 0;
+    for (const CpuDomain& domain : domains) {
+        max_capacity = std::max(max_capacity, domain.cpus.size());
+    }
+
+    // merge the heaviest edges first, as long as the cluster still fits into a single domain.
+    // every connection counts, so that connected groups are kept together even before any traffic is measured
+    typedef std::pair<double, std::pair<ThreadGroup*, ThreadGroup*>> Edge;
+    std::vector<Edge> edges;
+    for (const auto& entry : traffic) {
+        edges.push_back(std::make_pair(entry.second + 1.0, entry.first));
+    }
+    std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) { return a.first > b.first; });
+
+    Clusters clusters;
+    for (ThreadGroup* group : groups) {
+        clusters.find(group);
+    }
+    for (const Edge& edge : edges) {
+        ThreadGroup* a = clusters.find(edge.second.first);
+        ThreadGroup* b = clusters.find(edge.second.second);
+        if (a != b && clusters.size[a] + clusters.size[b] <= max_capacity) {
+            clusters.merge(a, b);
+        }
+    }
+
+    // assign the largest clusters first, each to the domain with the most free cpus
+    std::map<ThreadGroup*, std::vector<ThreadGroup*>> members;
+    for (ThreadGroup* group : groups) {
+        members[clusters.find(group)].push_back(group);
+    }
+    std::vector<std::vector<ThreadGroup*>> ordered;
+    for (auto& entry : members) {
+        ordered.push_back(entry.second);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const std::vector<ThreadGroup*>& a, const std::vector<ThreadGroup*>& b) { return a.size() > b.size(); });
+
+    std::vector<long> free_cpus;
+    for (const CpuDomain& domain : domains) {
+        free_cpus.push_back(static_cast<long>(domain.cpus.size()));
+    }
+
+    DomainMap assignment;
+    for (const std::vector<ThreadGroup*>& cluster : ordered) {
+        std::size_t best = 0;
+        for (std::size_t d = 1; d < free_cpus.size(); ++d) {
+            if (free_cpus[d] > free_cpus[best]) {
+                best = d;
+            }
+        }
+        free_cpus[best] -= static_cast<long>(cluster.size());
+        for (ThreadGroup* group : cluster) {
+            assignment[group] = domains[best].id;
+        }
+    }
+
+    // pinning to the only domain would not change anything
+    if (domains.size() > 1) {
+        for (const auto& entry : assignment) {
+            ThreadGroup* group = entry.first;
+            thread_pool_.setIndividualCpuAffinity(group, domains.at(entry.second).toAffinity(group->getCpuAffinity()->getNumCpus()));
+        }
+    }
+    assignment_ = assignment;
+
+    PlacementReport report = evaluate(traffic, groups, assignment);
+
+    std::unique_lock<std::mutex> lock(report_mutex_);
+    report_ = report;
+    return report;
+}
+
+PlacementReport ThreadPlacement::getReport() const
+{
+    std::unique_lock<std::mutex> lock(report_mutex_);
+    return report_;
+}
@@ -11,6 +11,7 @@
 #include <csapex/utility/cpu_affinity.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <set>
 #include <unordered_map>
 #include <iostream>
@@ -18,13 +19,13 @@
 using namespace csapex;
 
 ThreadPool::ThreadPool(ExceptionHandler& handler, bool enable_threading, bool grouping)
-  : handler_(handler), timed_queue_(new TimedQueue), enable_threading_(enable_threading), grouping_(grouping), private_group_cpu_affinity_(new CpuAffinity), suppress_exceptions_(true)
+  : handler_(handler), timed_queue_(new TimedQueue), enable_threading_(enable_threading), grouping_(grouping), private_group_cpu_affinity_(new CpuAffinity), suppress_exceptions_(true), auto_partition_groups_(0)
 {
     setup();
 }
 
 ThreadPool::ThreadPool(Executor* parent, ExceptionHandler& handler, bool enable_threading, bool grouping)
-  : handler_(handler), enable_threading_(enable_threading), grouping_(grouping), private_group_cpu_affinity_(new CpuAffinity), suppress_exceptions_(true)
+  : handler_(handler), enable_threading_(enable_threading), grouping_(grouping), private_group_cpu_affinity_(new CpuAffinity), suppress_exceptions_(true), auto_partition_groups_(0)
 {
     setup();
     parent->addChild(this);
@@ -390,6 +391,22 @@ std::vector<bool> ThreadPool::getPrivateThreadGroupCpuAffinity() const
     return private_group_cpu_affinity_->get();
 }
 
+void ThreadPool::setIndividualCpuAffinity(ThreadGroup* group, const std::vector<bool>& affinity)
+{
+    private_group_connections_.erase(group);
+    group->getCpuAffinity()->set(affinity);
+}
+
+void ThreadPool::setAutoPartitionGroupCount(int count)
+{
+    auto_partition_groups_ = std::max(0, count);
+}
+
+int ThreadPool::getAutoPartitionGroupCount() const
+{
+    return auto_partition_groups_;
+}
+
 void ThreadPool::saveSettings(YAML::Node& node)
 {
     YAML::Node threads(YAML::NodeType::Map);
@@ -408,6 +425,9 @@ void ThreadPool::saveSettings(YAML::Node& node)
     }
     threads["groups"] = groups;
     threads["private_affinity"] = private_group_cpu_affinity_->get();
+    if (auto_partition_groups_ > 0) {
+        threads["auto_partition_groups"] = auto_partition_groups_;
+    }
 
     YAML::Node assignments;
     for (std::map<TaskGenerator*, ThreadGroup*>::const_iterator it = group_assignment_.begin(); it != group_assignment_.end(); ++it) {
@@ -432,6 +452,11 @@ void ThreadPool::loadSettings(YAML::Node& node)
             private_group_cpu_affinity_->set(a);
         }
 
+        const YAML::Node& auto_partition_groups = threads["auto_partition_groups"];
+        if (auto_partition_groups.IsDefined()) {
+            setAutoPartitionGroupCount(auto_partition_groups.as<int>());
+        }
+
         const YAML::Node& groups = threads["groups"];
         if (groups.IsDefined()) {
             for (std::size_t i = 0, total = groups.size(); i < total; ++i) {
@@ -0,0 +1,265 @@
+/// HEADER
+#include <csapex/serialization/message_log.h>
+
+/// PROJECT
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+#include <csapex/serialization/message_serializer.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/semantic_version.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <limits>
+#include <stdexcept>
+
+using namespace csapex;
+
+namespace
+{
+const std::string MESSAGE_LOG_MAGIC = "APEXMLOG";
+const SemanticVersion MESSAGE_LOG_VERSION(1, 0, 0);
+
+const std::size_t INDEX_ENTRY_LENGTH = 16;
+
+void writeLittleEndian(uint8_t* target, uint64_t value)
+{
+    for (std::size_t byte = 0; byte < 8; ++byte) {
+        target[byte] = (value >> (byte * 8)) & 0xFF;
+    }
+}
+
+uint64_t readLittleEndian(const uint8_t* source, std::size_t bytes)
+{
+    uint64_t value = 0;
+    for (std::size_t byte = 0; byte < bytes; ++byte) {
+        value |= static_cast<uint64_t>(source[byte]) << (byte * 8);
+    }
+    return value;
+}
+
+std::string indexPath(const std::string& path)
+{
+    return path + ".idx";
+}
+}  // namespace
+
+MessageLogWriter::MessageLogWriter(const std::string& path)
+  : path_(path), data_(nullptr), index_(nullptr), offset_(0), count_(0), last_stamp_(std::numeric_limits<int64_t>::min())
+{
+    if (boost::filesystem::exists(path) && boost::filesystem::file_size(path) > 0) {
+        recover();
+        return;
+    }
+
+    data_ = std::fopen(path.c_str(), "wb");
+    if (!data_) {
+        throw std::runtime_error("cannot open message log " + path + " for writing");
+    }
+
+    SerializationBuffer header;
+    header << MESSAGE_LOG_VERSION;
+    header.finalize();
+
+    std::fwrite(MESSAGE_LOG_MAGIC.data(), 1, MESSAGE_LOG_MAGIC.size(), data_);
+    std::fwrite(header.data(), 1, header.size(), data_);
+    offset_ = MESSAGE_LOG_MAGIC.size() + header.size();
+
+    // a stale index of a deleted log must not be continued
+    index_ = std::fopen(indexPath(path).c_str(), "wb");
+    if (!index_) {
+        std::fclose(data_);
+        throw std::runtime_error("cannot open message log index " + indexPath(path) + " for writing");
+    }
+}
+
+void MessageLogWriter::recover()
+{
+    // a crashed writer can leave a torn record at the end, its length prefix would run into
+    // everything appended after it. Continue after the last complete record instead.
+    std::vector<MessageLogReader::Entry> entries;
+    {
+        MessageLogReader reader(path_);
+        entries = reader.entries_;
+        offset_ = entries.empty() ? reader.body_offset_ : entries.back().offset + reader.recordLength(entries.back().offset);
+    }
+    boost::filesystem::resize_file(path_, offset_);
+
+    if (!entries.empty()) {
+        last_stamp_ = entries.back().stamp;
+    }
+
+    data_ = std::fopen(path_.c_str(), "ab");
+    if (!data_) {
+        throw std::runtime_error("cannot open message log " + path_ + " for writing");
+    }
+
+    // the index may be missing entries or point past the recovered data, it is rewritten as a whole
+    index_ = std::fopen(indexPath(path_).c_str(), "wb");
+    if (!index_) {
+        std::fclose(data_);
+        throw std::runtime_error("cannot open message log index " + indexPath(path_) + " for writing");
+    }
+    for (const MessageLogReader::Entry& e : entries) {
+        uint8_t entry[INDEX_ENTRY_LENGTH];
+        writeLittleEndian(entry, e.offset);
+        writeLittleEndian(entry + 8, static_cast<uint64_t>(e.stamp));
+        std::fwrite(entry, 1, INDEX_ENTRY_LENGTH, index_);
+    }
+}
+
+MessageLogWriter::~MessageLogWriter()
+{
+    std::fclose(data_);
+    std::fclose(index_);
+}
+
+void MessageLogWriter::write(const TokenData& message, int64_t stamp)
+{
+    SerializationBuffer record;
+    record << stamp;
+    MessageSerializer::serializeBinaryMessage(message, record);
+    record.finalize();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::fwrite(record.data(), 1, record.size(), data_);
+
+    uint8_t entry[INDEX_ENTRY_LENGTH];
+    writeLittleEndian(entry, offset_);
+    writeLittleEndian(entry + 8, static_cast<uint64_t>(stamp));
+    std::fwrite(entry, 1, INDEX_ENTRY_LENGTH, index_);
+
+    offset_ += record.size();
+    last_stamp_ = stamp;
+    ++count_;
+}
+
+void MessageLogWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    // the index is flushed last, so that it never points past the data
+    std::fflush(data_);
+    std::fflush(index_);
+}
+
+std::size_t MessageLogWriter::count() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return count_;
+}
+
+std::string MessageLogWriter::getPath() const
+{
+    return path_;
+}
+
+int64_t MessageLogWriter::getLastStamp() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return last_stamp_;
+}
+
+MessageLogReader::MessageLogReader(const std::string& path) : file_(new boost::iostreams::mapped_file_source(path)), body_offset_(0)
+{
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(file_->data());
+    const std::size_t magic_length = MESSAGE_LOG_MAGIC.size();
+
+    if (file_->size() < magic_length + SerializationBuffer::HEADER_LENGTH || !std::equal(MESSAGE_LOG_MAGIC.begin(), MESSAGE_LOG_MAGIC.end(), file_->data())) {
+        throw std::runtime_error(path + " is not a message log");
+    }
+
+    uint32_t header_length = readLittleEndian(raw + magic_length, SerializationBuffer::HEADER_LENGTH);
+    if (magic_length + header_length > file_->size()) {
+        throw std::runtime_error(path + " has a truncated header");
+    }
+
+    SerializationBuffer header(raw + magic_length, header_length);
+    SemanticVersion version;
+    header >> version;
+    if (version.major_v != MESSAGE_LOG_VERSION.major_v) {
+        throw std::runtime_error(path + " is a message log of an unsupported version");
+    }
+
+    body_offset_ = magic_length + header_length;
+
+    loadIndex(path);
+}
+
+MessageLogReader::~MessageLogReader()
+{
+}
+
+uint32_t MessageLogReader::recordLength(uint64_t offset) const
+{
+    if (offset + SerializationBuffer::HEADER_LENGTH > file_->size()) {
+        return 0;
+    }
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(file_->data());
+    uint32_t length = readLittleEndian(raw + offset, SerializationBuffer::HEADER_LENGTH);
+    if (length < SerializationBuffer::HEADER_LENGTH + sizeof(int64_t) || offset + length > file_->size()) {
+        return 0;
+    }
+    return length;
+}
+
+void MessageLogReader::loadIndex(const std::string& path)
+{
+    uint64_t next = body_offset_;
+
+    std::FILE* index = std::fopen(indexPath(path).c_str(), "rb");
+    if (index) {
+        uint8_t entry[INDEX_ENTRY_LENGTH];
+        while (std::fread(entry, 1, INDEX_ENTRY_LENGTH, index) == INDEX_ENTRY_LENGTH) {
+            Entry e{ readLittleEndian(entry, 8), static_cast<int64_t>(readLittleEndian(entry + 8, 8)) };
+            uint32_t length = e.offset == next ? recordLength(e.offset) : 0;
+            if (length == 0) {
+                // the index does not match the log, rebuild it from here on
+                break;
+            }
+            entries_.push_back(e);
+            next = e.offset + length;
+        }
+        std::fclose(index);
+    }
+
+    scan(next);
+}
+
+void MessageLogReader::scan(uint64_t offset)
+{
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(file_->data());
+    while (uint32_t length = recordLength(offset)) {
+        Entry e{ offset, static_cast<int64_t>(readLittleEndian(raw + offset + SerializationBuffer::HEADER_LENGTH, sizeof(int64_t))) };
+        entries_.push_back(e);
+        offset += length;
+    }
+}
+
+std::size_t MessageLogReader::count() const
+{
+    return entries_.size();
+}
+
+int64_t MessageLogReader::getStamp(std::size_t index) const
+{
+    return entries_.at(index).stamp;
+}
+
+TokenData::Ptr MessageLogReader::read(std::size_t index) const
+{
+    const Entry& entry = entries_.at(index);
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(file_->data());
+
+    SerializationBuffer record(raw + entry.offset, recordLength(entry.offset));
+    int64_t stamp;
+    record >> stamp;
+    return MessageSerializer::deserializeBinaryMessage(record);
+}
+
+std::size_t MessageLogReader::find(int64_t stamp) const
+{
+    auto pos = std::lower_bound(entries_.begin(), entries_.end(), stamp, [](const Entry& entry, int64_t stamp) { return entry.stamp < stamp; });
+    return pos - entries_.begin();
+}
@@ -9,6 +9,11 @@
 
 using namespace csapex;
 
+bool NodeSerializer::hasSerializer(const csapex::Node& node) const
+{
+    return serializers.find(std::type_index(typeid(node))) != serializers.end();
+}
+
 void NodeSerializer::serialize(const csapex::Node& node, YAML::Node& doc)
 {
     auto fn = serializers.find(std::type_index(typeid(node)));
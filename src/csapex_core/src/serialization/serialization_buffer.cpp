@@ -13,6 +13,8 @@
 #include <csapex/model/node_characteristics.h>
 #include <csapex/model/node_state.h>
 #include <csapex/model/token_data.h>
+#include <csapex/model/token_latency_statistics.h>
+#include <csapex/model/token_memory.h>
 #include <csapex/param/parameter.h>
 #include <csapex/profiling/interval.h>
 #include <csapex/serialization/packet_serializer.h>
@@ -153,6 +155,10 @@ void SerializationBuffer::init()
         ADD_ANY_TYPE(ActivityType);
         ADD_ANY_TYPE(ErrorState::ErrorLevel);
         ADD_ANY_TYPE_1PC(std::string, name(), Interval);
+        // new types are appended, the ids are part of the wire format
+        ADD_ANY_TYPE(TokenLatencyStatistics);
+        ADD_ANY_TYPE_IMPL(std::vector<boost::any>);
+        ADD_ANY_TYPE(TokenMemoryStatistics);
 
         initialized_ = true;
     }
@@ -454,3 +460,33 @@ const SerializationBuffer& SerializationBuffer::operator>>(YAML::Node& node) con
     node = YAML::Load(ss);
     return *this;
 }
+
+void SerializationBuffer::writeYaml(const YAML::Node& node)
+{
+    if (!node.IsDefined() || node.IsNull()) {
+        operator<<(static_cast<uint32_t>(0));
+        return;
+    }
+
+    YAML::Emitter emitter;
+    emitter << node;
+
+    apex_assert_lte_hard(emitter.size(), std::numeric_limits<uint32_t>::max());
+    uint32_t length = emitter.size();
+    operator<<(length);
+    writeRaw(emitter.c_str(), length);
+}
+
+void SerializationBuffer::readYaml(YAML::Node& node) const
+{
+    uint32_t length;
+    operator>>(length);
+    if (length == 0) {
+        node = YAML::Node();
+        return;
+    }
+
+    std::string str(length, '\0');
+    readRaw(&str.at(0), length);
+    node = YAML::Load(str);
+}
@@ -6,13 +6,54 @@
 #include <csapex/serialization/packet_serializer.h>
 #include <csapex/serialization/io/std_io.h>
 #include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/serialization_buffer.h>
 
 /// SYSTEM
 #include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <unistd.h>
 
 using namespace csapex;
 
+namespace
+{
+std::atomic<uint64_t> g_spill_counter(0);
+
+std::size_t estimateByteSize(const YAML::Node& node)
+{
+    std::size_t bytes = sizeof(YAML::Node);
+    switch (node.Type()) {
+        case YAML::NodeType::Scalar:
+            bytes += node.Scalar().size();
+            break;
+        case YAML::NodeType::Sequence:
+            for (YAML::const_iterator it = node.begin(); it != node.end(); ++it) {
+                bytes += estimateByteSize(*it);
+            }
+            break;
+        case YAML::NodeType::Map:
+            for (YAML::const_iterator it = node.begin(); it != node.end(); ++it) {
+                bytes += estimateByteSize(it->first) + estimateByteSize(it->second);
+            }
+            break;
+        default:
+            break;
+    }
+    return bytes;
+}
+
+void removeSpillFile(const std::string* file)
+{
+    std::remove(file->c_str());
+    delete file;
+}
+}  // namespace
+
 CREATE_DEFAULT_SERIALIZER(Snippet);
 
 Snippet::Snippet(const std::string& serialized) : yaml_(std::make_shared<YAML::Node>(YAML::Load(serialized)))
@@ -33,7 +74,68 @@ Snippet::Snippet()
 
 void Snippet::toYAML(YAML::Node& out) const
 {
-    out = *yaml_;
+    out = getYAML();
+}
+
+const YAML::Node& Snippet::getYAML() const
+{
+    if (!yaml_ && spill_file_) {
+        std::ifstream in(*spill_file_, std::ios::binary);
+        std::vector<uint8_t> raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (raw.size() <= SerializationBuffer::HEADER_LENGTH) {
+            throw std::runtime_error(std::string("cannot reload snippet from ") + *spill_file_);
+        }
+
+        SerializationBuffer buffer(raw);
+        yaml_ = std::make_shared<YAML::Node>();
+        buffer >> *yaml_;
+
+        spill_file_.reset();
+    }
+    return *yaml_;
+}
+
+std::size_t Snippet::getByteSize() const
+{
+    if (!yaml_) {
+        return 0;
+    }
+    return estimateByteSize(*yaml_);
+}
+
+bool Snippet::spill(const std::string& directory)
+{
+    if (!yaml_) {
+        return spill_file_ != nullptr;
+    }
+
+    std::string file = directory + "/snippet_" + std::to_string(getpid()) + "_" + std::to_string(g_spill_counter++) + ".bin";
+
+    SerializationBuffer buffer;
+    buffer << *yaml_;
+
+    std::ofstream out(file, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    out.close();
+    if (!out) {
+        std::cerr << "cannot spill snippet to " << file << std::endl;
+        std::remove(file.c_str());
+        return false;
+    }
+
+    spill_file_ = std::shared_ptr<const std::string>(new std::string(file), removeSpillFile);
+    yaml_.reset();
+    return true;
+}
+
+void Snippet::reload() const
+{
+    getYAML();
+}
+
+bool Snippet::isSpilled() const
+{
+    return !yaml_ && spill_file_;
 }
 
 void Snippet::setName(const std::string& name)
@@ -122,7 +224,7 @@ uint8_t Snippet::getPacketType() const
 
 void Snippet::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
-    data << *yaml_;
+    data << getYAML();
     data << name_;
     data << description_;
     data << tags_;
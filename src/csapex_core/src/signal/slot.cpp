@@ -88,7 +88,7 @@ void Slot::notifyMessageAvailable(Connection* connection)
 
     {
         std::unique_lock<std::recursive_mutex> lock(available_connections_mutex_);
-        available_connections_.push_back(connection);
+        available_connections_.push_back(connection->shared_from_this());
     }
 
     tryNextToken();
@@ -98,11 +98,11 @@ void Slot::notifyMessageProcessed()
 {
     message_processed(shared_from_this());
 
-    Connection* front = nullptr;
+    ConnectionPtr front;
     {
         std::unique_lock<std::recursive_mutex> lock(available_connections_mutex_);
         if (!available_connections_.empty()) {
-            front = available_connections_.front();
+            front = available_connections_.front().lock();
             available_connections_.pop_front();
         }
     }
@@ -116,16 +116,17 @@ void Slot::notifyMessageProcessed()
 void Slot::tryNextToken()
 {
     if (!isEnabled() && !isActive()) {
-        std::vector<Connection*> connections;
+        std::vector<ConnectionPtr> connections;
         std::unique_lock<std::recursive_mutex> lock(available_connections_mutex_);
         while (!available_connections_.empty()) {
-            Connection* c = available_connections_.front();
-            connections.push_back(c);
+            if (ConnectionPtr c = available_connections_.front().lock()) {
+                connections.push_back(c);
+            }
             available_connections_.pop_front();
         }
         lock.unlock();
 
-        for (Connection* c : connections) {
+        for (const ConnectionPtr& c : connections) {
             c->setState(Connection::State::READ);
             c->setTokenProcessed();
         }
@@ -133,8 +134,14 @@ void Slot::tryNextToken()
 
     if (isEnabled() || isActive()) {
         std::unique_lock<std::recursive_mutex> lock(available_connections_mutex_);
-        if (!message_ && !available_connections_.empty()) {
-            auto* current_connection = available_connections_.front();
+        ConnectionPtr current_connection;
+        while (!message_ && !current_connection && !available_connections_.empty()) {
+            current_connection = available_connections_.front().lock();
+            if (!current_connection) {
+                available_connections_.pop_front();
+            }
+        }
+        if (current_connection) {
             TokenPtr token = current_connection->readToken();
             lock.unlock();
 
@@ -154,7 +161,7 @@ void Slot::handleEvent()
             auto msg_copy = message_;
             lock.unlock();
 
-            if (!std::dynamic_pointer_cast<connection_types::NoMessage const>(message_->getTokenData())) {
+            if (!message_->getTokenData()->isNoMessage()) {
                 apex_assert_hard(guard_ == -1);
                 try {
                     callback_(this, msg_copy);
@@ -222,8 +229,8 @@ void Slot::removeConnection(Connectable* other_side)
         // first remove queued input connections
         std::unique_lock<std::recursive_mutex> lock(available_connections_mutex_);
         for (auto it = available_connections_.begin(); it != available_connections_.end();) {
-            Connection* c = *it;
-            if (c->from().get() == other_side) {
+            ConnectionPtr c = it->lock();
+            if (!c || c->from().get() == other_side) {
                 it = available_connections_.erase(it);
             } else {
                 ++it;
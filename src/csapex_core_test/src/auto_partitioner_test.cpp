@@ -0,0 +1,128 @@
+#include <csapex/command/dispatcher.h>
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/scheduling/auto_partitioner.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+namespace csapex
+{
+class AutoPartitionerTest : public SteppingTest
+{
+protected:
+    ThreadGroup* groupOf(const NodeFacadeImplementationPtr& node)
+    {
+        return executor.getGroupFor(node->getNodeRunner().get());
+    }
+};
+
+TEST_F(AutoPartitionerTest, ConnectedNodesAreKeptTogether)
+{
+    NodeFacadeImplementationPtr src_a = makeNode("MockupSource", "src_a");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr sink_a = makeNode("MockupSink", "sink_a");
+    main_graph_facade->connect(src_a, "output", times_2, "input");
+    main_graph_facade->connect(times_2, "output", sink_a, "input");
+
+    NodeFacadeImplementationPtr src_b = makeNode("MockupSource", "src_b");
+    NodeFacadeImplementationPtr times_4 = makeNode("StaticMultiplier", "times_4");
+    NodeFacadeImplementationPtr sink_b = makeNode("MockupSink", "sink_b");
+    main_graph_facade->connect(src_b, "output", times_4, "input");
+    main_graph_facade->connect(times_4, "output", sink_b, "input");
+
+    executor.setAutoPartitionGroupCount(2);
+
+    AutoPartitioner partitioner(executor, main_graph_facade);
+    PartitionReport report = partitioner.partition();
+
+    ASSERT_EQ(2u, report.group_size.size());
+    EXPECT_EQ(0u, report.cut_edges);
+    EXPECT_EQ(4u, report.total_edges);
+    EXPECT_EQ(6u, report.moved_nodes);
+
+    EXPECT_EQ(groupOf(src_a), groupOf(times_2));
+    EXPECT_EQ(groupOf(src_a), groupOf(sink_a));
+    EXPECT_EQ(groupOf(src_b), groupOf(times_4));
+    EXPECT_EQ(groupOf(src_b), groupOf(sink_b));
+    EXPECT_NE(groupOf(src_a), groupOf(src_b));
+
+    // a balanced partition is kept
+    report = partitioner.partition();
+    EXPECT_EQ(0u, report.moved_nodes);
+}
+
+TEST_F(AutoPartitionerTest, AssignmentIsSavedWithTheThreadPool)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr sink = makeNode("MockupSink", "sink");
+    main_graph_facade->connect(src, "output", sink, "input");
+
+    executor.setAutoPartitionGroupCount(1);
+
+    AutoPartitioner partitioner(executor, main_graph_facade);
+    partitioner.partition();
+
+    YAML::Node node;
+    executor.saveSettings(node);
+    ASSERT_TRUE(node["threads"]["auto_partition_groups"].IsDefined());
+    EXPECT_EQ(1, node["threads"]["auto_partition_groups"].as<int>());
+
+    bool group_saved = false;
+    for (const YAML::Node& group : node["threads"]["groups"]) {
+        if (group["name"].as<std::string>() == AutoPartitioner::GROUP_PREFIX + "0") {
+            group_saved = true;
+            EXPECT_EQ(groupOf(src)->id(), group["id"].as<int>());
+        }
+    }
+    EXPECT_TRUE(group_saved);
+}
+
+TEST_F(AutoPartitionerTest, MovesCanBeUndone)
+{
+    SettingsImplementation settings(false);
+    settings.set("auto_partition_groups", 2);
+
+    CsApexCore core(settings, eh, nullptr, node_factory, nullptr);
+    core.init();
+
+    GraphFacadeImplementationPtr root = core.getRoot();
+    ThreadPoolPtr pool = core.getThreadPool();
+
+    NodeFacadeImplementationPtr src_a = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("src_a"), root->getLocalGraph());
+    root->addNode(src_a);
+    NodeFacadeImplementationPtr sink_a = factory.makeNode("MockupSink", UUIDProvider::makeUUID_without_parent("sink_a"), root->getLocalGraph());
+    root->addNode(sink_a);
+    root->connect(src_a, "output", sink_a, "input");
+    NodeFacadeImplementationPtr src_b = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("src_b"), root->getLocalGraph());
+    root->addNode(src_b);
+
+    int initial = pool->getGroupFor(src_a->getNodeRunner().get())->id();
+
+    PartitionReport report = core.getAutoPartitioner()->partition();
+    EXPECT_EQ(3u, report.moved_nodes);
+
+    int partitioned = pool->getGroupFor(src_a->getNodeRunner().get())->id();
+    EXPECT_NE(initial, partitioned);
+    EXPECT_EQ(partitioned, pool->getGroupFor(sink_a->getNodeRunner().get())->id());
+
+    CommandDispatcherPtr dispatcher = core.getCommandDispatcher();
+    ASSERT_TRUE(dispatcher->canUndo());
+
+    dispatcher->undo();
+    EXPECT_EQ(initial, pool->getGroupFor(src_a->getNodeRunner().get())->id());
+    EXPECT_EQ(initial, pool->getGroupFor(sink_a->getNodeRunner().get())->id());
+    EXPECT_EQ(initial, pool->getGroupFor(src_b->getNodeRunner().get())->id());
+
+    dispatcher->redo();
+    EXPECT_EQ(partitioned, pool->getGroupFor(src_a->getNodeRunner().get())->id());
+}
+
+}  // namespace csapex
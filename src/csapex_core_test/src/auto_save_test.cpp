@@ -0,0 +1,156 @@
+#include <csapex/core/auto_save.h>
+#include <csapex/core/graphio.h>
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/generic_state.h>
+#include <csapex/model/node_state.h>
+#include <csapex/param/parameter_factory.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+#include <boost/filesystem.hpp>
+
+namespace csapex
+{
+class AutoSaveTest : public SteppingTest
+{
+protected:
+    AutoSaveTest() : path((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("csapex_autosave_%%%%%%.apex")).string())
+    {
+    }
+
+    ~AutoSaveTest()
+    {
+        boost::filesystem::remove(path);
+    }
+
+    AutoSave::Source makeSource()
+    {
+        return [this](const GraphIO::NodeFilter& is_unchanged, const GraphIO::NodeStateWriter& write_state) {
+            YAML::Node doc(YAML::NodeType::Map);
+            GraphIO io(*main_graph_facade, &factory);
+            io.setUnchangedNodeFilter(is_unchanged);
+            io.setNodeStateWriter(write_state);
+            io.saveGraphTo(doc);
+            return doc;
+        };
+    }
+
+    std::map<std::string, YAML::Node> loadNodes()
+    {
+        std::map<std::string, YAML::Node> nodes;
+        YAML::Node doc = YAML::LoadFile(path);
+        for (const YAML::Node& node : doc["nodes"]) {
+            nodes[node["uuid"].as<std::string>()] = node;
+        }
+        return nodes;
+    }
+
+    std::string path;
+};
+
+TEST_F(AutoSaveTest, OnlyChangedNodesAreSerialized)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr sink = makeNode("MockupSink", "sink");
+    main_graph_facade->connect(src, "output", sink, "input");
+
+    AutoSave auto_save(makeSource());
+
+    auto_save.save(path);
+    EXPECT_EQ(2u, auto_save.getSerializedNodeCount());
+    EXPECT_EQ(0u, auto_save.getReusedNodeCount());
+
+    auto_save.save(path);
+    EXPECT_EQ(0u, auto_save.getSerializedNodeCount());
+    EXPECT_EQ(2u, auto_save.getReusedNodeCount());
+
+    sink->getNodeState()->setPos(Point(42, 23));
+
+    auto_save.save(path);
+    EXPECT_EQ(1u, auto_save.getSerializedNodeCount());
+    EXPECT_EQ(1u, auto_save.getReusedNodeCount());
+
+    auto_save.flush();
+
+    // the written file is complete, references are resolved from earlier snapshots
+    std::map<std::string, YAML::Node> nodes = loadNodes();
+    ASSERT_EQ(2u, nodes.size());
+    for (const auto& pair : nodes) {
+        EXPECT_FALSE(pair.second["cached"].IsDefined());
+        EXPECT_TRUE(pair.second["type"].IsDefined());
+    }
+    EXPECT_EQ(42, nodes["sink"]["pos"][0].as<int>());
+}
+
+TEST_F(AutoSaveTest, RemovedNodesAreDropped)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr sink = makeNode("MockupSink", "sink");
+
+    AutoSave auto_save(makeSource());
+    auto_save.save(path);
+
+    main_graph_facade->getLocalGraph()->deleteNode(sink->getUUID());
+
+    auto_save.save(path);
+    EXPECT_EQ(1u, auto_save.getReusedNodeCount());
+
+    auto_save.flush();
+
+    std::map<std::string, YAML::Node> nodes = loadNodes();
+    ASSERT_EQ(1u, nodes.size());
+    EXPECT_EQ(1u, nodes.count("src"));
+}
+
+TEST_F(AutoSaveTest, InvalidationSerializesEverything)
+{
+    makeNode("MockupSource", "src");
+
+    AutoSave auto_save(makeSource());
+    auto_save.save(path);
+    auto_save.invalidate();
+    auto_save.save(path);
+
+    EXPECT_EQ(1u, auto_save.getSerializedNodeCount());
+    EXPECT_EQ(0u, auto_save.getReusedNodeCount());
+}
+
+TEST_F(AutoSaveTest, RemovedParametersDoNotChangeTheRevision)
+{
+    GenericState state;
+    param::ParameterPtr p = param::ParameterFactory::declareBool("flag", false).build();
+    state.addParameter(p);
+
+    uint64_t revision = state.getRevision();
+    p->set(true);
+    EXPECT_NE(revision, state.getRevision());
+
+    state.removeParameter(p);
+
+    revision = state.getRevision();
+    p->set(false);
+    EXPECT_EQ(revision, state.getRevision());
+}
+
+TEST_F(AutoSaveTest, StatesAreWrittenAsTheyWereWhenSaved)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    src->getNodeState()->setPos(Point(1, 2));
+
+    AutoSave auto_save(makeSource());
+    auto_save.save(path);
+
+    // changes after the snapshot must not leak into the written file
+    src->getNodeState()->setPos(Point(3, 4));
+    auto_save.flush();
+
+    std::map<std::string, YAML::Node> nodes = loadNodes();
+    ASSERT_EQ(1u, nodes.count("src"));
+    EXPECT_EQ(1, nodes["src"]["pos"][0].as<int>());
+    EXPECT_EQ("MockupSource", nodes["src"]["type"].as<std::string>());
+}
+
+}  // namespace csapex
@@ -0,0 +1,245 @@
+#include <csapex/factory/node_wrapper.hpp>
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_worker.h>
+#include <csapex/msg/batch_message.h>
+#include <csapex/msg/end_of_sequence_message.h>
+#include <csapex/msg/input.h>
+#include <csapex/msg/io.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+namespace csapex
+{
+class MockupBatchSource
+{
+public:
+    MockupBatchSource() : next_(0)
+    {
+    }
+
+    void setup(NodeModifier& node_modifier)
+    {
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    void setupParameters(Parameterizable& /*parameters*/)
+    {
+    }
+
+    void process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+    {
+        std::vector<int> values;
+        for (int i = 0; i < 4; ++i) {
+            values.push_back(next_++);
+        }
+        msg::publishBatch(out, values);
+    }
+
+private:
+    Output* out;
+    int next_;
+};
+
+class MockupMarkedBatchSource
+{
+public:
+    void setup(NodeModifier& node_modifier)
+    {
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    void setupParameters(Parameterizable& /*parameters*/)
+    {
+    }
+
+    void process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+    {
+        auto batch = std::make_shared<connection_types::BatchMessage>();
+        batch->elements.push_back(std::make_shared<connection_types::GenericValueMessage<int>>(1));
+        batch->elements.push_back(std::make_shared<connection_types::GenericValueMessage<int>>(2));
+        batch->elements.push_back(makeEmpty<connection_types::EndOfSequenceMessage>());
+        batch->elements.push_back(std::make_shared<connection_types::GenericValueMessage<int>>(3));
+        msg::publish(out, batch);
+    }
+
+private:
+    Output* out;
+};
+
+class MockupFailingNode
+{
+public:
+    void setup(NodeModifier& node_modifier)
+    {
+        in = node_modifier.addInput<int>("input");
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    void setupParameters(Parameterizable& /*parameters*/)
+    {
+    }
+
+    void process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+    {
+        int value = msg::getValue<int>(in);
+        if (value == 2) {
+            throw std::runtime_error("cannot process 2");
+        }
+        msg::publish(out, value);
+    }
+
+private:
+    Input* in;
+    Output* out;
+};
+
+class MockupBatchSink
+{
+public:
+    void setup(NodeModifier& node_modifier)
+    {
+        in = node_modifier.addInput<int>("input");
+        node_modifier.setBatchProcessing(true);
+    }
+
+    void setupParameters(Parameterizable& /*parameters*/)
+    {
+    }
+
+    void process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+    {
+        batch_sizes.push_back(msg::getBatch<int>(in).size());
+        for (int value : msg::getBatch<int>(in)) {
+            values.push_back(value);
+        }
+
+        TokenDataConstPtr data = msg::getMessage(in);
+        if (data->isBatch()) {
+            for (const TokenDataConstPtr& element : std::static_pointer_cast<connection_types::BatchMessage const>(data)->elements) {
+                received.push_back(element->isMarker() ? "marker" : "message");
+            }
+        }
+    }
+
+    std::vector<int> values;
+    std::vector<std::size_t> batch_sizes;
+    std::vector<std::string> received;
+
+private:
+    Input* in;
+};
+
+class BatchProcessingTest : public SteppingTest
+{
+protected:
+    BatchProcessingTest()
+    {
+        factory.registerNodeType(std::make_shared<NodeConstructor>("MockupBatchSource", []() { return NodePtr(new NodeWrapper<MockupBatchSource>()); }));
+        factory.registerNodeType(std::make_shared<NodeConstructor>("MockupMarkedBatchSource", []() { return NodePtr(new NodeWrapper<MockupMarkedBatchSource>()); }));
+        factory.registerNodeType(std::make_shared<NodeConstructor>("MockupFailingNode", []() { return NodePtr(new NodeWrapper<MockupFailingNode>()); }));
+        factory.registerNodeType(std::make_shared<NodeConstructor>("MockupBatchSink", []() { return NodePtr(new NodeWrapper<MockupBatchSink>()); }));
+    }
+};
+
+TEST_F(BatchProcessingTest, BatchesAreUnrolledForSingleTokenNodes)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupBatchSource", "src");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr sink_p = makeNode("MockupBatchSink", "sink");
+
+    main_graph_facade->connect(src, "output", times_2, "input");
+    main_graph_facade->connect(times_2, "output", sink_p, "input");
+
+    auto sink = std::dynamic_pointer_cast<NodeWrapper<MockupBatchSink>>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    executor.start();
+
+    const int steps = 3;
+    for (int i = 0; i < steps; ++i) {
+        ASSERT_NO_FATAL_FAILURE(step());
+    }
+
+    ASSERT_EQ(4u * steps, sink->values.size());
+    for (std::size_t i = 0; i < sink->values.size(); ++i) {
+        EXPECT_EQ(2 * static_cast<int>(i), sink->values[i]);
+    }
+    for (std::size_t size : sink->batch_sizes) {
+        EXPECT_EQ(4u, size);
+    }
+
+    // the multiplier was called for every element, but only scheduled once per batch
+    EXPECT_EQ(steps, times_2->getNodeWorker().lock()->getProcessCount());
+}
+
+TEST_F(BatchProcessingTest, SingleMessagesAreViewedAsBatchesOfOne)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr sink_p = makeNode("MockupBatchSink", "sink");
+
+    main_graph_facade->connect(src, "output", sink_p, "input");
+
+    auto sink = std::dynamic_pointer_cast<NodeWrapper<MockupBatchSink>>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    executor.start();
+
+    ASSERT_NO_FATAL_FAILURE(step());
+    ASSERT_NO_FATAL_FAILURE(step());
+
+    ASSERT_EQ(2u, sink->values.size());
+    EXPECT_EQ(0, sink->values[0]);
+    EXPECT_EQ(1, sink->values[1]);
+    ASSERT_EQ(2u, sink->batch_sizes.size());
+    EXPECT_EQ(1u, sink->batch_sizes[0]);
+}
+
+TEST_F(BatchProcessingTest, MarkersKeepTheirPositionInTheBatch)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupMarkedBatchSource", "src");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr sink_p = makeNode("MockupBatchSink", "sink");
+
+    main_graph_facade->connect(src, "output", times_2, "input");
+    main_graph_facade->connect(times_2, "output", sink_p, "input");
+
+    auto sink = std::dynamic_pointer_cast<NodeWrapper<MockupBatchSink>>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    executor.start();
+
+    ASSERT_NO_FATAL_FAILURE(step());
+
+    // the batch view only contains the messages
+    ASSERT_EQ(3u, sink->values.size());
+    EXPECT_EQ(2, sink->values[0]);
+    EXPECT_EQ(4, sink->values[1]);
+    EXPECT_EQ(6, sink->values[2]);
+
+    std::vector<std::string> expected{ "message", "message", "marker", "message" };
+    EXPECT_EQ(expected, sink->received);
+}
+
+TEST_F(BatchProcessingTest, BatchIsRestoredIfAnElementFails)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupMarkedBatchSource", "src");
+    NodeFacadeImplementationPtr failing = makeNode("MockupFailingNode", "failing");
+
+    main_graph_facade->connect(src, "output", failing, "input");
+
+    executor.start();
+
+    ASSERT_NO_FATAL_FAILURE(step());
+
+    EXPECT_TRUE(failing->isError());
+
+    InputPtr input = failing->getNodeHandle()->getExternalInputs().front();
+    ASSERT_NE(nullptr, input->getToken());
+    EXPECT_TRUE(input->getToken()->getTokenData()->isBatch());
+}
+
+}  // namespace csapex
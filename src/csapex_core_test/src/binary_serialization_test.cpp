@@ -3,10 +3,15 @@
 #include <csapex/msg/message_template.hpp>
 #include <csapex/utility/register_msg.h>
 #include <yaml-cpp/yaml.h>
+#include <csapex/serialization/io/bulk_io.h>
 #include <csapex/serialization/io/std_io.h>
 #include <csapex/serialization/io/csapex_io.h>
 #include <csapex/msg/io.h>
 #include <csapex_testing/mockup_msgs.h>
+#include <csapex/model/connection_description.h>
+#include <csapex/model/fulcrum.h>
+#include <csapex/msg/any_message.h>
+#include <csapex/profiling/interval.h>
 
 #include <bitset>
 
@@ -101,6 +106,34 @@ TEST_F(BinarySerializationTest, TestUInt32)
     }
 }
 
+TEST_F(BinarySerializationTest, TestUInt64)
+{
+    std::vector<uint64_t> values{ 0, 1, 0xFFu, 0x100000000ull, 0x0123456789ABCDEFull, 0xFEDCBA9876543210ull, std::numeric_limits<uint64_t>::max() };
+
+    for (uint64_t i : values) {
+        SerializationBuffer buffer;
+        buffer << i;
+        uint64_t value;
+        buffer >> value;
+
+        ASSERT_EQ(i, value);
+    }
+}
+
+TEST_F(BinarySerializationTest, TestInt64)
+{
+    std::vector<int64_t> values{ 0, -1, 0x7FFFFFFFll, -0x80000000ll, 0x0123456789ABCDEFll, -0x0123456789ABCDEFll, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() };
+
+    for (int64_t i : values) {
+        SerializationBuffer buffer;
+        buffer << i;
+        int64_t value;
+        buffer >> value;
+
+        ASSERT_EQ(i, value);
+    }
+}
+
 TEST_F(BinarySerializationTest, TestFloat)
 {
     std::size_t STEPS = 64;
@@ -414,3 +447,128 @@ TEST_F(BinarySerializationTest, VectorTest)
         ASSERT_EQ(10, vector->size());
     }
 }
+
+TEST_F(BinarySerializationTest, BulkVectorTest)
+{
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i * 0.5);
+    }
+
+    SerializationBuffer data;
+    writeBulk(data, values);
+    EXPECT_EQ(SerializationBuffer::HEADER_LENGTH + sizeof(uint64_t) + values.size() * sizeof(double), data.size());
+
+    std::vector<double> read;
+    readBulk(data, read);
+    EXPECT_EQ(values, read);
+}
+
+TEST_F(BinarySerializationTest, TruncatedBulkVectorThrows)
+{
+    SerializationBuffer data;
+    writeBulk(data, std::vector<int>(10, 42));
+    data.resize(data.size() - 1);
+
+    std::vector<int> read;
+    EXPECT_THROW(readBulk(data, read), std::runtime_error);
+}
+
+TEST_F(BinarySerializationTest, PrimitiveVectorTest)
+{
+    SerializationBuffer data;
+    {
+        GenericVectorMessage::Ptr message = GenericVectorMessage::make<float>();
+
+        std::shared_ptr<std::vector<float>> vector = std::make_shared<std::vector<float>>();
+        for (int i = 0; i < 1000; ++i) {
+            vector->push_back(i / 4.0f);
+        }
+        message->set(vector);
+
+        TokenData::Ptr generic = message;
+        data << generic;
+    }
+
+    {
+        TokenData::Ptr generic;
+        data >> generic;
+        ASSERT_NE(nullptr, generic);
+
+        GenericVectorMessage::Ptr vector_msg = std::dynamic_pointer_cast<GenericVectorMessage>(generic);
+        ASSERT_NE(nullptr, vector_msg);
+
+        std::shared_ptr<const std::vector<float>> vector = vector_msg->makeShared<float>();
+        ASSERT_EQ(1000u, vector->size());
+        for (std::size_t i = 0; i < vector->size(); ++i) {
+            ASSERT_EQ(i / 4.0f, vector->at(i));
+        }
+    }
+}
+
+TEST_F(BinarySerializationTest, BulkPointVectorTest)
+{
+    std::vector<Point> points{ Point(1, 2), Point(3, 4) };
+
+    SerializationBuffer data;
+    writeBulk(data, points);
+
+    std::vector<Point> read;
+    readBulk(data, read);
+    ASSERT_EQ(2u, read.size());
+    EXPECT_EQ(Point(3, 4), read.at(1));
+}
+
+TEST_F(BinarySerializationTest, ConnectionPolicyIsSerialized)
+{
+    UUID from = UUIDProvider::makeUUID_without_parent("a:|:out_0");
+    UUID to = UUIDProvider::makeUUID_without_parent("b:|:in_0");
+    ConnectionDescription description(from, to, makeEmpty<AnyMessage>(), 3, true, {}, ConnectionPolicy::LATEST_VALUE);
+
+    SerializationBuffer data;
+    data << description;
+
+    ConnectionDescription read;
+    data >> read;
+    EXPECT_EQ(ConnectionPolicy::LATEST_VALUE, read.policy);
+    EXPECT_EQ(3, read.id);
+}
+
+TEST_F(BinarySerializationTest, ConnectionDescriptionsWithoutPolicyCanBeRead)
+{
+    UUID from = UUIDProvider::makeUUID_without_parent("a:|:out_0");
+    UUID to = UUIDProvider::makeUUID_without_parent("b:|:in_0");
+    TokenDataConstPtr type = makeEmpty<AnyMessage>();
+
+    // the layout written before connections had a policy
+    SerializationBuffer data;
+    data << SemanticVersion();
+    data << from << to << std::string() << std::string() << type << 3 << true << std::vector<Fulcrum>();
+    data << std::string("next");
+
+    ConnectionDescription read;
+    data >> read;
+    EXPECT_EQ(ConnectionPolicy::HANDSHAKE, read.policy);
+    EXPECT_EQ(to, read.to);
+
+    std::string next;
+    data >> next;
+    EXPECT_EQ("next", next);
+}
+
+TEST_F(BinarySerializationTest, IntervalValuesAreSerialized)
+{
+    Interval::Ptr interval = std::make_shared<Interval>("process");
+    interval->setValue("held bytes", 4096);
+    interval->stop();
+
+    SerializationBuffer data;
+    data << interval;
+
+    Interval::Ptr read;
+    data >> read;
+    ASSERT_NE(nullptr, read);
+    EXPECT_EQ(interval->getStartMicro(), read->getStartMicro());
+    ASSERT_EQ(1u, read->getValues().size());
+    EXPECT_EQ(4096, read->getValues().at("held bytes"));
+}
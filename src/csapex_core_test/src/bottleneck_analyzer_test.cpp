@@ -0,0 +1,137 @@
+#include <csapex/core/bottleneck_analyzer.h>
+#include <csapex/factory/node_wrapper.hpp>
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/msg/io.h>
+#include <csapex/msg/generic_value_message.hpp>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+#include <sstream>
+#include <thread>
+
+namespace csapex
+{
+class MockupSlowNode
+{
+public:
+    void setup(NodeModifier& node_modifier)
+    {
+        in = node_modifier.addInput<int>("input");
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    void setupParameters(Parameterizable& /*parameters*/)
+    {
+    }
+
+    void process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        msg::publish(out, msg::getValue<int>(in));
+    }
+
+private:
+    Input* in;
+    Output* out;
+};
+
+class BottleneckAnalyzerTest : public SteppingTest
+{
+protected:
+    BottleneckAnalyzerTest()
+    {
+        factory.registerNodeType(std::make_shared<NodeConstructor>("MockupSlowNode", []() { return NodePtr(new NodeWrapper<MockupSlowNode>()); }));
+    }
+};
+
+TEST_F(BottleneckAnalyzerTest, SlowestNodeIsTheBottleneck)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr fast = makeNode("StaticMultiplier", "fast");
+    NodeFacadeImplementationPtr slow = makeNode("MockupSlowNode", "slow");
+    NodeFacadeImplementationPtr other = makeNode("StaticMultiplier", "other");
+    NodeFacadeImplementationPtr sink = makeNode("MockupSink", "sink");
+    NodeFacadeImplementationPtr other_sink = makeNode("MockupSink", "other_sink");
+
+    main_graph_facade->connect(src, "output", fast, "input");
+    main_graph_facade->connect(fast, "output", slow, "input");
+    main_graph_facade->connect(slow, "output", sink, "input");
+    main_graph_facade->connect(src, "output", other, "input");
+    main_graph_facade->connect(other, "output", other_sink, "input");
+
+    BottleneckAnalyzer analyzer(main_graph_facade);
+    analyzer.update();
+
+    executor.start();
+
+    const int steps = 10;
+    for (int i = 0; i < steps; ++i) {
+        ASSERT_NO_FATAL_FAILURE(step());
+    }
+
+    BottleneckReport report = analyzer.update();
+
+    ASSERT_EQ(6u, report.nodes.size());
+    EXPECT_EQ(slow->getAUUID(), report.bottleneck);
+
+    for (const NodeLoad& load : report.nodes) {
+        EXPECT_EQ(steps, load.process_count) << load.node;
+        EXPECT_LE(load.utilization, 1.0);
+        if (load.node == slow->getAUUID()) {
+            EXPECT_GE(load.mean_process_time, 5000.0);
+        }
+    }
+
+    ASSERT_EQ(4u, report.critical_path.size());
+    EXPECT_EQ(src->getAUUID(), report.critical_path[0]);
+    EXPECT_EQ(fast->getAUUID(), report.critical_path[1]);
+    EXPECT_EQ(slow->getAUUID(), report.critical_path[2]);
+    EXPECT_EQ(sink->getAUUID(), report.critical_path[3]);
+    EXPECT_GE(report.critical_path_time, 5000.0);
+
+    std::stringstream dump;
+    dump << report;
+    EXPECT_NE(std::string::npos, dump.str().find("bottleneck"));
+}
+
+TEST_F(BottleneckAnalyzerTest, CriticalPathFollowsTheLongBranchOfAShortcut)
+{
+    // join is closer to the source than slow, but it must only be evaluated after slow
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr fast = makeNode("StaticMultiplier", "fast");
+    NodeFacadeImplementationPtr slow = makeNode("MockupSlowNode", "slow");
+    NodeFacadeImplementationPtr join = makeNode("DynamicMultiplier", "join");
+    NodeFacadeImplementationPtr sink = makeNode("MockupSink", "sink");
+
+    main_graph_facade->connect(src, "output", fast, "input");
+    main_graph_facade->connect(fast, "output", slow, "input");
+    main_graph_facade->connect(slow, "output", join, "input_a");
+    main_graph_facade->connect(src, "output", join, "input_b");
+    main_graph_facade->connect(join, "output", sink, "input");
+
+    ASSERT_LT(graph->getDepth(join->getUUID()), graph->getDepth(slow->getUUID()));
+
+    BottleneckAnalyzer analyzer(main_graph_facade);
+    analyzer.update();
+
+    executor.start();
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_NO_FATAL_FAILURE(step());
+    }
+
+    BottleneckReport report = analyzer.update();
+
+    ASSERT_EQ(5u, report.critical_path.size());
+    EXPECT_EQ(src->getAUUID(), report.critical_path[0]);
+    EXPECT_EQ(fast->getAUUID(), report.critical_path[1]);
+    EXPECT_EQ(slow->getAUUID(), report.critical_path[2]);
+    EXPECT_EQ(join->getAUUID(), report.critical_path[3]);
+    EXPECT_EQ(sink->getAUUID(), report.critical_path[4]);
+    EXPECT_GE(report.critical_path_time, 5000.0);
+}
+
+}  // namespace csapex
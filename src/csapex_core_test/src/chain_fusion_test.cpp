@@ -0,0 +1,104 @@
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/model/node_worker.h>
+#include <csapex/model/connection.h>
+#include <csapex/msg/generic_value_message.hpp>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+namespace csapex
+{
+class ChainFusionTest : public SteppingTest
+{
+protected:
+    ChainFusionTest()
+    {
+        NodeRunner::setChainFusionEnabled(true);
+    }
+
+    ~ChainFusionTest()
+    {
+        NodeRunner::setChainFusionEnabled(false);
+    }
+};
+
+TEST_F(ChainFusionTest, SingleConsumerChainsAreFused)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr times_4 = makeNode("StaticMultiplier", "times_4");
+    NodeFacadeImplementationPtr sink_p = makeNode("MockupSink", "sink");
+
+    ConnectionPtr src_to_times_2 = main_graph_facade->connect(src, "output", times_2, "input");
+    ConnectionPtr times_2_to_times_4 = main_graph_facade->connect(times_2, "output", times_4, "input");
+    ConnectionPtr times_4_to_sink = main_graph_facade->connect(times_4, "output", sink_p, "input");
+
+    EXPECT_EQ(nullptr, src->getNodeRunner()->getFusedPredecessor());
+    EXPECT_EQ(src->getNodeRunner(), times_2->getNodeRunner()->getFusedPredecessor());
+    EXPECT_EQ(times_2->getNodeRunner(), times_4->getNodeRunner()->getFusedPredecessor());
+    EXPECT_EQ(times_4->getNodeRunner(), sink_p->getNodeRunner()->getFusedPredecessor());
+
+    // tokens are handed over without copying the payload
+    EXPECT_TRUE(src_to_times_2->isDirectHandoff());
+    EXPECT_TRUE(times_2_to_times_4->isDirectHandoff());
+    EXPECT_TRUE(times_4_to_sink->isDirectHandoff());
+
+    std::shared_ptr<MockupSink> sink = std::dynamic_pointer_cast<MockupSink>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    executor.start();
+
+    const int steps = 20;
+    for (int iter = 0; iter < steps; ++iter) {
+        ASSERT_NO_FATAL_FAILURE(step());
+        ASSERT_EQ(4 * iter, sink->getValue());
+    }
+
+    // every member of the chain is still processed and profiled on its own
+    EXPECT_EQ(steps, times_2->getNodeWorker().lock()->getProcessCount());
+    EXPECT_EQ(steps, times_4->getNodeWorker().lock()->getProcessCount());
+
+    // the successors did not get a task of their own, they were executed in the source's task
+    EXPECT_EQ(0, src->getNodeRunner()->getFusedExecutionCount());
+    EXPECT_EQ(steps, times_2->getNodeRunner()->getFusedExecutionCount());
+    EXPECT_EQ(steps, times_4->getNodeRunner()->getFusedExecutionCount());
+    EXPECT_EQ(steps, sink_p->getNodeRunner()->getFusedExecutionCount());
+}
+
+TEST_F(ChainFusionTest, FusedChainsShareThePayload)
+{
+    TokenDataConstPtr data = std::make_shared<connection_types::GenericValueMessage<int>>(42);
+    TokenPtr token = std::make_shared<Token>(data);
+    token->setSequenceNumber(7);
+
+    TokenPtr handed_over = token->makeShallowCopy();
+    EXPECT_NE(token, handed_over);
+    EXPECT_EQ(data, handed_over->getTokenData());
+    EXPECT_EQ(7, handed_over->getSequenceNumber());
+
+    TokenPtr copied = token->cloneAs<Token>();
+    EXPECT_NE(data, copied->getTokenData());
+}
+
+TEST_F(ChainFusionTest, BranchesAreNotFused)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr sink_a = makeNode("MockupSink", "sink_a");
+    NodeFacadeImplementationPtr sink_b = makeNode("MockupSink", "sink_b");
+
+    main_graph_facade->connect(src, "output", times_2, "input");
+    main_graph_facade->connect(times_2, "output", sink_a, "input");
+    EXPECT_EQ(times_2->getNodeRunner(), sink_a->getNodeRunner()->getFusedPredecessor());
+
+    ConnectionPtr to_b = main_graph_facade->connect(times_2, "output", sink_b, "input");
+    EXPECT_EQ(nullptr, sink_a->getNodeRunner()->getFusedPredecessor());
+    EXPECT_EQ(nullptr, sink_b->getNodeRunner()->getFusedPredecessor());
+    EXPECT_EQ(src->getNodeRunner(), times_2->getNodeRunner()->getFusedPredecessor());
+    EXPECT_FALSE(to_b->isDirectHandoff());
+}
+
+}  // namespace csapex
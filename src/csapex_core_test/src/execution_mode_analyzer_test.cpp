@@ -0,0 +1,135 @@
+#include <csapex/core/execution_mode_analyzer.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_state.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+namespace csapex
+{
+class ExecutionModeAnalyzerTest : public SteppingTest
+{
+protected:
+    void connect(const NodeFacadeImplementationPtr& from, const std::string& output, const NodeFacadeImplementationPtr& to, const std::string& input)
+    {
+        main_graph_facade->connect(from->getNodeHandle().get(), output, to->getNodeHandle().get(), input);
+    }
+
+    ExecutionModeDecision find(const ExecutionModeReport& report, const NodeFacadeImplementationPtr& node)
+    {
+        for (const ExecutionModeDecision& decision : report.nodes) {
+            if (decision.node == node->getAUUID()) {
+                return decision;
+            }
+        }
+        throw std::runtime_error("node is missing in the report");
+    }
+
+    ExecutionMode mode(const NodeFacadeImplementationPtr& node)
+    {
+        return node->getNodeHandle()->getNodeState()->getExecutionMode();
+    }
+};
+
+TEST_F(ExecutionModeAnalyzerTest, NodesOnAChainArePromoted)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr times_4 = makeNode("StaticMultiplier4", "times_4");
+    NodeFacadeImplementationPtr sink = makeNode("MockupNonEssentialSink", "sink");
+
+    connect(src, "output", times_2, "input");
+    connect(times_2, "output", times_4, "input");
+    connect(times_4, "output", sink, "input");
+
+    ExecutionModeAnalyzer analyzer(main_graph_facade);
+    ExecutionModeReport report = analyzer.analyze();
+
+    ASSERT_EQ(4u, report.nodes.size());
+    EXPECT_FALSE(find(report, src).isPromotion());
+    EXPECT_TRUE(find(report, times_2).isPromotion());
+    EXPECT_TRUE(find(report, times_4).isPromotion());
+    EXPECT_FALSE(find(report, sink).isPromotion());
+    EXPECT_EQ(2u, report.promotions().size());
+
+    std::shared_ptr<MockupSink> sink_node = std::dynamic_pointer_cast<MockupSink>(sink->getNode());
+    ASSERT_NE(nullptr, sink_node);
+
+    executor.start();
+
+    const int steps = 10;
+    int iter = 0;
+    for (; iter < steps; ++iter) {
+        ASSERT_NO_FATAL_FAILURE(step());
+        ASSERT_EQ(8 * iter, sink_node->getValue());
+    }
+
+    analyzer.apply(report);
+
+    EXPECT_EQ(ExecutionMode::SEQUENTIAL, mode(src));
+    EXPECT_EQ(ExecutionMode::PIPELINING, mode(times_2));
+    EXPECT_EQ(ExecutionMode::PIPELINING, mode(times_4));
+    EXPECT_EQ(ExecutionMode::SEQUENTIAL, mode(sink));
+
+    // applied modes are reported as already chosen
+    EXPECT_TRUE(analyzer.analyze().promotions().empty());
+
+    // the promotion must not change what arrives at the sink
+    for (; iter < 2 * steps; ++iter) {
+        ASSERT_NO_FATAL_FAILURE(step());
+        ASSERT_EQ(8 * iter, sink_node->getValue());
+    }
+}
+
+TEST_F(ExecutionModeAnalyzerTest, ChainsLeadingToEssentialInputsStaySequential)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr sink = makeNode("MockupSink", "sink");
+
+    connect(src, "output", times_2, "input");
+    connect(times_2, "output", sink, "input");
+
+    ExecutionModeAnalyzer analyzer(main_graph_facade);
+    ExecutionModeReport report = analyzer.analyze();
+
+    ExecutionModeDecision decision = find(report, times_2);
+    EXPECT_FALSE(decision.isPromotion());
+    EXPECT_EQ("leads to an essential input", decision.reason);
+    EXPECT_TRUE(report.promotions().empty());
+}
+
+TEST_F(ExecutionModeAnalyzerTest, JoinedBranchesStaySequential)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr left = makeNode("StaticMultiplier", "left");
+    NodeFacadeImplementationPtr right = makeNode("StaticMultiplier4", "right");
+    NodeFacadeImplementationPtr join = makeNode("DynamicMultiplier", "join");
+    NodeFacadeImplementationPtr after = makeNode("StaticMultiplier7", "after");
+    NodeFacadeImplementationPtr sink = makeNode("MockupNonEssentialSink", "sink");
+
+    connect(src, "output", left, "input");
+    connect(src, "output", right, "input");
+    connect(left, "output", join, "input_a");
+    connect(right, "output", join, "input_b");
+    connect(join, "output", after, "input");
+    connect(after, "output", sink, "input");
+
+    ExecutionModeAnalyzer analyzer(main_graph_facade);
+    ExecutionModeReport report = analyzer.analyze();
+
+    EXPECT_FALSE(find(report, left).isPromotion());
+    EXPECT_FALSE(find(report, right).isPromotion());
+    EXPECT_FALSE(find(report, join).isPromotion());
+    EXPECT_TRUE(find(report, after).isPromotion());
+
+    std::vector<ExecutionModeDecision> promotions = report.promotions();
+    ASSERT_EQ(1u, promotions.size());
+    EXPECT_EQ(after->getAUUID(), promotions.front().node);
+    EXPECT_FALSE(promotions.front().reason.empty());
+}
+
+}  // namespace csapex
@@ -0,0 +1,137 @@
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph/vertex.h>
+#include <csapex/model/node_characteristics.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/connection.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/stepping_test.h>
+
+#include <chrono>
+#include <map>
+#include <set>
+
+namespace csapex
+{
+class GraphAnalysisTest : public SteppingTest
+{
+protected:
+    std::map<UUID, NodeCharacteristics> snapshot()
+    {
+        std::map<UUID, NodeCharacteristics> result;
+        for (const graph::VertexPtr& vertex : *graph) {
+            result[vertex->getUUID()] = vertex->getNodeCharacteristics();
+        }
+        return result;
+    }
+
+    void expectSameAsFullAnalysis()
+    {
+        std::map<UUID, NodeCharacteristics> incremental = snapshot();
+        graph->analyzeGraph();
+        std::map<UUID, NodeCharacteristics> full = snapshot();
+
+        ASSERT_EQ(full.size(), incremental.size());
+
+        std::map<int, int> component_mapping;
+        std::set<int> mapped_components;
+        for (const auto& pair : full) {
+            const NodeCharacteristics& expected = pair.second;
+            const NodeCharacteristics& actual = incremental.at(pair.first);
+
+            EXPECT_EQ(expected.depth, actual.depth) << pair.first;
+            EXPECT_EQ(expected.is_joining_vertex, actual.is_joining_vertex) << pair.first;
+            EXPECT_EQ(expected.is_joining_vertex_counterpart, actual.is_joining_vertex_counterpart) << pair.first;
+            EXPECT_EQ(expected.is_combined_by_joining_vertex, actual.is_combined_by_joining_vertex) << pair.first;
+            EXPECT_EQ(expected.is_leading_to_joining_vertex, actual.is_leading_to_joining_vertex) << pair.first;
+            EXPECT_EQ(expected.is_leading_to_essential_vertex, actual.is_leading_to_essential_vertex) << pair.first;
+
+            // component ids are arbitrary, but both analyses have to partition the graph the same way
+            auto pos = component_mapping.find(expected.component);
+            if (pos == component_mapping.end()) {
+                EXPECT_TRUE(mapped_components.insert(actual.component).second) << pair.first;
+                component_mapping[expected.component] = actual.component;
+            } else {
+                EXPECT_EQ(pos->second, actual.component) << pair.first;
+            }
+        }
+    }
+};
+
+TEST_F(GraphAnalysisTest, IncrementalAnalysisMatchesFullAnalysis)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    expectSameAsFullAnalysis();
+    NodeFacadeImplementationPtr a = makeNode("StaticMultiplier", "a");
+    expectSameAsFullAnalysis();
+    NodeFacadeImplementationPtr b = makeNode("StaticMultiplier", "b");
+    expectSameAsFullAnalysis();
+    NodeFacadeImplementationPtr join = makeNode("DynamicMultiplier", "join");
+    expectSameAsFullAnalysis();
+    NodeFacadeImplementationPtr c = makeNode("StaticMultiplier", "c");
+    expectSameAsFullAnalysis();
+    NodeFacadeImplementationPtr sink = makeNode("MockupSink", "sink");
+    expectSameAsFullAnalysis();
+
+    main_graph_facade->connect(join, "output", c, "input");
+    expectSameAsFullAnalysis();
+    main_graph_facade->connect(c, "output", sink, "input");
+    expectSameAsFullAnalysis();
+    main_graph_facade->connect(src, "output", a, "input");
+    expectSameAsFullAnalysis();
+    ConnectionPtr src_to_b = main_graph_facade->connect(src, "output", b, "input");
+    expectSameAsFullAnalysis();
+    main_graph_facade->connect(a, "output", join, "input_a");
+    expectSameAsFullAnalysis();
+    ConnectionPtr b_to_join = main_graph_facade->connect(b, "output", join, "input_b");
+    expectSameAsFullAnalysis();
+
+    ASSERT_EQ(3, graph->getDepth(c->getUUID()));
+    ASSERT_TRUE(join->getNodeHandle()->getVertex()->getNodeCharacteristics().is_joining_vertex);
+    ASSERT_TRUE(src->getNodeHandle()->getVertex()->getNodeCharacteristics().is_joining_vertex_counterpart);
+
+    graph->deleteConnection(b_to_join);
+    expectSameAsFullAnalysis();
+    ASSERT_FALSE(join->getNodeHandle()->getVertex()->getNodeCharacteristics().is_joining_vertex);
+    ASSERT_EQ(graph->getComponent(b->getUUID()), graph->getComponent(sink->getUUID()));
+
+    graph->deleteConnection(src_to_b);
+    expectSameAsFullAnalysis();
+    ASSERT_NE(graph->getComponent(src->getUUID()), graph->getComponent(b->getUUID()));
+    ASSERT_EQ(0, graph->getDepth(b->getUUID()));
+}
+
+TEST_F(GraphAnalysisTest, ConnectionsCanBeAddedOneAtATime)
+{
+    const int connections = 10000;
+
+    std::vector<NodeFacadeImplementationPtr> nodes;
+    nodes.reserve(connections + 1);
+
+    graph->beginTransaction();
+    for (int i = 0; i <= connections; ++i) {
+        nodes.push_back(makeNode("StaticMultiplier", std::string("n") + std::to_string(i)));
+    }
+    graph->finalizeTransaction();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < connections; ++i) {
+        main_graph_facade->connect(nodes[i], "output", nodes[i + 1], "input");
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    RecordProperty("add_connections_ms", static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()));
+
+    int component = graph->getComponent(nodes.front()->getUUID());
+    for (int i = 0; i <= connections; ++i) {
+        ASSERT_EQ(i, graph->getDepth(nodes[i]->getUUID()));
+        ASSERT_EQ(component, graph->getComponent(nodes[i]->getUUID()));
+    }
+
+    expectSameAsFullAnalysis();
+}
+
+}  // namespace csapex
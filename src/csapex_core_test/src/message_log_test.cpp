@@ -0,0 +1,142 @@
+#include <csapex_testing/csapex_test_case.h>
+
+#include <csapex/model/generic_state.h>
+#include <csapex/msg/message_log_provider.h>
+#include <csapex/param/parameter.h>
+#include <csapex/serialization/message_log.h>
+#include <csapex_testing/mockup_msgs.h>
+
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <limits>
+
+using namespace csapex;
+using namespace connection_types;
+
+class MessageLogTest : public CsApexTestCase
+{
+protected:
+    MessageLogTest() : path((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("csapex_%%%%%%.apexlog")).string())
+    {
+    }
+
+    ~MessageLogTest()
+    {
+        std::remove(path.c_str());
+        std::remove((path + ".idx").c_str());
+    }
+
+    void record(int count)
+    {
+        MessageLogWriter writer(path);
+        for (int i = 0; i < count; ++i) {
+            MockMessage msg;
+            msg.value.payload = std::to_string(i);
+            writer.write(msg, i * 1000);
+        }
+        writer.flush();
+    }
+
+    std::string payload(const TokenDataConstPtr& data)
+    {
+        auto msg = std::dynamic_pointer_cast<MockMessage const>(data);
+        return msg ? msg->value.payload : "";
+    }
+
+    std::string path;
+};
+
+TEST_F(MessageLogTest, RecordedMessagesCanBeReadInAnyOrder)
+{
+    record(10);
+
+    MessageLogReader reader(path);
+    ASSERT_EQ(10u, reader.count());
+
+    EXPECT_EQ("7", payload(reader.read(7)));
+    EXPECT_EQ("2", payload(reader.read(2)));
+    EXPECT_EQ(3000, reader.getStamp(3));
+    EXPECT_EQ(5u, reader.find(4500));
+}
+
+TEST_F(MessageLogTest, LogsCanBeAppended)
+{
+    record(3);
+    record(2);
+
+    MessageLogReader reader(path);
+    ASSERT_EQ(5u, reader.count());
+    EXPECT_EQ("1", payload(reader.read(4)));
+}
+
+TEST_F(MessageLogTest, MissingIndexIsRebuilt)
+{
+    record(4);
+    std::remove((path + ".idx").c_str());
+
+    MessageLogReader reader(path);
+    ASSERT_EQ(4u, reader.count());
+    EXPECT_EQ("3", payload(reader.read(3)));
+}
+
+TEST_F(MessageLogTest, TruncatedRecordIsIgnored)
+{
+    record(4);
+    boost::filesystem::resize_file(path, boost::filesystem::file_size(path) - 1);
+
+    MessageLogReader reader(path);
+    EXPECT_EQ(3u, reader.count());
+}
+
+TEST_F(MessageLogTest, AppendingCutsOffATruncatedRecord)
+{
+    record(4);
+    boost::filesystem::resize_file(path, boost::filesystem::file_size(path) - 1);
+    record(2);
+
+    MessageLogReader reader(path);
+    ASSERT_EQ(5u, reader.count());
+
+    std::vector<std::string> expected{ "0", "1", "2", "0", "1" };
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], payload(reader.read(i)));
+    }
+    EXPECT_EQ(1000, reader.getStamp(4));
+}
+
+TEST_F(MessageLogTest, AppendingWriterKnowsTheLastStamp)
+{
+    {
+        MessageLogWriter writer(path);
+        EXPECT_EQ(std::numeric_limits<int64_t>::min(), writer.getLastStamp());
+    }
+
+    record(3);
+
+    MessageLogWriter writer(path);
+    EXPECT_EQ(2000, writer.getLastStamp());
+}
+
+TEST_F(MessageLogTest, ProviderPlaysBackAsFastAsPossible)
+{
+    record(5);
+
+    MessageLogProvider provider;
+    provider.load(path);
+    provider.getParameters();
+
+    GenericStatePtr state = provider.getState();
+    (*state)["playback/original_timing"].set(false);
+    provider.setParameterState(state);
+
+    std::vector<std::string> payloads;
+    while (provider.hasNext()) {
+        payloads.push_back(payload(provider.next(0)));
+    }
+    std::vector<std::string> expected{ "0", "1", "2", "3", "4" };
+    EXPECT_EQ(expected, payloads);
+
+    provider.seek(3);
+    ASSERT_TRUE(provider.hasNext());
+    EXPECT_EQ("3", payload(provider.next(0)));
+}
@@ -8,6 +8,7 @@
 #include <csapex/model/node_state.h>
 #include <csapex/model/direct_node_worker.h>
 #include <csapex/model/subprocess_node_worker.h>
+#include <csapex/model/subprocess_pool.h>
 #include <csapex/msg/direct_connection.h>
 #include <csapex/msg/generic_value_message.hpp>
 #include <csapex/signal/event.h>
@@ -25,6 +26,8 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <csignal>
+#include <thread>
 
 #include <csapex_testing/stepping_test.h>
 
@@ -34,7 +37,7 @@ class NodeWorkerTest : public SteppingTest
 {
 };
 
-void runSyncTest(NodeFacadeImplementationPtr node_facade, int value = 23)
+void runSyncTest(NodeFacadeImplementationPtr node_facade, int value = 23, int factor = 4)
 {
     Node& node = *node_facade->getNode();
     NodeHandle& nh = *node_facade->getNodeHandle();
@@ -47,7 +50,7 @@ void runSyncTest(NodeFacadeImplementationPtr node_facade, int value = 23)
 
     // create a temporary output and connect it to the input
     OutputPtr tmp_out = std::make_shared<StaticOutput>(UUIDProvider::makeUUID_without_parent("tmp_out"));
-    InputPtr input = nh.getInput(UUIDProvider::makeUUID_without_parent("StaticMultiplier4:|:in_0"));
+    InputPtr input = nh.getInput(UUIDProvider::makeUUID_without_parent(nh.getUUID().getFullName() + ":|:in_0"));
     ASSERT_NE(nullptr, input);
     ConnectionPtr connection = DirectConnection::connect(tmp_out, input);
 
@@ -63,12 +66,12 @@ void runSyncTest(NodeFacadeImplementationPtr node_facade, int value = 23)
     ASSERT_TRUE(nh.getInputTransition()->isEnabled());
     ASSERT_TRUE(nh.getOutputTransition()->isEnabled());
 
-    // no inputs are sent now -> node should multiply the input by 4
+    // no inputs are sent now -> node should multiply the input by its factor
     ASSERT_FALSE(node_facade->isProcessing());
     ASSERT_TRUE(node_facade->startProcessingMessages());
 
     // commit the messages produced by the node
-    OutputPtr output = nh.getOutput(UUIDProvider::makeUUID_without_parent("StaticMultiplier4:|:out_0"));
+    OutputPtr output = nh.getOutput(UUIDProvider::makeUUID_without_parent(nh.getUUID().getFullName() + ":|:out_0"));
     ASSERT_NE(nullptr, output);
 
     // view outputs
@@ -79,7 +82,7 @@ void runSyncTest(NodeFacadeImplementationPtr node_facade, int value = 23)
     auto msg_out = std::dynamic_pointer_cast<connection_types::GenericValueMessage<int> const>(data_out);
     ASSERT_NE(nullptr, msg_out);
 
-    ASSERT_EQ(value * 4, msg_out->value);
+    ASSERT_EQ(value * factor, msg_out->value);
 
     input->removeConnection(tmp_out.get());
 }
@@ -138,6 +141,65 @@ TEST_F(NodeWorkerTest, SubprocessNodeWorkerWorks)
     runSyncTest(times_4, 42);
 }
 
+TEST_F(NodeWorkerTest, SubprocessNodeWorkersCanShareAProcess)
+{
+    SubprocessPool& pool = SubprocessPool::instance();
+
+    // restore the process wide configuration even if an assertion fails
+    struct PoolConfiguration
+    {
+        PoolConfiguration(SubprocessPool& pool) : pool(pool), worker_count(pool.getWorkerCount())
+        {
+        }
+        ~PoolConfiguration()
+        {
+            pool.setGranularity(IsolationGranularity::NODE);
+            pool.setWorkerCount(worker_count);
+            pool.setNodeFactory(nullptr);
+        }
+        SubprocessPool& pool;
+        std::size_t worker_count;
+    } configuration(pool);
+
+    pool.setGranularity(IsolationGranularity::SHARED);
+    pool.setWorkerCount(1);
+    pool.setNodeFactory(node_factory);
+
+    auto makeIsolatedNode = [this](const std::string& type) {
+        NodeStatePtr state = std::make_shared<NodeState>(nullptr);
+        state->setExecutionType(ExecutionType::SUBPROCESS);
+        return factory.makeNode(type, UUIDProvider::makeUUID_without_parent(type), graph, state);
+    };
+
+    NodeFacadeImplementationPtr times_4 = makeIsolatedNode("StaticMultiplier4");
+    ASSERT_NE(nullptr, times_4);
+    std::shared_ptr<SubprocessHost> host = pool.acquire(*times_4->getNodeHandle());
+
+    runSyncTest(times_4, 23, 4);
+    ASSERT_TRUE(host->isRunning());
+
+    // a node that is added later is constructed in the running process
+    NodeFacadeImplementationPtr times_7 = makeIsolatedNode("StaticMultiplier7");
+    ASSERT_NE(nullptr, times_7);
+    EXPECT_EQ(host, pool.acquire(*times_7->getNodeHandle()));
+    EXPECT_EQ(2u, host->getNodeCount());
+
+    runSyncTest(times_7, 5, 7);
+    runSyncTest(times_4, 42, 4);
+    EXPECT_EQ(0, host->getRestartCount());
+
+    // a crashed process is restarted with all of its nodes
+    ASSERT_EQ(0, kill(host->getChildPid(), SIGTERM));
+    for (int i = 0; i < 500 && host->isRunning(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_FALSE(host->isRunning());
+
+    runSyncTest(times_7, 6, 7);
+    runSyncTest(times_4, 7, 4);
+    EXPECT_EQ(1, host->getRestartCount());
+}
+
 TEST_F(NodeWorkerTest, NodeWorkerCanBeSwappedOnTheFly)
 {
     NodeFacadeImplementationPtr times_4 = factory.makeNode("StaticMultiplier4", UUIDProvider::makeUUID_without_parent("StaticMultiplier4"), graph);
@@ -0,0 +1,113 @@
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/token.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/output.h>
+#include <csapex/msg/output_tap.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace csapex
+{
+class OutputTapTest : public SteppingTest
+{
+protected:
+    void waitForTap(const OutputTap& tap, long expected)
+    {
+        for (int i = 0; i < 200 && tap.getDeliveredCount() + tap.getDroppedCount() < expected; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+};
+
+TEST_F(OutputTapTest, FrequencyIsLimited)
+{
+    std::atomic<int> received(0);
+    OutputTap tap([&received](const TokenConstPtr&) { ++received; }, 1.0);
+
+    const int tokens = 50;
+    for (int i = 0; i < tokens; ++i) {
+        tap.offer(connection_types::makeEmptyToken<connection_types::GenericValueMessage<int>>());
+    }
+
+    waitForTap(tap, tokens);
+
+    EXPECT_EQ(1, received);
+    EXPECT_EQ(1, tap.getDeliveredCount());
+    EXPECT_EQ(tokens - 1, tap.getDroppedCount());
+}
+
+TEST_F(OutputTapTest, SlowTapDoesNotBlockTheProducer)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr sink_p = makeNode("MockupSink", "sink");
+    main_graph_facade->connect(src, "output", sink_p, "input");
+
+    std::shared_ptr<MockupSink> sink = std::dynamic_pointer_cast<MockupSink>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    std::mutex mutex;
+    std::condition_variable released_changed;
+    bool released = false;
+    int last_value = -1;
+
+    OutputTapPtr tap = std::make_shared<OutputTap>(
+        [&](const TokenConstPtr& token) {
+            std::unique_lock<std::mutex> lock(mutex);
+            released_changed.wait(lock, [&]() { return released; });
+
+            auto value = std::dynamic_pointer_cast<connection_types::GenericValueMessage<int> const>(token->getTokenData());
+            ASSERT_NE(nullptr, value);
+            last_value = value->value;
+        },
+        0.0);
+
+    // the source also has an output for its value parameter, pick the connected one
+    OutputPtr output;
+    for (const OutputPtr& candidate : src->getNodeHandle()->getExternalOutputs()) {
+        if (candidate->getLabel() == "output") {
+            output = candidate;
+        }
+    }
+    ASSERT_NE(nullptr, output);
+    ASSERT_TRUE(output->isConnected());
+    ASSERT_TRUE(output->addTap(tap));
+
+    executor.start();
+
+    // the tap is stuck in its callback, the graph keeps running regardless
+    const int steps = 20;
+    for (int iter = 0; iter < steps; ++iter) {
+        ASSERT_NO_FATAL_FAILURE(step());
+        ASSERT_EQ(iter, sink->getValue());
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        released = true;
+    }
+    released_changed.notify_all();
+
+    waitForTap(*tap, steps);
+
+    // at most the token in flight and the latest one are delivered, everything else is dropped
+    EXPECT_GE(tap->getDeliveredCount(), 1);
+    EXPECT_LE(tap->getDeliveredCount(), 2);
+    EXPECT_EQ(steps, tap->getDeliveredCount() + tap->getDroppedCount());
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_EQ(steps - 1, last_value);
+    }
+
+    output->removeTap(tap);
+    EXPECT_FALSE(output->hasTaps());
+}
+
+}  // namespace csapex
@@ -0,0 +1,161 @@
+#include <csapex/factory/node_wrapper.hpp>
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/token.h>
+#include <csapex/msg/input.h>
+#include <csapex/msg/output.h>
+#include <csapex/param/parameter_factory.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+namespace csapex
+{
+class MockupConstant
+{
+public:
+    void setup(NodeModifier& /*node_modifier*/)
+    {
+    }
+
+    void setupParameters(Parameterizable& parameters)
+    {
+        parameters.addParameter(param::ParameterFactory::declareValue<int>("constant", 42));
+    }
+
+    void process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+    {
+    }
+};
+
+class ParameterPortTest : public SteppingTest
+{
+protected:
+    ParameterPortTest()
+    {
+        factory.registerNodeType(std::make_shared<NodeConstructor>("MockupConstant", []() { return NodePtr(new NodeWrapper<MockupConstant>()); }));
+    }
+
+    NodeHandle::ParameterPortPtr getParameterPort(const NodeFacadeImplementationPtr& nf, const std::string& name)
+    {
+        for (const NodeHandle::ParameterPortPtr& port : nf->getNodeHandle()->getParameterPorts()) {
+            if (port->parameter->name() == name) {
+                return port;
+            }
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(ParameterPortTest, ChangedParametersArePublished)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupSource", "src");
+    NodeFacadeImplementationPtr sink_p = makeNode("MockupSink", "sink");
+
+    OutputPtr parameter_output = src->getNodeHandle()->getParameterOutput("value").lock();
+    ASSERT_NE(nullptr, parameter_output);
+    main_graph_facade->connect(parameter_output->getUUID(), sink_p, "input");
+
+    std::shared_ptr<MockupSink> sink = std::dynamic_pointer_cast<MockupSink>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    executor.start();
+
+    // the source increments its parameter in every iteration
+    for (int iter = 1; iter <= 5; ++iter) {
+        ASSERT_NO_FATAL_FAILURE(step());
+        ASSERT_EQ(iter, sink->getValue());
+    }
+}
+
+TEST_F(ParameterPortTest, UnchangedParametersReuseTheirMessage)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupConstant", "src");
+    NodeFacadeImplementationPtr sink_p = makeNode("MockupSink", "sink");
+
+    OutputPtr parameter_output = src->getNodeHandle()->getParameterOutput("constant").lock();
+    ASSERT_NE(nullptr, parameter_output);
+    main_graph_facade->connect(parameter_output->getUUID(), sink_p, "input");
+
+    std::shared_ptr<MockupSink> sink = std::dynamic_pointer_cast<MockupSink>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    executor.start();
+
+    ASSERT_NO_FATAL_FAILURE(step());
+    ASSERT_EQ(42, sink->getValue());
+    TokenDataConstPtr first = parameter_output->getToken()->getTokenData();
+
+    ASSERT_NO_FATAL_FAILURE(step());
+    ASSERT_EQ(42, sink->getValue());
+    EXPECT_EQ(first, parameter_output->getToken()->getTokenData());
+
+    src->getNode()->getParameter("constant")->set<int>(23);
+
+    ASSERT_NO_FATAL_FAILURE(step());
+    ASSERT_EQ(23, sink->getValue());
+    EXPECT_NE(first, parameter_output->getToken()->getTokenData());
+}
+
+TEST_F(ParameterPortTest, ReceivedValuesAreOnlyAppliedWhenSomethingChanged)
+{
+    NodeFacadeImplementationPtr src = makeNode("MockupConstant", "src");
+    NodeFacadeImplementationPtr dst = makeNode("MockupConstant", "dst");
+
+    OutputPtr parameter_output = src->getNodeHandle()->getParameterOutput("constant").lock();
+    InputPtr parameter_input = dst->getNodeHandle()->getParameterInput("constant").lock();
+    ASSERT_NE(nullptr, parameter_output);
+    ASSERT_NE(nullptr, parameter_input);
+    main_graph_facade->connect(parameter_output->getUUID(), parameter_input->getUUID());
+
+    NodeHandle::ParameterPortPtr port = getParameterPort(dst, "constant");
+    ASSERT_NE(nullptr, port);
+
+    param::ParameterPtr src_param = src->getNode()->getParameter("constant");
+    param::ParameterPtr dst_param = dst->getNode()->getParameter("constant");
+    src_param->set<int>(7);
+
+    executor.start();
+
+    ASSERT_NO_FATAL_FAILURE(step());
+    ASSERT_EQ(7, dst_param->as<int>());
+    TokenDataConstPtr applied = port->applied;
+    ASSERT_NE(nullptr, applied);
+
+    // changing the parameter locally applies the same message again
+    dst_param->set<int>(5);
+    ASSERT_NO_FATAL_FAILURE(step());
+    EXPECT_EQ(7, dst_param->as<int>());
+    EXPECT_EQ(applied, port->applied);
+
+    // the same message with an unchanged parameter is skipped, the value is not read back from the input
+    dst_param->set<int>(5);
+    port->apply_pending = false;
+    ASSERT_NO_FATAL_FAILURE(step());
+    EXPECT_EQ(5, dst_param->as<int>());
+    EXPECT_EQ(applied, port->applied);
+
+    // a new message is applied again
+    src_param->set<int>(3);
+    ASSERT_NO_FATAL_FAILURE(step());
+    EXPECT_EQ(3, dst_param->as<int>());
+    EXPECT_NE(applied, port->applied);
+}
+
+TEST_F(ParameterPortTest, UnconnectedInputsAreSkipped)
+{
+    NodeFacadeImplementationPtr dst = makeNode("MockupConstant", "dst");
+
+    NodeHandle::ParameterPortPtr port = getParameterPort(dst, "constant");
+    ASSERT_NE(nullptr, port);
+
+    executor.start();
+
+    ASSERT_NO_FATAL_FAILURE(step());
+    EXPECT_EQ(nullptr, port->applied);
+    EXPECT_EQ(42, dst->getNode()->readParameter<int>("constant"));
+}
+
+}  // namespace csapex
@@ -0,0 +1,204 @@
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/io/remote_subgraph.h>
+#include <csapex/io/session_client.h>
+#include <csapex/io/tcp_server.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/node_constructing_test.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace csapex
+{
+/**
+ * @brief RemoteSubgraphTest runs the server in a second process and talks to it via a loopback connection
+ */
+class RemoteSubgraphTest : public NodeConstructingTest
+{
+protected:
+    RemoteSubgraphTest() : port(42123 + 1 + getpid() % 1000), server(-1)
+    {
+    }
+
+    void TearDown() override
+    {
+        stopServer();
+
+        NodeConstructingTest::TearDown();
+    }
+
+    void startServer()
+    {
+        server = fork();
+        ASSERT_NE(-1, server);
+        if (server == 0) {
+            serve();
+            _exit(0);
+        }
+    }
+
+    void stopServer()
+    {
+        if (server > 0) {
+            kill(server, SIGKILL);
+            waitpid(server, nullptr, 0);
+            server = -1;
+        }
+    }
+
+    SubgraphBridgePtr connect()
+    {
+        // the server needs some time to open its port
+        auto start = std::chrono::steady_clock::now();
+        while (true) {
+            try {
+                return SubgraphBridgeFactory::instance().makeBridge("localhost", port, AUUID(UUIDProvider::makeUUID_without_parent("remote")));
+            } catch (const std::runtime_error& e) {
+                if (std::chrono::steady_clock::now() - start > std::chrono::seconds(10)) {
+                    throw;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+        }
+    }
+
+    SubgraphMessages makeInputs(int value)
+    {
+        SubgraphMessages inputs;
+        inputs["value"] = std::make_shared<connection_types::GenericValueMessage<int>>(value);
+        return inputs;
+    }
+
+private:
+    /**
+     * @brief serve runs the subgraph "remote" in the child process, it doubles the values it receives
+     */
+    void serve()
+    {
+        SettingsImplementation settings(false);
+        settings.set("port", port);
+
+        CsApexCore core(settings, eh, nullptr, node_factory, nullptr);
+        core.init();
+
+        GraphFacadeImplementationPtr root = core.getRoot();
+        UUID uuid = UUIDProvider::makeUUID_without_parent("remote");
+        NodeFacadeImplementationPtr subgraph_facade = factory.makeNode("csapex::Graph", uuid, root->getLocalGraph());
+        root->addNode(subgraph_facade);
+        SubgraphNodePtr subgraph = std::dynamic_pointer_cast<SubgraphNode>(subgraph_facade->getNode());
+        apex_assert_hard(subgraph);
+
+        auto type = makeEmpty<connection_types::GenericValueMessage<int> >();
+        RelayMapping in_map = subgraph->addForwardingInput(type, "value", false);
+        RelayMapping out_map = subgraph->addForwardingOutput(type, "value");
+
+        GraphFacadeImplementationPtr nested = root->getLocalSubGraph(uuid);
+        NodeFacadeImplementationPtr times_2 = factory.makeNode("StaticMultiplier", UUIDProvider::makeUUID_without_parent("times_2"), subgraph->getLocalGraph());
+        nested->addNode(times_2);
+        nested->connect(in_map.internal, times_2, "input");
+        nested->connect(times_2, "output", out_map.internal);
+
+        core.setServerFactory([&core]() { return std::make_shared<TcpServer>(core); });
+        apex_assert_hard(core.startServer());
+        core.startMainLoop();
+
+        // the parent ends this process
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+
+protected:
+    int port;
+    pid_t server;
+};
+
+TEST_F(RemoteSubgraphTest, PassesAreProcessedByTheServer)
+{
+    ASSERT_NO_FATAL_FAILURE(startServer());
+    SubgraphBridgePtr bridge = connect();
+
+    for (int value = 0; value < 5; ++value) {
+        std::promise<int> result;
+        bridge->process(makeInputs(value),
+                        [&result](const SubgraphMessages& outputs) {
+                            auto msg = std::dynamic_pointer_cast<connection_types::GenericValueMessage<int> const>(outputs.at("value"));
+                            result.set_value(msg ? msg->value : -1);
+                        },
+                        [&result](const std::string& error) { result.set_value(-1); });
+
+        std::future<int> future = result.get_future();
+        ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(10)));
+        EXPECT_EQ(2 * value, future.get());
+    }
+}
+
+TEST_F(RemoteSubgraphTest, PassesFailWhenTheServerIsGone)
+{
+    ASSERT_NO_FATAL_FAILURE(startServer());
+    SubgraphBridgePtr bridge = connect();
+
+    stopServer();
+
+    // a pass that was sent before the session ended fails as well as every later one
+    for (int pass = 0; pass < 2; ++pass) {
+        std::promise<std::string> error;
+        bridge->process(makeInputs(1), [&error](const SubgraphMessages&) { error.set_value(""); }, [&error](const std::string& e) { error.set_value(e); });
+
+        std::future<std::string> future = error.get_future();
+        ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(10)));
+        EXPECT_NE("", future.get());
+    }
+}
+
+TEST_F(RemoteSubgraphTest, PassesFailWhenTheServerDoesNotAnswerInTime)
+{
+    ASSERT_NO_FATAL_FAILURE(startServer());
+    // only used to wait for the server
+    connect().reset();
+
+    SessionPtr session = std::make_shared<SessionClient>("localhost", port);
+    session->start();
+    std::thread spinner([session]() { session->run(); });
+    while (!session->isRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::unique_ptr<RemoteSubgraphBridge> bridge(new RemoteSubgraphBridge(session, AUUID(UUIDProvider::makeUUID_without_parent("remote")), 1, std::chrono::milliseconds(200)));
+
+    // a stopped server keeps the connection open, but never answers
+    kill(server, SIGSTOP);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        std::promise<std::string> error;
+        bridge->process(makeInputs(1), [&error](const SubgraphMessages&) { error.set_value(""); }, [&error](const std::string& e) { error.set_value(e); });
+
+        std::future<std::string> future = error.get_future();
+        ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(10)));
+        EXPECT_NE("", future.get());
+    }
+    EXPECT_EQ(0u, bridge->getInFlightCount());
+
+    // the bridge would wait for the stopped server to confirm the end of the session
+    stopServer();
+    while (session->isRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    bridge.reset();
+
+    session->shutdown();
+    spinner.join();
+}
+
+}  // namespace csapex
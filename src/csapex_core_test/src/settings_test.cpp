@@ -0,0 +1,74 @@
+#include <csapex_testing/csapex_test_case.h>
+
+#include <csapex/core/settings/settings_impl.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace csapex;
+
+class SettingsTest : public CsApexTestCase
+{
+protected:
+    SettingsTest() : path((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("csapex_settings_%%%%%%")).string())
+    {
+    }
+
+    ~SettingsTest()
+    {
+        boost::filesystem::remove(path);
+    }
+
+    std::string path;
+};
+
+TEST_F(SettingsTest, PersistentSettingsAreSavedInTheBackground)
+{
+    {
+        SettingsImplementation settings(false, path);
+        for (int i = 0; i < 100; ++i) {
+            settings.setPersistent("value", i);
+            settings.savePersistent();
+        }
+        settings.set("temporary", std::string("not saved"));
+        settings.flushPersistent();
+    }
+
+    SettingsImplementation loaded_impl(true, path);
+    Settings& loaded = loaded_impl;
+    EXPECT_EQ(99, loaded.get<int>("value"));
+    EXPECT_FALSE(loaded.knows("temporary"));
+}
+
+TEST_F(SettingsTest, PendingSavesAreWrittenOnDestruction)
+{
+    {
+        SettingsImplementation settings(false, path);
+        settings.setPersistent("name", std::string("foo"));
+        settings.savePersistent();
+    }
+
+    SettingsImplementation loaded_impl(true, path);
+    Settings& loaded = loaded_impl;
+    EXPECT_EQ("foo", loaded.get<std::string>("name"));
+}
+
+TEST_F(SettingsTest, UnchangedSettingsAreNotRewritten)
+{
+    SettingsImplementation settings(false, path);
+    settings.setPersistent("value", 1);
+    settings.savePersistent();
+    settings.flushPersistent();
+    ASSERT_TRUE(boost::filesystem::exists(path));
+
+    boost::filesystem::remove(path);
+
+    settings.set("temporary", 2);
+    settings.savePersistent();
+    settings.flushPersistent();
+    EXPECT_FALSE(boost::filesystem::exists(path));
+
+    settings.setPersistent("value", 3);
+    settings.savePersistent();
+    settings.flushPersistent();
+    EXPECT_TRUE(boost::filesystem::exists(path));
+}
@@ -0,0 +1,94 @@
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/scheduling/thread_placement.h>
+#include <csapex/scheduling/thread_pool.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+#include <cstdlib>
+#include <fstream>
+
+namespace csapex
+{
+class ThreadPlacementTest : public SteppingTest
+{
+protected:
+    NodeFacadeImplementationPtr makeNode(const std::string& type, const std::string& name)
+    {
+        NodeFacadeImplementationPtr node = SteppingTest::makeNode(type, name);
+        executor.createNewGroupFor(node->getNodeRunner().get(), name);
+        return node;
+    }
+
+    // two sockets with three cpus each
+    CpuTopology makeDualSocketTopology()
+    {
+        char dir_template[] = "/tmp/csapex_sysfs_XXXXXX";
+        std::string root = mkdtemp(dir_template);
+
+        write(root, "cpu/present", "0-5");
+        write(root, "node/online", "0-1");
+        write(root, "node/node0/cpulist", "0-2");
+        write(root, "node/node1/cpulist", "3-5");
+
+        CpuTopology topology = CpuTopology::fromSysfs(root);
+        std::system(("rm -rf " + root).c_str());
+        return topology;
+    }
+
+    void write(const std::string& root, const std::string& path, const std::string& content)
+    {
+        std::string full = root + "/" + path;
+        std::system(("mkdir -p " + full.substr(0, full.find_last_of('/'))).c_str());
+        std::ofstream out(full);
+        out << content << '\n';
+    }
+
+    int domainOf(const PlacementReport& report, const std::string& name)
+    {
+        for (const GroupPlacement& group : report.groups) {
+            if (group.name == name) {
+                return group.domain;
+            }
+        }
+        return -2;
+    }
+};
+
+TEST_F(ThreadPlacementTest, ConnectedGroupsShareADomain)
+{
+    NodeFacadeImplementationPtr src_a = makeNode("MockupSource", "src_a");
+    NodeFacadeImplementationPtr times_2 = makeNode("StaticMultiplier", "times_2");
+    NodeFacadeImplementationPtr sink_a = makeNode("MockupSink", "sink_a");
+    main_graph_facade->connect(src_a, "output", times_2, "input");
+    main_graph_facade->connect(times_2, "output", sink_a, "input");
+
+    NodeFacadeImplementationPtr src_b = makeNode("MockupSource", "src_b");
+    NodeFacadeImplementationPtr sink_b = makeNode("MockupSink", "sink_b");
+    main_graph_facade->connect(src_b, "output", sink_b, "input");
+
+    CpuTopology topology = makeDualSocketTopology();
+    ASSERT_EQ(2u, topology.getDomains().size());
+
+    ThreadPlacement placement(executor, main_graph_facade, topology);
+    PlacementReport report = placement.place();
+
+    ASSERT_EQ(5u, report.groups.size());
+
+    int domain_a = domainOf(report, "src_a");
+    EXPECT_GE(domain_a, 0);
+    EXPECT_EQ(domain_a, domainOf(report, "times_2"));
+    EXPECT_EQ(domain_a, domainOf(report, "sink_a"));
+
+    int domain_b = domainOf(report, "src_b");
+    EXPECT_GE(domain_b, 0);
+    EXPECT_NE(domain_a, domain_b);
+    EXPECT_EQ(domain_b, domainOf(report, "sink_b"));
+
+    EXPECT_EQ(0.0, report.cross_numa_traffic);
+}
+
+}  // namespace csapex
@@ -0,0 +1,54 @@
+#include <csapex_testing/csapex_test_case.h>
+
+#include <csapex/model/token.h>
+#include <csapex/msg/any_message.h>
+#include <csapex/msg/end_of_program_message.h>
+#include <csapex/msg/end_of_sequence_message.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/no_message.h>
+#include <csapex/msg/token_traits.h>
+
+using namespace csapex;
+using namespace connection_types;
+
+class TokenKindTest : public CsApexTestCase
+{
+};
+
+TEST_F(TokenKindTest, KindsMatchTheMessageHierarchy)
+{
+    TokenDataConstPtr value = makeEmpty<GenericValueMessage<int>>();
+    EXPECT_FALSE(value->isMarker());
+    EXPECT_FALSE(value->isNoMessage());
+    EXPECT_FALSE(value->isAny());
+
+    TokenDataConstPtr no_message = makeEmpty<NoMessage>();
+    EXPECT_TRUE(no_message->isMarker());
+    EXPECT_TRUE(no_message->isNoMessage());
+    EXPECT_FALSE(no_message->isEndOfSequence());
+
+    TokenDataConstPtr end_of_sequence = makeEmpty<EndOfSequenceMessage>();
+    EXPECT_TRUE(end_of_sequence->isMarker());
+    EXPECT_TRUE(end_of_sequence->isEndOfSequence());
+    EXPECT_FALSE(end_of_sequence->isEndOfProgram());
+    EXPECT_FALSE(end_of_sequence->isNoMessage());
+
+    TokenDataConstPtr end_of_program = makeEmpty<EndOfProgramMessage>();
+    EXPECT_TRUE(end_of_program->isMarker());
+    EXPECT_TRUE(end_of_program->isEndOfSequence());
+    EXPECT_TRUE(end_of_program->isEndOfProgram());
+
+    TokenDataConstPtr any = makeEmpty<AnyMessage>();
+    EXPECT_TRUE(any->isAny());
+    EXPECT_FALSE(any->isMarker());
+}
+
+TEST_F(TokenKindTest, KindsSurviveCloning)
+{
+    TokenDataConstPtr end_of_program = makeEmpty<EndOfProgramMessage>();
+    TokenDataConstPtr clone = end_of_program->cloneAs<TokenData>();
+    EXPECT_EQ(end_of_program->getKind(), clone->getKind());
+
+    TokenDataConstPtr type = makeEmpty<AnyMessage>()->toType();
+    EXPECT_TRUE(type->isAny());
+}
@@ -0,0 +1,105 @@
+#include <csapex/model/graph_facade.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/token_latency_statistics.h>
+#include <csapex/model/token_provenance.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/semantic_version.h>
+
+#include <csapex_testing/mockup_nodes.h>
+#include <csapex_testing/stepping_test.h>
+
+namespace csapex
+{
+class TokenLatencyTest : public SteppingTest
+{
+protected:
+    void SetUp() override
+    {
+        SteppingTest::SetUp();
+        TokenProvenance::setTracingEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        TokenProvenance::setTracingEnabled(false);
+        SteppingTest::TearDown();
+    }
+};
+
+TEST_F(TokenLatencyTest, HistogramApproximatesPercentiles)
+{
+    TokenLatencyStatistics statistics;
+
+    for (long latency = 1; latency <= 1000; ++latency) {
+        TokenProvenance provenance;
+        provenance.hops.emplace_back(UUIDProvider::makeUUID_without_parent("src"));
+        provenance.hops.back().process_start = 1000;
+        provenance.hops.emplace_back(UUIDProvider::makeUUID_without_parent("sink"));
+        provenance.hops.back().process_end = 1000 + latency;
+        statistics.record(provenance);
+    }
+
+    ASSERT_EQ(1u, statistics.getPaths().size());
+    const TokenLatencyStatistics::Path& path = statistics.getPaths().begin()->second;
+    ASSERT_EQ(2u, path.nodes.size());
+    EXPECT_EQ(1000u, path.count);
+    EXPECT_EQ(1000, path.latency_max);
+    EXPECT_DOUBLE_EQ(500.5, path.getMeanLatency());
+
+    // buckets are powers of two, so the percentiles are exact up to a factor of two
+    EXPECT_LE(500, path.getPercentile(0.5));
+    EXPECT_GT(1000, path.getPercentile(0.5));
+    EXPECT_EQ(1000, path.getPercentile(1.0));
+
+    SerializationBuffer buffer;
+    SemanticVersion version;
+    statistics.serialize(buffer, version);
+
+    TokenLatencyStatistics copy;
+    buffer.rewind();
+    copy.deserialize(buffer, version);
+
+    ASSERT_EQ(1u, copy.getPaths().size());
+    EXPECT_EQ(path.nodes, copy.getPaths().begin()->second.nodes);
+    EXPECT_EQ(path.histogram, copy.getPaths().begin()->second.histogram);
+}
+
+TEST_F(TokenLatencyTest, LatenciesAreRecordedPerPath)
+{
+    NodeFacadeImplementationPtr src = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("src"), graph);
+    main_graph_facade->addNode(src);
+
+    NodeFacadeImplementationPtr times = factory.makeNode("StaticMultiplier", UUIDProvider::makeUUID_without_parent("times"), graph);
+    main_graph_facade->addNode(times);
+
+    NodeFacadeImplementationPtr sink = factory.makeNode("MockupSink", UUIDProvider::makeUUID_without_parent("sink"), graph);
+    main_graph_facade->addNode(sink);
+
+    main_graph_facade->connect(src, "output", times, "input");
+    main_graph_facade->connect(times, "output", sink, "input");
+
+    executor.start();
+
+    const int steps = 10;
+    for (int i = 0; i < steps; ++i) {
+        ASSERT_NO_FATAL_FAILURE(step());
+    }
+
+    TokenLatencyStatistics sink_statistics = sink->getTokenLatencyStatistics();
+    ASSERT_EQ(1u, sink_statistics.getPaths().size());
+
+    const TokenLatencyStatistics::Path& path = sink_statistics.getPaths().begin()->second;
+    ASSERT_EQ(3u, path.nodes.size());
+    EXPECT_EQ(src->getUUID().getFullName(), path.nodes[0]);
+    EXPECT_EQ(times->getUUID().getFullName(), path.nodes[1]);
+    EXPECT_EQ(sink->getUUID().getFullName(), path.nodes[2]);
+    EXPECT_EQ(static_cast<uint64_t>(steps), path.count);
+    EXPECT_LE(path.queued_sum + path.processing_sum, path.latency_sum);
+
+    TokenLatencyStatistics times_statistics = times->getTokenLatencyStatistics();
+    ASSERT_EQ(1u, times_statistics.getPaths().size());
+    EXPECT_EQ(2u, times_statistics.getPaths().begin()->second.nodes.size());
+}
+
+}  // namespace csapex
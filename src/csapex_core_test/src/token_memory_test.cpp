@@ -0,0 +1,119 @@
+#include <csapex/model/token.h>
+#include <csapex/model/token_memory.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/direct_connection.h>
+#include <csapex/msg/input.h>
+#include <csapex/msg/io.h>
+#include <csapex/msg/static_output.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/semantic_version.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+namespace csapex
+{
+class TokenMemoryTest : public CsApexTestCase
+{
+protected:
+    void SetUp() override
+    {
+        CsApexTestCase::SetUp();
+        TokenMemoryTracker::setAccountingEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        TokenMemoryTracker::setAccountingEnabled(false);
+        CsApexTestCase::TearDown();
+    }
+
+    TokenPtr makeToken(const std::string& value)
+    {
+        return std::make_shared<Token>(std::make_shared<connection_types::GenericValueMessage<std::string>>(value));
+    }
+};
+
+TEST_F(TokenMemoryTest, ByteSizeIncludesOwnedBuffers)
+{
+    connection_types::GenericValueMessage<std::string> small("a");
+    connection_types::GenericValueMessage<std::string> large(std::string(4096, 'a'));
+
+    EXPECT_LE(sizeof(small), small.getByteSize());
+    EXPECT_LE(large.getByteSize(), small.getByteSize() + 4096 + large.value.capacity());
+    EXPECT_LE(small.getByteSize() + 4096 - small.value.capacity(), large.getByteSize());
+}
+
+TEST_F(TokenMemoryTest, PayloadsAreCountedOncePerTypeAndOncePerHolder)
+{
+    TokenPtr token = makeToken(std::string(1024, 'a'));
+    std::size_t bytes = token->getTokenData()->getByteSize();
+    UUID output = UUIDProvider::makeUUID_without_parent("node:|:out_0");
+
+    {
+        TokenMemoryLease output_lease;
+        TokenMemoryLease connection_lease;
+        output_lease.holdForOutput(output, token);
+        connection_lease.holdForConnection("node:|:out_0 -> sink:|:in_0", token);
+
+        TokenMemoryStatistics statistics = TokenMemoryTracker::instance().getStatistics();
+        EXPECT_EQ(1u, statistics.getTotal().count);
+        EXPECT_EQ(bytes, statistics.getTotal().bytes);
+
+        ASSERT_EQ(1u, statistics.getTypes().size());
+        EXPECT_EQ(1u, statistics.getTypes().begin()->second.count);
+
+        ASSERT_EQ(1u, statistics.getOutputs().size());
+        EXPECT_EQ(output.getFullName(), statistics.getOutputs().begin()->first);
+        EXPECT_EQ(bytes, statistics.getNodeUsage(UUIDProvider::makeUUID_without_parent("node")).bytes);
+
+        ASSERT_EQ(1u, statistics.getConnections().size());
+        EXPECT_EQ(bytes, statistics.getConnections().begin()->second.bytes);
+
+        // holding the same payload again does not change anything
+        output_lease.holdForOutput(output, token);
+        EXPECT_EQ(1u, TokenMemoryTracker::instance().getStatistics().getOutputs().begin()->second.count);
+
+        SerializationBuffer buffer;
+        SemanticVersion version;
+        statistics.serialize(buffer, version);
+
+        TokenMemoryStatistics copy;
+        buffer.rewind();
+        copy.deserialize(buffer, version);
+        EXPECT_EQ(bytes, copy.getTotal().bytes);
+        EXPECT_EQ(statistics.getConnections().begin()->first, copy.getConnections().begin()->first);
+    }
+
+    EXPECT_TRUE(TokenMemoryTracker::instance().getStatistics().empty());
+}
+
+TEST_F(TokenMemoryTest, OutputsAndConnectionsReleaseTheirPayloads)
+{
+    OutputPtr output = std::make_shared<StaticOutput>(UUIDProvider::makeUUID_without_parent("src:|:out_0"));
+    InputPtr input = std::make_shared<Input>(UUIDProvider::makeUUID_without_parent("sink:|:in_0"));
+    ConnectionPtr connection = DirectConnection::connect(output, input);
+
+    msg::publish(output.get(), std::string(1024, 'a'));
+    EXPECT_EQ(1u, TokenMemoryTracker::instance().getStatistics().getOutputs().size());
+    std::size_t bytes = TokenMemoryTracker::instance().getStatistics().getTotal().bytes;
+
+    output->commitMessages(false);
+    output->publish();
+
+    // the connection stores its own copy of the committed token
+    TokenMemoryStatistics statistics = TokenMemoryTracker::instance().getStatistics();
+    EXPECT_EQ(2u, statistics.getTotal().count);
+    ASSERT_EQ(1u, statistics.getTypes().size());
+    EXPECT_EQ(2u, statistics.getTypes().begin()->second.count);
+    ASSERT_EQ(1u, statistics.getConnections().size());
+    EXPECT_LT(0u, statistics.getConnections().begin()->second.bytes);
+    EXPECT_EQ(bytes + statistics.getConnections().begin()->second.bytes, statistics.getTotal().bytes);
+
+    connection->reset();
+    output->reset();
+
+    EXPECT_TRUE(TokenMemoryTracker::instance().getStatistics().empty());
+}
+
+}  // namespace csapex
@@ -6,7 +6,7 @@
 #include <csapex/msg/static_output.h>
 #include <csapex/msg/generic_value_message.hpp>
 #include <csapex/msg/direct_connection.h>
-#include <csapex/msg/direct_connection.h>
+#include <csapex/msg/latest_value_connection.h>
 #include <csapex/model/connection.h>
 #include <csapex/utility/uuid_provider.h>
 #include <csapex/msg/output_transition.h>
@@ -408,3 +408,51 @@ TEST_F(TransitionTest, TestBundledAndDirectConnectionsCanBeMixed)
         ASSERT_RECEIVED(*i2, iter);
     }
 }
+
+TEST_F(TransitionTest, LatestValueConnectionsDoNotBlockTheOutput)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = LatestValueConnection::connect(o1, i1);
+    std::shared_ptr<LatestValueConnection> latest = std::dynamic_pointer_cast<LatestValueConnection>(c);
+    ASSERT_NE(nullptr, latest);
+    ASSERT_EQ(ConnectionPolicy::LATEST_VALUE, c->getDescription().policy);
+
+    // the input does not read, unread values are replaced
+    for (int value = 1; value <= 3; ++value) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, value);
+        ot.sendMessages(false);
+    }
+
+    ASSERT_IN_CONNECTION(*c, 3);
+    ASSERT_EQ(2, latest->getDroppedCount());
+    int first_seq_no = c->getToken()->getSequenceNumber();
+
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 3);
+
+    // while the input is processing, only the newest value is kept
+    for (int value = 4; value <= 5; ++value) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, value);
+        ot.sendMessages(false);
+    }
+    ASSERT_RECEIVED(*i1, 3);
+    ASSERT_EQ(3, latest->getDroppedCount());
+
+    it.notifyMessageRead();
+    it.notifyMessageProcessed();
+
+    ASSERT_IN_CONNECTION(*c, 5);
+    ASSERT_LT(first_seq_no, c->getToken()->getSequenceNumber());
+
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 5);
+}
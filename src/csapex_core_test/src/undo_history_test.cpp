@@ -0,0 +1,327 @@
+#include <csapex/command/command_impl.hpp>
+#include <csapex/command/dispatcher.h>
+#include <csapex/command/move_box.h>
+#include <csapex/command/move_fulcrum.h>
+#include <csapex/core/csapex_core.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/serialization/snippet.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/node_constructing_test.h>
+
+#include <boost/filesystem.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <thread>
+
+namespace csapex
+{
+namespace
+{
+YAML::Node makeDocument(int nodes)
+{
+    YAML::Node doc;
+    for (int i = 0; i < nodes; ++i) {
+        YAML::Node node;
+        node["type"] = "csapex::MockupSource";
+        node["uuid"] = "node_" + std::to_string(i);
+        doc["nodes"].push_back(node);
+    }
+    return doc;
+}
+
+/**
+ * @brief SnapshotCommand keeps a snapshot alive for undo, like DeleteNode does with the deleted subgraph
+ */
+class SnapshotCommand : public CommandImplementation<SnapshotCommand>
+{
+    COMMAND_HEADER(SnapshotCommand);
+
+public:
+    SnapshotCommand(const YAML::Node& doc) : CommandImplementation(AUUID(UUID::NONE)), snapshot(doc)
+    {
+    }
+
+    std::size_t getMemoryFootprint() const override
+    {
+        return snapshot.getByteSize();
+    }
+
+    void spill(const std::string& directory) override
+    {
+        snapshot.spill(directory);
+    }
+
+    void reload() override
+    {
+        snapshot.reload();
+    }
+
+    bool isSpilled() const
+    {
+        return snapshot.isSpilled();
+    }
+
+    std::string getDescription() const override
+    {
+        return "snapshot";
+    }
+
+    void serialize(SerializationBuffer& data, SemanticVersion& version) const override
+    {
+    }
+    void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override
+    {
+    }
+
+    YAML::Node restored;
+
+protected:
+    bool doExecute() override
+    {
+        return true;
+    }
+    bool doUndo() override
+    {
+        snapshot.toYAML(restored);
+        return true;
+    }
+    bool doRedo() override
+    {
+        return true;
+    }
+
+private:
+    Snippet snapshot;
+};
+}  // namespace
+
+class UndoHistoryTest : public NodeConstructingTest
+{
+protected:
+    UndoHistoryTest() : directory(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("csapex_undo_%%%%%%")), settings(false)
+    {
+        boost::filesystem::create_directories(directory);
+    }
+
+    ~UndoHistoryTest()
+    {
+        core.reset();
+        boost::filesystem::remove_all(directory);
+    }
+
+    std::size_t countSpilledFiles() const
+    {
+        return std::distance(boost::filesystem::directory_iterator(directory), boost::filesystem::directory_iterator());
+    }
+
+    CommandDispatcherPtr makeDispatcher(int history_length = 0, int history_memory_mb = 0)
+    {
+        settings.set("undo_history_length", history_length);
+        settings.set("undo_history_memory_mb", history_memory_mb);
+
+        core = std::make_shared<CsApexCore>(settings, eh, nullptr, node_factory, nullptr);
+        core->init();
+        return core->getCommandDispatcher();
+    }
+
+    std::shared_ptr<SnapshotCommand> execute(const CommandDispatcherPtr& dispatcher)
+    {
+        auto cmd = std::make_shared<SnapshotCommand>(makeDocument(64));
+        dispatcher->execute(cmd);
+        return cmd;
+    }
+
+    std::size_t countUndoCommands(const CommandDispatcherPtr& dispatcher) const
+    {
+        std::size_t count = 0;
+        dispatcher->visitUndoCommands([&count](int level, const Command&) { ++count; });
+        return count;
+    }
+
+    boost::filesystem::path directory;
+
+    SettingsImplementation settings;
+    std::shared_ptr<CsApexCore> core;
+};
+
+TEST_F(UndoHistoryTest, SnippetsAreReloadedFromDiskOnDemand)
+{
+    YAML::Node doc = makeDocument(64);
+
+    Snippet snippet(doc);
+    std::size_t bytes = snippet.getByteSize();
+    EXPECT_LT(0u, bytes);
+
+    ASSERT_TRUE(snippet.spill(directory.string()));
+    EXPECT_TRUE(snippet.isSpilled());
+    EXPECT_EQ(0u, snippet.getByteSize());
+    EXPECT_EQ(1u, countSpilledFiles());
+
+    YAML::Node reloaded;
+    snippet.toYAML(reloaded);
+    EXPECT_EQ(YAML::Dump(doc), YAML::Dump(reloaded));
+
+    EXPECT_FALSE(snippet.isSpilled());
+    EXPECT_EQ(bytes, snippet.getByteSize());
+    EXPECT_EQ(0u, countSpilledFiles());
+}
+
+TEST_F(UndoHistoryTest, SpilledFilesAreRemovedWithTheLastCopy)
+{
+    YAML::Node doc;
+    doc["nodes"].push_back("node_0");
+
+    {
+        Snippet snippet(doc);
+        ASSERT_TRUE(snippet.spill(directory.string()));
+
+        Snippet copy = snippet;
+        EXPECT_TRUE(copy.isSpilled());
+        EXPECT_EQ(1u, countSpilledFiles());
+    }
+
+    EXPECT_EQ(0u, countSpilledFiles());
+}
+
+TEST_F(UndoHistoryTest, ConsecutiveMovesAreCompacted)
+{
+    AUUID graph(UUIDProvider::makeUUID_without_parent("graph"));
+    UUID box = UUIDProvider::makeUUID_without_parent("box");
+    UUID other_box = UUIDProvider::makeUUID_without_parent("other_box");
+
+    command::MoveBox move(graph, box, Point(0, 0), Point(1, 1));
+    command::MoveBox next(graph, box, Point(1, 1), Point(5, 5));
+    command::MoveBox other(graph, other_box, Point(5, 5), Point(7, 7));
+    const Command& merged = move;
+
+    EXPECT_TRUE(move.absorb(next));
+    EXPECT_NE(std::string::npos, merged.getDescription().find("(5, 5)"));
+
+    EXPECT_FALSE(move.absorb(other));
+    EXPECT_EQ(std::string::npos, merged.getDescription().find("(7, 7)"));
+
+    // a move that does not start where the last one ended is a new drag
+    EXPECT_FALSE(move.absorb(command::MoveBox(graph, box, Point(6, 6), Point(7, 7))));
+
+    command::MoveFulcrum fulcrum(graph, 0, 0, Point(0, 0), Point(1, 1));
+    EXPECT_FALSE(move.absorb(fulcrum));
+    EXPECT_FALSE(fulcrum.absorb(command::MoveFulcrum(graph, 0, 1, Point(1, 1), Point(2, 2))));
+    EXPECT_TRUE(fulcrum.absorb(command::MoveFulcrum(graph, 0, 0, Point(1, 1), Point(2, 2))));
+}
+
+TEST_F(UndoHistoryTest, SeparateDragsAreNotCompacted)
+{
+    AUUID graph(UUIDProvider::makeUUID_without_parent("graph"));
+    UUID box = UUIDProvider::makeUUID_without_parent("box");
+
+    command::MoveBox move(graph, box, Point(0, 0), Point(1, 1));
+    command::MoveFulcrum fulcrum(graph, 0, 0, Point(0, 0), Point(1, 1));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+
+    EXPECT_FALSE(move.absorb(command::MoveBox(graph, box, Point(1, 1), Point(2, 2))));
+    EXPECT_FALSE(fulcrum.absorb(command::MoveFulcrum(graph, 0, 0, Point(1, 1), Point(2, 2))));
+}
+
+TEST_F(UndoHistoryTest, HistoryIsBoundedByLength)
+{
+    CommandDispatcherPtr dispatcher = makeDispatcher(3);
+
+    for (int i = 0; i < 5; ++i) {
+        execute(dispatcher);
+    }
+    EXPECT_EQ(3u, countUndoCommands(dispatcher));
+
+    dispatcher->undo();
+    execute(dispatcher);
+    EXPECT_EQ(3u, countUndoCommands(dispatcher));
+    EXPECT_FALSE(dispatcher->canRedo());
+}
+
+TEST_F(UndoHistoryTest, NegativeLimitsAreIgnored)
+{
+    CommandDispatcherPtr dispatcher = makeDispatcher(-1, -1);
+
+    for (int i = 0; i < 5; ++i) {
+        execute(dispatcher);
+    }
+    EXPECT_EQ(5u, countUndoCommands(dispatcher));
+}
+
+TEST_F(UndoHistoryTest, HistoryIsBoundedByMemory)
+{
+    CommandDispatcherPtr dispatcher = makeDispatcher();
+
+    std::shared_ptr<SnapshotCommand> first = execute(dispatcher);
+    std::size_t bytes = first->getMemoryFootprint();
+    ASSERT_LT(0u, bytes);
+    EXPECT_EQ(bytes, dispatcher->getHistoryMemory());
+
+    dispatcher->setHistoryLimits(0, bytes * 5 / 2);
+    for (int i = 0; i < 4; ++i) {
+        execute(dispatcher);
+    }
+
+    EXPECT_EQ(2u, countUndoCommands(dispatcher));
+    EXPECT_EQ(2 * bytes, dispatcher->getHistoryMemory());
+    EXPECT_EQ(0u, countSpilledFiles());
+
+    // the last command stays undoable, even if it alone exceeds the budget
+    dispatcher->setHistoryLimits(0, 1);
+    EXPECT_EQ(1u, countUndoCommands(dispatcher));
+}
+
+TEST_F(UndoHistoryTest, OldCommandsAreSpilledAndReloadedOnUndo)
+{
+    CommandDispatcherPtr dispatcher = makeDispatcher();
+    dispatcher->setSpillDirectory(directory.string());
+
+    std::vector<std::shared_ptr<SnapshotCommand>> commands;
+    commands.push_back(execute(dispatcher));
+    std::size_t bytes = commands.front()->getMemoryFootprint();
+
+    dispatcher->setHistoryLimits(0, bytes * 5 / 2);
+    for (int i = 0; i < 4; ++i) {
+        commands.push_back(execute(dispatcher));
+    }
+
+    // nothing is forgotten, the oldest commands are spilled instead
+    EXPECT_EQ(5u, countUndoCommands(dispatcher));
+    EXPECT_EQ(3u, countSpilledFiles());
+    EXPECT_TRUE(commands[2]->isSpilled());
+    EXPECT_FALSE(commands[3]->isSpilled());
+    EXPECT_LE(dispatcher->getHistoryMemory(), bytes * 5 / 2);
+
+    dispatcher->undo();
+    dispatcher->undo();
+    dispatcher->undo();
+
+    EXPECT_FALSE(commands[2]->isSpilled());
+    EXPECT_EQ(YAML::Dump(makeDocument(64)), YAML::Dump(commands[2]->restored));
+    EXPECT_LE(dispatcher->getHistoryMemory(), bytes * 5 / 2);
+}
+
+TEST_F(UndoHistoryTest, UnreadableSpillFilesKeepTheCommand)
+{
+    CommandDispatcherPtr dispatcher = makeDispatcher();
+    dispatcher->setSpillDirectory(directory.string());
+
+    std::shared_ptr<SnapshotCommand> first = execute(dispatcher);
+    dispatcher->setHistoryLimits(0, first->getMemoryFootprint() * 3 / 2);
+    std::shared_ptr<SnapshotCommand> second = execute(dispatcher);
+    ASSERT_TRUE(first->isSpilled());
+
+    dispatcher->undo();
+    EXPECT_EQ(first, dispatcher->getNextUndoCommand());
+
+    for (boost::filesystem::directory_iterator it(directory), end; it != end; ++it) {
+        boost::filesystem::remove(it->path());
+    }
+
+    EXPECT_THROW(dispatcher->undo(), std::runtime_error);
+    EXPECT_EQ(first, dispatcher->getNextUndoCommand());
+    EXPECT_EQ(second, dispatcher->getNextRedoCommand());
+}
+
+}  // namespace csapex
@@ -53,6 +53,8 @@ public:
     virtual void setSteppingMode(bool stepping) = 0;
     virtual void step() = 0;
 
+    virtual TokenMemoryStatistics getTokenMemoryStatistics() const = 0;
+
     virtual Settings& getSettings() const = 0;
 
     // TODO: add proxies or remove
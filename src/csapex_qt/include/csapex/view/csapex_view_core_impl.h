@@ -28,6 +28,8 @@ public:
     void setSteppingMode(bool stepping) override;
     void step() override;
 
+    TokenMemoryStatistics getTokenMemoryStatistics() const override;
+
     Settings& getSettings() const override;
 
     CsApexCorePtr getCore() const;
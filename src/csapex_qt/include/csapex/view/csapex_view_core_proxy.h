@@ -46,6 +46,8 @@ public:
     void setSteppingMode(bool stepping) override;
     void step() override;
 
+    TokenMemoryStatistics getTokenMemoryStatistics() const override;
+
     Settings& getSettings() const override;
     CommandExecutorPtr getCommandDispatcher() override;
     ExceptionHandler& getExceptionHandler() const override;
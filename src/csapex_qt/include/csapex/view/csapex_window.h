@@ -67,6 +67,8 @@ private Q_SLOTS:
     void startStopServer();
     void updateServerOptions();
 
+    void inferExecutionModes();
+
     void updateSelectionActions();
     void updateClipboardActions();
 
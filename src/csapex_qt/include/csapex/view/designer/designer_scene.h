@@ -12,17 +12,19 @@
 #include <csapex/utility/slim_signal.hpp>
 #include <csapex/utility/uuid.h>
 #include <csapex/profiling/profilable.h>
+#include <csapex/model/connection_description.h>
 
 /// SYSTEM
 #include <QGraphicsScene>
 #include <QLabel>
+#include <QPainterPath>
 #include <QTime>
 #include <unordered_map>
 #include <QPointer>
+#include <set>
 
 namespace csapex
 {
-class ConnectionDescription;
 class Timer;
 
 class CSAPEX_QT_EXPORT DesignerScene : public QGraphicsScene, public Profilable
@@ -31,6 +33,8 @@ class CSAPEX_QT_EXPORT DesignerScene : public QGraphicsScene, public Profilable
 
 private:
     static const float ARROW_LENGTH;
+    static const double GRID_CELL_SIZE;
+    static const double SIMPLIFIED_SCALE;
 
 public:
     DesignerScene(csapex::GraphFacadePtr graph, CsApexViewCore& view_core);
@@ -53,6 +57,8 @@ public:
     Port* getPort(const UUID& connector_uuid);
     void removePort(Port* port);
 
+    void invalidateNodeConnections(const UUID& node);
+
     std::string makeStatusString() const;
 
 public Q_SLOTS:
@@ -156,10 +162,46 @@ private:
         double r;
     };
 
+    /**
+     * @brief ConnectionGeometry is the scene space shape of a connection, one path per sub section.
+     *        It only depends on the port positions, the fulcrums and the zoom level,
+     *        so it is reused for all repaints until one of those changes.
+     */
+    struct ConnectionGeometry
+    {
+        std::vector<QPainterPath> paths;
+        std::vector<QRectF> bounding_boxes;
+        double stroke_width;
+
+        QPointF from;
+        QPointF to;
+        Position start_pos;
+        Position end_pos;
+    };
+
+    struct CachedConnection
+    {
+        ConnectionDescription description;
+        ConnectionGeometry geometry;
+
+        bool placed;
+        bool stale;
+    };
+
+    typedef std::pair<int, int> GridCell;
+
 private:
-    void drawConnection(QPainter* painter, const ConnectionDescription& connection);
-    std::vector<QRectF> drawConnection(QPainter* painter, Connector* from, Connector* to, int id);
-    std::vector<QRectF> drawConnection(QPainter* painter, const QPointF& from, const QPointF& to, int id);
+    void drawConnection(QPainter* painter, CachedConnection& connection);
+    ConnectionGeometry drawConnection(QPainter* painter, Connector* from, Connector* to, int id);
+    ConnectionGeometry drawConnection(QPainter* painter, const QPointF& from, const QPointF& to, int id);
+    void generatePaths(const QPointF& from, const QPointF& to, const std::vector<Fulcrum>& fulcrums, bool simplified, std::vector<QPainterPath>& paths);
+
+    void placeConnection(int id, const ConnectionGeometry& geometry);
+    void unplaceConnection(int id);
+    void invalidateConnection(int id);
+
+    std::set<int> findConnections(const QRectF& rect) const;
+    std::pair<int, int> findConnectionAt(const QPointF& pos) const;
 
     void drawPort(QPainter* painter, bool selected, Port* p, int pos = -1);
 
@@ -176,16 +218,17 @@ private:
 
     QPixmap background_;
 
-    QPainter* schematics_painter;
-    QImage schematics;
-
     QTimer* preview_timer_;
     MessagePreviewWidget* preview_;
 
     std::vector<TempConnection> temp_;
 
     std::vector<csapex::slim_signal::Connection> connections_;
-    std::map<int, std::vector<QRectF>> connection_bb_;
+
+    std::map<int, CachedConnection> connection_cache_;
+    std::map<GridCell, std::set<int>> connection_grid_;
+    std::set<int> unplaced_connections_;
+    std::unordered_map<UUID, std::set<int>, UUID::Hasher> node_connections_;
 
     std::map<int, std::vector<Fulcrum>> connection_2_fulcrum_;
     std::map<Fulcrum*, FulcrumWidget*> fulcrum_2_widget_;
@@ -213,8 +256,6 @@ private:
 
     int connector_radius_;
 
-    bool schema_dirty_;
-
     bool debug_;
 
     std::unordered_map<UUID, QPointer<Port>, UUID::Hasher> port_map_;
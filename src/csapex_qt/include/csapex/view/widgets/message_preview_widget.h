@@ -3,12 +3,13 @@
 
 /// COMPONENT
 #include <csapex_qt_export.h>
-#include <csapex/msg/output.h>
-#include <csapex/msg/input.h>
+#include <csapex/model/connector.h>
+#include <csapex/model/token_data.h>
 
 /// SYSTEM
 #include <QGraphicsView>
 #include <QPointer>
+#include <mutex>
 
 namespace csapex
 {
@@ -16,16 +17,17 @@ class MessagePreviewWidget;
 
 namespace impl
 {
-class CSAPEX_QT_EXPORT PreviewInput : public Input
+class CSAPEX_QT_EXPORT PreviewRenderer
 {
 public:
-    PreviewInput(QPointer<MessagePreviewWidget> parent);
+    PreviewRenderer(QPointer<MessagePreviewWidget> parent);
 
-    virtual void setToken(TokenPtr message) override;
+    void render(const TokenConstPtr& token);
 
     void detach();
 
 private:
+    std::mutex parent_mutex_;
     QPointer<MessagePreviewWidget> parent_;
 };
 }  // namespace impl
@@ -55,12 +57,12 @@ public Q_SLOTS:
     void displayText(const QString& txt);
 
 private:
-    void connectToImpl(OutputPtr out);
-    void connectToImpl(InputPtr out);
+    ConnectorPtr findSource(const ConnectorPtr& c) const;
 
 private:
-    ConnectionPtr connection_;
-    std::shared_ptr<impl::PreviewInput> input_;
+    ConnectorPtr connector_;
+    OutputTapPtr tap_;
+    std::shared_ptr<impl::PreviewRenderer> renderer_;
 
     QString displayed_;
 
@@ -6,6 +6,7 @@
 #include <csapex/view/node/node_adapter_factory.h>
 #include <csapex/view/designer/drag_io.h>
 #include <csapex/model/graph_facade.h>
+#include <csapex/model/token_memory.h>
 #include <csapex/scheduling/thread_pool.h>
 #include <csapex/command/dispatcher.h>
 #include <csapex/factory/node_factory_impl.h>
@@ -190,6 +191,11 @@ bool CsApexViewCoreImplementation::isSteppingMode() const
     return core_->isSteppingMode();
 }
 
+TokenMemoryStatistics CsApexViewCoreImplementation::getTokenMemoryStatistics() const
+{
+    return core_->getTokenMemoryStatistics();
+}
+
 void CsApexViewCoreImplementation::setSteppingMode(bool stepping)
 {
     core_->setSteppingMode(stepping);
@@ -19,6 +19,7 @@
 #include <csapex/model/graph_facade_proxy.h>
 #include <csapex/model/graph/graph_proxy.h>
 #include <csapex/model/node_facade_proxy.h>
+#include <csapex/model/token_memory.h>
 #include <csapex/plugin/plugin_locator.h>
 #include <csapex/profiling/profiler_proxy.h>
 #include <csapex/scheduling/thread_pool.h>
@@ -296,6 +297,11 @@ bool CsApexViewCoreProxy::isSteppingMode() const
     return request<bool, CoreRequests>(CoreRequests::CoreRequestType::CoreGetSteppingMode);
 }
 
+TokenMemoryStatistics CsApexViewCoreProxy::getTokenMemoryStatistics() const
+{
+    return request<TokenMemoryStatistics, CoreRequests>(CoreRequests::CoreRequestType::CoreGetTokenMemoryStatistics);
+}
+
 void CsApexViewCoreProxy::setSteppingMode(bool stepping)
 {
     session_->sendRequest<CoreRequests>(CoreRequests::CoreRequestType::CoreSetSteppingMode, stepping);
@@ -17,6 +17,7 @@
 #include <csapex/model/node_constructor.h>
 #include <csapex/model/node_facade.h>
 #include <csapex/core/csapex_core.h>
+#include <csapex/core/execution_mode_analyzer.h>
 #include <csapex/manager/message_renderer_manager.h>
 #include <csapex/model/tag.h>
 #include <csapex/model/token_data.h>
@@ -125,12 +126,14 @@ void CsApexWindow::construct()
 
     if (view_core_.isProxy()) {
         ui->actionServer_StartStop->setEnabled(false);
+        ui->actionInfer_Execution_Modes->setEnabled(false);
     } else {
         CsApexViewCoreImplementation& local_view_core = dynamic_cast<CsApexViewCoreImplementation&>(view_core_);
         ui->actionServer_StartStop->setChecked(local_view_core.getCore()->isServerActive());
     }
     QObject::connect(ui->actionServer_StartStop, &QAction::triggered, this, &CsApexWindow::startStopServer);
     QObject::connect(ui->actionServer_Options, &QAction::triggered, this, &CsApexWindow::updateServerOptions);
+    QObject::connect(ui->actionInfer_Execution_Modes, &QAction::triggered, this, &CsApexWindow::inferExecutionModes);
 
     ui->menuBar->setVisible(true);
 
@@ -1071,6 +1074,23 @@ void CsApexWindow::startStopServer()
     ui->actionServer_StartStop->setChecked(running);
 }
 
+void CsApexWindow::inferExecutionModes()
+{
+    apex_assert_hard(!view_core_.isProxy());
+
+    CsApexViewCoreImplementation& local_view_core = dynamic_cast<CsApexViewCoreImplementation&>(view_core_);
+    ExecutionModeReport report = local_view_core.getCore()->inferExecutionModes();
+
+    std::stringstream details;
+    details << report;
+
+    QMessageBox box(this);
+    box.setWindowTitle("Execution Modes");
+    box.setText(QString::number(report.promotions().size()) + " of " + QString::number(report.nodes.size()) + " nodes were promoted to pipelining.");
+    box.setDetailedText(QString::fromStdString(details.str()));
+    box.exec();
+}
+
 void CsApexWindow::updateServerOptions()
 {
     bool ok;
@@ -41,29 +41,25 @@
 using namespace csapex;
 
 const float DesignerScene::ARROW_LENGTH = 1.5f;
+const double DesignerScene::GRID_CELL_SIZE = 256.0;
+const double DesignerScene::SIMPLIFIED_SCALE = 0.35;
 
 namespace
 {
-QRgb id2rgb(int id, int subsection)
+std::vector<std::pair<int, int>> coveredCells(const QRectF& rect, double cell_size)
 {
-    apex_assert_hard(id < 0xFFFF);
-    apex_assert_hard(subsection < 0xFF);
-    int raw = (id & 0xFFFF) | ((subsection & 0xFF) << 16);
-
-    return qRgb(qRed(raw), qGreen(raw), qBlue(raw));
-}
-
-std::pair<int, int> rgb2id(QRgb rgb)
-{
-    int raw = (rgb & 0xFFFFFF);
-    if (raw >= 0xFFFFFF) {
-        return std::make_pair(-1, -1);
+    int min_x = static_cast<int>(std::floor(rect.left() / cell_size));
+    int max_x = static_cast<int>(std::floor(rect.right() / cell_size));
+    int min_y = static_cast<int>(std::floor(rect.top() / cell_size));
+    int max_y = static_cast<int>(std::floor(rect.bottom() / cell_size));
+
+    std::vector<std::pair<int, int>> cells;
+    for (int x = min_x; x <= max_x; ++x) {
+        for (int y = min_y; y <= max_y; ++y) {
+            cells.emplace_back(x, y);
+        }
     }
-
-    int id = raw & 0xFFFF;
-    int subsection = (raw >> 16) & 0xFF;
-
-    return std::make_pair(id, subsection);
+    return cells;
 }
 
 QPointF centerPoint(Port* port)
@@ -116,7 +112,6 @@ DesignerScene::DesignerScene(GraphFacadePtr graph_facade, CsApexViewCore& view_c
   , scale_(1.0)
   , highlight_connection_id_(-1)
   , highlight_connection_sub_id_(-1)
-  , schema_dirty_(false)
   , debug_(false)
 {
     background_ = QPixmap::fromImage(QImage(":/background.png"));
@@ -199,8 +194,7 @@ void DesignerScene::displayConnections(bool& member, bool display)
     if (display != member) {
         member = display;
 
-        connection_bb_.clear();
-
+        invalidateSchema();
         invalidate();
     }
 }
@@ -318,22 +312,6 @@ void DesignerScene::drawForeground(QPainter* painter, const QRectF& rect)
         return;
     }
 
-    // check if we need to update the schematics
-    QSize scene_size(sceneRect().width(), sceneRect().height());
-    if (schematics.isNull() || schematics.size() != scene_size) {
-        schematics = QImage(scene_size, QImage::Format_RGB888);
-        schema_dirty_ = true;
-    }
-
-    // make schematics renderer
-    QPainter ps(&schematics);
-    ps.setWindow(sceneRect().toRect());
-    schematics_painter = &ps;
-
-    if (schema_dirty_) {
-        schematics_painter->fillRect(sceneRect(), -1);
-    }
-
     // set drawing params
     painter->setRenderHint(QPainter::Antialiasing);
     painter->setPen(QPen(Qt::black, 3));
@@ -374,21 +352,25 @@ void DesignerScene::drawForeground(QPainter* painter, const QRectF& rect)
             }
         }
 
-        // draw all connections
-        auto intersects_any = [](const std::vector<QRectF>& rects, const QRectF& rect) {
-            for (auto r : rects) {
-                if (rect.intersects(r)) {
-                    return true;
-                }
+        // draw the connections in the exposed area, new or changed ones are placed in the grid while drawing
+        for (int id : findConnections(rect)) {
+            auto pos = connection_cache_.find(id);
+            if (pos == connection_cache_.end()) {
+                continue;
             }
-            return false;
-        };
 
-        for (const ConnectionDescription& connection : graph_facade_->enumerateAllConnections()) {
-            auto pos = connection_bb_.find(connection.id);
-            if (pos == connection_bb_.end() || intersects_any(pos->second, rect)) {
-                drawConnection(painter, connection);
+            CachedConnection& connection = pos->second;
+            if (connection.stale) {
+                try {
+                    connection.description = graph_facade_->getConnectionWithId(id);
+                    connection.stale = false;
+                } catch (const std::exception& e) {
+                    std::cerr << "Error updating connection " << id << ": " << e.what() << std::endl;
+                    continue;
+                }
             }
+
+            drawConnection(painter, connection);
         }
     }
 
@@ -396,7 +378,7 @@ void DesignerScene::drawForeground(QPainter* painter, const QRectF& rect)
 
     {
         INTERLUDE("node augmentations");
-        for (QGraphicsItem* item : items()) {
+        for (QGraphicsItem* item : items(rect)) {
             MovableGraphicsProxyWidget* proxy = dynamic_cast<MovableGraphicsProxyWidget*>(item);
             if (!proxy) {
                 continue;
@@ -497,8 +479,16 @@ void DesignerScene::drawForeground(QPainter* painter, const QRectF& rect)
     }
 
     if (draw_schema_) {
-        painter->setOpacity(0.35);
-        painter->drawImage(sceneRect().topLeft(), schematics);
+        // visualize the occupied cells of the connection index
+        painter->save();
+        painter->setOpacity(0.15);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(Qt::blue);
+        for (const auto& entry : connection_grid_) {
+            const GridCell& cell = entry.first;
+            painter->drawRect(QRectF(cell.first * GRID_CELL_SIZE, cell.second * GRID_CELL_SIZE, GRID_CELL_SIZE, GRID_CELL_SIZE));
+        }
+        painter->restore();
     }
 
     if (debug_) {
@@ -510,10 +500,6 @@ void DesignerScene::drawForeground(QPainter* painter, const QRectF& rect)
         painter->restore();
     }
 
-    schema_dirty_ = false;
-
-    schematics_painter = nullptr;
-
 #if DEBUG_DRAWINGS_PER_SECOND
     long draw_end = QDateTime::currentMSecsSinceEpoch();
     long dt_drawing = draw_end - draw_begin;
@@ -559,12 +545,7 @@ void DesignerScene::mouseMoveEvent(QGraphicsSceneMouseEvent* e)
 {
     QGraphicsScene::mouseMoveEvent(e);
 
-    QPoint pos = (e->scenePos() - sceneRect().topLeft()).toPoint();
-    if (!schematics.rect().contains(pos)) {
-        return;
-    }
-
-    std::pair<int, int> data = rgb2id(schematics.pixel(pos.x(), pos.y()));
+    std::pair<int, int> data = findConnectionAt(e->scenePos());
 
     auto* item = itemAt(e->scenePos(), QTransform());
     Port* port = nullptr;
@@ -684,6 +665,17 @@ bool DesignerScene::isEmpty() const
 
 void DesignerScene::connectionAdded(const ConnectionDescription& ci)
 {
+    unplaceConnection(ci.id);
+
+    CachedConnection& cached = connection_cache_[ci.id];
+    cached.description = ci;
+    cached.placed = false;
+    cached.stale = false;
+    unplaced_connections_.insert(ci.id);
+
+    node_connections_[ci.from.parentUUID()].insert(ci.id);
+    node_connections_[ci.to.parentUUID()].insert(ci.id);
+
     for (const Fulcrum& f : ci.fulcrums) {
         connection_2_fulcrum_[ci.id].push_back(f);
         Fulcrum* proxy = &connection_2_fulcrum_[ci.id].back();
@@ -703,12 +695,30 @@ void DesignerScene::connectionAdded(const ConnectionDescription& ci)
         // TODO: implement fulcrum manipulation for remote connections!
     }
 
-    invalidateSchema();
+    update();
 }
 
 void DesignerScene::connectionDeleted(const ConnectionDescription& ci)
 {
-    invalidateSchema();
+    unplaceConnection(ci.id);
+    unplaced_connections_.erase(ci.id);
+    connection_cache_.erase(ci.id);
+
+    for (const UUID& node : { ci.from.parentUUID(), ci.to.parentUUID() }) {
+        auto pos = node_connections_.find(node);
+        if (pos != node_connections_.end()) {
+            pos->second.erase(ci.id);
+            if (pos->second.empty()) {
+                node_connections_.erase(pos);
+            }
+        }
+    }
+
+    if (highlight_connection_id_ == ci.id) {
+        highlight_connection_id_ = -1;
+    }
+
+    update();
 }
 
 void DesignerScene::fulcrumAdded(Fulcrum* f)
@@ -739,13 +749,16 @@ void DesignerScene::fulcrumAdded(Fulcrum* f)
     w->setSelected(true);
     setFocusItem(w, Qt::MouseFocusReason);
 
-    invalidateSchema();
+    invalidateConnection(f->connectionId());
 }
 
 void DesignerScene::fulcrumDeleted(void* fulcrum)
 {
     Fulcrum* f = (Fulcrum*)fulcrum;
 
+    // the fulcrum is still alive while this signal is being handled
+    invalidateConnection(f->connectionId());
+
     std::map<Fulcrum*, FulcrumWidget*>::iterator pos = fulcrum_2_widget_.find(f);
     if (pos == fulcrum_2_widget_.end()) {
         return;
@@ -754,8 +767,6 @@ void DesignerScene::fulcrumDeleted(void* fulcrum)
     //    delete pos->second;
     pos->second->deleteLater();
     fulcrum_2_widget_.erase(pos);
-
-    invalidateSchema();
 }
 
 void DesignerScene::fulcrumMoved(void* fulcrum, bool dropped)
@@ -766,7 +777,7 @@ void DesignerScene::fulcrumMoved(void* fulcrum, bool dropped)
         view_core_.getCommandDispatcher()->execute(Command::Ptr(new command::MoveFulcrum(graph_facade_->getAbsoluteUUID(), f->connectionId(), f->id(), fulcrum_last_pos_[f], f->pos())));
         fulcrum_last_pos_[f] = f->pos();
     }
-    invalidateSchema();
+    invalidateConnection(f->connectionId());
 }
 
 void DesignerScene::fulcrumHandleMoved(void* fulcrum, bool dropped, int /*which*/)
@@ -780,12 +791,13 @@ void DesignerScene::fulcrumHandleMoved(void* fulcrum, bool dropped, int /*which*
         fulcrum_last_hin_[f] = f->handleIn();
         fulcrum_last_hout_[f] = f->handleOut();
     }
-    invalidateSchema();
+    invalidateConnection(f->connectionId());
 }
 
-void DesignerScene::fulcrumTypeChanged(void* /*f*/, int /*type*/)
+void DesignerScene::fulcrumTypeChanged(void* fulcrum, int /*type*/)
 {
-    invalidateSchema();
+    Fulcrum* f = (Fulcrum*)fulcrum;
+    invalidateConnection(f->connectionId());
 }
 
 void DesignerScene::addTemporaryConnection(ConnectorPtr from, const QPointF& end)
@@ -844,17 +856,15 @@ void DesignerScene::deleteTemporaryConnectionsAndRepaint()
     update();
 }
 
-void DesignerScene::drawConnection(QPainter* painter, const ConnectionDescription& ci)
+void DesignerScene::drawConnection(QPainter* painter, CachedConnection& cached)
 {
-    if (ci.active && !display_active_) {
-        return;
-    }
-    if (!ci.active && !display_inactive_) {
-        return;
-    }
+    const ConnectionDescription& ci = cached.description;
 
     ConnectorPtr from = graph_facade_->findConnector(ci.from);
     ConnectorPtr to = graph_facade_->findConnector(ci.to);
+    if (!from || !to) {
+        return;
+    }
 
     ccs = CurrentConnectionState();
 
@@ -884,27 +894,37 @@ void DesignerScene::drawConnection(QPainter* painter, const ConnectionDescriptio
         ccs.target_is_pipelining = false;
     }
 
-    connection_bb_[ci.id] = drawConnection(painter, from.get(), to.get(), ci.id);
+    if (ccs.active && !display_active_) {
+        return;
+    }
+    if (!ccs.active && !display_inactive_) {
+        return;
+    }
+
+    ConnectionGeometry geometry = drawConnection(painter, from.get(), to.get(), ci.id);
+    if (!cached.placed && !geometry.paths.empty()) {
+        placeConnection(ci.id, geometry);
+    }
 }
 
-std::vector<QRectF> DesignerScene::drawConnection(QPainter* painter, Connector* from, Connector* to, int id)
+DesignerScene::ConnectionGeometry DesignerScene::drawConnection(QPainter* painter, Connector* from, Connector* to, int id)
 {
     Port* from_port = getPort(from->getUUID());
     Port* to_port = getPort(to->getUUID());
 
     if (!from_port || !to_port) {
-        return std::vector<QRectF>();
+        return ConnectionGeometry();
     }
 
     if (to->isAsynchronous()) {
         if (!display_signals_) {
-            return std::vector<QRectF>();
+            return ConnectionGeometry();
         }
         ccs.type = TokenType::SIG;
 
     } else {
         if (!display_messages_) {
-            return std::vector<QRectF>();
+            return ConnectionGeometry();
         }
         ccs.type = TokenType::MSG;
     }
@@ -958,52 +978,22 @@ QPointF DesignerScene::offset(const QPointF& vector, Position position, double o
     return result;
 }
 
-std::vector<QRectF> DesignerScene::drawConnection(QPainter* painter, const QPointF& from, const QPointF& real_to, int id)
+void DesignerScene::generatePaths(const QPointF& from, const QPointF& to, const std::vector<Fulcrum>& fulcrums, bool simplified, std::vector<QPainterPath>& paths)
 {
-    QPointF to = offset(real_to, ccs.end_pos, view_core_.getStyle().lineWidth() * ARROW_LENGTH);
-
-    painter->setRenderHint(QPainter::Antialiasing);
-
-    double scale_factor = 1.0 / scale_;
-    if (scale_factor < 1.0) {
-        scale_factor = 1.0;
-    }
-
-    if (ccs.type == TokenType::SIG) {
-        //        scale_factor *= 0.5;
-    }
-
-    if (ccs.active) {
-        scale_factor *= 3;
-    }
-
-    ccs.minimized = ccs.minimized_from || ccs.minimized_to;
-    ccs.r = ccs.minimized ? view_core_.getStyle().lineWidth() / 2.0 : view_core_.getStyle().lineWidth();
-    ccs.r *= scale_factor;
-
     double max_slack_height = 40.0;
     double mindist_for_slack = 60.0;
     double slack_smooth_distance = 300.0;
 
     Fulcrum first(-1, convert(from), Fulcrum::FULCRUM_OUT, convert(from), convert(from));
     const Fulcrum* current = &first;
-    //    const Fulcrum* last = current;
 
-    std::vector<Fulcrum> targets;
-    if (id >= 0) {
-        ConnectionDescription connection = graph_facade_->getConnectionWithId(id);
-        targets = connection.fulcrums;
-    }
+    std::vector<Fulcrum> targets = fulcrums;
     targets.emplace_back(-1, convert(to), Fulcrum::FULCRUM_IN, convert(to), convert(to));
 
     int sub_section = 0;
 
     QPointF cp1, cp2;
 
-    // paths
-    typedef std::pair<QPainterPath, int> Path;
-    std::vector<Path> paths;
-
     // generate lines
     for (std::size_t i = 0; i < targets.size(); ++i) {
         const Fulcrum& next = targets[i];
@@ -1054,14 +1044,74 @@ std::vector<QRectF> DesignerScene::drawConnection(QPainter* painter, const QPoin
             }
         }
 
-        path.cubicTo(cp1, cp2, next_pos);
+        if (simplified) {
+            path.lineTo(next_pos);
+        } else {
+            path.cubicTo(cp1, cp2, next_pos);
+        }
 
-        paths.push_back(std::make_pair(path, sub_section));
+        paths.push_back(path);
 
-        //        last = current;
         current = &next;
         ++sub_section;
     }
+}
+
+DesignerScene::ConnectionGeometry DesignerScene::drawConnection(QPainter* painter, const QPointF& from, const QPointF& real_to, int id)
+{
+    QPointF to = offset(real_to, ccs.end_pos, view_core_.getStyle().lineWidth() * ARROW_LENGTH);
+
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    double scale_factor = 1.0 / scale_;
+    if (scale_factor < 1.0) {
+        scale_factor = 1.0;
+    }
+
+    // when zoomed out far enough, details of the curves are not visible anymore
+    bool simplified = scale_ < SIMPLIFIED_SCALE;
+
+    // the active state only changes the width, so the cached geometry must account for the widest case
+    double margin = (3 * view_core_.getStyle().lineWidth() + 6) * scale_factor;
+
+    if (ccs.type == TokenType::SIG) {
+        //        scale_factor *= 0.5;
+    }
+
+    if (ccs.active) {
+        scale_factor *= 3;
+    }
+
+    ccs.minimized = ccs.minimized_from || ccs.minimized_to;
+    ccs.r = ccs.minimized ? view_core_.getStyle().lineWidth() / 2.0 : view_core_.getStyle().lineWidth();
+    ccs.r *= scale_factor;
+
+    ConnectionGeometry geometry;
+    geometry.stroke_width = ccs.r * 1.75;
+
+    auto cached = id >= 0 ? connection_cache_.find(id) : connection_cache_.end();
+    bool reuse = false;
+    if (cached != connection_cache_.end() && cached->second.placed) {
+        const ConnectionGeometry& last = cached->second.geometry;
+        reuse = last.from == from && last.to == to && last.start_pos == ccs.start_pos && last.end_pos == ccs.end_pos;
+        if (!reuse) {
+            // a port has moved without notifying us, the connection has to be placed again
+            unplaceConnection(id);
+        }
+    }
+
+    geometry.from = from;
+    geometry.to = to;
+    geometry.start_pos = ccs.start_pos;
+    geometry.end_pos = ccs.end_pos;
+
+    if (reuse) {
+        geometry.paths = cached->second.geometry.paths;
+        geometry.bounding_boxes = cached->second.geometry.bounding_boxes;
+    } else {
+        generatePaths(from, to, cached != connection_cache_.end() ? cached->second.description.fulcrums : std::vector<Fulcrum>(), simplified, geometry.paths);
+    }
+    const std::vector<QPainterPath>& paths = geometry.paths;
 
     // arrow
     QPolygonF arrow;
@@ -1082,14 +1132,14 @@ std::vector<QRectF> DesignerScene::drawConnection(QPainter* painter, const QPoin
     // draw
     if (ccs.highlighted) {
         painter->setPen(QPen(Qt::black, ccs.r + 6 * scale_factor, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        for (const Path& path : paths) {
-            painter->drawPath(path.first);
+        for (const QPainterPath& path : paths) {
+            painter->drawPath(path);
         }
         painter->drawPath(arrow_path);
 
         painter->setPen(QPen(Qt::white, ccs.r + 3 * scale_factor, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        for (const Path& path : paths) {
-            painter->drawPath(path.first);
+        for (const QPainterPath& path : paths) {
+            painter->drawPath(path);
         }
         painter->drawPath(arrow_path);
     }
@@ -1138,40 +1188,42 @@ std::vector<QRectF> DesignerScene::drawConnection(QPainter* painter, const QPoin
         color_end.setAlpha(200);
     }
 
-    QLinearGradient lg(from, to);
-    lg.setColorAt(0, color_start);
-    lg.setColorAt(1, color_end);
-
-    painter->setPen(QPen(QBrush(lg), ccs.r * 0.75, ccs.target_is_pipelining ? Qt::DotLine : Qt::SolidLine, ccs.target_is_pipelining ? Qt::SquareCap : Qt::RoundCap, Qt::RoundJoin));
-
-    std::vector<QRectF> bounding_boxes;
+    QBrush line_brush(color_end);
+    if (!simplified) {
+        QLinearGradient lg(from, to);
+        lg.setColorAt(0, color_start);
+        lg.setColorAt(1, color_end);
+        line_brush = QBrush(lg);
+    }
 
-    for (const Path& path : paths) {
-        painter->drawPath(path.first);
-        bounding_boxes.push_back(path.first.boundingRect());
+    painter->setPen(QPen(line_brush, ccs.r * 0.75, ccs.target_is_pipelining ? Qt::DotLine : Qt::SolidLine, ccs.target_is_pipelining ? Qt::SquareCap : Qt::RoundCap, Qt::RoundJoin));
 
-        if (id >= 0 && schema_dirty_) {
-            QPen schema_pen = QPen(QColor(id2rgb(id, path.second)), ccs.r * 1.75, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
-            schematics_painter->setPen(schema_pen);
-            schematics_painter->drawPath(path.first);
-        }
+    for (const QPainterPath& path : paths) {
+        painter->drawPath(path);
     }
     painter->setBrush(color_end);
     painter->setPen(QPen(painter->brush(), 1.0));
     painter->drawPath(arrow_path);
 
-    bounding_boxes.push_back(arrow_path.boundingRect());
+    if (!reuse) {
+        for (const QPainterPath& path : paths) {
+            geometry.bounding_boxes.push_back(path.boundingRect().adjusted(-margin, -margin, margin, margin));
+        }
+        geometry.bounding_boxes.push_back(arrow_path.boundingRect().adjusted(-margin, -margin, margin, margin));
+    }
 
     if (draw_schema_) {
         painter->setBrush(QBrush());
-        for (auto r : bounding_boxes) {
+        for (const QRectF& r : geometry.bounding_boxes) {
             painter->drawRect(r);
         }
     }
 
-    painter->drawText(QPointF(from + real_to) * 0.5, ccs.label);
+    if (!simplified) {
+        painter->drawText(QPointF(from + real_to) * 0.5, ccs.label);
+    }
 
-    return bounding_boxes;
+    return geometry;
 }
 
 void DesignerScene::addPort(Port* port)
@@ -1430,10 +1482,139 @@ std::vector<NodeBox*> DesignerScene::getSelectedBoxes() const
 
 void DesignerScene::invalidateSchema()
 {
-    schema_dirty_ = true;
+    connection_grid_.clear();
+    for (auto& entry : connection_cache_) {
+        entry.second.placed = false;
+        unplaced_connections_.insert(entry.first);
+    }
     update();
 }
 
+void DesignerScene::invalidateConnection(int id)
+{
+    auto pos = connection_cache_.find(id);
+    if (pos == connection_cache_.end()) {
+        return;
+    }
+
+    unplaceConnection(id);
+    pos->second.stale = true;
+    update();
+}
+
+void DesignerScene::invalidateNodeConnections(const UUID& node)
+{
+    auto pos = node_connections_.find(node);
+    if (pos == node_connections_.end()) {
+        return;
+    }
+
+    for (int id : pos->second) {
+        unplaceConnection(id);
+    }
+}
+
+void DesignerScene::placeConnection(int id, const ConnectionGeometry& geometry)
+{
+    auto pos = connection_cache_.find(id);
+    apex_assert_hard(pos != connection_cache_.end());
+
+    CachedConnection& cached = pos->second;
+    cached.geometry = geometry;
+    cached.placed = true;
+    unplaced_connections_.erase(id);
+
+    for (const QRectF& bb : geometry.bounding_boxes) {
+        for (const GridCell& cell : coveredCells(bb, GRID_CELL_SIZE)) {
+            connection_grid_[cell].insert(id);
+        }
+    }
+}
+
+void DesignerScene::unplaceConnection(int id)
+{
+    auto pos = connection_cache_.find(id);
+    if (pos == connection_cache_.end()) {
+        return;
+    }
+
+    CachedConnection& cached = pos->second;
+    if (cached.placed) {
+        for (const QRectF& bb : cached.geometry.bounding_boxes) {
+            for (const GridCell& cell : coveredCells(bb, GRID_CELL_SIZE)) {
+                auto cell_pos = connection_grid_.find(cell);
+                if (cell_pos != connection_grid_.end()) {
+                    cell_pos->second.erase(id);
+                    if (cell_pos->second.empty()) {
+                        connection_grid_.erase(cell_pos);
+                    }
+                }
+            }
+        }
+        cached.placed = false;
+        cached.geometry = ConnectionGeometry();
+    }
+
+    unplaced_connections_.insert(id);
+}
+
+std::set<int> DesignerScene::findConnections(const QRectF& rect) const
+{
+    // connections without geometry have to be drawn once to be placed
+    std::set<int> result = unplaced_connections_;
+
+    for (const GridCell& cell : coveredCells(rect, GRID_CELL_SIZE)) {
+        auto cell_pos = connection_grid_.find(cell);
+        if (cell_pos == connection_grid_.end()) {
+            continue;
+        }
+
+        for (int id : cell_pos->second) {
+            if (result.find(id) != result.end()) {
+                continue;
+            }
+
+            const ConnectionGeometry& geometry = connection_cache_.at(id).geometry;
+            for (const QRectF& bb : geometry.bounding_boxes) {
+                if (bb.intersects(rect)) {
+                    result.insert(id);
+                    break;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::pair<int, int> DesignerScene::findConnectionAt(const QPointF& pos) const
+{
+    auto cell_pos = connection_grid_.find(coveredCells(QRectF(pos, QSizeF(0, 0)), GRID_CELL_SIZE).front());
+    if (cell_pos == connection_grid_.end()) {
+        return std::make_pair(-1, -1);
+    }
+
+    for (int id : cell_pos->second) {
+        const ConnectionGeometry& geometry = connection_cache_.at(id).geometry;
+
+        QPainterPathStroker stroker;
+        stroker.setWidth(geometry.stroke_width);
+        stroker.setCapStyle(Qt::RoundCap);
+        stroker.setJoinStyle(Qt::RoundJoin);
+
+        for (std::size_t sub_section = 0; sub_section < geometry.paths.size(); ++sub_section) {
+            if (!geometry.bounding_boxes[sub_section].contains(pos)) {
+                continue;
+            }
+            if (stroker.createStroke(geometry.paths[sub_section]).contains(pos)) {
+                return std::make_pair(id, static_cast<int>(sub_section));
+            }
+        }
+    }
+
+    return std::make_pair(-1, -1);
+}
+
 void DesignerScene::refresh()
 {
     invalidateSchema();
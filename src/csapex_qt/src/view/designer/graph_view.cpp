@@ -951,6 +951,9 @@ void GraphView::addBox(NodeBox* box)
 
     QObject::connect(proxy, &MovableGraphicsProxyWidget::moved, this, &GraphView::movedBoxes);
 
+    UUID node_uuid = facade->getUUID();
+    QObject::connect(proxy, &QGraphicsWidget::geometryChanged, this, [this, node_uuid]() { scene_->invalidateNodeConnections(node_uuid); });
+
     boxes_.push_back(box);
 
     for (QGraphicsItem* item : items()) {
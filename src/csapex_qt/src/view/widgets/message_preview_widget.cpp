@@ -2,12 +2,12 @@
 #include <csapex/view/widgets/message_preview_widget.h>
 
 /// PROJECT
-#include <csapex/msg/direct_connection.h>
 #include <csapex/manager/message_renderer_manager.h>
-#include <csapex/msg/io.h>
+#include <csapex/model/token.h>
 #include <csapex/msg/generic_value_message.hpp>
-#include <csapex/msg/any_message.h>
-#include <csapex/utility/uuid_provider.h>
+#include <csapex/msg/input.h>
+#include <csapex/msg/output.h>
+#include <csapex/msg/output_tap.h>
 #include <csapex/utility/exceptions.h>
 
 /// SYSTEM
@@ -19,58 +19,70 @@
 using namespace csapex;
 using namespace csapex::impl;
 
-PreviewInput::PreviewInput(QPointer<MessagePreviewWidget> parent) : Input(UUIDProvider::makeUUID_without_parent("message_preview_in")), parent_(parent)
+namespace
 {
-    setType(std::make_shared<connection_types::AnyMessage>());
-    setVirtual(true);
+template <typename T>
+bool getExactValue(const TokenDataConstPtr& message, T& value)
+{
+    if (auto v = std::dynamic_pointer_cast<connection_types::GenericValueMessage<T> const>(message)) {
+        value = v->value;
+        return true;
+    }
+    return false;
 }
+}  // namespace
 
-void PreviewInput::setToken(TokenPtr token)
+PreviewRenderer::PreviewRenderer(QPointer<MessagePreviewWidget> parent) : parent_(parent)
 {
-    Input::setToken(token);
+}
 
-    if (isConnected()) {
-        TokenDataConstPtr message = token->getTokenData();
+void PreviewRenderer::render(const TokenConstPtr& token)
+{
+    // called from the tap's thread, the producer is not blocked while rendering
+    std::unique_lock<std::mutex> lock(parent_mutex_);
+    if (!parent_) {
+        return;
+    }
 
-        if (!parent_) {
-            return;
-        }
-        try {
-            if (msg::isExactValue<std::string>(this)) {
-                parent_->displayTextRequest(QString::fromStdString(msg::getValue<std::string>(this)));
-
-            } else if (msg::isExactValue<int>(this)) {
-                parent_->displayTextRequest(QString::number(msg::getValue<int>(this)));
-
-            } else if (msg::isExactValue<float>(this)) {
-                parent_->displayTextRequest(QString::number(msg::getValue<float>(this)));
-
-            } else if (msg::isExactValue<double>(this)) {
-                parent_->displayTextRequest(QString::number(msg::getValue<float>(this)));
-
-            } else {
-                MessageRenderer::Ptr renderer = MessageRendererManager::instance().createMessageRenderer(message);
-                if (renderer) {
-                    std::unique_ptr<QImage> img = renderer->render(message);
-                    if (parent_) {
-                        parent_->displayImageRequest(*img);
-                    }
-                }
+    TokenDataConstPtr message = token->getTokenData();
+    try {
+        std::string str;
+        int i;
+        float f;
+        double d;
+        if (getExactValue(message, str)) {
+            parent_->displayTextRequest(QString::fromStdString(str));
+
+        } else if (getExactValue(message, i)) {
+            parent_->displayTextRequest(QString::number(i));
+
+        } else if (getExactValue(message, f)) {
+            parent_->displayTextRequest(QString::number(f));
+
+        } else if (getExactValue(message, d)) {
+            parent_->displayTextRequest(QString::number(d));
+
+        } else {
+            MessageRenderer::Ptr renderer = MessageRendererManager::instance().createMessageRenderer(message);
+            if (renderer) {
+                std::unique_ptr<QImage> img = renderer->render(message);
+                parent_->displayImageRequest(*img);
             }
-        } catch (const std::exception& e) {
-            // silent death
         }
+    } catch (const std::exception& e) {
+        // silent death
     }
 }
 
-void PreviewInput::detach()
+void PreviewRenderer::detach()
 {
+    std::unique_lock<std::mutex> lock(parent_mutex_);
     parent_.clear();
 }
 
 MessagePreviewWidget::MessagePreviewWidget() : pm_item_(nullptr), txt_item_(nullptr)
 {
-    input_ = std::make_shared<impl::PreviewInput>(this);
+    renderer_ = std::make_shared<impl::PreviewRenderer>(this);
     setScene(new QGraphicsScene);
 
     setWindowFlags(windowFlags() | Qt::FramelessWindowHint);
@@ -91,61 +103,63 @@ MessagePreviewWidget::MessagePreviewWidget() : pm_item_(nullptr), txt_item_(null
 
 MessagePreviewWidget::~MessagePreviewWidget()
 {
+    renderer_->detach();
+    if (isConnected()) {
+        disconnect();
+    }
     if (scene()) {
         delete scene();
         setScene(nullptr);
     }
-    input_->detach();
-    if (isConnected()) {
-        disconnect();
-    }
 }
 
 void MessagePreviewWidget::connectTo(ConnectorPtr c)
 {
     scene()->clear();
 
-    if (OutputPtr o = std::dynamic_pointer_cast<Output>(c)) {
-        connectToImpl(o);
-    } else if (InputPtr i = std::dynamic_pointer_cast<Input>(c)) {
-        connectToImpl(i);
-    } else {
+    ConnectorPtr source = findSource(c);
+    if (!source) {
         return;
     }
 
-    if (connection_) {
-        QApplication::setOverrideCursor(Qt::BusyCursor);
-    }
-}
+    std::shared_ptr<impl::PreviewRenderer> renderer = renderer_;
+    OutputTapPtr tap = std::make_shared<OutputTap>([renderer](const TokenConstPtr& token) { renderer->render(token); });
 
-void MessagePreviewWidget::connectToImpl(OutputPtr out)
-{
     try {
-        connection_ = DirectConnection::connect(out, input_);
-        apex_assert_soft_msg(connection_, "could not connect preview widget");
-
-    } catch (const csapex::Failure& e) {
-        std::cerr << "connecting preview panel to " << out->getUUID() << " caused an assertion error: " << e.what() << std::endl;
+        if (!source->addTap(tap)) {
+            std::cerr << "connector " << source->getUUID() << " cannot be previewed" << std::endl;
+            return;
+        }
     } catch (const std::exception& e) {
-        std::cerr << "connecting preview panel to " << out->getUUID() << " failed: " << e.what() << std::endl;
-    } catch (...) {
-        std::cerr << "connecting preview panel to " << out->getUUID() << " failed with unknown cause" << std::endl;
+        std::cerr << "connecting preview panel to " << source->getUUID() << " failed: " << e.what() << std::endl;
+        return;
     }
+
+    connector_ = source;
+    tap_ = tap;
+
+    QApplication::setOverrideCursor(Qt::BusyCursor);
 }
 
-void MessagePreviewWidget::connectToImpl(InputPtr in)
+ConnectorPtr MessagePreviewWidget::findSource(const ConnectorPtr& c) const
 {
-    if (in->isConnected()) {
-        ConnectorPtr s = in->getSource()->shared_from_this();
-        if (OutputPtr source = std::dynamic_pointer_cast<Output>(s)) {
-            connection_ = DirectConnection::connect(source, input_);
+    if (!c) {
+        return nullptr;
+    }
+    if (c->isOutput()) {
+        return c;
+    }
+    if (InputPtr in = std::dynamic_pointer_cast<Input>(c)) {
+        if (in->isConnected()) {
+            return in->getSource();
         }
     }
+    return nullptr;
 }
 
 void MessagePreviewWidget::disconnect()
 {
-    if (!connection_) {
+    if (!tap_) {
         return;
     }
 
@@ -153,11 +167,9 @@ void MessagePreviewWidget::disconnect()
         QApplication::restoreOverrideCursor();
     }
 
-    OutputPtr out = connection_->from();
-    if (out) {
-        out->removeConnection(input_.get());
-    }
-    connection_.reset();
+    connector_->removeTap(tap_);
+    connector_.reset();
+    tap_.reset();
 }
 
 void MessagePreviewWidget::displayText(const QString& txt)
@@ -207,7 +219,7 @@ void MessagePreviewWidget::displayImage(const QImage& img)
 
 bool MessagePreviewWidget::isConnected() const
 {
-    return static_cast<bool>(connection_);
+    return static_cast<bool>(tap_);
 }
 
 /// MOC
@@ -23,6 +23,8 @@ enum class ConnectorNoteType
     /**
      * end: connect signals
      **/
+
+    TokenSampled
 };
 
 class ConnectorNote : public NoteImplementation<ConnectorNote>
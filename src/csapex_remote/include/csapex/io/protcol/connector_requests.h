@@ -21,6 +21,9 @@ public:
 
         IsConnectedTo,
         IsActivelyConnectedTo,
+
+        AddTap,
+        RemoveTap,
     };
 
     class ConnectorRequest : public RequestImplementation<ConnectorRequest>
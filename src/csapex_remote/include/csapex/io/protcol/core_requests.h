@@ -30,7 +30,8 @@ public:
         CoreSendNotification,
 
         CoreGetPause,
-        CoreGetSteppingMode
+        CoreGetSteppingMode,
+        CoreGetTokenMemoryStatistics
     };
 
     class CoreRequest : public RequestImplementation<CoreRequest>
@@ -20,6 +20,8 @@ public:
 
         GenerateUUID,
 
+        GetCachedState,
+
 #define HANDLE_ACCESSOR(_enum, type, function) _enum,
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function) HANDLE_ACCESSOR(_enum, type, function)
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function) HANDLE_ACCESSOR(_enum, type, function)
@@ -26,6 +26,11 @@ public:
         IsParameterInput,
         IsParameterOutput,
 
+        ServeSubgraph,
+        StopServingSubgraph,
+
+        GetCachedAccessors,
+
 #define HANDLE_ACCESSOR(_enum, type, function) _enum,
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function) HANDLE_ACCESSOR(_enum, type, function)
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function) HANDLE_ACCESSOR(_enum, type, function)
@@ -98,6 +103,12 @@ public:
 public:
     using RequestT = NodeRequest;
     using ResponseT = NodeResponse;
+
+    /**
+     * @brief collectCachedState gathers everything a NodeFacadeProxy caches:
+     *        the accessor values in the order of the accessor list, followed by the node state and the parameters
+     */
+    static std::vector<boost::any> collectCachedState(const NodeFacadePtr& nf);
 };
 
 }  // namespace csapex
@@ -27,6 +27,8 @@ FWD(Server)
 FWD(GraphServer)
 FWD(NodeServer)
 FWD(ConnectorServer)
+FWD(RemoteSubgraphBridge)
+FWD(RemoteSubgraphServer)
 
 namespace io
 {
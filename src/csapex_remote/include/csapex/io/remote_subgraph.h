@@ -0,0 +1,114 @@
+#ifndef REMOTE_SUBGRAPH_H
+#define REMOTE_SUBGRAPH_H
+
+/// PROJECT
+#include <csapex/io/remote_io_fwd.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/model/observer.h>
+#include <csapex/model/subgraph_bridge.h>
+#include <csapex/serialization/serialization_fwd.h>
+#include <csapex/utility/uuid.h>
+
+/// SYSTEM
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace csapex
+{
+/**
+ * @brief RemoteSubgraphBridge executes a subgraph on another csapex server.
+ *        Mark a SubgraphNode as remote by setting this as its bridge, the server runs a subgraph with ports of the same labels.
+ *        Messages are sent as RawMessages addressed to the remote subgraph, at most <window> passes are in flight,
+ *        further passes wait locally until the server has reported the results of an earlier one.
+ *        A pass that the server could not process fails on its own. When the session ends, the server answers out of order
+ *        or a pass is not answered within <timeout>, the bridge is unusable and all passes that have not been completed fail.
+ */
+class RemoteSubgraphBridge : public SubgraphBridge, public Observer
+{
+public:
+    RemoteSubgraphBridge(SessionPtr session, const AUUID& remote_subgraph, std::size_t window = 1, std::chrono::milliseconds timeout = std::chrono::seconds(30));
+    ~RemoteSubgraphBridge();
+
+    void process(const SubgraphMessages& inputs, Callback done, ErrorCallback failed) override;
+
+    std::size_t getInFlightCount() const;
+
+private:
+    struct Pass
+    {
+        uint32_t sequence;
+        SubgraphMessages messages;
+        Callback done;
+        ErrorCallback failed;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    void sendPending();
+    void handleResult(const StreamableConstPtr& packet);
+    void failAll(const std::string& error);
+    void watchDeadlines();
+
+private:
+    SessionPtr session_;
+    AUUID remote_subgraph_;
+    std::size_t window_;
+    std::chrono::milliseconds timeout_;
+
+    mutable std::recursive_mutex passes_mutex_;
+    std::condition_variable_any passes_changed_;
+    uint32_t next_sequence_;
+    std::string failure_;
+    std::deque<Pass> waiting_;
+    std::deque<Pass> in_flight_;
+
+    std::thread watchdog_;
+};
+
+/**
+ * @brief RemoteSubgraphServer is the server side of a RemoteSubgraphBridge, it runs a local subgraph for the messages of one session.
+ *        Passes are processed strictly one after another, in the order they were received.
+ *        A pass that cannot be started is answered with an error instead of outputs.
+ */
+class RemoteSubgraphServer : public std::enable_shared_from_this<RemoteSubgraphServer>
+{
+public:
+    /**
+     * @brief serve starts processing the passes that the session sends to the subgraph
+     */
+    static void serve(const SessionPtr& session, const SubgraphNodePtr& subgraph, const AUUID& uuid);
+    static void stop(const SessionPtr& session, const AUUID& uuid);
+
+public:
+    RemoteSubgraphServer(const SessionPtr& session, const SubgraphNodePtr& subgraph, const AUUID& uuid);
+    ~RemoteSubgraphServer();
+
+private:
+    void handlePass(const StreamableConstPtr& packet);
+    void processNext();
+    void reply(uint32_t sequence, const SubgraphMessages& outputs, const std::string& error);
+
+private:
+    SessionWeakPtr session_;
+    SubgraphNodePtr subgraph_;
+    AUUID uuid_;
+
+    std::recursive_mutex queue_mutex_;
+    std::deque<std::pair<uint32_t, SubgraphMessages>> queue_;
+    bool busy_;
+};
+
+namespace remote_subgraph
+{
+/**
+ * @brief write encodes a pass, a non-empty error marks a pass that the server could not process
+ */
+void write(SerializationBuffer& data, uint32_t sequence, const SubgraphMessages& messages, const std::string& error = "");
+void read(const SerializationBuffer& data, uint32_t& sequence, SubgraphMessages& messages, std::string& error);
+}  // namespace remote_subgraph
+
+}  // namespace csapex
+
+#endif  // REMOTE_SUBGRAPH_H
@@ -6,6 +6,10 @@
 #include <csapex/io/session.h>
 #include <csapex/io/proxy.h>
 
+/// SYSTEM
+#include <mutex>
+#include <vector>
+
 namespace csapex
 {
 class ConnectorProxy : public Connector, public Observer, public Proxy
@@ -17,6 +21,13 @@ public:
     virtual bool isConnectedTo(const UUID& other) const override;
     virtual bool isActivelyConnectedTo(const UUID& other) const override;
 
+    /**
+     * Taps are forwarded to the server, which samples the connector and sends the tokens back.
+     * All local taps share one remote tap running at the maximum frequency of the first local tap.
+     */
+    virtual bool addTap(const OutputTapPtr& tap) override;
+    virtual void removeTap(const OutputTapPtr& tap) override;
+
 /**
  * begin: generate getters
  **/
@@ -51,6 +62,9 @@ private:
      **/
 
     bool connected_;
+
+    std::mutex taps_mutex_;
+    std::vector<OutputTapPtr> taps_;
 };
 
 }  // namespace csapex
@@ -7,6 +7,11 @@
 #include <csapex/io/io_fwd.h>
 #include <csapex/io/proxy.h>
 
+/// SYSTEM
+#include <boost/any.hpp>
+#include <mutex>
+#include <unordered_map>
+
 namespace csapex
 {
 class GraphImplementation;
@@ -43,7 +48,10 @@ public:
     ConnectionDescription getConnection(const UUID& from, const UUID& to) const;
     ConnectionDescription getConnectionWithId(int id) const;
 
-    void reload();
+    /**
+     * @brief load adds the nodes and connections of the remote graph, node_states holds the cached state of each node
+     */
+    void load(const std::vector<UUID>& nodes, const std::vector<boost::any>& node_states, const std::vector<ConnectionDescription>& connections);
 
 /**
  * begin: generate getters
@@ -60,7 +68,7 @@ public:
      **/
 
 private:
-    void vertexAdded(const UUID& id);
+    void vertexAdded(const UUID& id, const std::vector<boost::any>& cached_state = std::vector<boost::any>());
     void vertexRemoved(const UUID& id);
 
     void connectionAdded(const ConnectionDescription& id);
@@ -69,7 +77,11 @@ private:
 private:
     io::ChannelPtr graph_channel_;
 
+    // the graph structure is written by the notes of the server and read by the views
+    mutable std::recursive_mutex cache_mutex_;
+
     std::vector<graph::VertexPtr> remote_vertices_;
+    std::unordered_map<UUID, NodeFacadePtr, UUID::Hasher> node_facades_;
     std::vector<ConnectionDescription> edges_;
 
 /**
@@ -5,6 +5,9 @@
 #include <csapex/io/io_fwd.h>
 #include <csapex/io/proxy.h>
 
+/// SYSTEM
+#include <mutex>
+
 namespace csapex
 {
 class GraphFacadeImplementation;
@@ -89,6 +92,8 @@ private:
 
     AUUID uuid_;
 
+    mutable std::recursive_mutex cache_mutex_;
+
 /**
  * begin: generate caches
  **/
@@ -8,6 +8,8 @@
 #include <csapex/io/proxy.h>
 
 /// SYSTEM
+#include <boost/any.hpp>
+#include <mutex>
 #include <unordered_map>
 
 namespace csapex
@@ -17,7 +19,11 @@ class ProfilerProxy;
 class CSAPEX_CORE_EXPORT NodeFacadeProxy : public NodeFacade, public Proxy
 {
 public:
-    NodeFacadeProxy(const SessionPtr& session, AUUID uuid);
+    /**
+     * @brief NodeFacadeProxy fills its caches from cached_state, as collected by NodeRequests::collectCachedState.
+     *        Without it, the state is requested from the server.
+     */
+    NodeFacadeProxy(const SessionPtr& session, AUUID uuid, std::vector<boost::any> cached_state = std::vector<boost::any>());
 
     ~NodeFacadeProxy();
 
@@ -74,11 +80,19 @@ private:
 
     void createParameterProxy(param::ParameterPtr proxy) const;
 
+    std::size_t fillCaches(const std::vector<boost::any>& values);
+
 private:
     AUUID uuid_;
 
     io::ChannelPtr node_channel_;
 
+    /**
+     * guards all cached state, it is written by the notes of the server and read by the views,
+     * requests to the server are never made while holding it
+     */
+    mutable std::recursive_mutex cache_mutex_;
+
 /**
  * begin: generate caches
  **/
@@ -23,6 +23,7 @@ HANDLE_DYNAMIC_ACCESSOR(GetInternalOutputs, internal_outputs_changed, std::vecto
 HANDLE_DYNAMIC_ACCESSOR(GetInternalEvents, internal_events_changed, std::vector<ConnectorDescription>, getInternalEvents)
 HANDLE_DYNAMIC_ACCESSOR(GetInternalSlots, internal_slots_changed, std::vector<ConnectorDescription>, getInternalSlots)
 HANDLE_ACCESSOR(IsProfiling, bool, isProfiling)
+HANDLE_ACCESSOR(GetTokenLatencyStatistics, TokenLatencyStatistics, getTokenLatencyStatistics)
 
 HANDLE_STATIC_ACCESSOR(HasVariadicInputs, bool, hasVariadicInputs)
 HANDLE_STATIC_ACCESSOR(HasVariadicOutputs, bool, hasVariadicOutputs)
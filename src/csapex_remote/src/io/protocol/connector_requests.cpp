@@ -10,6 +10,9 @@
 #include <csapex/model/graph.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/model/node_handle.h>
+#include <csapex/model/token.h>
+#include <csapex/msg/output_tap.h>
+#include <csapex/io/protcol/connector_notes.h>
 #include <csapex/serialization/parameter_serializer.h>
 #include <csapex/serialization/request_serializer.h>
 #include <csapex/serialization/io/std_io.h>
@@ -18,11 +21,57 @@
 
 /// SYSTEM
 #include <iostream>
+#include <map>
+#include <mutex>
 
 CSAPEX_REGISTER_REQUEST_SERIALIZER(ConnectorRequests)
 
 using namespace csapex;
 
+namespace
+{
+/**
+ * Taps requested by remote clients, they are released when the client's session stops
+ */
+std::mutex g_session_taps_mutex;
+std::map<Session*, std::map<AUUID, OutputTapPtr>> g_session_taps;
+
+void addSessionTap(const SessionPtr& session, const AUUID& uuid, const OutputTapPtr& tap)
+{
+    std::unique_lock<std::mutex> lock(g_session_taps_mutex);
+    auto pos = g_session_taps.find(session.get());
+    if (pos == g_session_taps.end()) {
+        session->stopped.connect([](Session* session) {
+            std::map<AUUID, OutputTapPtr> released;
+            {
+                std::unique_lock<std::mutex> lock(g_session_taps_mutex);
+                auto pos = g_session_taps.find(session);
+                if (pos != g_session_taps.end()) {
+                    released.swap(pos->second);
+                    g_session_taps.erase(pos);
+                }
+            }
+        });
+    }
+    g_session_taps[session.get()][uuid] = tap;
+}
+
+OutputTapPtr removeSessionTap(const SessionPtr& session, const AUUID& uuid)
+{
+    std::unique_lock<std::mutex> lock(g_session_taps_mutex);
+    OutputTapPtr tap;
+    auto pos = g_session_taps.find(session.get());
+    if (pos != g_session_taps.end()) {
+        auto tap_pos = pos->second.find(uuid);
+        if (tap_pos != pos->second.end()) {
+            tap = tap_pos->second;
+            pos->second.erase(tap_pos);
+        }
+    }
+    return tap;
+}
+}  // namespace
+
 ///
 /// REQUEST
 ///
@@ -71,6 +120,30 @@ ResponsePtr ConnectorRequests::ConnectorRequest::execute(const SessionPtr& sessi
             UUID other_id = boost::any_cast<UUID>(payload_);
             return std::make_shared<ConnectorResponse>(request_type_, c->isActivelyConnectedTo(other_id), getRequestID(), uuid_);
         }
+        case ConnectorRequests::ConnectorRequestType::AddTap: {
+            double max_frequency = boost::any_cast<double>(payload_);
+            std::weak_ptr<Session> weak_session = session;
+            AUUID uuid = uuid_;
+            OutputTapPtr tap = std::make_shared<OutputTap>(
+                [weak_session, uuid](const TokenConstPtr& token) {
+                    if (SessionPtr session = weak_session.lock()) {
+                        session->sendNote<ConnectorNote>(ConnectorNoteType::TokenSampled, uuid, token->getTokenData());
+                    }
+                },
+                max_frequency);
+            if (!c->addTap(tap)) {
+                return std::make_shared<Feedback>(std::string("connector ") + uuid_.getFullName() + " cannot be tapped", getRequestID());
+            }
+            if (OutputTapPtr previous = removeSessionTap(session, uuid_)) {
+                c->removeTap(previous);
+            }
+            addSessionTap(session, uuid_, tap);
+        } break;
+        case ConnectorRequests::ConnectorRequestType::RemoveTap: {
+            if (OutputTapPtr tap = removeSessionTap(session, uuid_)) {
+                c->removeTap(tap);
+            }
+        } break;
 
         /**
          * begin: generate cases
@@ -7,6 +7,7 @@
 #include <csapex/io/feedback.h>
 #include <csapex/utility/uuid_provider.h>
 #include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/token_memory.h>
 #include <csapex/serialization/parameter_serializer.h>
 #include <csapex/serialization/snippet.h>
 
@@ -93,6 +94,8 @@ ResponsePtr CoreRequests::CoreRequest::execute(const SessionPtr& session, CsApex
             return std::make_shared<CoreResponse>(request_type_, core.isSteppingMode(), getRequestID());
         case CoreRequestType::CoreGetPause:
             return std::make_shared<CoreResponse>(request_type_, core.isPaused(), getRequestID());
+        case CoreRequestType::CoreGetTokenMemoryStatistics:
+            return std::make_shared<CoreResponse>(request_type_, core.getTokenMemoryStatistics(), getRequestID());
 
         default:
             return std::make_shared<Feedback>(std::string("unknown core request type ") + std::to_string((int)request_type_), getRequestID());
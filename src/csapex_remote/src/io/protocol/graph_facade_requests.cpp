@@ -4,10 +4,12 @@
 /// PROJECT
 #include <csapex/command/command.h>
 #include <csapex/io/feedback.h>
+#include <csapex/io/protcol/node_requests.h>
 #include <csapex/io/raw_message.h>
 #include <csapex/io/session.h>
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/graph.h>
+#include <csapex/model/graph/graph_impl.h>
 #include <csapex/serialization/parameter_serializer.h>
 #include <csapex/serialization/request_serializer.h>
 #include <csapex/serialization/io/std_io.h>
@@ -52,6 +54,27 @@ ResponsePtr GraphFacadeRequests::GraphFacadeRequest::execute(const SessionPtr& s
             UUID result = gf->generateUUID(getArgument<std::string>(0));
             return std::make_shared<GraphFacadeResponse>(request_type_, uuid_, result, getRequestID());
         } break;
+        case GraphFacadeRequestType::GetCachedState: {
+            // everything a proxy of the graph caches: the accessor values, the nodes with their cached state and the connections
+            std::vector<boost::any> accessors;
+#define HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function) accessors.push_back(gf->function());
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function) HANDLE_STATIC_ACCESSOR(_enum, type, function)
+#define HANDLE_SIGNAL(_enum, signal)
+
+#include <csapex/model/graph_facade_proxy_accessors.hpp>
+
+            GraphImplementationPtr graph = gf_local->getLocalGraph();
+            std::vector<UUID> nodes = graph->getAllNodeUUIDs();
+            std::vector<boost::any> node_states;
+            node_states.reserve(nodes.size());
+            for (const UUID& node : nodes) {
+                node_states.push_back(NodeRequests::collectCachedState(graph->findNodeFacade(node)));
+            }
+
+            std::vector<boost::any> result{ accessors, nodes, node_states, graph->enumerateAllConnections() };
+            return std::make_shared<GraphFacadeResponse>(request_type_, uuid_, result, getRequestID());
+        }
 
         /**
          * begin: generate cases
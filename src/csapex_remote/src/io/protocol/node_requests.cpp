@@ -5,12 +5,15 @@
 #include <csapex/command/command.h>
 #include <csapex/io/feedback.h>
 #include <csapex/io/raw_message.h>
+#include <csapex/io/remote_subgraph.h>
 #include <csapex/io/session.h>
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/node_characteristics.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/model/node_handle.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/model/token_latency_statistics.h>
 #include <csapex/serialization/parameter_serializer.h>
 #include <csapex/serialization/request_serializer.h>
 #include <csapex/serialization/io/std_io.h>
@@ -24,6 +27,28 @@ CSAPEX_REGISTER_REQUEST_SERIALIZER(NodeRequests)
 
 using namespace csapex;
 
+std::vector<boost::any> NodeRequests::collectCachedState(const NodeFacadePtr& nf)
+{
+    std::vector<boost::any> result;
+    bool is_graph = nf->isGraph();
+#define HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function)                                                                                                                                                  \
+    if (NodeRequestType::_enum == NodeRequestType::GetSubgraphAUUID && !is_graph) {                                                                                                                    \
+        /* only graphs have a subgraph, the value is never read for other nodes */                                                                                                                     \
+        result.push_back(type());                                                                                                                                                                      \
+    } else {                                                                                                                                                                                           \
+        result.push_back(nf->function());                                                                                                                                                              \
+    }
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function) HANDLE_STATIC_ACCESSOR(_enum, type, function)
+#define HANDLE_SIGNAL(_enum, signal)
+
+#include <csapex/model/node_facade_proxy_accessors.hpp>
+
+    result.push_back(nf->getNodeState());
+    result.push_back(nf->getParameters());
+    return result;
+}
+
 ///
 /// REQUEST
 ///
@@ -91,6 +116,21 @@ ResponsePtr NodeRequests::NodeRequest::execute(const SessionPtr& session, CsApex
             return std::make_shared<NodeResponse>(request_type_, uuid_, result, getRequestID());
         }
 
+        case NodeRequestType::ServeSubgraph: {
+            SubgraphNodePtr subgraph = std::dynamic_pointer_cast<SubgraphNode>(nh->getNode().lock());
+            if (!subgraph) {
+                return std::make_shared<Feedback>(std::string("node ") + uuid_.getFullName() + " is not a subgraph", getRequestID());
+            }
+            RemoteSubgraphServer::serve(session, subgraph, uuid_);
+        } break;
+        case NodeRequestType::StopServingSubgraph:
+            RemoteSubgraphServer::stop(session, uuid_);
+            break;
+
+        case NodeRequestType::GetCachedAccessors: {
+            return std::make_shared<NodeResponse>(request_type_, uuid_, collectCachedState(nf), getRequestID());
+        }
+
         /**
          * begin: generate cases
          **/
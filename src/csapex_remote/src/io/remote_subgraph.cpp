@@ -0,0 +1,366 @@
+/// HEADER
+#include <csapex/io/remote_subgraph.h>
+
+/// PROJECT
+#include <csapex/io/protcol/node_requests.h>
+#include <csapex/io/raw_message.h>
+#include <csapex/io/session.h>
+#include <csapex/io/session_client.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/model/token_data.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+#include <csapex/utility/assert.h>
+#include <csapex/utility/exceptions.h>
+
+/// SYSTEM
+#include <iostream>
+#include <thread>
+
+using namespace csapex;
+
+namespace
+{
+/**
+ * @brief connect creates a bridge with its own session to the server, the session ends with the bridge
+ */
+SubgraphBridgePtr connect(const std::string& host, int port, const AUUID& remote_subgraph)
+{
+    SessionPtr session;
+    try {
+        session = std::make_shared<SessionClient>(host, port);
+    } catch (const boost::system::system_error& se) {
+        throw std::runtime_error(std::string("cannot connect to ") + host + ":" + std::to_string(port) + ": " + se.what());
+    }
+
+    session->start();
+    std::shared_ptr<std::thread> spinner = std::make_shared<std::thread>([session]() { session->run(); });
+
+    // busy waiting for the spinning thread, like the view core does
+    while (!session->isRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto shutdown = [session, spinner]() {
+        session->shutdown();
+        spinner->join();
+    };
+
+    RemoteSubgraphBridge* bridge;
+    try {
+        bridge = new RemoteSubgraphBridge(session, remote_subgraph);
+    } catch (...) {
+        shutdown();
+        throw;
+    }
+
+    return SubgraphBridgePtr(bridge, [shutdown](SubgraphBridge* bridge) {
+        delete bridge;
+        shutdown();
+    });
+}
+
+struct RemoteSubgraphBridgeRegistered
+{
+    RemoteSubgraphBridgeRegistered()
+    {
+        SubgraphBridgeFactory::instance().setConstructor(&connect);
+    }
+};
+RemoteSubgraphBridgeRegistered g_register_remote_subgraph_bridge_;
+}  // namespace
+
+void remote_subgraph::write(SerializationBuffer& data, uint32_t sequence, const SubgraphMessages& messages, const std::string& error)
+{
+    data << sequence;
+    data << error;
+    data << messages;
+}
+
+void remote_subgraph::read(const SerializationBuffer& data, uint32_t& sequence, SubgraphMessages& messages, std::string& error)
+{
+    data >> sequence;
+    data >> error;
+    data >> messages;
+}
+
+///
+/// BRIDGE
+///
+
+RemoteSubgraphBridge::RemoteSubgraphBridge(SessionPtr session, const AUUID& remote_subgraph, std::size_t window, std::chrono::milliseconds timeout)
+  : session_(session), remote_subgraph_(remote_subgraph), window_(window), timeout_(timeout), next_sequence_(0)
+{
+    apex_assert_hard(window_ > 0);
+    apex_assert_hard(timeout_.count() > 0);
+
+    observe(session_->raw_packet_received(remote_subgraph_), [this](const StreamableConstPtr& packet) { handleResult(packet); });
+    observe(session_->stopped, [this](Session*) { failAll("the session to the remote subgraph " + remote_subgraph_.getFullName() + " has ended"); });
+
+    session_->sendRequest<NodeRequests>(NodeRequests::NodeRequestType::ServeSubgraph, remote_subgraph_);
+
+    watchdog_ = std::thread([this]() { watchDeadlines(); });
+}
+
+RemoteSubgraphBridge::~RemoteSubgraphBridge()
+{
+    stopObserving();
+
+    if (session_->isRunning()) {
+        try {
+            session_->sendRequest<NodeRequests>(NodeRequests::NodeRequestType::StopServingSubgraph, remote_subgraph_);
+        } catch (const std::exception& e) {
+            std::cerr << "cannot stop the remote subgraph " << remote_subgraph_ << ": " << e.what() << std::endl;
+        }
+    }
+
+    failAll("the bridge to the remote subgraph " + remote_subgraph_.getFullName() + " has been removed");
+
+    // failing the bridge ends the watchdog, unless it is the watchdog that drops the last reference
+    if (watchdog_.get_id() == std::this_thread::get_id()) {
+        watchdog_.detach();
+    } else {
+        watchdog_.join();
+    }
+}
+
+void RemoteSubgraphBridge::process(const SubgraphMessages& inputs, Callback done, ErrorCallback failed)
+{
+    std::string failure;
+    {
+        std::unique_lock<std::recursive_mutex> lock(passes_mutex_);
+        failure = failure_;
+        if (failure.empty()) {
+            waiting_.push_back(Pass{ next_sequence_++, inputs, done, failed, {} });
+        }
+    }
+    if (!failure.empty()) {
+        failed(failure);
+        return;
+    }
+    sendPending();
+}
+
+std::size_t RemoteSubgraphBridge::getInFlightCount() const
+{
+    std::unique_lock<std::recursive_mutex> lock(passes_mutex_);
+    return in_flight_.size();
+}
+
+void RemoteSubgraphBridge::sendPending()
+{
+    std::unique_lock<std::recursive_mutex> lock(passes_mutex_);
+    while (!waiting_.empty() && in_flight_.size() < window_) {
+        Pass pass = waiting_.front();
+        waiting_.pop_front();
+
+        SerializationBuffer data;
+        remote_subgraph::write(data, pass.sequence, pass.messages);
+
+        // the inputs are not needed anymore, only the callback has to wait for the result
+        pass.messages.clear();
+        pass.deadline = std::chrono::steady_clock::now() + timeout_;
+        in_flight_.push_back(pass);
+
+        session_->write(std::make_shared<RawMessage>(data, remote_subgraph_));
+    }
+    passes_changed_.notify_all();
+}
+
+void RemoteSubgraphBridge::handleResult(const StreamableConstPtr& packet)
+{
+    RawMessageConstPtr raw = std::dynamic_pointer_cast<RawMessage const>(packet);
+    if (!raw) {
+        return;
+    }
+
+    uint32_t sequence;
+    SubgraphMessages outputs;
+    std::string error;
+    try {
+        SerializationBuffer data(raw->getData());
+        remote_subgraph::read(data, sequence, outputs, error);
+    } catch (const std::exception& e) {
+        failAll("cannot read the result of the remote subgraph " + remote_subgraph_.getFullName() + ": " + e.what());
+        return;
+    } catch (const Failure& f) {
+        failAll("cannot read the result of the remote subgraph " + remote_subgraph_.getFullName() + ": " + f.what());
+        return;
+    }
+
+    Pass pass;
+    {
+        std::unique_lock<std::recursive_mutex> lock(passes_mutex_);
+        if (in_flight_.empty()) {
+            // the pass has already failed
+            return;
+        }
+        if (in_flight_.front().sequence != sequence) {
+            // the server processes the passes in order, the results cannot be assigned anymore
+            lock.unlock();
+            failAll("the remote subgraph " + remote_subgraph_.getFullName() + " has answered pass " + std::to_string(sequence) + " out of order");
+            return;
+        }
+        pass = in_flight_.front();
+        in_flight_.pop_front();
+    }
+
+    // the result frees a slot in the window before the node can issue the next pass
+    sendPending();
+
+    if (error.empty()) {
+        pass.done(outputs);
+    } else {
+        pass.failed(error);
+    }
+}
+
+void RemoteSubgraphBridge::failAll(const std::string& error)
+{
+    std::deque<Pass> failed;
+    {
+        std::unique_lock<std::recursive_mutex> lock(passes_mutex_);
+        if (failure_.empty()) {
+            failure_ = error;
+        }
+        failed.swap(in_flight_);
+        failed.insert(failed.end(), waiting_.begin(), waiting_.end());
+        waiting_.clear();
+        passes_changed_.notify_all();
+    }
+
+    // the callbacks are called without the lock, they start the next pass of the node
+    for (const Pass& pass : failed) {
+        pass.failed(error);
+    }
+}
+
+void RemoteSubgraphBridge::watchDeadlines()
+{
+    std::unique_lock<std::recursive_mutex> lock(passes_mutex_);
+    while (failure_.empty()) {
+        if (in_flight_.empty()) {
+            passes_changed_.wait(lock);
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point deadline = in_flight_.front().deadline;
+        if (std::chrono::steady_clock::now() < deadline) {
+            passes_changed_.wait_until(lock, deadline);
+            continue;
+        }
+
+        // the server answers in order, a pass that never finishes blocks all later ones as well
+        uint32_t sequence = in_flight_.front().sequence;
+        lock.unlock();
+        failAll("the remote subgraph " + remote_subgraph_.getFullName() + " has not answered pass " + std::to_string(sequence) + " in time");
+        return;
+    }
+}
+
+///
+/// SERVER
+///
+
+void RemoteSubgraphServer::serve(const SessionPtr& session, const SubgraphNodePtr& subgraph, const AUUID& uuid)
+{
+    if (subgraph->isDrivenExternally()) {
+        throw std::runtime_error(std::string("subgraph ") + uuid.getFullName() + " is already served");
+    }
+
+    RemoteSubgraphServerPtr server = std::make_shared<RemoteSubgraphServer>(session, subgraph, uuid);
+
+    // the connection owns the server, stopping it destroys it as soon as the last pass is done
+    session->raw_packet_received(uuid).connect([server](const StreamableConstPtr& packet) { server->handlePass(packet); });
+    session->stopped.connect([uuid](Session* session) { session->raw_packet_received(uuid).disconnectAll(); });
+}
+
+void RemoteSubgraphServer::stop(const SessionPtr& session, const AUUID& uuid)
+{
+    session->raw_packet_received(uuid).disconnectAll();
+}
+
+RemoteSubgraphServer::RemoteSubgraphServer(const SessionPtr& session, const SubgraphNodePtr& subgraph, const AUUID& uuid)
+  : session_(session), subgraph_(subgraph), uuid_(uuid), busy_(false)
+{
+    subgraph_->setDrivenExternally(true);
+}
+
+RemoteSubgraphServer::~RemoteSubgraphServer()
+{
+    subgraph_->setDrivenExternally(false);
+}
+
+void RemoteSubgraphServer::handlePass(const StreamableConstPtr& packet)
+{
+    RawMessageConstPtr raw = std::dynamic_pointer_cast<RawMessage const>(packet);
+    if (!raw) {
+        return;
+    }
+
+    uint32_t sequence;
+    SubgraphMessages inputs;
+    std::string error;
+    try {
+        SerializationBuffer data(raw->getData());
+        remote_subgraph::read(data, sequence, inputs, error);
+    } catch (const std::exception& e) {
+        // without a sequence the pass cannot be answered, the client runs into its timeout
+        std::cerr << "cannot read a pass for the remote subgraph " << uuid_ << ": " << e.what() << std::endl;
+        return;
+    } catch (const Failure& f) {
+        std::cerr << "cannot read a pass for the remote subgraph " << uuid_ << ": " << f.what() << std::endl;
+        return;
+    }
+
+    {
+        std::unique_lock<std::recursive_mutex> lock(queue_mutex_);
+        queue_.emplace_back(sequence, inputs);
+        if (busy_) {
+            return;
+        }
+        busy_ = true;
+    }
+
+    processNext();
+}
+
+void RemoteSubgraphServer::processNext()
+{
+    std::pair<uint32_t, SubgraphMessages> pass;
+    {
+        std::unique_lock<std::recursive_mutex> lock(queue_mutex_);
+        if (queue_.empty()) {
+            busy_ = false;
+            return;
+        }
+        pass = queue_.front();
+        queue_.pop_front();
+    }
+
+    uint32_t sequence = pass.first;
+    RemoteSubgraphServerPtr self = shared_from_this();
+    try {
+        subgraph_->processExternally(pass.second, [self, sequence](const SubgraphMessages& outputs) {
+            self->reply(sequence, outputs, "");
+            self->processNext();
+        });
+    } catch (const std::exception& e) {
+        // the client waits for every pass in order, it has to learn about the failure
+        reply(sequence, {}, std::string("the remote subgraph cannot process: ") + e.what());
+        processNext();
+    } catch (const Failure& f) {
+        reply(sequence, {}, "the remote subgraph cannot process: " + f.what());
+        processNext();
+    }
+}
+
+void RemoteSubgraphServer::reply(uint32_t sequence, const SubgraphMessages& outputs, const std::string& error)
+{
+    if (SessionPtr session = session_.lock()) {
+        SerializationBuffer data;
+        remote_subgraph::write(data, sequence, outputs, error);
+        session->write(std::make_shared<RawMessage>(data, uuid_));
+    }
+}
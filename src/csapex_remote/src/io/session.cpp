@@ -37,8 +37,8 @@ Session::~Session()
     is_valid_ = false;
     {
         std::unique_lock<std::recursive_mutex> running_lock(running_mutex_);
-        if (running_) {
-            running_ = false;
+        running_ = false;
+        if (packet_handler_thread_.joinable()) {
             packet_handler_thread_.join();
         }
     }
@@ -180,10 +180,13 @@ void Session::stop()
         std::promise<ResponseConstPtr>* open_requests = pair.second;
         open_requests->set_value(nullptr);
     }
+    // the promises live on the stacks of the waiting requests, they are gone once those return
+    open_requests_.clear();
+    lock.unlock();
 
-    running_lock.unlock();
-
-    if (is_live_) {
+    // the client stops from its io thread and on shutdown, only one of them may join.
+    // The packet handler can already have left its loop, so being live is not enough to tell.
+    if (packet_handler_thread_.joinable()) {
         packet_handler_thread_.join();
     }
     apex_assert_hard(!is_live_);
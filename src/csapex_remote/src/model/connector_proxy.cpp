@@ -5,8 +5,11 @@
 #include <csapex/io/protcol/connector_requests.h>
 #include <csapex/io/protcol/connector_notes.h>
 #include <csapex/io/channel.h>
+#include <csapex/model/token.h>
+#include <csapex/msg/output_tap.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <iostream>
 
 using namespace csapex;
@@ -47,6 +50,13 @@ ConnectorProxy::ConnectorProxy(const SessionPtr& session, UUID uuid, Connectable
                 /**
                  * end: connect signals
                  **/
+                case ConnectorNoteType::TokenSampled: {
+                    TokenConstPtr token = std::make_shared<Token>(boost::any_cast<TokenDataConstPtr>(cn->getPayload()));
+                    std::unique_lock<std::mutex> lock(taps_mutex_);
+                    for (const OutputTapPtr& tap : taps_) {
+                        tap->offer(token);
+                    }
+                } break;
             }
         }
     });
@@ -68,6 +78,42 @@ bool ConnectorProxy::isActivelyConnectedTo(const UUID& other) const
     return request<bool, ConnectorRequests>(ConnectorRequests::ConnectorRequestType::IsActivelyConnectedTo, getUUID().getAbsoluteUUID(), other);
 }
 
+bool ConnectorProxy::addTap(const OutputTapPtr& tap)
+{
+    if (!isOutput()) {
+        return false;
+    }
+
+    bool first = false;
+    {
+        std::unique_lock<std::mutex> lock(taps_mutex_);
+        first = taps_.empty();
+        taps_.push_back(tap);
+    }
+    // the lock must not be held while waiting for the server, samples arrive on the same thread
+    if (first) {
+        session_->sendRequest<ConnectorRequests>(ConnectorRequests::ConnectorRequestType::AddTap, getUUID().getAbsoluteUUID(), tap->getMaximumFrequency());
+    }
+    return true;
+}
+
+void ConnectorProxy::removeTap(const OutputTapPtr& tap)
+{
+    bool last = false;
+    {
+        std::unique_lock<std::mutex> lock(taps_mutex_);
+        auto pos = std::find(taps_.begin(), taps_.end(), tap);
+        if (pos == taps_.end()) {
+            return;
+        }
+        taps_.erase(pos);
+        last = taps_.empty();
+    }
+    if (last) {
+        session_->sendRequest<ConnectorRequests>(ConnectorRequests::ConnectorRequestType::RemoveTap, getUUID().getAbsoluteUUID());
+    }
+}
+
 /**
  * begin: generate getters
  **/
@@ -64,8 +64,13 @@ GraphProxy::GraphProxy(io::ChannelPtr channel, NodeFacadeProxyPtr& node_facade)
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function)
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
     case GraphNoteType::function##Changed: {                                                                                                                                                           \
-        value_##function##_ = cn->getPayload<type>(0);                                                                                                                                                 \
-        signal(value_##function##_);                                                                                                                                                                   \
+        type value = cn->getPayload<type>(0);                                                                                                                                                          \
+        {                                                                                                                                                                                              \
+            std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                 \
+            value_##function##_ = value;                                                                                                                                                               \
+            has_##function##_ = true;                                                                                                                                                                  \
+        }                                                                                                                                                                                              \
+        signal(value);                                                                                                                                                                                 \
     } break;
 #define HANDLE_SIGNAL(_enum, signal)                                                                                                                                                                   \
     case GraphNoteType::_enum##Triggered: {                                                                                                                                                            \
@@ -85,52 +90,74 @@ GraphProxy::~GraphProxy()
 {
 }
 
-void GraphProxy::reload()
+void GraphProxy::load(const std::vector<UUID>& nodes, const std::vector<boost::any>& node_states, const std::vector<ConnectionDescription>& connections)
 {
-    auto nodes = graph_channel_->request<std::vector<UUID>, GraphRequests>(GraphRequests::GraphRequestType::GetAllNodes);
-    for (const UUID& id : nodes) {
-        vertexAdded(id);
+    apex_assert_hard(nodes.size() == node_states.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        vertexAdded(nodes[i], boost::any_cast<std::vector<boost::any>>(node_states[i]));
     }
-    auto connections = graph_channel_->request<std::vector<ConnectionDescription>, GraphRequests>(GraphRequests::GraphRequestType::GetAllConnections);
     for (const ConnectionDescription& ci : connections) {
         connectionAdded(ci);
     }
 }
 
-void GraphProxy::vertexAdded(const UUID& id)
+void GraphProxy::vertexAdded(const UUID& id, const std::vector<boost::any>& cached_state)
 {
     AUUID auuid(makeUUID_forced(shared_from_this(), id.getFullName()).getAbsoluteUUID());
-    std::shared_ptr<NodeFacadeProxy> remote_node_facade = std::make_shared<NodeFacadeProxy>(graph_channel_->getSession().shared_from_this(), auuid);
+    std::shared_ptr<NodeFacadeProxy> remote_node_facade = std::make_shared<NodeFacadeProxy>(graph_channel_->getSession().shared_from_this(), auuid, cached_state);
 
     graph::VertexPtr remote_vertex = std::make_shared<graph::Vertex>(remote_node_facade);
-    remote_vertices_.push_back(remote_vertex);
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        remote_vertices_.push_back(remote_vertex);
+        node_facades_[remote_node_facade->getUUID()] = remote_node_facade;
+    }
     vertex_added(remote_vertex);
 }
 
 void GraphProxy::vertexRemoved(const UUID& id)
 {
-    for (auto it = remote_vertices_.begin(); it != remote_vertices_.end(); ++it) {
-        graph::VertexPtr remote_vertex = *it;
-        if (remote_vertex->getNodeFacade()->getUUID() == id) {
-            vertex_removed(remote_vertex);
-            remote_vertices_.erase(it);
-            return;
+    graph::VertexPtr remote_vertex;
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        for (auto it = remote_vertices_.begin(); it != remote_vertices_.end(); ++it) {
+            if ((*it)->getNodeFacade()->getUUID() == id) {
+                remote_vertex = *it;
+                break;
+            }
         }
     }
+    if (!remote_vertex) {
+        return;
+    }
+
+    // the vertex stays findable while the views let go of it
+    vertex_removed(remote_vertex);
+
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+    remote_vertices_.erase(std::find(remote_vertices_.begin(), remote_vertices_.end(), remote_vertex));
+    node_facades_.erase(id);
 }
 
 void GraphProxy::connectionAdded(const ConnectionDescription& ci)
 {
-    edges_.push_back(ci);
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        edges_.push_back(ci);
+    }
     connection_added(ci);
 }
 void GraphProxy::connectionRemoved(const ConnectionDescription& ci)
 {
-    auto pos = std::find(edges_.begin(), edges_.end(), ci);
-    if (pos != edges_.end()) {
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        auto pos = std::find(edges_.begin(), edges_.end(), ci);
+        if (pos == edges_.end()) {
+            return;
+        }
         edges_.erase(pos);
-        connection_removed(ci);
     }
+    connection_removed(ci);
 }
 
 AUUID GraphProxy::getAbsoluteUUID() const
@@ -140,6 +167,7 @@ AUUID GraphProxy::getAbsoluteUUID() const
 
 std::size_t GraphProxy::countNodes()
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     return remote_vertices_.size();
 }
 
@@ -185,11 +213,10 @@ NodeFacadePtr GraphProxy::findNodeFacadeNoThrow(const UUID& uuid) const noexcept
         return nullptr;
 
     } else {
-        for (const auto& vertex : remote_vertices_) {
-            NodeFacadePtr nf = vertex->getNodeFacade();
-            if (nf->getUUID() == uuid) {
-                return nf;
-            }
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        auto pos = node_facades_.find(uuid);
+        if (pos != node_facades_.end()) {
+            return pos->second;
         }
     }
 
@@ -210,6 +237,7 @@ NodeFacadePtr GraphProxy::findNodeFacadeForConnectorNoThrow(const UUID& uuid) co
 }
 NodeFacadePtr GraphProxy::findNodeFacadeWithLabel(const std::string& label) const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     for (const auto& vertex : remote_vertices_) {
         NodeFacadePtr nf = vertex->getNodeFacade();
         if (nf->getLabel() == label) {
@@ -222,6 +250,7 @@ NodeFacadePtr GraphProxy::findNodeFacadeWithLabel(const std::string& label) cons
 
 std::vector<UUID> GraphProxy::getAllNodeUUIDs() const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     std::vector<UUID> uuids;
     for (const auto& vertex : remote_vertices_) {
         uuids.push_back(vertex->getUUID());
@@ -230,6 +259,7 @@ std::vector<UUID> GraphProxy::getAllNodeUUIDs() const
 }
 std::vector<NodeFacadePtr> GraphProxy::getAllNodeFacades()
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     std::vector<NodeFacadePtr> node_facades;
     for (const graph::VertexPtr& vertex : remote_vertices_) {
         NodeFacadePtr nf = vertex->getNodeFacade();
@@ -263,6 +293,7 @@ ConnectorPtr GraphProxy::findConnectorNoThrow(const UUID& uuid) noexcept
 
 ConnectionDescription GraphProxy::getConnection(const UUID& from, const UUID& to) const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     for (const ConnectionDescription& ci : edges_) {
         if (ci.from == from && ci.to == to) {
             return ci;
@@ -272,6 +303,7 @@ ConnectionDescription GraphProxy::getConnection(const UUID& from, const UUID& to
 }
 ConnectionDescription GraphProxy::getConnectionWithId(int id) const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     for (const ConnectionDescription& ci : edges_) {
         if (ci.id == id) {
             return ci;
@@ -282,6 +314,7 @@ ConnectionDescription GraphProxy::getConnectionWithId(int id) const
 
 bool GraphProxy::isConnected(const UUID& from, const UUID& to) const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     for (const ConnectionDescription& ci : edges_) {
         if (ci.from == from && ci.to == to) {
             return true;
@@ -292,6 +325,7 @@ bool GraphProxy::isConnected(const UUID& from, const UUID& to) const
 
 std::vector<ConnectionDescription> GraphProxy::enumerateAllConnections() const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     return edges_;
 }
 
@@ -87,8 +87,13 @@ GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function)
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
     case GraphFacadeNoteType::function##Changed: {                                                                                                                                                     \
-        value_##function##_ = cn->getPayload<type>(0);                                                                                                                                                 \
-        signal(value_##function##_);                                                                                                                                                                   \
+        type value = cn->getPayload<type>(0);                                                                                                                                                          \
+        {                                                                                                                                                                                              \
+            std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                 \
+            value_##function##_ = value;                                                                                                                                                               \
+            has_##function##_ = true;                                                                                                                                                                  \
+        }                                                                                                                                                                                              \
+        signal(value);                                                                                                                                                                                 \
     } break;
 #define HANDLE_SIGNAL(_enum, signal)                                                                                                                                                                   \
     case GraphFacadeNoteType::_enum##Triggered: {                                                                                                                                                      \
@@ -112,7 +117,38 @@ GraphFacadeProxy::GraphFacadeProxy(const SessionPtr& session, NodeFacadeProxyPtr
 
     observe(graph_->state_changed, state_changed);
 
-    graph_->reload();
+    // the accessors, nodes and connections arrive in one bulk request instead of several requests per node
+    auto state = request<std::vector<boost::any>, GraphFacadeRequests>(GraphFacadeRequests::GraphFacadeRequestType::GetCachedState, uuid_.getAbsoluteUUID());
+    apex_assert_hard(state.size() == 4);
+
+    std::vector<boost::any> values = boost::any_cast<std::vector<boost::any>>(state[0]);
+    std::size_t index = 0;
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+
+/**
+ * begin: fill caches
+ **/
+#define HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function)                                                                                                                                                  \
+    cache_##function##_ = boost::any_cast<type>(values.at(index++));                                                                                                                                   \
+    has_##function##_ = true;
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
+    if (!has_##function##_) {                                                                                                                                                                          \
+        /* a note that arrived in the meantime is at least as recent */                                                                                                                                \
+        value_##function##_ = boost::any_cast<type>(values.at(index));                                                                                                                                 \
+        has_##function##_ = true;                                                                                                                                                                      \
+    }                                                                                                                                                                                                  \
+    ++index;
+#define HANDLE_SIGNAL(_enum, signal)
+
+#include <csapex/model/graph_facade_proxy_accessors.hpp>
+        /**
+         * end: fill caches
+         **/
+    }
+
+    graph_->load(boost::any_cast<std::vector<UUID>>(state[1]), boost::any_cast<std::vector<boost::any>>(state[2]), boost::any_cast<std::vector<ConnectionDescription>>(state[3]));
 }
 
 GraphFacadeProxy::~GraphFacadeProxy()
@@ -325,8 +361,16 @@ std::vector<ConnectionDescription> GraphFacadeProxy::enumerateAllConnections() c
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function)                                                                                                                                                  \
     type GraphFacadeProxy::function() const                                                                                                                                                            \
     {                                                                                                                                                                                                  \
+        {                                                                                                                                                                                              \
+            std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                 \
+            if (has_##function##_) {                                                                                                                                                                   \
+                return cache_##function##_;                                                                                                                                                            \
+            }                                                                                                                                                                                          \
+        }                                                                                                                                                                                              \
+        type value = request<type, GraphFacadeRequests>(GraphFacadeRequests::GraphFacadeRequestType::_enum, uuid_.getAbsoluteUUID());                                                                  \
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                     \
         if (!has_##function##_) {                                                                                                                                                                      \
-            cache_##function##_ = request<type, GraphFacadeRequests>(GraphFacadeRequests::GraphFacadeRequestType::_enum, uuid_.getAbsoluteUUID());                                                     \
+            cache_##function##_ = value;                                                                                                                                                               \
             has_##function##_ = true;                                                                                                                                                                  \
         }                                                                                                                                                                                              \
         return cache_##function##_;                                                                                                                                                                    \
@@ -334,8 +378,16 @@ std::vector<ConnectionDescription> GraphFacadeProxy::enumerateAllConnections() c
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
     type GraphFacadeProxy::function() const                                                                                                                                                            \
     {                                                                                                                                                                                                  \
+        {                                                                                                                                                                                              \
+            std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                 \
+            if (has_##function##_) {                                                                                                                                                                   \
+                return value_##function##_;                                                                                                                                                            \
+            }                                                                                                                                                                                          \
+        }                                                                                                                                                                                              \
+        type value = request<type, GraphFacadeRequests>(GraphFacadeRequests::GraphFacadeRequestType::_enum, uuid_.getAbsoluteUUID());                                                                  \
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                     \
         if (!has_##function##_) {                                                                                                                                                                      \
-            value_##function##_ = request<type, GraphFacadeRequests>(GraphFacadeRequests::GraphFacadeRequestType::_enum, uuid_.getAbsoluteUUID());                                                     \
+            value_##function##_ = value;                                                                                                                                                               \
             has_##function##_ = true;                                                                                                                                                                  \
         }                                                                                                                                                                                              \
         return value_##function##_;                                                                                                                                                                    \
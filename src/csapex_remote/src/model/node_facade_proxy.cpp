@@ -14,6 +14,7 @@
 #include <csapex/model/connector_proxy.h>
 #include <csapex/model/node_characteristics.h>
 #include <csapex/model/node_state.h>
+#include <csapex/model/token_latency_statistics.h>
 #include <csapex/profiling/profiler_proxy.h>
 #include <csapex/utility/uuid_provider.h>
 #include <csapex/utility/slim_signal_invoker.hpp>
@@ -23,7 +24,7 @@
 
 using namespace csapex;
 
-NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
+NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid, std::vector<boost::any> cached_state)
   : Proxy(session)
   , uuid_(uuid)
   ,
@@ -47,7 +48,13 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
 
     profiler_proxy_ = std::make_shared<ProfilerProxy>(node_channel_);
 
-    state_proxy_ = node_channel_->request<NodeStatePtr, NodeRequests>(NodeRequests::NodeRequestType::GetNodeState);
+    // one bulk request instead of one request per accessor, the notes keep the values current afterwards
+    if (cached_state.empty()) {
+        cached_state = node_channel_->request<std::vector<boost::any>, NodeRequests>(NodeRequests::NodeRequestType::GetCachedAccessors);
+    }
+    std::size_t index = fillCaches(cached_state);
+    state_proxy_ = boost::any_cast<NodeStatePtr>(cached_state.at(index++));
+    auto params = boost::any_cast<std::vector<param::ParameterPtr>>(cached_state.at(index++));
 
     observe(node_channel_->note_received, [this](const io::NoteConstPtr& note) {
         if (const std::shared_ptr<NodeNote const>& cn = std::dynamic_pointer_cast<NodeNote const>(note)) {
@@ -59,8 +66,13 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function)
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
     case NodeNoteType::function##Changed: {                                                                                                                                                            \
-        value_##function##_ = cn->getPayload<type>(0);                                                                                                                                                 \
-        signal(value_##function##_);                                                                                                                                                                   \
+        type value = cn->getPayload<type>(0);                                                                                                                                                          \
+        {                                                                                                                                                                                              \
+            std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                 \
+            value_##function##_ = value;                                                                                                                                                               \
+            has_##function##_ = true;                                                                                                                                                                  \
+        }                                                                                                                                                                                              \
+        signal(value);                                                                                                                                                                                 \
     } break;
 #define HANDLE_SIGNAL(_enum, signal)                                                                                                                                                                   \
     case NodeNoteType::_enum##Triggered: {                                                                                                                                                             \
@@ -87,13 +99,19 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
                 case NodeNoteType::ParameterChangedTriggered: {
                     param::ParameterPtr p = cn->getPayload<param::ParameterPtr>(0);
                     apex_assert_hard(p);
-                    auto pos = parameter_cache_.find(p->name());
-                    if (pos == parameter_cache_.end()) {
+                    param::ParameterPtr proxy;
+                    {
+                        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+                        auto pos = parameter_cache_.find(p->name());
+                        if (pos != parameter_cache_.end()) {
+                            proxy = pos->second;
+                        }
+                    }
+                    if (!proxy) {
                         createParameterProxy(p);
                         parameter_added(p);
 
                     } else {
-                        param::ParameterPtr proxy = pos->second;
                         proxy->cloneDataFrom(*p);
                         parameter_changed(proxy);
                     }
@@ -103,16 +121,23 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
                     param::ParameterPtr p = cn->getPayload<param::ParameterPtr>(0);
                     std::string name = p->name();
 
-                    auto pos = parameter_cache_.find(name);
-                    if (pos != parameter_cache_.end()) {
-                        parameter_removed(pos->second);
-                        for (auto it = parameters_.begin(); it != parameters_.end(); ++it) {
-                            if ((*it)->name() == name) {
-                                parameters_.erase(it);
-                                break;
+                    param::ParameterPtr proxy;
+                    {
+                        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+                        auto pos = parameter_cache_.find(name);
+                        if (pos != parameter_cache_.end()) {
+                            proxy = pos->second;
+                            for (auto it = parameters_.begin(); it != parameters_.end(); ++it) {
+                                if ((*it)->name() == name) {
+                                    parameters_.erase(it);
+                                    break;
+                                }
                             }
+                            parameter_cache_.erase(pos);
                         }
-                        parameter_cache_.erase(pos);
+                    }
+                    if (proxy) {
+                        parameter_removed(proxy);
                     }
                 } break;
 
@@ -162,7 +187,6 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
         }
     });
 
-    auto params = node_channel_->request<std::vector<param::ParameterPtr>, NodeRequests>(NodeRequests::NodeRequestType::GetParameters);
     for (param::ParameterPtr& p : params) {
         createParameterProxy(p);
         parameter_added(p);
@@ -203,21 +227,53 @@ void NodeFacadeProxy::handleBroadcast(const BroadcastMessageConstPtr& message)
     }
 }
 
+std::size_t NodeFacadeProxy::fillCaches(const std::vector<boost::any>& values)
+{
+    std::size_t index = 0;
+
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+/**
+ * begin: fill caches
+ **/
+#define HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function)                                                                                                                                                  \
+    cache_##function##_ = boost::any_cast<type>(values.at(index++));                                                                                                                                   \
+    has_##function##_ = true;
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
+    value_##function##_ = boost::any_cast<type>(values.at(index++));                                                                                                                                   \
+    has_##function##_ = true;
+#define HANDLE_SIGNAL(_enum, signal)
+
+#include <csapex/model/node_facade_proxy_accessors.hpp>
+    /**
+     * end: fill caches
+     **/
+
+    return index;
+}
+
 void NodeFacadeProxy::createConnectorProxy(const ConnectorDescription& cd)
 {
     ConnectableOwnerPtr owner;
     std::shared_ptr<ConnectorProxy> proxy = std::make_shared<ConnectorProxy>(session_, cd.getAUUID(), owner, cd);
-    remote_connectors_[cd.id] = proxy;
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        remote_connectors_[cd.id] = proxy;
+    }
     connector_created(cd);
 }
 
 void NodeFacadeProxy::removeConnectorProxy(const ConnectorDescription& cd)
 {
-    auto pos = remote_connectors_.find(cd.id);
-    if (pos != remote_connectors_.end()) {
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        auto pos = remote_connectors_.find(cd.id);
+        if (pos == remote_connectors_.end()) {
+            return;
+        }
         remote_connectors_.erase(pos);
-        connector_removed(cd);
     }
+    connector_removed(cd);
 }
 
 UUID NodeFacadeProxy::getUUID() const
@@ -236,28 +292,36 @@ AUUID NodeFacadeProxy::getAUUID() const
 
 bool NodeFacadeProxy::isParameterInput(const UUID& id)
 {
-    auto pos = is_parameter_input_.find(id);
-    if (pos == is_parameter_input_.end()) {
-        bool result = node_channel_->request<bool, NodeRequests>(NodeRequests::NodeRequestType::IsParameterInput, id);
-        is_parameter_input_[id] = result;
-        return result;
-
-    } else {
-        return pos->second;
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        auto pos = is_parameter_input_.find(id);
+        if (pos != is_parameter_input_.end()) {
+            return pos->second;
+        }
     }
+
+    bool result = node_channel_->request<bool, NodeRequests>(NodeRequests::NodeRequestType::IsParameterInput, id);
+
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+    is_parameter_input_[id] = result;
+    return result;
 }
 
 bool NodeFacadeProxy::isParameterOutput(const UUID& id)
 {
-    auto pos = is_parameter_output_.find(id);
-    if (pos == is_parameter_output_.end()) {
-        bool result = node_channel_->request<bool, NodeRequests>(NodeRequests::NodeRequestType::IsParameterOutput, id);
-        is_parameter_output_[id] = result;
-        return result;
-
-    } else {
-        return pos->second;
+    {
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+        auto pos = is_parameter_output_.find(id);
+        if (pos != is_parameter_output_.end()) {
+            return pos->second;
+        }
     }
+
+    bool result = node_channel_->request<bool, NodeRequests>(NodeRequests::NodeRequestType::IsParameterOutput, id);
+
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
+    is_parameter_output_[id] = result;
+    return result;
 }
 
 GraphPtr NodeFacadeProxy::getSubgraph() const
@@ -268,10 +332,12 @@ GraphPtr NodeFacadeProxy::getSubgraph() const
 
 ConnectorPtr NodeFacadeProxy::getConnector(const UUID& id) const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     return remote_connectors_.at(id);
 }
 ConnectorPtr NodeFacadeProxy::getConnectorNoThrow(const UUID& id) const noexcept
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     auto pos = remote_connectors_.find(id);
     if (pos == remote_connectors_.end()) {
         return nullptr;
@@ -292,11 +358,13 @@ ConnectorPtr NodeFacadeProxy::getParameterOutput(const std::string& name) const
 
 std::vector<param::ParameterPtr> NodeFacadeProxy::getParameters() const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     return parameters_;
 }
 
 param::ParameterPtr NodeFacadeProxy::getParameter(const std::string& name) const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     return parameter_cache_.at(name);
 }
 
@@ -326,6 +394,7 @@ std::string NodeFacadeProxy::getLoggerOutput(ErrorState::ErrorLevel level) const
 
 bool NodeFacadeProxy::hasParameter(const std::string& name) const
 {
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     auto pos = parameter_cache_.find(name);
     return pos != parameter_cache_.end();
 }
@@ -344,6 +413,7 @@ void NodeFacadeProxy::createParameterProxy(param::ParameterPtr proxy) const
         self->session_->write(change);
     });
 
+    std::unique_lock<std::recursive_mutex> lock(cache_mutex_);
     parameters_.push_back(proxy);
     parameter_cache_[proxy->name()] = proxy;
 }
@@ -359,8 +429,16 @@ void NodeFacadeProxy::createParameterProxy(param::ParameterPtr proxy) const
 #define HANDLE_STATIC_ACCESSOR(_enum, type, function)                                                                                                                                                  \
     type NodeFacadeProxy::function() const                                                                                                                                                             \
     {                                                                                                                                                                                                  \
+        {                                                                                                                                                                                              \
+            std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                 \
+            if (has_##function##_) {                                                                                                                                                                   \
+                return cache_##function##_;                                                                                                                                                            \
+            }                                                                                                                                                                                          \
+        }                                                                                                                                                                                              \
+        type value = request<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                                   \
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                     \
         if (!has_##function##_) {                                                                                                                                                                      \
-            cache_##function##_ = request<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                      \
+            cache_##function##_ = value;                                                                                                                                                               \
             has_##function##_ = true;                                                                                                                                                                  \
         }                                                                                                                                                                                              \
         return cache_##function##_;                                                                                                                                                                    \
@@ -368,8 +446,16 @@ void NodeFacadeProxy::createParameterProxy(param::ParameterPtr proxy) const
 #define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
     type NodeFacadeProxy::function() const                                                                                                                                                             \
     {                                                                                                                                                                                                  \
+        {                                                                                                                                                                                              \
+            std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                 \
+            if (has_##function##_) {                                                                                                                                                                   \
+                return value_##function##_;                                                                                                                                                            \
+            }                                                                                                                                                                                          \
+        }                                                                                                                                                                                              \
+        type value = request<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                                   \
+        std::unique_lock<std::recursive_mutex> lock(cache_mutex_);                                                                                                                                     \
         if (!has_##function##_) {                                                                                                                                                                      \
-            value_##function##_ = request<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                      \
+            value_##function##_ = value;                                                                                                                                                               \
             has_##function##_ = true;                                                                                                                                                                  \
         }                                                                                                                                                                                              \
         return value_##function##_;                                                                                                                                                                    \
@@ -8,6 +8,10 @@
 #include <csapex/msg/generic_value_message.hpp>
 #include <csapex/msg/io.h>
 #include <csapex/model/token.h>
+#include <csapex_testing/mockup_msgs.h>
+
+/// SYSTEM
+#include <mutex>
 
 namespace csapex
 {
@@ -104,7 +108,7 @@ private:
 class MockupSink : public Node
 {
 public:
-    MockupSink();
+    MockupSink(bool essential = true);
 
     void setup(NodeModifier& node_modifier) override;
 
@@ -119,10 +123,20 @@ public:
 private:
     Input* in;
 
+    bool essential;
     bool aborted;
     int value;
 };
 
+/**
+ * @brief MockupNonEssentialSink records its input like MockupSink, without requiring the producer to wait for it
+ */
+class MockupNonEssentialSink : public MockupSink
+{
+public:
+    MockupNonEssentialSink();
+};
+
 class AnySink : public Node
 {
 public:
@@ -136,6 +150,85 @@ private:
     Input* in;
 };
 
+/// BENCHMARK NODES
+/// these nodes pass MockMessages through a graph, the messages are stamped
+/// with the (steady) time of their creation to measure end-to-end latency
+class MockupPayloadSource : public Node
+{
+public:
+    MockupPayloadSource();
+
+    void setup(NodeModifier& node_modifier) override;
+
+    void setupParameters(Parameterizable& parameters) override;
+
+    void process() override;
+
+    static std::uint64_t now();
+
+protected:
+    std::shared_ptr<connection_types::MockMessage> makePayload();
+
+protected:
+    Output* out;
+};
+
+class MockupPayloadVectorSource : public MockupPayloadSource
+{
+public:
+    void setup(NodeModifier& node_modifier) override;
+
+    void setupParameters(Parameterizable& parameters) override;
+
+    void process() override;
+};
+
+class MockupPayloadForwarder : public Node
+{
+public:
+    void setup(NodeModifier& node_modifier) override;
+
+    void process(NodeModifier& node_modifier, Parameterizable& parameters) override;
+
+private:
+    Input* in;
+    Output* out;
+};
+
+class MockupPayloadJoin : public Node
+{
+public:
+    void setup(NodeModifier& node_modifier) override;
+
+    void process(NodeModifier& node_modifier, Parameterizable& parameters) override;
+
+private:
+    Input* in_a;
+    Input* in_b;
+    Output* out;
+};
+
+class MockupPayloadSink : public Node
+{
+public:
+    MockupPayloadSink();
+
+    void setup(NodeModifier& node_modifier) override;
+
+    void process(NodeModifier& node_modifier, Parameterizable& parameters) override;
+
+    std::size_t getCount() const;
+    std::vector<std::uint64_t> takeLatencies();
+    void reset();
+
+private:
+    Input* in;
+
+    mutable std::mutex mutex_;
+    std::size_t count_;
+    std::vector<std::uint64_t> latencies_;
+};
+
 }  // namespace csapex
 
 #endif  // MOCKUP_NODES_H
@@ -19,6 +19,7 @@ protected:
 
 public:
     SteppingTest();
+    ~SteppingTest();
 
     void SetUp() override;
     void TearDown() override;
@@ -26,6 +27,11 @@ public:
 protected:
     void step();
 
+    /**
+     * @brief makeNode creates a node of the given type and adds it to the main graph
+     */
+    NodeFacadeImplementationPtr makeNode(const std::string& type, const std::string& name);
+
 private:
     void waitForEndOfStep();
 
@@ -0,0 +1,445 @@
+/// PROJECT
+#include <csapex/core/exception_handler.h>
+#include <csapex/core/settings/settings_impl.h>
+#include <csapex/factory/node_factory_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_runner.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/msg/generic_vector_message.hpp>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/thread_pool.h>
+#include <csapex/param/parameter.h>
+#include <csapex_testing/mockup_msgs.h>
+#include <csapex_testing/mockup_nodes.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <sys/resource.h>
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+using namespace csapex;
+
+namespace
+{
+template <typename T>
+NodePtr makeNode()
+{
+    return NodePtr(new T());
+}
+
+struct BenchConfig
+{
+    std::string topology;
+    int size;
+    int payload_size;
+
+    bool threading;
+    bool grouping;
+    int groups;
+
+    double warmup;
+    double duration;
+};
+
+struct BenchResult
+{
+    std::size_t messages;
+    std::size_t samples;
+    double seconds;
+    double cpu_seconds;
+
+    std::vector<std::uint64_t> latencies;
+};
+
+double cpuTime()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+std::uint64_t percentile(const std::vector<std::uint64_t>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::size_t index = std::min(sorted.size() - 1, static_cast<std::size_t>(p * sorted.size()));
+    return sorted[index];
+}
+
+/**
+ * @brief The Benchmark class generates a synthetic topology of mockup payload nodes
+ *        and measures how many messages per second reach the sinks.
+ */
+class Benchmark
+{
+    /// connector ids that a generated sub-topology can be connected with
+    struct Segment
+    {
+        UUID input;
+        UUID output;
+    };
+
+public:
+    Benchmark(const BenchConfig& config)
+      : config_(config)
+      , eh_(false)
+      , factory_(SettingsImplementation::NoSettings, nullptr)
+      , executor_(eh_, config.threading, config.grouping)
+      , payload_type_(makeEmpty<connection_types::MockMessage>())
+    {
+        factory_.registerNodeType(std::make_shared<NodeConstructor>("MockupPayloadSource", std::bind(&makeNode<MockupPayloadSource>)));
+        factory_.registerNodeType(std::make_shared<NodeConstructor>("MockupPayloadVectorSource", std::bind(&makeNode<MockupPayloadVectorSource>)));
+        factory_.registerNodeType(std::make_shared<NodeConstructor>("MockupPayloadForwarder", std::bind(&makeNode<MockupPayloadForwarder>)));
+        factory_.registerNodeType(std::make_shared<NodeConstructor>("MockupPayloadJoin", std::bind(&makeNode<MockupPayloadJoin>)));
+        factory_.registerNodeType(std::make_shared<NodeConstructor>("MockupPayloadSink", std::bind(&makeNode<MockupPayloadSink>)));
+
+        graph_node_ = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+        graph_ = graph_node_->getLocalGraph();
+
+        main_graph_facade_ = std::make_shared<GraphFacadeImplementation>(executor_, graph_, graph_node_);
+        graph_->setNodeFacade(main_graph_facade_->getLocalNodeFacade().get());
+    }
+
+    ~Benchmark()
+    {
+        executor_.stop();
+    }
+
+    void build()
+    {
+        if (config_.topology == "chain") {
+            buildChain();
+        } else if (config_.topology == "fanout") {
+            buildFanOut();
+        } else if (config_.topology == "diamond") {
+            buildDiamond();
+        } else if (config_.topology == "nested") {
+            buildNested();
+        } else if (config_.topology == "iterated") {
+            buildIterated();
+        } else {
+            throw std::runtime_error(std::string("unknown topology: ") + config_.topology);
+        }
+
+        if (config_.groups > 0) {
+            distributeOverGroups();
+        }
+    }
+
+    BenchResult run()
+    {
+        executor_.start();
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(config_.warmup));
+        for (MockupPayloadSink* sink : sinks_) {
+            sink->reset();
+        }
+
+        double cpu_start = cpuTime();
+        auto start = std::chrono::steady_clock::now();
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(config_.duration));
+
+        BenchResult result;
+        result.messages = 0;
+        for (MockupPayloadSink* sink : sinks_) {
+            result.messages += sink->getCount();
+            std::vector<std::uint64_t> latencies = sink->takeLatencies();
+            result.latencies.insert(result.latencies.end(), latencies.begin(), latencies.end());
+        }
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.cpu_seconds = cpuTime() - cpu_start;
+        result.samples = result.latencies.size();
+
+        executor_.stop();
+
+        std::sort(result.latencies.begin(), result.latencies.end());
+        return result;
+    }
+
+    std::size_t countNodes() const
+    {
+        return node_count_;
+    }
+
+private:
+    NodeFacadeImplementationPtr addNode(const std::string& type, GraphImplementationPtr graph, GraphFacadeImplementation& facade)
+    {
+        NodeFacadeImplementationPtr node = factory_.makeNode(type, graph->generateUUID(type), graph);
+        apex_assert_hard(node);
+        facade.addNode(node);
+        ++node_count_;
+        return node;
+    }
+
+    NodeFacadeImplementationPtr addSource(const std::string& type)
+    {
+        NodeFacadeImplementationPtr source = addNode(type, graph_, *main_graph_facade_);
+        source->getNode()->getParameter("payload_size")->set(config_.payload_size);
+        return source;
+    }
+
+    NodeFacadeImplementationPtr addSink()
+    {
+        NodeFacadeImplementationPtr sink = addNode("MockupPayloadSink", graph_, *main_graph_facade_);
+        MockupPayloadSink* node = dynamic_cast<MockupPayloadSink*>(sink->getNode().get());
+        apex_assert_hard(node);
+        sinks_.push_back(node);
+        return sink;
+    }
+
+    Segment addForwarder(GraphImplementationPtr graph, GraphFacadeImplementation& facade)
+    {
+        NodeFacadeImplementationPtr forwarder = addNode("MockupPayloadForwarder", graph, facade);
+        return Segment{ UUIDProvider::makeTypedUUID_forced(forwarder->getUUID(), "in", 0), UUIDProvider::makeTypedUUID_forced(forwarder->getUUID(), "out", 0) };
+    }
+
+    UUID outputOf(const NodeFacadeImplementationPtr& node)
+    {
+        return UUIDProvider::makeTypedUUID_forced(node->getUUID(), "out", 0);
+    }
+
+    UUID inputOf(const NodeFacadeImplementationPtr& node, int id = 0)
+    {
+        return UUIDProvider::makeTypedUUID_forced(node->getUUID(), "in", id);
+    }
+
+    /// source -> size x forwarder -> sink
+    void buildChain()
+    {
+        NodeFacadeImplementationPtr source = addSource("MockupPayloadSource");
+        UUID previous = outputOf(source);
+        for (int i = 0; i < config_.size; ++i) {
+            Segment segment = addForwarder(graph_, *main_graph_facade_);
+            main_graph_facade_->connect(previous, segment.input);
+            previous = segment.output;
+        }
+        main_graph_facade_->connect(previous, inputOf(addSink()));
+    }
+
+    /// source -> size x (forwarder -> sink)
+    void buildFanOut()
+    {
+        NodeFacadeImplementationPtr source = addSource("MockupPayloadSource");
+        for (int i = 0; i < config_.size; ++i) {
+            Segment segment = addForwarder(graph_, *main_graph_facade_);
+            main_graph_facade_->connect(outputOf(source), segment.input);
+            main_graph_facade_->connect(segment.output, inputOf(addSink()));
+        }
+    }
+
+    /// source -> size x forwarder -> binary tree of joins -> sink
+    void buildDiamond()
+    {
+        NodeFacadeImplementationPtr source = addSource("MockupPayloadSource");
+
+        std::vector<UUID> branches;
+        for (int i = 0; i < std::max(2, config_.size); ++i) {
+            Segment segment = addForwarder(graph_, *main_graph_facade_);
+            main_graph_facade_->connect(outputOf(source), segment.input);
+            branches.push_back(segment.output);
+        }
+
+        while (branches.size() > 1) {
+            std::vector<UUID> joined;
+            for (std::size_t i = 0; i + 1 < branches.size(); i += 2) {
+                NodeFacadeImplementationPtr join = addNode("MockupPayloadJoin", graph_, *main_graph_facade_);
+                main_graph_facade_->connect(branches[i], inputOf(join, 0));
+                main_graph_facade_->connect(branches[i + 1], inputOf(join, 1));
+                joined.push_back(outputOf(join));
+            }
+            if (branches.size() % 2 == 1) {
+                joined.push_back(branches.back());
+            }
+            branches.swap(joined);
+        }
+
+        main_graph_facade_->connect(branches.front(), inputOf(addSink()));
+    }
+
+    /// source -> size nested subgraphs around one forwarder -> sink
+    void buildNested()
+    {
+        NodeFacadeImplementationPtr source = addSource("MockupPayloadSource");
+        Segment nested = addNestedSegment(graph_, *main_graph_facade_, config_.size, false);
+        main_graph_facade_->connect(outputOf(source), nested.input);
+        main_graph_facade_->connect(nested.output, inputOf(addSink()));
+    }
+
+    /// vector source with size elements -> iterated subgraph with one forwarder -> sink
+    void buildIterated()
+    {
+        NodeFacadeImplementationPtr source = addSource("MockupPayloadVectorSource");
+        source->getNode()->getParameter("elements")->set(std::max(1, config_.size));
+
+        Segment iterated = addNestedSegment(graph_, *main_graph_facade_, 1, true);
+        main_graph_facade_->connect(outputOf(source), iterated.input);
+        main_graph_facade_->connect(iterated.output, inputOf(addSink()));
+    }
+
+    Segment addNestedSegment(GraphImplementationPtr graph, GraphFacadeImplementation& facade, int depth, bool iterate)
+    {
+        if (depth <= 0) {
+            return addForwarder(graph, facade);
+        }
+
+        NodeFacadeImplementationPtr sub_graph_node_facade = factory_.makeNode("csapex::Graph", graph->generateUUID("subgraph"), graph);
+        SubgraphNodePtr sub_graph = std::dynamic_pointer_cast<SubgraphNode>(sub_graph_node_facade->getNode());
+        apex_assert_hard(sub_graph);
+
+        GraphFacadeImplementationPtr sub_graph_facade = std::make_shared<GraphFacadeImplementation>(executor_, sub_graph->getLocalGraph(), sub_graph);
+        sub_graph_facades_.push_back(sub_graph_facade);
+
+        Segment inner = addNestedSegment(sub_graph->getLocalGraph(), *sub_graph_facade, depth - 1, false);
+
+        graph->addNode(sub_graph_node_facade);
+        ++node_count_;
+
+        TokenDataConstPtr type = iterate ? TokenDataConstPtr(connection_types::GenericVectorMessage::make<connection_types::MockMessage>()) : payload_type_;
+        RelayMapping in_map = sub_graph->addForwardingInput(type, "forwarding", false);
+        RelayMapping out_map = sub_graph->addForwardingOutput(type, "forwarding");
+        if (iterate) {
+            sub_graph->setIterationEnabled(in_map.external, true);
+        }
+
+        sub_graph_facade->connect(in_map.internal, inner.input);
+        sub_graph_facade->connect(inner.output, out_map.internal);
+
+        return Segment{ in_map.external, out_map.external };
+    }
+
+    void distributeOverGroups()
+    {
+        std::vector<int> group_ids;
+        for (int i = 0; i < config_.groups; ++i) {
+            group_ids.push_back(executor_.createGroup(std::string("bench_") + std::to_string(i))->id());
+        }
+
+        std::size_t next = 0;
+        for (const NodeFacadeImplementationPtr& nf : graph_->getAllLocalNodeFacades()) {
+            if (NodeRunnerPtr runner = nf->getNodeRunner()) {
+                executor_.addToGroup(runner.get(), group_ids[next++ % group_ids.size()]);
+            }
+        }
+    }
+
+private:
+    BenchConfig config_;
+
+    ExceptionHandler eh_;
+    NodeFactoryImplementation factory_;
+    ThreadPool executor_;
+
+    TokenDataConstPtr payload_type_;
+
+    SubgraphNodePtr graph_node_;
+    GraphImplementationPtr graph_;
+    GraphFacadeImplementationPtr main_graph_facade_;
+    std::vector<GraphFacadeImplementationPtr> sub_graph_facades_;
+
+    std::vector<MockupPayloadSink*> sinks_;
+    std::size_t node_count_ = 0;
+};
+
+void writeJson(std::ostream& out, const BenchConfig& config, std::size_t nodes, const BenchResult& result)
+{
+    double mean = 0.0;
+    for (std::uint64_t latency : result.latencies) {
+        mean += latency;
+    }
+    if (!result.latencies.empty()) {
+        mean /= result.latencies.size();
+    }
+
+    out << "{\n";
+    out << "  \"topology\": \"" << config.topology << "\",\n";
+    out << "  \"size\": " << config.size << ",\n";
+    out << "  \"nodes\": " << nodes << ",\n";
+    out << "  \"payload_bytes\": " << config.payload_size << ",\n";
+    out << "  \"threading\": " << (config.threading ? "true" : "false") << ",\n";
+    out << "  \"grouping\": " << (config.grouping ? "true" : "false") << ",\n";
+    out << "  \"groups\": " << config.groups << ",\n";
+    out << "  \"duration_s\": " << result.seconds << ",\n";
+    out << "  \"messages\": " << result.messages << ",\n";
+    out << "  \"messages_per_s\": " << (result.seconds > 0 ? result.messages / result.seconds : 0.0) << ",\n";
+    out << "  \"bytes_per_s\": " << (result.seconds > 0 ? result.samples * static_cast<double>(config.payload_size) / result.seconds : 0.0) << ",\n";
+    out << "  \"latency_us\": {\n";
+    out << "    \"samples\": " << result.samples << ",\n";
+    out << "    \"mean\": " << mean << ",\n";
+    out << "    \"p50\": " << percentile(result.latencies, 0.5) << ",\n";
+    out << "    \"p90\": " << percentile(result.latencies, 0.9) << ",\n";
+    out << "    \"p99\": " << percentile(result.latencies, 0.99) << ",\n";
+    out << "    \"max\": " << (result.latencies.empty() ? 0 : result.latencies.back()) << "\n";
+    out << "  },\n";
+    out << "  \"cpu_s\": " << result.cpu_seconds << ",\n";
+    out << "  \"cpu_utilization\": " << (result.seconds > 0 ? result.cpu_seconds / result.seconds : 0.0) << "\n";
+    out << "}" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchConfig config;
+    std::string output_file;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+            ("help", "show help message")
+            ("topology", po::value<std::string>(&config.topology)->default_value("chain"), "chain, fanout, diamond, nested or iterated")
+            ("size", po::value<int>(&config.size)->default_value(8), "chain length, fan-out / diamond width, nesting depth or vector length")
+            ("payload", po::value<int>(&config.payload_size)->default_value(1024), "payload size per message in bytes")
+            ("threading", po::value<bool>(&config.threading)->default_value(true), "enable threading")
+            ("grouping", po::value<bool>(&config.grouping)->default_value(false), "enable thread grouping")
+            ("groups", po::value<int>(&config.groups)->default_value(0), "distribute the nodes round-robin over this many thread groups")
+            ("warmup", po::value<double>(&config.warmup)->default_value(0.5), "warmup time in seconds")
+            ("duration", po::value<double>(&config.duration)->default_value(5.0), "measurement time in seconds")
+            ("output", po::value<std::string>(&output_file), "write the results to this file instead of stdout")
+            ;
+    // clang-format on
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch (const std::exception& e) {
+        std::cerr << "cannot parse parameters: " << e.what() << std::endl;
+        std::cerr << desc << std::endl;
+        return 2;
+    }
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    try {
+        Benchmark benchmark(config);
+        benchmark.build();
+        BenchResult result = benchmark.run();
+
+        if (output_file.empty()) {
+            writeJson(std::cout, config, benchmark.countNodes(), result);
+        } else {
+            std::ofstream out(output_file);
+            writeJson(out, config, benchmark.countNodes(), result);
+        }
+
+        return result.messages > 0 ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
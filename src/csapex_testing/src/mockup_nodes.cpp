@@ -7,6 +7,11 @@
 #include <csapex/model/token.h>
 #include <csapex/param/parameter_factory.h>
 #include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/generic_vector_message.hpp>
+#include <csapex/msg/any_message.h>
+
+/// SYSTEM
+#include <chrono>
 
 using namespace csapex;
 
@@ -59,14 +64,14 @@ int MockupSource::getValue() const
     return readParameter<int>("value");
 }
 
-MockupSink::MockupSink() : aborted(false), value(-1)
+MockupSink::MockupSink(bool essential) : essential(essential), aborted(false), value(-1)
 {
 }
 
 void MockupSink::setup(NodeModifier& node_modifier)
 {
     in = node_modifier.addInput<int>("input");
-    in->setEssential(true);
+    in->setEssential(essential);
 }
 
 void MockupSink::setupParameters(Parameterizable& parameters)
@@ -90,6 +95,10 @@ void MockupSink::abort()
     aborted = true;
 }
 
+MockupNonEssentialSink::MockupNonEssentialSink() : MockupSink(false)
+{
+}
+
 AnySink::AnySink()
 {
 }
@@ -102,3 +111,144 @@ void AnySink::setup(NodeModifier& node_modifier)
 void AnySink::process(NodeModifier& node_modifier, Parameterizable& parameters)
 {
 }
+
+MockupPayloadSource::MockupPayloadSource()
+{
+}
+
+void MockupPayloadSource::setup(NodeModifier& node_modifier)
+{
+    out = node_modifier.addOutput<connection_types::MockMessage>("output");
+}
+
+void MockupPayloadSource::setupParameters(Parameterizable& parameters)
+{
+    parameters.addHiddenParameter(param::ParameterFactory::declareValue<int>("payload_size", 0));
+}
+
+void MockupPayloadSource::process()
+{
+    msg::publish(out, makePayload());
+}
+
+std::uint64_t MockupPayloadSource::now()
+{
+    auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(since_epoch).count();
+}
+
+std::shared_ptr<connection_types::MockMessage> MockupPayloadSource::makePayload()
+{
+    auto message = std::make_shared<connection_types::MockMessage>();
+    message->value.payload.assign(std::max(0, readParameter<int>("payload_size")), 'x');
+    message->stamp_micro_seconds = now();
+    return message;
+}
+
+void MockupPayloadVectorSource::setup(NodeModifier& node_modifier)
+{
+    out = node_modifier.addOutput<connection_types::GenericVectorMessage, connection_types::MockMessage>("output");
+}
+
+void MockupPayloadVectorSource::setupParameters(Parameterizable& parameters)
+{
+    MockupPayloadSource::setupParameters(parameters);
+    parameters.addHiddenParameter(param::ParameterFactory::declareValue<int>("elements", 1));
+}
+
+void MockupPayloadVectorSource::process()
+{
+    auto vector = std::make_shared<std::vector<connection_types::MockMessage>>();
+    int elements = readParameter<int>("elements");
+    for (int i = 0; i < elements; ++i) {
+        vector->push_back(*makePayload());
+    }
+
+    msg::publish<connection_types::GenericVectorMessage, connection_types::MockMessage>(out, vector);
+}
+
+void MockupPayloadForwarder::setup(NodeModifier& node_modifier)
+{
+    in = node_modifier.addInput<connection_types::MockMessage>("input");
+    out = node_modifier.addOutput<connection_types::MockMessage>("output");
+}
+
+void MockupPayloadForwarder::process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+{
+    TokenDataConstPtr message = msg::getMessage<connection_types::MockMessage>(in);
+    msg::publish(out, message);
+}
+
+void MockupPayloadJoin::setup(NodeModifier& node_modifier)
+{
+    in_a = node_modifier.addInput<connection_types::MockMessage>("input_a");
+    in_b = node_modifier.addInput<connection_types::MockMessage>("input_b");
+    out = node_modifier.addOutput<connection_types::MockMessage>("output");
+}
+
+void MockupPayloadJoin::process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+{
+    // forward the older message, so that the latency at the sink covers the slower branch
+    auto a = msg::getMessage<connection_types::MockMessage>(in_a);
+    auto b = msg::getMessage<connection_types::MockMessage>(in_b);
+
+    TokenDataConstPtr message = a->stamp_micro_seconds <= b->stamp_micro_seconds ? a : b;
+    msg::publish(out, message);
+}
+
+MockupPayloadSink::MockupPayloadSink() : count_(0)
+{
+}
+
+void MockupPayloadSink::setup(NodeModifier& node_modifier)
+{
+    in = node_modifier.addInput<connection_types::AnyMessage>("input");
+}
+
+void MockupPayloadSink::process(NodeModifier& /*node_modifier*/, Parameterizable& /*parameters*/)
+{
+    std::uint64_t now = MockupPayloadSource::now();
+
+    TokenDataConstPtr data = msg::getMessage(in);
+
+    std::vector<TokenDataConstPtr> messages;
+    std::size_t nested = data->nestedValueCount();
+    if (nested > 0) {
+        for (std::size_t i = 0; i < nested; ++i) {
+            messages.push_back(data->nestedValue(i));
+        }
+    } else {
+        messages.push_back(data);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++count_;
+    for (const TokenDataConstPtr& message : messages) {
+        if (auto stamped = std::dynamic_pointer_cast<connection_types::Message const>(message)) {
+            if (stamped->stamp_micro_seconds > 0 && stamped->stamp_micro_seconds <= now) {
+                latencies_.push_back(now - stamped->stamp_micro_seconds);
+            }
+        }
+    }
+}
+
+std::size_t MockupPayloadSink::getCount() const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return count_;
+}
+
+std::vector<std::uint64_t> MockupPayloadSink::takeLatencies()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<std::uint64_t> result;
+    result.swap(latencies_);
+    return result;
+}
+
+void MockupPayloadSink::reset()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    count_ = 0;
+    latencies_.clear();
+}
@@ -53,6 +53,7 @@ NodeConstructingTest::NodeConstructingTest()
     factory.registerNodeType(std::make_shared<NodeConstructor>("DynamicMultiplier", std::bind(&detail::makeNode<NodeWrapper<MockupDynamicMultiplierNode>>)));
     factory.registerNodeType(std::make_shared<NodeConstructor>("MockupSource", std::bind(&detail::makeNode<MockupSource>)));
     factory.registerNodeType(std::make_shared<NodeConstructor>("MockupSink", std::bind(&detail::makeNode<MockupSink>)));
+    factory.registerNodeType(std::make_shared<NodeConstructor>("MockupNonEssentialSink", std::bind(&detail::makeNode<MockupNonEssentialSink>)));
     factory.registerNodeType(std::make_shared<NodeConstructor>("AnySink", std::bind(&detail::makeNode<AnySink>)));
 }
 
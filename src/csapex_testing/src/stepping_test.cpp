@@ -5,6 +5,7 @@
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/graph_facade_impl.h>
+#include <csapex/utility/uuid_provider.h>
 
 using namespace csapex;
 
@@ -13,6 +14,12 @@ SteppingTest::SteppingTest()
     step_called_only_once = true;
 }
 
+SteppingTest::~SteppingTest()
+{
+    // the last step ends while its worker is still emitting, the nodes must not be destroyed before it returns
+    executor.stop();
+}
+
 void SteppingTest::SetUp()
 {
     NodeConstructingTest::SetUp();
@@ -47,6 +54,14 @@ void SteppingTest::TearDown()
     NodeConstructingTest::TearDown();
 }
 
+NodeFacadeImplementationPtr SteppingTest::makeNode(const std::string& type, const std::string& name)
+{
+    NodeFacadeImplementationPtr node = factory.makeNode(type, UUIDProvider::makeUUID_without_parent(name), graph);
+    apex_assert_hard(node);
+    main_graph_facade->addNode(node);
+    return node;
+}
+
 void SteppingTest::step()
 {
     // TRACEstd::cerr << "\n\nSTEP\n\n";
@@ -0,0 +1,40 @@
+#ifndef BYTE_SIZE_HPP
+#define BYTE_SIZE_HPP
+
+/// SYSTEM
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief heapSizeOf approximates the number of bytes a value owns outside of its own object, e.g. the buffer of a container.
+ *        Types without an overload are assumed to own no memory on the heap.
+ */
+template <typename T>
+std::size_t heapSizeOf(const T&)
+{
+    return 0;
+}
+
+inline std::size_t heapSizeOf(const std::string& value)
+{
+    return value.capacity();
+}
+
+template <typename T, typename Allocator>
+std::size_t heapSizeOf(const std::vector<T, Allocator>& value)
+{
+    std::size_t bytes = value.capacity() * sizeof(T);
+    if (!std::is_arithmetic<T>::value) {
+        for (const auto& entry : value) {
+            bytes += heapSizeOf(entry);
+        }
+    }
+    return bytes;
+}
+
+}  // namespace csapex
+
+#endif  // BYTE_SIZE_HPP
@@ -0,0 +1,58 @@
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+/// PROJECT
+#include <csapex_util_export.h>
+
+/// SYSTEM
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief CpuDomain is a set of cpus that share a last level cache and a memory controller.
+ *        Threads exchanging large messages should be placed in the same domain.
+ */
+struct CSAPEX_UTILS_EXPORT CpuDomain
+{
+    int id;
+    int numa_node;
+    int package;
+    std::vector<unsigned> cpus;
+
+    std::vector<bool> toAffinity(unsigned num_cpus) const;
+};
+
+/**
+ * @brief CpuTopology describes how the cpus of the machine are grouped into sockets,
+ *        NUMA nodes and L3 cache domains. On Linux it is read from sysfs, on other platforms
+ *        (or if sysfs is not available) all cpus are reported as a single domain.
+ */
+class CSAPEX_UTILS_EXPORT CpuTopology
+{
+public:
+    static CpuTopology fromSystem();
+    static CpuTopology fromSysfs(const std::string& sysfs_root);
+    static CpuTopology flat(unsigned num_cpus);
+
+    static std::vector<unsigned> parseCpuList(const std::string& list);
+
+public:
+    CpuTopology();
+
+    const std::vector<CpuDomain>& getDomains() const;
+    const CpuDomain* getDomainOf(unsigned cpu) const;
+
+    std::size_t getNumaNodeCount() const;
+    unsigned getCpuCount() const;
+
+private:
+    std::vector<CpuDomain> domains_;
+    std::size_t numa_nodes_;
+    unsigned num_cpus_;
+};
+
+}  // namespace csapex
+
+#endif  // CPU_TOPOLOGY_H
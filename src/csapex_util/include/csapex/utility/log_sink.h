@@ -0,0 +1,94 @@
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+/// PROJECT
+#include <csapex/utility/singleton.hpp>
+#include <csapex_util_export.h>
+
+/// SYSTEM
+#include <atomic>
+#include <condition_variable>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief LogSink decouples log output from the threads producing it.
+ *        Every producing thread owns a bounded single producer / single consumer ring,
+ *        so writing a line never blocks on other producers.
+ *        A background thread drains all rings and writes to the target streams.
+ *        It sleeps while there is nothing to write and is only woken up by the first line after that.
+ *        When a ring is full, lines are dropped and reported as such.
+ */
+class CSAPEX_UTILS_EXPORT LogSink : public Singleton<LogSink>
+{
+    friend class Singleton<LogSink>;
+
+public:
+    /**
+     * @brief Source post-processes its lines on the writer thread, before they are written out
+     */
+    class CSAPEX_UTILS_EXPORT Source
+    {
+    public:
+        virtual ~Source();
+
+        virtual void consume(const std::string& line) = 0;
+        virtual std::ostream& getStream() const = 0;
+    };
+
+public:
+    static const std::size_t RING_CAPACITY;
+
+    void write(std::ostream& stream, std::string text);
+    void write(Source& source, std::string line);
+
+    /**
+     * @brief flush blocks until all lines that were written before the call have been written out.
+     */
+    void flush();
+
+    long getDroppedCount() const;
+
+    void shutdown() override;
+
+private:
+    class Ring;
+
+    LogSink();
+    ~LogSink();
+
+    Ring& localRing();
+    void push(std::ostream* stream, Source* source, std::string&& text);
+
+    bool hasPendingLines();
+
+    void run();
+    void drain();
+
+private:
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+
+    std::mutex drain_mutex_;
+
+    std::mutex wake_up_mutex_;
+    std::condition_variable wake_up_;
+    std::atomic<bool> sleeping_;
+    std::thread writer_;
+
+    std::atomic<bool> running_;
+    std::atomic<bool> stopped_;
+
+    std::atomic<long> dropped_;
+    long reported_dropped_;
+};
+
+}  // namespace csapex
+
+#endif  // LOG_SINK_H
@@ -25,14 +25,14 @@ struct SemanticVersion
 
     constexpr SemanticVersion() = default;
 
-    bool operator!=(const SemanticVersion& other);
-    bool operator==(const SemanticVersion& other);
+    bool operator!=(const SemanticVersion& other) const;
+    bool operator==(const SemanticVersion& other) const;
 
-    bool operator<(const SemanticVersion& other);
-    bool operator<=(const SemanticVersion& other);
+    bool operator<(const SemanticVersion& other) const;
+    bool operator<=(const SemanticVersion& other) const;
 
-    bool operator>(const SemanticVersion& other);
-    bool operator>=(const SemanticVersion& other);
+    bool operator>(const SemanticVersion& other) const;
+    bool operator>=(const SemanticVersion& other) const;
 
     bool valid() const;
     operator bool() const;
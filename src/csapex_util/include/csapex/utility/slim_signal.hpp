@@ -139,8 +139,8 @@ void Signal<Signature>::removeParent(Signal<Signature>* parent)
 
     for (auto it = parents_.begin(); it != parents_.end();) {
         Signal<Signature>* c = *it;
-        apex_assert_hard(c->guard_ == -1);
         if (c == parent) {
+            apex_assert_hard(c->guard_ == -1);
             it = parents_.erase(it);
             c->removeChild(this);
 
@@ -258,9 +258,9 @@ void Signal<Signature>::removeChild(Signal<Signature>* child)
         std::unique_lock<std::recursive_mutex> lock(mutex_);
         for (auto it = children_.begin(); it != children_.end();) {
             Signal<Signature>* child_it = *it;
-            // if the child exists, it has to be valid, otherwise the pointer may point to a destructed object
-            apex_assert_hard(child_it->guard_ == -1);
             if (child_it == child) {
+                // if the child exists, it has to be valid, otherwise the pointer may point to a destructed object
+                apex_assert_hard(child_it->guard_ == -1);
                 std::vector<Connection*> to_remove;
                 for (Connection* connection : connections_) {
                     if (connection->getChild() == child) {
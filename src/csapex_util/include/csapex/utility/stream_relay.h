@@ -2,63 +2,122 @@
 #define STREAM_RELAY_H
 
 /// PROJECT
+#include <csapex/utility/log_sink.h>
 #include <csapex_util_export.h>
 
 /// SYSTEM
-#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace csapex
 {
-class CSAPEX_UTILS_EXPORT StreamRelay
+/**
+ * @brief StreamRelay collects log output line by line.
+ *        Every thread formats into its own line buffer, so writing does not take a lock.
+ *        Complete lines are handed to the LogSink, whose writer thread keeps a bounded history
+ *        and reports identical lines that are repeated quickly only once per REPEAT_INTERVAL.
+ */
+class CSAPEX_UTILS_EXPORT StreamRelay : public LogSink::Source
 {
 public:
-    StreamRelay(std::ostream& stream, const std::string& prefix);
+    enum class Level
+    {
+        DEBUG = 0,
+        INFO = 1,
+        WARNING = 2,
+        ERROR = 3
+    };
+
+    static const std::size_t DEFAULT_HISTORY_LIMIT;
+    static const std::chrono::milliseconds REPEAT_INTERVAL;
+
+public:
+    StreamRelay(std::ostream& stream, const std::string& prefix, Level level = Level::INFO);
     ~StreamRelay();
 
     void setPrefix(const std::string& prefix);
 
+    /**
+     * @brief isActive is checked before anything is formatted, so disabled or filtered relays are almost free.
+     */
+    bool isActive() const
+    {
+        return is_enabled_ && static_cast<int>(level_) >= minimum_level_;
+    }
+
     template <class Type>
     StreamRelay& operator<<(const Type& x)
     {
-        if (is_enabled_) {
-            if (has_prefix_) {
-                writePrefix();
-            }
-            *history_ << x;
-            s_ << x;
-        }
-        if (continued_) {
-            return *continued_;
-        } else {
-            return *this;
+        if (isActive()) {
+            localLine() << x;
         }
+        return *this;
     }
 
+    StreamRelay& operator<<(const char* x);
+    StreamRelay& operator<<(const std::string& x);
+    StreamRelay& operator<<(char x);
+
     void setEnabled(bool muted);
     bool isEnabled() const;
 
+    static void setMinimumLevel(Level level);
+    static Level getMinimumLevel();
+    static Level parseLevel(const std::string& name);
+
     typedef std::ostream& (*ostream_manipulator)(std::ostream&);
 
     StreamRelay& operator<<(std::ostream& (*pf)(std::ostream&));
 
-    std::stringstream& history() const;
+    void setHistoryLimit(std::size_t lines);
+    std::string history() const;
+
+    void consume(const std::string& line) override;
+    std::ostream& getStream() const override;
+
+private:
+    struct LineBuffers
+    {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<std::ostringstream>> lines;
+    };
 
 private:
-    StreamRelay(std::ostream& stream, std::shared_ptr<std::stringstream> history);
-    void writePrefix();
+    std::ostringstream& localLine();
+    void commitLines();
+    void emit(const std::string& line);
 
 private:
     std::ostream& s_;
 
-    bool is_enabled_;
+    Level level_;
+    std::atomic<bool> is_enabled_;
+
+    // lines are buffered per thread, the id keeps a buffer from being inherited by a relay at the same address
+    const std::uint64_t id_;
+    std::shared_ptr<LineBuffers> lines_;
+
+    // everything below is used by the writer thread
+    mutable std::mutex mutex_;
 
-    bool has_prefix_;
     std::string prefix_;
 
-    mutable std::shared_ptr<std::stringstream> history_;
-    std::unique_ptr<StreamRelay> continued_;
+    std::deque<std::string> history_;
+    std::size_t history_limit_;
+
+    std::string last_line_;
+    std::chrono::steady_clock::time_point last_emitted_;
+    std::size_t repetitions_;
+
+    static std::atomic<int> minimum_level_;
 };
 }  // namespace csapex
 
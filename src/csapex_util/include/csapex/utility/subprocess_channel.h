@@ -28,6 +28,7 @@ public:
         PARAMETER_UPDATE,
         PORT_ADD,
         NODE_STATE_CHANGED,
+        NODE_ADD,
 
         SHUTDOWN,
         CHILD_SIGNAL,
@@ -0,0 +1,191 @@
+/// HEADER
+#include <csapex/utility/cpu_topology.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+using namespace csapex;
+
+namespace
+{
+bool readLine(const std::string& path, std::string& line)
+{
+    std::ifstream in(path);
+    if (!in.good()) {
+        return false;
+    }
+    std::getline(in, line);
+    return true;
+}
+
+int readInt(const std::string& path, int fallback)
+{
+    std::string line;
+    if (!readLine(path, line)) {
+        return fallback;
+    }
+    try {
+        return std::stoi(line);
+    } catch (const std::exception&) {
+        return fallback;
+    }
+}
+
+std::vector<unsigned> readCpuList(const std::string& path)
+{
+    std::string line;
+    if (!readLine(path, line)) {
+        return {};
+    }
+    return CpuTopology::parseCpuList(line);
+}
+}  // namespace
+
+std::vector<bool> CpuDomain::toAffinity(unsigned num_cpus) const
+{
+    std::vector<bool> affinity(num_cpus, false);
+    for (unsigned cpu : cpus) {
+        if (cpu < num_cpus) {
+            affinity[cpu] = true;
+        }
+    }
+    return affinity;
+}
+
+CpuTopology::CpuTopology() : numa_nodes_(0), num_cpus_(0)
+{
+}
+
+CpuTopology CpuTopology::fromSystem()
+{
+#if WIN32
+    return flat(std::thread::hardware_concurrency());
+#else
+    return fromSysfs("/sys/devices/system");
+#endif
+}
+
+CpuTopology CpuTopology::flat(unsigned num_cpus)
+{
+    CpuTopology topology;
+    CpuDomain domain;
+    domain.id = 0;
+    domain.numa_node = 0;
+    domain.package = 0;
+    for (unsigned cpu = 0; cpu < std::max(1u, num_cpus); ++cpu) {
+        domain.cpus.push_back(cpu);
+    }
+    topology.num_cpus_ = domain.cpus.size();
+    topology.numa_nodes_ = 1;
+    topology.domains_.push_back(domain);
+    return topology;
+}
+
+CpuTopology CpuTopology::fromSysfs(const std::string& sysfs_root)
+{
+    std::vector<unsigned> present = readCpuList(sysfs_root + "/cpu/present");
+    if (present.empty()) {
+        return flat(std::thread::hardware_concurrency());
+    }
+
+    std::map<unsigned, int> numa_node_of;
+    std::set<int> numa_nodes;
+    for (unsigned node : readCpuList(sysfs_root + "/node/online")) {
+        for (unsigned cpu : readCpuList(sysfs_root + "/node/node" + std::to_string(node) + "/cpulist")) {
+            numa_node_of[cpu] = node;
+            numa_nodes.insert(node);
+        }
+    }
+
+    // cpus are grouped by (numa node, package, first cpu sharing the L3 cache)
+    typedef std::tuple<int, int, int> Key;
+    std::map<Key, std::vector<unsigned>> groups;
+    for (unsigned cpu : present) {
+        std::string cpu_dir = sysfs_root + "/cpu/cpu" + std::to_string(cpu);
+
+        auto numa = numa_node_of.find(cpu);
+        int numa_node = numa != numa_node_of.end() ? numa->second : 0;
+        int package = readInt(cpu_dir + "/topology/physical_package_id", 0);
+
+        std::vector<unsigned> l3 = readCpuList(cpu_dir + "/cache/index3/shared_cpu_list");
+        int l3_leader = l3.empty() ? -1 : static_cast<int>(*std::min_element(l3.begin(), l3.end()));
+
+        groups[Key(numa_node, package, l3_leader)].push_back(cpu);
+    }
+
+    CpuTopology topology;
+    topology.numa_nodes_ = std::max<std::size_t>(1, numa_nodes.size());
+    for (const auto& group : groups) {
+        CpuDomain domain;
+        domain.id = topology.domains_.size();
+        domain.numa_node = std::get<0>(group.first);
+        domain.package = std::get<1>(group.first);
+        domain.cpus = group.second;
+        topology.domains_.push_back(domain);
+
+        topology.num_cpus_ = std::max(topology.num_cpus_, domain.cpus.back() + 1);
+    }
+    return topology;
+}
+
+std::vector<unsigned> CpuTopology::parseCpuList(const std::string& list)
+{
+    std::vector<unsigned> cpus;
+
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range.find_first_not_of(" \t\n") == std::string::npos) {
+            continue;
+        }
+        try {
+            std::size_t dash = range.find('-');
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoul(range));
+            } else {
+                unsigned first = std::stoul(range.substr(0, dash));
+                unsigned last = std::stoul(range.substr(dash + 1));
+                for (unsigned cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+const std::vector<CpuDomain>& CpuTopology::getDomains() const
+{
+    return domains_;
+}
+
+const CpuDomain* CpuTopology::getDomainOf(unsigned cpu) const
+{
+    for (const CpuDomain& domain : domains_) {
+        if (std::find(domain.cpus.begin(), domain.cpus.end(), cpu) != domain.cpus.end()) {
+            return &domain;
+        }
+    }
+    return nullptr;
+}
+
+std::size_t CpuTopology::getNumaNodeCount() const
+{
+    return numa_nodes_;
+}
+
+unsigned CpuTopology::getCpuCount() const
+{
+    return num_cpus_;
+}
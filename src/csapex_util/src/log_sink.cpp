@@ -0,0 +1,250 @@
+/// HEADER
+#include <csapex/utility/log_sink.h>
+
+/// PROJECT
+#include <csapex/utility/thread.h>
+
+/// SYSTEM
+#include <iostream>
+#include <set>
+
+using namespace csapex;
+
+const std::size_t LogSink::RING_CAPACITY = 1024;
+
+class LogSink::Ring
+{
+public:
+    struct Entry
+    {
+        std::ostream* stream;
+        Source* source;
+        std::string text;
+    };
+
+    Ring() : entries_(RING_CAPACITY), head_(0), tail_(0)
+    {
+    }
+
+    // producer side, only ever called by the owning thread
+    bool push(std::ostream* stream, Source* source, std::string&& text)
+    {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t head = head_.load(std::memory_order_acquire);
+        if (tail - head >= entries_.size()) {
+            return false;
+        }
+
+        Entry& entry = entries_[tail % entries_.size()];
+        entry.stream = stream;
+        entry.source = source;
+        entry.text = std::move(text);
+
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, serialized by the drain mutex
+    template <typename Callback>
+    void consume(Callback callback)
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t tail = tail_.load(std::memory_order_acquire);
+        while (head != tail) {
+            Entry& entry = entries_[head % entries_.size()];
+            callback(entry);
+            std::string().swap(entry.text);
+
+            ++head;
+            head_.store(head, std::memory_order_release);
+        }
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<Entry> entries_;
+
+    std::atomic<std::size_t> head_;
+    std::atomic<std::size_t> tail_;
+};
+
+LogSink::Source::~Source()
+{
+}
+
+LogSink::LogSink() : sleeping_(false), running_(false), stopped_(false), dropped_(0), reported_dropped_(0)
+{
+}
+
+LogSink::~LogSink()
+{
+    shutdown();
+}
+
+void LogSink::shutdown()
+{
+    {
+        std::unique_lock<std::mutex> lock(rings_mutex_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(wake_up_mutex_);
+        wake_up_.notify_all();
+    }
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    drain();
+}
+
+void LogSink::write(std::ostream& stream, std::string text)
+{
+    if (stopped_) {
+        stream << text << std::flush;
+        return;
+    }
+
+    push(&stream, nullptr, std::move(text));
+}
+
+void LogSink::write(Source& source, std::string line)
+{
+    if (stopped_) {
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        source.consume(line);
+        source.getStream().flush();
+        return;
+    }
+
+    push(nullptr, &source, std::move(line));
+}
+
+void LogSink::push(std::ostream* stream, Source* source, std::string&& text)
+{
+    if (!localRing().push(stream, source, std::move(text))) {
+        ++dropped_;
+        return;
+    }
+
+    // pairs with the fence in run(): either the writer sees the new line or we see that it sleeps
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        std::unique_lock<std::mutex> lock(wake_up_mutex_);
+        sleeping_ = false;
+        wake_up_.notify_one();
+    }
+}
+
+void LogSink::flush()
+{
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    drain();
+}
+
+long LogSink::getDroppedCount() const
+{
+    return dropped_;
+}
+
+LogSink::Ring& LogSink::localRing()
+{
+    static thread_local std::shared_ptr<Ring> ring;
+    if (!ring) {
+        ring = std::make_shared<Ring>();
+
+        std::unique_lock<std::mutex> lock(rings_mutex_);
+        rings_.push_back(ring);
+
+        if (!running_ && !stopped_) {
+            running_ = true;
+            writer_ = std::thread(&LogSink::run, this);
+        }
+    }
+    return *ring;
+}
+
+bool LogSink::hasPendingLines()
+{
+    std::unique_lock<std::mutex> lock(rings_mutex_);
+    for (const std::shared_ptr<Ring>& ring : rings_) {
+        if (!ring->empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LogSink::run()
+{
+    csapex::thread::set_name("log_sink");
+
+    while (!stopped_) {
+        {
+            std::unique_lock<std::mutex> lock(wake_up_mutex_);
+            sleeping_ = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (hasPendingLines()) {
+                sleeping_ = false;
+            } else {
+                wake_up_.wait(lock, [this]() { return !sleeping_ || stopped_; });
+                sleeping_ = false;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        drain();
+    }
+}
+
+void LogSink::drain()
+{
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::unique_lock<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    std::set<std::ostream*> touched;
+    for (const std::shared_ptr<Ring>& ring : rings) {
+        ring->consume([&touched](Ring::Entry& entry) {
+            if (entry.source) {
+                entry.source->consume(entry.text);
+                touched.insert(&entry.source->getStream());
+            } else {
+                *entry.stream << entry.text;
+                touched.insert(entry.stream);
+            }
+        });
+    }
+
+    long dropped = dropped_;
+    if (dropped != reported_dropped_) {
+        std::cerr << "[log] " << (dropped - reported_dropped_) << " lines were dropped, the log ring was full" << std::endl;
+        reported_dropped_ = dropped;
+    }
+
+    for (std::ostream* stream : touched) {
+        stream->flush();
+    }
+
+    // rings of threads that have terminated are only referenced by us
+    rings.clear();
+    std::unique_lock<std::mutex> lock(rings_mutex_);
+    for (auto it = rings_.begin(); it != rings_.end();) {
+        if (it->use_count() == 1 && (*it)->empty()) {
+            it = rings_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
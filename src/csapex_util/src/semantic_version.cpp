@@ -3,7 +3,7 @@
 
 using namespace csapex;
 
-bool SemanticVersion::operator<(const SemanticVersion& other)
+bool SemanticVersion::operator<(const SemanticVersion& other) const
 {
     if (major_v < other.major_v) {
         return true;
@@ -20,26 +20,26 @@ bool SemanticVersion::operator<(const SemanticVersion& other)
     return patch_v < other.patch_v;
 }
 
-bool SemanticVersion::operator==(const SemanticVersion& other)
+bool SemanticVersion::operator==(const SemanticVersion& other) const
 {
     return major_v == other.major_v && minor_v == other.minor_v && patch_v == other.patch_v;
 }
 
-bool SemanticVersion::operator>(const SemanticVersion& other)
+bool SemanticVersion::operator>(const SemanticVersion& other) const
 {
     return (operator>=(other)) && (operator!=(other));
 }
 
-bool SemanticVersion::operator>=(const SemanticVersion& other)
+bool SemanticVersion::operator>=(const SemanticVersion& other) const
 {
     return !(operator<(other));
 }
-bool SemanticVersion::operator<=(const SemanticVersion& other)
+bool SemanticVersion::operator<=(const SemanticVersion& other) const
 {
     return (operator<(other)) || (operator==(other));
 }
 
-bool SemanticVersion::operator!=(const SemanticVersion& other)
+bool SemanticVersion::operator!=(const SemanticVersion& other) const
 {
     return !(operator==(other));
 }
@@ -2,58 +2,236 @@
 #include <csapex/utility/stream_relay.h>
 
 /// SYSTEM
-#include <sstream>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 using namespace csapex;
 
-StreamRelay::StreamRelay(std::ostream& stream, const std::string& prefix)
-  : s_(stream), is_enabled_(true), has_prefix_(true), prefix_(prefix), history_(new std::stringstream), continued_(new StreamRelay(s_, history_))
+const std::size_t StreamRelay::DEFAULT_HISTORY_LIMIT = 256;
+const std::chrono::milliseconds StreamRelay::REPEAT_INTERVAL(1000);
+
+std::atomic<int> StreamRelay::minimum_level_(static_cast<int>(StreamRelay::Level::DEBUG));
+
+namespace
 {
-}
-StreamRelay::StreamRelay(std::ostream& stream, std::shared_ptr<std::stringstream> history) : s_(stream), is_enabled_(true), has_prefix_(false), history_(history)
+std::atomic<std::uint64_t> g_next_relay_id(0);
+
+struct LocalLine
+{
+    std::weak_ptr<std::ostringstream> owner;
+    std::ostringstream* line;
+};
+}  // namespace
+
+StreamRelay::StreamRelay(std::ostream& stream, const std::string& prefix, Level level)
+  : s_(stream), level_(level), is_enabled_(true), id_(g_next_relay_id++), lines_(std::make_shared<LineBuffers>()), prefix_(prefix), history_limit_(DEFAULT_HISTORY_LIMIT), repetitions_(0)
 {
 }
 
 StreamRelay::~StreamRelay()
 {
+    // unterminated lines are written as they are
+    {
+        std::unique_lock<std::mutex> lock(lines_->mutex);
+        for (const std::shared_ptr<std::ostringstream>& line : lines_->lines) {
+            std::string rest = line->str();
+            if (!rest.empty()) {
+                LogSink::instance().write(*this, rest);
+            }
+        }
+    }
+
+    // afterwards no line refers to this relay anymore
+    LogSink::instance().flush();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (repetitions_ > 0) {
+        LogSink::instance().write(s_, "[" + prefix_ + "] last message repeated " + std::to_string(repetitions_) + " times\n");
+    }
 }
 
 void StreamRelay::setPrefix(const std::string& prefix)
 {
+    std::unique_lock<std::mutex> lock(mutex_);
     prefix_ = prefix;
 }
 
-void StreamRelay::writePrefix()
+std::ostringstream& StreamRelay::localLine()
+{
+    static thread_local std::unordered_map<std::uint64_t, LocalLine> local_lines;
+
+    auto pos = local_lines.find(id_);
+    if (pos != local_lines.end()) {
+        return *pos->second.line;
+    }
+
+    // first line of this relay on this thread, forget the lines of relays that do not exist anymore
+    for (auto it = local_lines.begin(); it != local_lines.end();) {
+        if (it->second.owner.expired()) {
+            it = local_lines.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto line = std::make_shared<std::ostringstream>();
+    {
+        std::unique_lock<std::mutex> lock(lines_->mutex);
+        lines_->lines.push_back(line);
+    }
+
+    local_lines[id_] = LocalLine{ line, line.get() };
+    return *line;
+}
+
+StreamRelay& StreamRelay::operator<<(const char* x)
 {
-    s_ << "[" << prefix_ << "] ";
+    if (isActive()) {
+        localLine() << x;
+        commitLines();
+    }
+    return *this;
+}
+
+StreamRelay& StreamRelay::operator<<(const std::string& x)
+{
+    if (isActive()) {
+        localLine() << x;
+        commitLines();
+    }
+    return *this;
 }
 
-std::stringstream& StreamRelay::history() const
+StreamRelay& StreamRelay::operator<<(char x)
 {
-    return *history_;
+    if (isActive()) {
+        localLine() << x;
+        if (x == '\n') {
+            commitLines();
+        }
+    }
+    return *this;
 }
 
 StreamRelay& StreamRelay::operator<<(std::ostream& (*pf)(std::ostream&))
 {
-    if (is_enabled_) {
-        *history_ << pf;
-        s_ << pf;
+    if (isActive()) {
+        localLine() << pf;
+        commitLines();
     }
+    return *this;
+}
 
-    return *continued_;
+void StreamRelay::commitLines()
+{
+    std::ostringstream& line = localLine();
+    std::string buffer = line.str();
+    std::size_t end = buffer.rfind('\n');
+    if (end == std::string::npos) {
+        return;
+    }
+
+    line.str(std::string());
+    line << buffer.substr(end + 1);
+
+    std::size_t begin = 0;
+    while (begin <= end) {
+        std::size_t next = buffer.find('\n', begin);
+        LogSink::instance().write(*this, buffer.substr(begin, next - begin));
+        begin = next + 1;
+    }
 }
 
-void StreamRelay::setEnabled(bool enable)
+void StreamRelay::consume(const std::string& line)
 {
-    if (is_enabled_ != enable) {
-        is_enabled_ = enable;
-        if (continued_) {
-            continued_->setEnabled(enable);
-        }
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto now = std::chrono::steady_clock::now();
+    if (line == last_line_ && now - last_emitted_ < REPEAT_INTERVAL) {
+        ++repetitions_;
+        return;
+    }
+
+    if (repetitions_ > 0) {
+        emit("last message repeated " + std::to_string(repetitions_) + " times");
+        repetitions_ = 0;
+    }
+
+    emit(line);
+    last_line_ = line;
+    last_emitted_ = now;
+}
+
+std::ostream& StreamRelay::getStream() const
+{
+    return s_;
+}
+
+void StreamRelay::emit(const std::string& line)
+{
+    history_.push_back(line);
+    while (history_.size() > history_limit_) {
+        history_.pop_front();
     }
+
+    s_ << "[" << prefix_ << "] " << line << '\n';
+}
+
+void StreamRelay::setEnabled(bool enable)
+{
+    is_enabled_ = enable;
 }
 
 bool StreamRelay::isEnabled() const
 {
     return is_enabled_;
 }
+
+void StreamRelay::setMinimumLevel(Level level)
+{
+    minimum_level_ = static_cast<int>(level);
+}
+
+StreamRelay::Level StreamRelay::getMinimumLevel()
+{
+    return static_cast<Level>(minimum_level_.load());
+}
+
+StreamRelay::Level StreamRelay::parseLevel(const std::string& name)
+{
+    if (name == "debug") {
+        return Level::DEBUG;
+    } else if (name == "info") {
+        return Level::INFO;
+    } else if (name == "warning") {
+        return Level::WARNING;
+    } else if (name == "error") {
+        return Level::ERROR;
+    }
+    throw std::runtime_error(std::string("unknown log level: ") + name);
+}
+
+void StreamRelay::setHistoryLimit(std::size_t lines)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    history_limit_ = lines;
+    while (history_.size() > history_limit_) {
+        history_.pop_front();
+    }
+}
+
+std::string StreamRelay::history() const
+{
+    // the history is kept by the writer thread
+    LogSink::instance().flush();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::string result;
+    for (const std::string& line : history_) {
+        result += line;
+        result += '\n';
+    }
+    return result;
+}
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+
+#include <csapex/utility/cpu_topology.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+using namespace csapex;
+
+class CpuTopologyTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char dir_template[] = "/tmp/csapex_sysfs_XXXXXX";
+        char* dir = mkdtemp(dir_template);
+        ASSERT_NE(nullptr, dir);
+        root = dir;
+    }
+
+    void TearDown() override
+    {
+        std::system(("rm -rf " + root).c_str());
+    }
+
+    void write(const std::string& path, const std::string& content)
+    {
+        std::string full = root + "/" + path;
+        std::system(("mkdir -p " + full.substr(0, full.find_last_of('/'))).c_str());
+        std::ofstream out(full);
+        out << content << '\n';
+    }
+
+    std::string root;
+};
+
+TEST_F(CpuTopologyTest, CpuListsAreParsed)
+{
+    std::vector<unsigned> cpus = CpuTopology::parseCpuList("0-2,8,10-11");
+    std::vector<unsigned> expected{ 0, 1, 2, 8, 10, 11 };
+    EXPECT_EQ(expected, cpus);
+
+    EXPECT_TRUE(CpuTopology::parseCpuList("").empty());
+    EXPECT_TRUE(CpuTopology::parseCpuList("x-y").empty());
+}
+
+TEST_F(CpuTopologyTest, DualSocketMachineIsSplitIntoDomains)
+{
+    write("cpu/present", "0-3");
+    write("node/online", "0-1");
+    write("node/node0/cpulist", "0-1");
+    write("node/node1/cpulist", "2-3");
+    for (int cpu = 0; cpu < 4; ++cpu) {
+        std::string dir = "cpu/cpu" + std::to_string(cpu);
+        write(dir + "/topology/physical_package_id", cpu < 2 ? "0" : "1");
+        write(dir + "/cache/index3/shared_cpu_list", cpu < 2 ? "0-1" : "2-3");
+    }
+
+    CpuTopology topology = CpuTopology::fromSysfs(root);
+    ASSERT_EQ(2u, topology.getDomains().size());
+    EXPECT_EQ(2u, topology.getNumaNodeCount());
+    EXPECT_EQ(4u, topology.getCpuCount());
+
+    const CpuDomain* domain = topology.getDomainOf(3);
+    ASSERT_NE(nullptr, domain);
+    EXPECT_EQ(1, domain->numa_node);
+    EXPECT_EQ(1, domain->package);
+
+    std::vector<bool> expected{ false, false, true, true };
+    EXPECT_EQ(expected, domain->toAffinity(4));
+}
+
+TEST_F(CpuTopologyTest, MissingSysfsFallsBackToASingleDomain)
+{
+    CpuTopology topology = CpuTopology::fromSysfs(root + "/does_not_exist");
+    ASSERT_EQ(1u, topology.getDomains().size());
+    EXPECT_EQ(1u, topology.getNumaNodeCount());
+}
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+
+#include <csapex/utility/log_sink.h>
+#include <csapex/utility/stream_relay.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace csapex;
+
+namespace
+{
+struct FormattingProbe
+{
+    mutable bool formatted = false;
+};
+
+std::ostream& operator<<(std::ostream& out, const FormattingProbe& probe)
+{
+    probe.formatted = true;
+    return out << "probe";
+}
+}  // namespace
+
+class StreamRelayTest : public ::testing::Test
+{
+protected:
+    ~StreamRelayTest()
+    {
+        // pending lines refer to the stream, so they must be written before it is destroyed
+        LogSink::instance().flush();
+        StreamRelay::setMinimumLevel(StreamRelay::Level::DEBUG);
+    }
+
+    std::stringstream out;
+};
+
+TEST_F(StreamRelayTest, LinesAreWrittenAsynchronously)
+{
+    StreamRelay relay(out, "node");
+    relay << "value: " << 42 << std::endl;
+    relay << "second" << std::endl;
+
+    LogSink::instance().flush();
+
+    EXPECT_EQ("[node] value: 42\n[node] second\n", out.str());
+    EXPECT_EQ("value: 42\nsecond\n", relay.history());
+}
+
+TEST_F(StreamRelayTest, FilteredLevelsAreNotFormatted)
+{
+    StreamRelay relay(out, "node", StreamRelay::Level::DEBUG);
+    StreamRelay::setMinimumLevel(StreamRelay::Level::WARNING);
+
+    FormattingProbe probe;
+    relay << probe << std::endl;
+
+    LogSink::instance().flush();
+
+    EXPECT_FALSE(probe.formatted);
+    EXPECT_TRUE(out.str().empty());
+    EXPECT_TRUE(relay.history().empty());
+}
+
+TEST_F(StreamRelayTest, HistoryIsBounded)
+{
+    StreamRelay relay(out, "node");
+    relay.setHistoryLimit(3);
+
+    for (int i = 0; i < 10; ++i) {
+        relay << "line " << i << std::endl;
+    }
+
+    EXPECT_EQ("line 7\nline 8\nline 9\n", relay.history());
+}
+
+TEST_F(StreamRelayTest, RepeatedLinesAreRateLimited)
+{
+    StreamRelay relay(out, "node");
+
+    for (int i = 0; i < 100; ++i) {
+        relay << "spam" << std::endl;
+    }
+    relay << "done" << std::endl;
+
+    LogSink::instance().flush();
+
+    EXPECT_EQ("[node] spam\n[node] last message repeated 99 times\n[node] done\n", out.str());
+}
+
+TEST_F(StreamRelayTest, LinesOfConcurrentThreadsAreNotInterleaved)
+{
+    StreamRelay relay(out, "node");
+
+    auto write = [&relay](char c) {
+        for (int i = 0; i < 100; ++i) {
+            relay << c << ' ' << i << ' ' << c << std::endl;
+        }
+    };
+    std::thread a(write, 'a');
+    std::thread b(write, 'b');
+    a.join();
+    b.join();
+
+    LogSink::instance().flush();
+
+    std::string line;
+    int lines = 0;
+    while (std::getline(out, line)) {
+        ++lines;
+        ASSERT_EQ(line[7], line[line.size() - 1]) << line;
+    }
+    EXPECT_EQ(200, lines);
+}
+
+TEST_F(StreamRelayTest, LevelsAreParsedFromTheirNames)
+{
+    EXPECT_EQ(StreamRelay::Level::DEBUG, StreamRelay::parseLevel("debug"));
+    EXPECT_EQ(StreamRelay::Level::INFO, StreamRelay::parseLevel("info"));
+    EXPECT_EQ(StreamRelay::Level::WARNING, StreamRelay::parseLevel("warning"));
+    EXPECT_EQ(StreamRelay::Level::ERROR, StreamRelay::parseLevel("error"));
+    EXPECT_THROW(StreamRelay::parseLevel("verbose"), std::runtime_error);
+}